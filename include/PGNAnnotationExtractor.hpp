@@ -0,0 +1,89 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace chessDataLib {
+
+/**
+ * @brief Per-ply annotation columns extracted from PGN move text.
+ *
+ * Clock values are in centiseconds, evaluations in centipawns from White's
+ * point of view. Plies without an annotation hold kNoValue.
+ */
+struct GameAnnotations {
+    static constexpr int32_t kNoValue = INT32_MIN;  ///< Missing annotation marker
+    static constexpr int32_t kMateScore = 100000;   ///< Mate in n is stored as ±(kMateScore - n)
+
+    int plies = 0;                ///< Number of mainline plies seen
+    std::vector<int32_t> clocks;  ///< [%clk] per ply, empty if the game has none
+    std::vector<int32_t> evals;   ///< [%eval] per ply, empty if the game has none
+};
+
+/**
+ * @brief Extracts [%clk] and [%eval] comment commands from PGN move text.
+ *
+ * Counts mainline plies in a single pass and attaches each command to the ply
+ * it follows, walking the mainline with PGNMoveText::WalkMainline() so ply
+ * counts match the encoded moves. Variations and ';' comments are skipped;
+ * comment bodies are searched for "[%" with a vectorized scan.
+ */
+class PGNAnnotationExtractor {
+public:
+    static constexpr int kBlunderThreshold = 300;  ///< Default evaluation drop, in centipawns, counted as a blunder
+
+    /**
+     * @brief Scans move text and fills ply count and annotation columns.
+     * @param moveText Raw move section as a string.
+     * @return Extracted annotations; columns are empty when absent.
+     */
+    static GameAnnotations Extract(const std::string& moveText);
+
+    /**
+     * @brief Scans raw move text in place, line breaks included.
+     * @param begin Start of the move section.
+     * @param end End of the move section.
+     * @return Extracted annotations; columns are empty when absent.
+     */
+    static GameAnnotations Extract(const char* begin, const char* end);
+
+    /**
+     * @brief Parses a clock value such as "1:02:03" or "0:00:59.5".
+     * @return Centiseconds, or GameAnnotations::kNoValue if malformed (including fields over 9 digits).
+     */
+    static int32_t ParseClock(const char* begin, const char* end);
+
+    /**
+     * @brief Parses an evaluation such as "0.25", "-1.3" or "#-3".
+     * @return Centipawns (mates mapped near ±kMateScore), or kNoValue if malformed or over 9 integer digits.
+     */
+    static int32_t ParseEval(const char* begin, const char* end);
+
+    /**
+     * @brief Sums clock time consumed by one side.
+     *
+     * Time for a ply is the drop from the same side's previous clock reading;
+     * increments are not known, so gains are clamped to zero.
+     * @param clocks Per-ply clock column.
+     * @param white True for White's plies, false for Black's.
+     * @param spentCentis Receives the consumed time in centiseconds.
+     * @param timedMoves Receives the number of moves with two clock readings.
+     * @param whiteMovesFirst False if the first ply is Black's (a FEN start with Black to move).
+     */
+    static void ComputeTimeUsage(const std::vector<int32_t>& clocks, bool white,
+                                 int64_t& spentCentis, int& timedMoves, bool whiteMovesFirst = true);
+
+    /**
+     * @brief Counts one side's moves that lose at least threshold centipawns.
+     * @param evals Per-ply evaluation column.
+     * @param white True for White's plies, false for Black's.
+     * @param thresholdCentipawns Evaluation drop treated as a blunder.
+     * @param whiteMovesFirst False if the first ply is Black's (a FEN start with Black to move).
+     * @return Number of blunders.
+     */
+    static int CountBlunders(const std::vector<int32_t>& evals, bool white,
+                             int thresholdCentipawns = kBlunderThreshold, bool whiteMovesFirst = true);
+};
+
+} // namespace chessDataLib
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "game.hpp"
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace chessDataLib {
+
+/**
+ * @brief Writes the games of PGN files that satisfy a predicate to a new PGN file.
+ *
+ * Games are not re-serialized: the original bytes of each selected game
+ * (through the blank lines that follow it) are copied from the source.
+ * Adjacent selected games are coalesced into one range. On Linux ranges are
+ * copied in the kernel with copy_file_range; elsewhere, or when the kernel
+ * refuses, they are written straight from the memory-mapped source.
+ */
+class PGNExporter {
+public:
+    /**
+     * @brief Selects games to keep. Called concurrently from worker threads.
+     *
+     * Games carry their tags, move count and annotations, but no move text
+     * handle: the run's mappings are not kept in any SourceTable.
+     */
+    using Predicate = std::function<bool(const Game&)>;
+
+    /**
+     * @brief Counters of one export run.
+     */
+    struct Summary {
+        std::uint64_t gamesScanned = 0;  ///< Games parsed from all inputs
+        std::uint64_t gamesWritten = 0;  ///< Games that matched the predicate
+        std::uint64_t bytesWritten = 0;  ///< Bytes written to the output
+        std::uint64_t ranges = 0;        ///< Coalesced byte ranges copied
+    };
+
+    /**
+     * @brief Sets the number of worker threads used to scan and filter.
+     * @param count Thread count; 0 selects the hardware concurrency.
+     */
+    void SetThreadCount(unsigned count);
+
+    /**
+     * @brief Sets the target size of the byte ranges scheduled as tasks.
+     * @param bytes Target chunk size in bytes.
+     */
+    void SetChunkSize(std::uint64_t bytes);
+
+    /**
+     * @brief Writes matching games of the inputs, in input order, to a file.
+     * @param inputs Paths to PGN files.
+     * @param output Output file path (truncated); must not name one of the inputs.
+     * @param predicate Returns true for games to keep.
+     * @param summary Optional counters of the run.
+     * @return False if the output is an input, an input cannot be opened or writing fails.
+     */
+    bool ExportFiltered(const std::vector<std::string>& inputs, const std::string& output,
+                        const Predicate& predicate, Summary* summary = nullptr) const;
+
+private:
+    unsigned threadCount = 0;
+    std::uint64_t chunkSize = 32ull << 20;
+};
+
+} // namespace chessDataLib
@@ -0,0 +1,109 @@
+#pragma once
+
+#include "board.hpp"
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace chessDataLib {
+
+/**
+ * @brief Helpers for walking the mainline of PGN move text.
+ *
+ * Comments, variations, NAGs, move numbers and the result token are skipped.
+ */
+class PGNMoveText {
+public:
+    /**
+     * @brief Checks whether a token is a SAN move.
+     *
+     * Accepts move-number prefixes such as "12.e4" and "12...e5", castling
+     * written with 'O' or '0', and the "--" null move.
+     * @param begin Start of the token.
+     * @param end End of the token.
+     * @return True if the token is a move.
+     */
+    static bool IsMoveToken(const char* begin, const char* end);
+
+    /**
+     * @brief Walks the mainline of a move text range.
+     *
+     * Calls onMove(begin, end) for each mainline SAN move, without
+     * move-number prefix or trailing "!"/"?" glyphs, and onComment(begin, end)
+     * for the body of each mainline "{...}" comment. ';' comments run to the
+     * end of their line. The walk stops when a callback returns false.
+     * @param begin Start of the move text.
+     * @param end End of the move text.
+     */
+    template <typename OnMove, typename OnComment>
+    static void WalkMainline(const char* begin, const char* end, OnMove onMove, OnComment onComment);
+
+    /**
+     * @brief Returns the SAN mainline moves of a move text range.
+     *
+     * Move-number prefixes and trailing "!"/"?" glyphs are stripped.
+     * @param begin Start of the move text.
+     * @param end End of the move text.
+     * @return SAN moves in game order.
+     */
+    static std::vector<std::string> MainlineMoves(const char* begin, const char* end);
+
+    /**
+     * @brief Replays the mainline on a board and appends the packed moves.
+     *
+     * Stops at the first move that does not resolve to exactly one legal
+     * move, so the output is always a legal prefix of the game.
+     * @param begin Start of the move text.
+     * @param end End of the move text.
+     * @param board Starting position; left at the position after the last encoded move.
+     * @param out Receives the packed moves.
+     * @return Number of moves appended.
+     */
+    static std::size_t EncodeMainline(const char* begin, const char* end, Board& board, std::vector<PackedMove>& out);
+
+private:
+    static bool IsSpace(char c) { return c == ' ' || c == '\t' || c == '\n' || c == '\r'; }
+    static bool IsDigit(char c) { return c >= '0' && c <= '9'; }
+};
+
+template <typename OnMove, typename OnComment>
+void PGNMoveText::WalkMainline(const char* p, const char* end, OnMove onMove, OnComment onComment) {
+    int depth = 0; // variation nesting
+
+    while (p < end) {
+        const char c = *p;
+        if (IsSpace(c)) {
+            ++p;
+        } else if (c == '{') {
+            const char* close = static_cast<const char*>(std::memchr(p + 1, '}', static_cast<std::size_t>(end - p - 1)));
+            if (!close) close = end;
+            if (depth == 0 && !onComment(p + 1, close)) return;
+            p = close == end ? end : close + 1;
+        } else if (c == ';') {
+            const char* eol = static_cast<const char*>(std::memchr(p, '\n', static_cast<std::size_t>(end - p)));
+            p = eol ? eol + 1 : end;
+        } else if (c == '(') {
+            ++depth;
+            ++p;
+        } else if (c == ')') {
+            if (depth > 0) --depth;
+            ++p;
+        } else {
+            const char* tokEnd = p;
+            while (tokEnd < end && !IsSpace(*tokEnd) && *tokEnd != '{' && *tokEnd != '(' && *tokEnd != ')') ++tokEnd;
+            if (depth == 0 && IsMoveToken(p, tokEnd)) {
+                const char* s = p;
+                if (IsDigit(*s) && !(tokEnd - s >= 3 && s[1] == '-')) {
+                    while (IsDigit(*s)) ++s;
+                    while (*s == '.') ++s;
+                }
+                const char* e = tokEnd;
+                while (e > s && (e[-1] == '!' || e[-1] == '?')) --e;
+                if (!onMove(s, e)) return;
+            }
+            p = tokEnd;
+        }
+    }
+}
+
+} // namespace chessDataLib
@@ -4,7 +4,7 @@
 #include "player.hpp"
 #include "tournament.hpp"
 #include "databaseStats.hpp"
-#include <unordered_map>
+#include "utils/flatHashMap.hpp"
 #include <string>
 
 namespace chessDataLib {
@@ -12,7 +12,10 @@ namespace chessDataLib {
 /**
  * @brief Updates aggregated statistics based on a parsed Game.
  * 
- * Modifies player map, tournament map, and global statistics.
+ * Modifies the player map, the tournament map and the game and result
+ * counters of the global statistics. The player and tournament views of
+ * DatabaseStats are not touched; the owner of the maps fills them once,
+ * after all updates (see DatabaseStats::SetPlayerStats()).
  */
 class PGNStatsUpdater {
 public:
@@ -21,12 +24,15 @@ public:
      * @param game Parsed Game object.
      * @param players Reference to player map.
      * @param tournaments Reference to tournament map.
-     * @param stats Reference to global database statistics.
+     * @param stats Global statistics; only counters are updated.
+     * @param whiteMovesFirst False for a FEN start with Black to move; sets
+     *        whose plies the clock and evaluation columns begin with.
      */
     static void Update(const Game& game,
-                       std::unordered_map<std::string, Player>& players,
-                       std::unordered_map<std::string, Tournament>& tournaments,
-                       DatabaseStats& stats);
+                       utils::StringMap<Player>& players,
+                       utils::StringMap<Tournament>& tournaments,
+                       DatabaseStats& stats,
+                       bool whiteMovesFirst = true);
 };
 
 } // namespace chessDataLib
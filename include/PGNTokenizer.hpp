@@ -1,5 +1,7 @@
 #pragma once
 
+#include "utils/scan.hpp"
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <istream>
@@ -9,15 +11,26 @@ namespace chessDataLib {
 /**
  * @brief Tokenizes a PGN input stream into tag blocks and move text.
  * 
- * Supports sequential parsing of PGN games from a file or stream.
+ * Supports sequential parsing of PGN games from a file or stream. Streams are
+ * read in large blocks; in-memory sources are scanned in place. Line breaks
+ * are located with SIMD newline bitmasks (utils::LineScanner).
  */
 class PGNTokenizer {
 public:
     /**
      * @brief Constructs a tokenizer from an input stream.
      * @param input Reference to an open input stream.
+     * @param baseOffset Source offset of the stream's first byte, added to reported offsets.
      */
-    explicit PGNTokenizer(std::istream& input);
+    explicit PGNTokenizer(std::istream& input, std::uint64_t baseOffset = 0);
+
+    /**
+     * @brief Constructs a tokenizer over bytes already in memory (no copy).
+     * @param data First byte; must outlive the tokenizer.
+     * @param size Number of bytes.
+     * @param baseOffset Source offset of data, added to reported offsets.
+     */
+    PGNTokenizer(const char* data, std::size_t size, std::uint64_t baseOffset = 0);
 
     /**
      * @brief Advances to the next PGN game block.
@@ -33,12 +46,50 @@ public:
 
     /**
      * @brief Returns the raw move text of the current game.
+     *
+     * Each line ends with '\n' (any '\r' is dropped), so ';' comments end
+     * where they did in the source.
      * @return String containing move section.
      */
     const std::string& GetCurrentMoveText() const;
 
+    /**
+     * @brief Returns the source offset of the current game's first line.
+     */
+    std::uint64_t GetCurrentGameOffset() const;
+
+    /**
+     * @brief Returns the source bytes from the game's first line through its last line break.
+     */
+    std::uint64_t GetCurrentGameLength() const;
+
+    /**
+     * @brief Returns the source offset of the first move text line.
+     */
+    std::uint64_t GetCurrentMoveTextOffset() const;
+
+    /**
+     * @brief Returns the source bytes from the first to the end of the last move text line.
+     *
+     * The range holds the original line breaks, '\r' included, and no final one.
+     */
+    std::uint64_t GetCurrentMoveTextLength() const;
+
 private:
-    std::istream& input;
+    bool NextLine(const char*& begin, const char*& end);
+    bool Refill();
+
+    std::istream* input = nullptr;   ///< Null when tokenizing memory
+    std::vector<char> buffer;        ///< Read buffer in stream mode
+    const char* cursor = nullptr;    ///< Next unread byte
+    const char* limit = nullptr;     ///< End of the bytes available
+    bool exhausted = false;          ///< No more bytes beyond limit
+    utils::LineScanner scanner;
+    std::uint64_t position;          ///< Source offset of the next unread byte
+    std::uint64_t gameOffset = 0;
+    std::uint64_t gameEnd = 0;
+    std::uint64_t moveTextOffset = 0;
+    std::uint64_t moveTextEnd = 0;
     std::vector<std::string> currentTagLines;
     std::string currentMoveText;
 };
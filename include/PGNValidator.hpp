@@ -0,0 +1,113 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace chessDataLib {
+
+/**
+ * @brief Kind of problem found while validating a game.
+ */
+enum class ValidationIssueKind {
+    IllegalMove,     ///< SAN token matches no legal move
+    AmbiguousMove,   ///< SAN token matches several legal moves
+    MalformedMove,   ///< Token in move position is not SAN
+    BadTagLine,      ///< Tag line is not [Name "value"]
+    BadResultTag,    ///< Result tag is not 1-0, 0-1, 1/2-1/2 or *
+    BadEloTag,       ///< WhiteElo/BlackElo is not a number
+    BadDateTag,      ///< Date is not YYYY.MM.DD (with '?' allowed)
+    BadEcoTag,       ///< ECO is not A00-E99
+    BadFen,          ///< FEN tag does not describe a position
+    MissingResult,   ///< Move text has no termination token
+    ResultMismatch   ///< Termination token differs from the Result tag
+};
+
+/**
+ * @brief Returns a stable lowercase name for an issue kind (e.g. "illegal_move").
+ */
+const char* ToString(ValidationIssueKind kind);
+
+/**
+ * @brief One problem found in one game.
+ */
+struct ValidationIssue {
+    ValidationIssueKind kind = ValidationIssueKind::IllegalMove;
+    std::uint32_t file = 0;        ///< Index into ValidationReport::files
+    std::uint64_t game = 0;        ///< Game number within the file (0-based)
+    std::uint64_t gameOffset = 0;  ///< Byte offset of the game in the file
+    std::uint64_t offset = 0;      ///< Byte offset of the offending token or tag line
+    std::uint32_t ply = 0;         ///< Mainline ply of the offending move (1-based), 0 for tags
+    std::string detail;            ///< Offending token or tag value
+};
+
+/**
+ * @brief Result of validating one or more PGN files.
+ */
+struct ValidationReport {
+    std::vector<std::string> files;        ///< Files validated, in request order
+    std::uint64_t games = 0;               ///< Games checked
+    std::uint64_t gamesWithIssues = 0;     ///< Games with at least one issue
+    std::vector<ValidationIssue> issues;   ///< Issues in file, then byte order
+
+    /**
+     * @brief Returns the number of issues of one kind.
+     */
+    std::size_t Count(ValidationIssueKind kind) const;
+
+    /**
+     * @brief Writes the report as JSON Lines: one summary object, then one object per issue.
+     * @param filename Output file path.
+     * @return True on success, false on I/O failure.
+     */
+    bool WriteJsonLines(const std::string& filename) const;
+};
+
+/**
+ * @brief Replays PGN games on a board and reports illegal or inconsistent data.
+ *
+ * Works directly on the mapped file: tags and move text are checked in place
+ * and the mainline is replayed with Board, so validating a clean game does
+ * not allocate. Variations and comments are skipped; replay of a game stops
+ * at its first bad move. Files are split into chunks at game starts and
+ * checked on a work-stealing pool.
+ */
+class PGNValidator {
+public:
+    /**
+     * @brief Sets the number of worker threads.
+     * @param count Thread count; 0 selects the hardware concurrency.
+     */
+    void SetThreadCount(unsigned count);
+
+    /**
+     * @brief Sets the target size of the byte ranges scheduled as tasks.
+     * @param bytes Target chunk size in bytes.
+     */
+    void SetChunkSize(std::uint64_t bytes);
+
+    /**
+     * @brief Validates PGN files.
+     * @param filenames Paths to PGN files.
+     * @param report Receives the findings.
+     * @return True if every file could be opened.
+     */
+    bool ValidateFiles(const std::vector<std::string>& filenames, ValidationReport& report) const;
+
+    /**
+     * @brief Validates a single game held in memory.
+     * @param begin First byte of the game (its first tag line).
+     * @param end One past the last byte of the game.
+     * @param baseOffset File offset of begin, used for issue offsets.
+     * @param issues Receives issues (file and game number left at 0).
+     * @return True if the game has no issue.
+     */
+    static bool ValidateGame(const char* begin, const char* end, std::uint64_t baseOffset,
+                             std::vector<ValidationIssue>& issues);
+
+private:
+    unsigned threadCount = 0;
+    std::uint64_t chunkSize = 8ull << 20;
+};
+
+} // namespace chessDataLib
@@ -0,0 +1,152 @@
+#pragma once
+
+#include "utils/flatHashMap.hpp"
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace chessDataLib {
+
+/**
+ * @brief Streaming writer for Apache Arrow IPC files (Feather v2) and streams.
+ *
+ * Rows are appended column by column and written out as record batches of
+ * a fixed number of rows, so memory stays bounded by one batch plus the
+ * string dictionaries. Dictionary-encoded string columns intern values as
+ * they arrive; each batch is preceded by a delta dictionary batch holding
+ * only the values first seen in it. Metadata is emitted as FlatBuffers
+ * without external dependencies; buffers are 8-byte aligned so readers can
+ * map the file without copying.
+ */
+class ArrowWriter {
+public:
+    /**
+     * @brief Column types supported by the writer.
+     */
+    enum class Type {
+        Int32,          ///< Signed 32-bit integer
+        Int64,          ///< Signed 64-bit integer
+        Float64,        ///< Double-precision float
+        Utf8,           ///< Variable-length string
+        DictionaryUtf8  ///< String dictionary-encoded with int32 indices
+    };
+
+    /**
+     * @brief Output container.
+     */
+    enum class Format {
+        File,   ///< Arrow IPC file (Feather v2): magic, stream, footer
+        Stream  ///< Arrow IPC stream: messages only, readable while written
+    };
+
+    /**
+     * @brief Column declaration.
+     */
+    struct Field {
+        std::string name;       ///< Column name
+        Type type = Type::Utf8; ///< Column type
+        bool nullable = false;  ///< Whether AppendNull() is allowed
+    };
+
+    ArrowWriter() = default;
+    ArrowWriter(const ArrowWriter&) = delete;
+    ArrowWriter& operator=(const ArrowWriter&) = delete;
+    ~ArrowWriter();
+
+    /**
+     * @brief Creates the output and writes the schema.
+     * @param path Output file path (truncated).
+     * @param fields Column declarations.
+     * @param format File or stream container.
+     * @return False if the file cannot be opened.
+     */
+    bool Open(const std::string& path, std::vector<Field> fields, Format format = Format::File);
+
+    /**
+     * @brief Sets the number of rows per record batch (default 65536).
+     */
+    void SetBatchRows(std::size_t rows);
+
+    /**
+     * @brief Appends a value to a column of the current row.
+     * @param column Column index in declaration order.
+     */
+    void AppendInt32(std::size_t column, std::int32_t value);
+    void AppendInt64(std::size_t column, std::int64_t value);
+    void AppendFloat64(std::size_t column, double value);
+    void AppendString(std::size_t column, std::string_view value);
+
+    /**
+     * @brief Appends a null to a nullable column of the current row.
+     */
+    void AppendNull(std::size_t column);
+
+    /**
+     * @brief Completes the current row; writes a batch when it is full.
+     * @return False if writing fails.
+     */
+    bool EndRow();
+
+    /**
+     * @brief Writes the last batch, the end-of-stream marker and, for files, the footer.
+     * @return False if writing fails.
+     */
+    bool Close();
+
+    /**
+     * @brief Returns the number of rows written or buffered.
+     */
+    std::uint64_t GetRowCount() const;
+
+    /**
+     * @brief Returns the number of record batches written.
+     */
+    std::size_t GetBatchCount() const;
+
+private:
+    struct Column {
+        Field field;
+        std::vector<std::uint8_t> validity;  ///< One bit per row of the current batch
+        std::int64_t nullCount = 0;
+        std::vector<std::uint8_t> values;    ///< Fixed-width values or dictionary indices
+        std::vector<std::int32_t> offsets;   ///< Utf8 offsets (rows + 1)
+        std::string data;                    ///< Utf8 bytes
+
+        // Dictionary-encoded columns
+        utils::StringMap<std::int32_t> ids;
+        std::vector<std::int32_t> dictOffsets{0};
+        std::string dictData;
+        std::size_t dictWritten = 0;  ///< Entries already written in dictionary batches
+    };
+
+    // Location of a message in the file, for the footer
+    struct Block {
+        std::int64_t offset;
+        std::int32_t metaDataLength;
+        std::int32_t padding;
+        std::int64_t bodyLength;
+    };
+
+    void SetValid(Column& column, bool valid);
+    bool FlushBatch();
+    bool WriteDictionaries();
+    bool WriteMessage(const std::vector<std::uint8_t>& metadata, const std::vector<std::string_view>& body,
+                      std::int64_t bodyLength, std::vector<Block>* blocks);
+    bool WriteBytes(const void* data, std::size_t size);
+
+    std::ofstream out;
+    std::string path;
+    Format format = Format::File;
+    std::vector<Column> columns;
+    std::size_t batchRows = 65536;
+    std::size_t rows = 0;  ///< Rows in the current batch
+    std::uint64_t totalRows = 0;
+    std::uint64_t position = 0;
+    std::vector<Block> dictionaryBlocks;
+    std::vector<Block> recordBlocks;
+    bool ok = false;
+};
+
+} // namespace chessDataLib
@@ -0,0 +1,202 @@
+#pragma once
+
+#include "PGNAnnotationExtractor.hpp"
+#include "game.hpp"
+#include "sourceMapping.hpp"
+#include "utils/scan.hpp"
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace chessDataLib {
+
+/**
+ * @brief Field masks selecting what BasicParser extracts from each game.
+ */
+namespace Extract {
+
+constexpr std::uint32_t Event = 1u << 0;
+constexpr std::uint32_t Site = 1u << 1;
+constexpr std::uint32_t Date = 1u << 2;
+constexpr std::uint32_t Round = 1u << 3;
+constexpr std::uint32_t White = 1u << 4;
+constexpr std::uint32_t Black = 1u << 5;
+constexpr std::uint32_t Result = 1u << 6;
+constexpr std::uint32_t WhiteElo = 1u << 7;
+constexpr std::uint32_t BlackElo = 1u << 8;
+constexpr std::uint32_t Eco = 1u << 9;
+constexpr std::uint32_t Opening = 1u << 10;
+constexpr std::uint32_t MoveCount = 1u << 11;    ///< Scans the move text for mainline plies
+constexpr std::uint32_t Annotations = 1u << 12;  ///< Scans the move text for [%clk] and [%eval]
+constexpr std::uint32_t MoveText = 1u << 13;     ///< Keeps a handle to the move text (see BasicParser::GetMoveText)
+
+constexpr std::uint32_t Players = White | Black;
+constexpr std::uint32_t Ratings = WhiteElo | BlackElo;
+constexpr std::uint32_t Tags = Event | Site | Date | Round | Players | Result | Ratings | Eco | Opening;
+constexpr std::uint32_t All = Tags | MoveCount | Annotations | MoveText;
+
+} // namespace Extract
+
+namespace detail {
+
+/**
+ * @brief Parses the games of [begin, end) of a mapped source with an id in a SourceTable; begin is a game start or 0.
+ */
+using ChunkParser = std::function<void(const SourceMapping& source, std::uint32_t sourceId, std::uint64_t begin,
+                                       std::uint64_t end, std::vector<Game>& games)>;
+
+/**
+ * @brief Maps the files, adds them to a table, cuts them into chunks at game starts and parses the chunks in parallel.
+ * @return False if a file cannot be opened (the others are still parsed).
+ */
+bool ParseChunked(const std::vector<std::string>& filenames, unsigned threadCount, std::uint64_t chunkSize,
+                  const ChunkParser& parse, SourceTable& sources, std::vector<Game>& games);
+
+} // namespace detail
+
+/**
+ * @brief Lightweight PGN loader that extracts only the fields in a compile-time mask.
+ *
+ * Games are read straight from the memory-mapped files. Tag lines are
+ * matched against the selected tags only and never collected into a map;
+ * tags outside the mask are skipped without a copy. Unless MoveCount,
+ * Annotations or MoveText is selected, the move text is not tokenized at
+ * all: the scan jumps to the next game start with a vectorized search.
+ * Unselected Game fields keep their defaults. No player, tournament or
+ * database statistics are aggregated; use Parser for those.
+ *
+ * @tparam Fields Combination of Extract masks, e.g. Extract::Players | Extract::Result.
+ */
+template <std::uint32_t Fields>
+class BasicParser {
+public:
+    static constexpr std::uint32_t kFields = Fields;
+    static constexpr bool kScansMoveText = (Fields & (Extract::MoveCount | Extract::Annotations)) != 0;
+
+    /**
+     * @brief Sets the number of worker threads.
+     * @param count Thread count; 0 selects the hardware concurrency.
+     */
+    void SetThreadCount(unsigned count) { threadCount = count; }
+
+    /**
+     * @brief Sets the target size of the byte ranges scheduled as tasks.
+     */
+    void SetChunkSize(std::uint64_t bytes) { chunkSize = bytes ? bytes : (32ull << 20); }
+
+    /**
+     * @brief Loads the games of a PGN file, appending to GetGames().
+     * @return False if the file cannot be opened.
+     */
+    bool LoadFile(const std::string& filename) { return LoadFiles({filename}); }
+
+    /**
+     * @brief Loads the games of several PGN files in parallel, in file order.
+     * @return False if a file cannot be opened (the others are still loaded).
+     */
+    bool LoadFiles(const std::vector<std::string>& filenames) {
+        return detail::ParseChunked(filenames, threadCount, chunkSize, &BasicParser::ParseRange, sources, games);
+    }
+
+    /**
+     * @brief Returns the loaded games; only the selected fields are set.
+     */
+    const std::vector<Game>& GetGames() const { return games; }
+
+    /**
+     * @brief Returns the raw move text of a loaded game (requires Extract::MoveText).
+     * @return Copy of the move text bytes, empty if the game has no handle.
+     */
+    std::string GetMoveText(const Game& game) const { return sources.GetMoveText(game.GetMoveTextRef()); }
+
+    /**
+     * @brief Returns the mainline SAN moves of a loaded game (requires Extract::MoveText).
+     * @return Shared, immutable move list (empty if the game has no handle).
+     */
+    std::shared_ptr<const std::vector<std::string>> GetMoveList(const Game& game) const {
+        return sources.GetMoveList(game.GetMoveTextRef());
+    }
+
+    /**
+     * @brief Parses the games of a byte range of a mapped source.
+     * @param source Mapped PGN file.
+     * @param sourceId Id of the file in the SourceTable move text handles point into.
+     * @param begin Offset of a game start, or 0.
+     * @param end End offset (a game start or the end of the file).
+     * @param out Receives the games.
+     */
+    static void ParseRange(const SourceMapping& source, std::uint32_t sourceId, std::uint64_t begin,
+                           std::uint64_t end, std::vector<Game>& out) {
+        const char* base = source.Data();
+        const char* p = base + begin;
+        const char* limit = base + end;
+        if (begin == 0) p = utils::FindFirstGame(p, limit);
+
+        while (p < limit) {
+            Game game;
+            while (p < limit && *p == '[') {
+                const char* nl = static_cast<const char*>(std::memchr(p, '\n', static_cast<std::size_t>(limit - p)));
+                const char* lineEnd = nl ? nl : limit;
+                if constexpr ((Fields & Extract::Tags) != 0) AssignTag(game, p, lineEnd);
+                p = nl ? nl + 1 : limit;
+            }
+
+            while (p < limit && (*p == '\n' || *p == '\r')) ++p;
+            const char* next = utils::FindGameStart(base, p, limit);
+            if constexpr (kScansMoveText) {
+                GameAnnotations ann = PGNAnnotationExtractor::Extract(p, next);
+                if constexpr ((Fields & Extract::MoveCount) != 0) game.SetMoveCount((ann.plies + 1) / 2);
+                if constexpr ((Fields & Extract::Annotations) != 0) {
+                    if (!ann.clocks.empty()) game.SetClocks(std::move(ann.clocks));
+                    if (!ann.evals.empty()) game.SetEvals(std::move(ann.evals));
+                }
+            }
+            if constexpr ((Fields & Extract::MoveText) != 0) {
+                const char* textEnd = next;
+                while (textEnd > p && (textEnd[-1] == '\n' || textEnd[-1] == '\r' || textEnd[-1] == ' ')) --textEnd;
+                game.SetMoveTextRef({static_cast<std::uint64_t>(p - base), static_cast<std::uint32_t>(textEnd - p),
+                                     sourceId});
+            }
+            out.push_back(std::move(game));
+            p = next;
+        }
+    }
+
+private:
+    // Stores the value of a "[Key "Value"]" line if its key is selected
+    static void AssignTag(Game& game, const char* line, const char* end) {
+        if (end > line && end[-1] == '\r') --end;
+        const char* open = static_cast<const char*>(std::memchr(line, '"', static_cast<std::size_t>(end - line)));
+        if (!open) return;
+        const char* close = end;
+        while (close > open + 1 && close[-1] != '"') --close;
+        if (close <= open + 1) return;
+        const char* keyEnd = open;
+        while (keyEnd > line + 1 && keyEnd[-1] == ' ') --keyEnd;
+        const std::string_view key(line + 1, static_cast<std::size_t>(keyEnd - line - 1));
+        const auto value = [open, close] { return std::string(open + 1, close - 1); };
+
+        if constexpr ((Fields & Extract::White) != 0) if (key == "White") return game.SetWhite(value());
+        if constexpr ((Fields & Extract::Black) != 0) if (key == "Black") return game.SetBlack(value());
+        if constexpr ((Fields & Extract::Result) != 0) if (key == "Result") return game.SetResult(value());
+        if constexpr ((Fields & Extract::Event) != 0) if (key == "Event") return game.SetEvent(value());
+        if constexpr ((Fields & Extract::Site) != 0) if (key == "Site") return game.SetSite(value());
+        if constexpr ((Fields & Extract::Date) != 0) if (key == "Date") return game.SetDate(value());
+        if constexpr ((Fields & Extract::Round) != 0) if (key == "Round") return game.SetRound(value());
+        if constexpr ((Fields & Extract::WhiteElo) != 0) if (key == "WhiteElo") return game.SetWhiteElo(value());
+        if constexpr ((Fields & Extract::BlackElo) != 0) if (key == "BlackElo") return game.SetBlackElo(value());
+        if constexpr ((Fields & Extract::Eco) != 0) if (key == "ECO") return game.SetEco(value());
+        if constexpr ((Fields & Extract::Opening) != 0) if (key == "Opening") return game.SetOpening(value());
+    }
+
+    unsigned threadCount = 0;
+    std::uint64_t chunkSize = 32ull << 20;
+    SourceTable sources;
+    std::vector<Game> games;
+};
+
+} // namespace chessDataLib
@@ -0,0 +1,177 @@
+#pragma once
+
+#include <cstdint>
+
+namespace chessDataLib {
+
+/**
+ * @brief Piece types; a piece code is type | (color << 3), 0 for an empty square.
+ */
+enum PieceType : std::uint8_t {
+    NoPieceType = 0,
+    Pawn = 1,
+    Knight = 2,
+    Bishop = 3,
+    Rook = 4,
+    Queen = 5,
+    King = 6
+};
+
+/**
+ * @brief Side to move / piece color.
+ */
+enum Color : std::uint8_t {
+    White = 0,
+    Black = 1
+};
+
+/**
+ * @brief A move on the 0..63 square grid (a1 = 0, h8 = 63).
+ */
+struct Move {
+    static constexpr std::uint8_t kCapture = 1;     ///< Captures a piece (including en passant)
+    static constexpr std::uint8_t kEnPassant = 2;   ///< En passant capture
+    static constexpr std::uint8_t kCastle = 4;      ///< King move of a castling
+    static constexpr std::uint8_t kDoublePush = 8;  ///< Pawn advances two squares
+    static constexpr std::uint8_t kNull = 16;       ///< "--" null move (pass)
+
+    std::uint8_t from = 0;       ///< Origin square
+    std::uint8_t to = 0;         ///< Destination square
+    std::uint8_t promotion = 0;  ///< PieceType promoted to, NoPieceType otherwise
+    std::uint8_t flags = 0;      ///< Combination of the k* flags
+};
+
+/**
+ * @brief 16-bit move encoding used for stored move lists.
+ *
+ * Bits 0-5 hold the origin square, bits 6-11 the destination, bits 12-13 the
+ * promotion piece (0 = knight .. 3 = queen) and bits 14-15 the kind: normal,
+ * promotion, en passant or castling. The null move is encoded as 0 (a1-a1).
+ */
+using PackedMove = std::uint16_t;
+
+/**
+ * @brief Outcome of resolving a SAN token against a position.
+ */
+enum class SanStatus {
+    Ok,         ///< Exactly one legal move matches
+    Illegal,    ///< No legal move matches
+    Ambiguous,  ///< Several legal moves match (insufficient disambiguation)
+    Malformed   ///< Token is not SAN
+};
+
+/**
+ * @brief Chess position with legal move generation and SAN resolution.
+ *
+ * Plain value type (~80 bytes) with no heap allocation; move lists are
+ * written into caller-provided arrays of kMaxMoves entries.
+ */
+class Board {
+public:
+    static constexpr int kMaxMoves = 256;  ///< Upper bound on moves in any position
+
+    /**
+     * @brief Constructs the standard starting position.
+     */
+    Board();
+
+    /**
+     * @brief Resets to the standard starting position.
+     */
+    void SetStartPosition();
+
+    /**
+     * @brief Sets the position from a FEN string.
+     * @param begin Start of the FEN text.
+     * @param end End of the FEN text.
+     * @return False if the FEN is malformed; the board is then unspecified.
+     */
+    bool SetFen(const char* begin, const char* end);
+
+    /**
+     * @brief Returns the piece code on a square (0 if empty).
+     */
+    std::uint8_t PieceAt(int square) const;
+
+    /**
+     * @brief Returns the side to move.
+     */
+    Color SideToMove() const;
+
+    /**
+     * @brief Returns the en passant target square, or -1.
+     */
+    int EnPassantSquare() const;
+
+    /**
+     * @brief Returns the castling rights as a 4-bit mask (K, Q, k, q).
+     */
+    std::uint8_t CastlingRights() const;
+
+    /**
+     * @brief Checks whether a square is attacked by a side.
+     */
+    bool IsAttacked(int square, Color by) const;
+
+    /**
+     * @brief Checks whether the side to move is in check.
+     */
+    bool InCheck() const;
+
+    /**
+     * @brief Writes all pseudo-legal moves (castling already fully checked).
+     * @param out Array of at least kMaxMoves entries.
+     * @return Number of moves written.
+     */
+    int GeneratePseudoLegal(Move* out) const;
+
+    /**
+     * @brief Writes all legal moves.
+     * @param out Array of at least kMaxMoves entries.
+     * @return Number of moves written.
+     */
+    int GenerateLegal(Move* out) const;
+
+    /**
+     * @brief Checks that a pseudo-legal move does not leave the mover's king in check.
+     */
+    bool IsLegal(const Move& move) const;
+
+    /**
+     * @brief Plays a move assumed to be legal.
+     */
+    void MakeMove(const Move& move);
+
+    /**
+     * @brief Encodes a move in 16 bits (see PackedMove).
+     */
+    static PackedMove Pack(const Move& move);
+
+    /**
+     * @brief Decodes a packed move in this position, restoring capture and double-push flags.
+     */
+    Move Unpack(PackedMove packed) const;
+
+    /**
+     * @brief Resolves a SAN token (e.g. "Nbd7", "exd8=Q+", "O-O") to a legal move.
+     * @param begin Start of the token.
+     * @param end End of the token.
+     * @param move Receives the move when the status is Ok.
+     * @return Resolution status.
+     */
+    SanStatus ParseSan(const char* begin, const char* end, Move& move) const;
+
+private:
+    void AddPawnMoves(int from, Move* out, int& n) const;
+    void AddCastling(Move* out, int& n) const;
+
+    std::uint8_t squares[64];
+    std::uint8_t kingSquare[2];
+    Color side = White;
+    std::uint8_t castling = 0;
+    std::int8_t epSquare = -1;
+    std::uint16_t halfmoveClock = 0;
+    std::uint16_t fullmoveNumber = 1;
+};
+
+} // namespace chessDataLib
@@ -1,11 +1,12 @@
 #pragma once
 
 #include "tournament.hpp"
+#include "gameHistograms.hpp"
 #include "game.hpp"
 #include "player.hpp"
+#include "utils/flatHashMap.hpp"
 #include <string>
 #include <vector>
-#include <unordered_map>
 
 namespace chessDataLib {
 
@@ -35,8 +36,10 @@ private:
     std::vector<std::string> tournamentNames;
     std::vector<std::string> playerNames;
 
-    std::unordered_map<std::string, Player> playerStats;
-    std::unordered_map<std::string, Tournament> tournaments;
+    utils::StringMap<Player> playerStats;
+    utils::StringMap<Tournament> tournaments;
+
+    GameHistograms histograms;
 
 public:
     // === Getters ===
@@ -114,12 +117,17 @@ public:
     /**
      * @brief Returns the map of player statistics.
      */
-    const std::unordered_map<std::string, Player>& GetPlayerStats() const;
+    const utils::StringMap<Player>& GetPlayerStats() const;
 
     /**
      * @brief Returns the map of tournaments.
      */
-    const std::unordered_map<std::string, Tournament>& GetTournaments() const;
+    const utils::StringMap<Tournament>& GetTournaments() const;
+
+    /**
+     * @brief Returns the game-length and rating-gap distributions.
+     */
+    const GameHistograms& GetHistograms() const;
 
     // === Setters ===
 
@@ -196,12 +204,17 @@ public:
     /**
      * @brief Sets the map of player statistics.
      */
-    void SetPlayerStats(const std::unordered_map<std::string, Player>& val);
+    void SetPlayerStats(const utils::StringMap<Player>& val);
 
     /**
      * @brief Sets the map of tournaments.
      */
-    void SetTournaments(const std::unordered_map<std::string, Tournament>& val);
+    void SetTournaments(const utils::StringMap<Tournament>& val);
+
+    /**
+     * @brief Sets the game-length and rating-gap distributions.
+     */
+    void SetHistograms(const GameHistograms& val);
 
     // === Helpers ===
 
@@ -224,6 +237,33 @@ public:
      * @param result Result string ("1-0", "0-1", "1/2-1/2", "*").
      */
     void IncrementResultCount(const std::string& result);
+
+    /**
+     * @brief Adds a game to the histograms.
+     * @param plies Mainline plies.
+     * @param result Result string ("1-0", "0-1", "1/2-1/2", "*").
+     * @param whiteElo White rating, 0 if unknown.
+     * @param blackElo Black rating, 0 if unknown.
+     */
+    void AddToHistograms(int plies, const std::string& result, int whiteElo, int blackElo);
+
+    /**
+     * @brief Adds game and result counters and histograms from another stats object.
+     *
+     * Player/tournament maps, name lists and maxima are not merged; they are
+     * rebuilt by the owner from its merged maps.
+     * @param other Stats collected over a disjoint set of games.
+     */
+    void MergeCounters(const DatabaseStats& other);
+
+    // === Memory accounting ===
+
+    /**
+     * @brief Returns the heap memory owned by the name lists and the player/tournament copies.
+     *
+     * The stats object's own footprint is accounted by whoever holds it.
+     */
+    MemoryUsage GetMemoryUsage() const;
 };
 
 } // namespace chessDataLib
@@ -1,6 +1,12 @@
 #pragma once
 
+#include "memoryReport.hpp"
+#include "movePool.hpp"
+#include "sourceMapping.hpp"
+#include <cstdint>
+#include <memory>
 #include <string>
+#include <vector>
 
 namespace chessDataLib {
 
@@ -8,13 +14,16 @@ namespace chessDataLib {
  * @brief Represents a single chess game with metadata and result.
  * 
  * Stores PGN tag information such as players, date, event, result, and opening.
- * Does not store full move list or Player objects for memory efficiency.
+ * Does not store full move list or Player objects for memory efficiency; the
+ * move text is reachable through a handle into the mapped source file and is
+ * decoded on demand.
  */
 class Game {
 private:
     std::string event;        ///< Event name
     std::string site;         ///< Location of the game
     std::string date;         ///< Date of the game
+    std::uint32_t packedDate = 0;  ///< Date packed with utils::PackDate(); 0 if unknown
     std::string round;        ///< Round number or label
 
     std::string white;        ///< White player's name
@@ -28,6 +37,13 @@ private:
     std::string opening;      ///< Opening name
 
     int moveCount = 0;        ///< Number of moves played
+    int plyCount = 0;         ///< Number of mainline plies (half-moves)
+
+    std::vector<int32_t> clocks;  ///< Per-ply [%clk] in centiseconds (empty if absent)
+    std::vector<int32_t> evals;   ///< Per-ply [%eval] in centipawns (empty if absent)
+
+    MoveTextRef moveTextRef;      ///< Handle to the move text in its owner's SourceTable
+    MovesRef movesRef;            ///< Handle to the packed mainline in its owner's MovePool
 
 public:
     // === Getters ===
@@ -50,6 +66,14 @@ public:
      */
     const std::string& GetDate() const;
 
+    /**
+     * @brief Returns the date packed with utils::PackDate().
+     *
+     * Unknown months and days are 0; the whole value is 0 without a year.
+     * @return Packed date, kept in sync by SetDate().
+     */
+    std::uint32_t GetPackedDate() const;
+
     /**
      * @brief Returns the round identifier.
      * @return Reference to the round string.
@@ -104,6 +128,51 @@ public:
      */
     int GetMoveCount() const;
 
+    /**
+     * @brief Returns the number of mainline plies (half-moves) of the game.
+     */
+    int GetPlyCount() const;
+
+    /**
+     * @brief Returns the per-ply clock column in centiseconds.
+     * @return Reference to the clock vector; empty if the PGN had no [%clk] comments.
+     */
+    const std::vector<int32_t>& GetClocks() const;
+
+    /**
+     * @brief Returns the per-ply evaluation column in centipawns (White's view).
+     * @return Reference to the eval vector; empty if the PGN had no [%eval] comments.
+     */
+    const std::vector<int32_t>& GetEvals() const;
+
+    /**
+     * @brief Checks whether the game carries a handle to its move text.
+     *
+     * The text is read back through the SourceTable of the parser that
+     * produced the game (e.g. Parser::GetMoveText).
+     * @return True if a handle is set.
+     */
+    bool HasMoveText() const;
+
+    /**
+     * @brief Returns the handle to the move text in its owner's SourceTable.
+     * @return Reference to the handle.
+     */
+    const MoveTextRef& GetMoveTextRef() const;
+
+    /**
+     * @brief Checks whether the game's mainline was stored as packed moves.
+     *
+     * The moves are read back through the MovePool of the parser that
+     * loaded the game (Parser::GetMoves).
+     */
+    bool HasMoves() const;
+
+    /**
+     * @brief Returns the handle to the packed moves in its owner's MovePool.
+     */
+    const MovesRef& GetMovesRef() const;
+
     // === Setters ===
 
     /**
@@ -119,7 +188,7 @@ public:
     void SetSite(const std::string& val);
 
     /**
-     * @brief Sets the date of the game.
+     * @brief Sets the date of the game and its packed form.
      * @param val New date string.
      */
     void SetDate(const std::string& val);
@@ -178,6 +247,36 @@ public:
      */
     void SetMoveCount(int val);
 
+    /**
+     * @brief Sets the number of mainline plies.
+     * @param val New ply count.
+     */
+    void SetPlyCount(int val);
+
+    /**
+     * @brief Sets the per-ply clock column.
+     * @param val New clock vector in centiseconds.
+     */
+    void SetClocks(std::vector<int32_t> val);
+
+    /**
+     * @brief Sets the per-ply evaluation column.
+     * @param val New eval vector in centipawns.
+     */
+    void SetEvals(std::vector<int32_t> val);
+
+    /**
+     * @brief Sets the handle to the move text in its owner's SourceTable.
+     * @param val New move text handle.
+     */
+    void SetMoveTextRef(MoveTextRef val);
+
+    /**
+     * @brief Sets the handle to the packed moves.
+     * @param val New moves handle.
+     */
+    void SetMovesRef(MovesRef val);
+
     // === Result helpers ===
 
     /**
@@ -203,6 +302,15 @@ public:
      * @return True if result is "*".
      */
     bool IsUnknownResult() const;
+
+    // === Memory accounting ===
+
+    /**
+     * @brief Returns the heap memory owned by this game's strings.
+     *
+     * The game's own footprint is accounted by the container holding it.
+     */
+    MemoryUsage GetMemoryUsage() const;
 };
 
 } // namespace chessDataLib
@@ -0,0 +1,152 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string>
+
+namespace chessDataLib {
+
+/**
+ * @brief Finished games of one rating-gap bin of GameHistograms.
+ *
+ * The gap and the scores are White's: White's rating minus Black's, and
+ * White's expected and actual score.
+ */
+struct RatingGapBin {
+    std::uint64_t games = 0;           ///< Finished games with both ratings known
+    std::uint64_t whiteWins = 0;       ///< Games won by White
+    std::uint64_t draws = 0;           ///< Drawn games
+    std::uint64_t blackWins = 0;       ///< Games won by Black
+    std::uint64_t expectedMicros = 0;  ///< Sum of White's Elo-expected scores, in millionths
+
+    /**
+     * @brief Returns the percentage of decisive games, 0 if the bin is empty.
+     */
+    double GetDecisiveRate() const;
+
+    /**
+     * @brief Returns White's average Elo-expected score (0–1), 0 if the bin is empty.
+     */
+    double GetExpectedScore() const;
+
+    /**
+     * @brief Returns White's average actual score (0–1), 0 if the bin is empty.
+     */
+    double GetActualScore() const;
+};
+
+/**
+ * @brief Fixed-bin distributions of game length and results.
+ *
+ * Game length is counted in plies per outcome, in bins of kPlyBinWidth
+ * plies; the last bin also holds longer games. Finished games with both
+ * ratings known are binned by White's rating minus Black's in bins of
+ * kGapBinWidth points over [-kGapRange, kGapRange); the end bins also hold
+ * larger gaps. Expected scores use the Elo formula on the exact gap.
+ *
+ * All counters live in fixed arrays, so per-thread copies are cheap and
+ * MergeWith() is a plain element-wise sum.
+ */
+class GameHistograms {
+public:
+    /**
+     * @brief Game outcome; also the index of the per-outcome length histograms.
+     */
+    enum class Outcome { WhiteWin, Draw, BlackWin, Unfinished };
+
+    static constexpr int kOutcomes = 4;
+    static constexpr int kPlyBinWidth = 10;
+    static constexpr int kPlyBins = 40;      ///< Last bin: 390 plies and more
+    static constexpr int kGapBinWidth = 50;
+    static constexpr int kGapRange = 800;
+    static constexpr int kGapBins = 2 * kGapRange / kGapBinWidth;
+
+    using LengthHistogram = std::array<std::uint64_t, kPlyBins>;
+    using RatingGapHistogram = std::array<RatingGapBin, kGapBins>;
+
+    /**
+     * @brief Returns the outcome of a result string ("1-0", "0-1", "1/2-1/2"; anything else is unfinished).
+     */
+    static Outcome OutcomeOf(const std::string& result);
+
+    /**
+     * @brief Returns the length bin of a ply count.
+     */
+    static int PlyBinOf(int plies);
+
+    /**
+     * @brief Returns the rating-gap bin of White's rating minus Black's.
+     */
+    static int GapBinOf(int gap);
+
+    /**
+     * @brief Returns the smallest gap of a rating-gap bin; the first bin also holds smaller gaps.
+     */
+    static int GapBinStart(int bin);
+
+    /**
+     * @brief Adds one game.
+     * @param plies Mainline plies.
+     * @param result Result string ("1-0", "0-1", "1/2-1/2", "*").
+     * @param whiteElo White rating, 0 if unknown.
+     * @param blackElo Black rating, 0 if unknown.
+     */
+    void AddGame(int plies, const std::string& result, int whiteElo, int blackElo);
+
+    /**
+     * @brief Adds the counters of histograms collected over a disjoint set of games.
+     */
+    void MergeWith(const GameHistograms& other);
+
+    /**
+     * @brief Returns the number of games added.
+     */
+    std::uint64_t GetGames() const;
+
+    /**
+     * @brief Returns the length histogram of all games.
+     */
+    LengthHistogram GetLengthHistogram() const;
+
+    /**
+     * @brief Returns the length histogram of the games with one outcome.
+     */
+    const LengthHistogram& GetLengthHistogram(Outcome outcome) const;
+
+    /**
+     * @brief Returns the total plies of the games with one outcome.
+     */
+    std::uint64_t GetPlySum(Outcome outcome) const;
+
+    /**
+     * @brief Returns the average length in plies of all games, 0 if none.
+     */
+    double GetAverageLength() const;
+
+    /**
+     * @brief Returns the average length in plies of the games with one outcome, 0 if none.
+     */
+    double GetAverageLength(Outcome outcome) const;
+
+    /**
+     * @brief Returns the rating-gap bins.
+     */
+    const RatingGapHistogram& GetRatingGaps() const;
+
+    /**
+     * @brief Sets the length histogram and ply total of one outcome.
+     */
+    void SetLengthHistogram(Outcome outcome, const LengthHistogram& counts, std::uint64_t plySum);
+
+    /**
+     * @brief Sets the rating-gap bins.
+     */
+    void SetRatingGaps(const RatingGapHistogram& val);
+
+private:
+    std::array<LengthHistogram, kOutcomes> lengths{};
+    std::array<std::uint64_t, kOutcomes> plySums{};
+    RatingGapHistogram gaps{};
+};
+
+} // namespace chessDataLib
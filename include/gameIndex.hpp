@@ -0,0 +1,81 @@
+#pragma once
+
+#include "statsSnapshot.hpp"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace chessDataLib {
+
+/**
+ * @brief Byte range of one game in a PGN file.
+ */
+struct GameLocation {
+    std::uint64_t offset = 0;  ///< Offset of the game's first tag line
+    std::uint64_t length = 0;  ///< Bytes up to the next game (or end of file)
+};
+
+/**
+ * @brief Byte-offset index of the games in a PGN file.
+ *
+ * Built by a single vectorized scan for empty-line + '[' boundaries, without
+ * tokenizing. Persisted in a sidecar file ("<pgn>.idx") together with the
+ * source's FileIdentity so a stale index is detected and rebuilt.
+ */
+class GameIndex {
+public:
+    /**
+     * @brief Scans a PGN file and records the start offset of every game.
+     * @param filename Path to PGN file.
+     * @return False if the file cannot be read.
+     */
+    bool Build(const std::string& filename);
+
+    /**
+     * @brief Writes the index to a sidecar file.
+     * @param filename Output path.
+     * @return False on I/O failure.
+     */
+    bool Save(const std::string& filename) const;
+
+    /**
+     * @brief Reads an index from a sidecar file.
+     * @param filename Sidecar path.
+     * @return False if missing or invalid.
+     */
+    bool Load(const std::string& filename);
+
+    /**
+     * @brief Loads the sidecar of a PGN file if it matches, otherwise builds and saves it.
+     * @param filename Path to PGN file.
+     * @return False if the PGN file cannot be read.
+     */
+    bool LoadOrBuild(const std::string& filename);
+
+    /**
+     * @brief Returns the sidecar path used for a PGN file.
+     */
+    static std::string SidecarPath(const std::string& filename);
+
+    /**
+     * @brief Returns the number of indexed games.
+     */
+    std::size_t Size() const;
+
+    /**
+     * @brief Returns the byte range of a game.
+     * @param index Game number; must be below Size().
+     */
+    GameLocation At(std::size_t index) const;
+
+    /**
+     * @brief Returns the identity of the indexed file.
+     */
+    const FileIdentity& GetSource() const;
+
+private:
+    FileIdentity source;
+    std::vector<std::uint64_t> offsets;  ///< Game start offsets; lengths follow from the next entry
+};
+
+} // namespace chessDataLib
@@ -0,0 +1,99 @@
+#pragma once
+
+#include "game.hpp"
+#include "gameIndex.hpp"
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace chessDataLib {
+
+/**
+ * @brief Draws random samples of games from PGN files.
+ *
+ * Candidates are tracked as (file, offset) locations in reservoirs
+ * (Algorithm L, see utils::Reservoir) and only the games that end up in a
+ * sample are built into Game objects, so drawing N games costs one scan of
+ * the inputs plus N game parses. Samples are returned in input order.
+ */
+class GameSampler {
+public:
+    /**
+     * @brief Maps a game's tags to the stratum it is sampled in.
+     */
+    using StratumFunction = std::function<std::string(const std::unordered_map<std::string, std::string>&)>;
+
+    /**
+     * @brief Strata of the average Elo of both players, e.g. "2200-2399"; "unrated" if either is missing.
+     * @param width Band width in rating points.
+     */
+    static StratumFunction ByEloBand(int width = 200);
+
+    /**
+     * @brief Strata of the year of the Date tag, e.g. "1999"; "unknown" if absent.
+     */
+    static StratumFunction ByYear();
+
+    /**
+     * @brief Strata of the TimeControl tag: "bullet", "blitz", "rapid", "classical" or "unknown".
+     *
+     * Uses the estimated duration base + 40 * increment seconds (under 3, 8
+     * and 25 minutes for bullet, blitz and rapid).
+     */
+    static StratumFunction ByTimeControl();
+
+    /**
+     * @brief Sets the seed; equal seeds over equal inputs give equal samples.
+     */
+    void SetSeed(std::uint64_t seed);
+
+    /**
+     * @brief Draws a uniform sample of games without replacement.
+     *
+     * Only game boundaries are scanned; no game outside the sample is
+     * tokenized.
+     * @param filenames PGN files, sampled as one stream.
+     * @param count Sample size (all games if the inputs hold fewer).
+     * @param games Receives the sampled games in input order.
+     * @param sources Table the games' move text handles point into; no handles if null.
+     * @return False if an input cannot be opened (the others are still sampled).
+     */
+    bool SampleUniform(const std::vector<std::string>& filenames, std::size_t count, std::vector<Game>& games,
+                       SourceTable* sources = nullptr) const;
+
+    /**
+     * @brief Draws a uniform sample of games within each stratum.
+     *
+     * Every game's tags are parsed to find its stratum; move text is not
+     * processed except for sampled games.
+     * @param filenames PGN files, sampled as one stream.
+     * @param countPerStratum Sample size per stratum.
+     * @param stratum Stratum of a game's tags.
+     * @param samples Receives the sampled games of each stratum in input order.
+     * @param sources Table the games' move text handles point into; no handles if null.
+     * @return False if an input cannot be opened (the others are still sampled).
+     */
+    bool SampleStratified(const std::vector<std::string>& filenames, std::size_t countPerStratum,
+                          const StratumFunction& stratum, std::map<std::string, std::vector<Game>>& samples,
+                          SourceTable* sources = nullptr) const;
+
+    /**
+     * @brief Picks distinct game numbers uniformly from an offset index.
+     *
+     * With the index at hand the sample size is known up front, so the
+     * numbers are drawn directly (Floyd's algorithm) and only the chosen
+     * games need to be read.
+     * @param index Offset index of a PGN file.
+     * @param count Sample size (all games if the index holds fewer).
+     * @return Sorted game numbers.
+     */
+    std::vector<std::size_t> SampleIndices(const GameIndex& index, std::size_t count) const;
+
+private:
+    std::uint64_t seed = 5489;
+};
+
+} // namespace chessDataLib
@@ -0,0 +1,119 @@
+#pragma once
+
+#include "utils/flatHashMap.hpp"
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace chessDataLib {
+
+/**
+ * @brief Results between two players, from the first player's point of view.
+ */
+struct PairRecord {
+    std::uint32_t games = 0;   ///< Games played against each other (any result)
+    std::uint32_t wins = 0;    ///< Games won by the first player
+    std::uint32_t losses = 0;  ///< Games won by the second player
+    std::uint32_t draws = 0;   ///< Drawn games
+
+    /**
+     * @brief Returns the first player's score (win = 1, draw = 0.5).
+     */
+    double GetScore() const;
+};
+
+/**
+ * @brief Sparse head-to-head table built during ingestion.
+ *
+ * Player names are interned to dense IDs; each pair of IDs that met is stored
+ * once in a hash table keyed by the ordered ID pair. Dense sub-matrices for a
+ * chosen player set are filled in parallel, one block of rows per task.
+ */
+class HeadToHead {
+public:
+    /**
+     * @brief Dense crosstable of a chosen player set (row-major, n x n).
+     */
+    struct Matrix {
+        std::vector<std::string> players;  ///< Row/column order
+        std::vector<float> scores;         ///< scores[i * n + j]: points of players[i] against players[j]
+        std::vector<std::uint32_t> games;  ///< games[i * n + j]: games between players[i] and players[j]
+
+        /**
+         * @brief Returns the matrix dimension.
+         */
+        std::size_t Size() const;
+    };
+
+    /**
+     * @brief Records a game between two players.
+     * @param white White player's name.
+     * @param black Black player's name.
+     * @param result Result string ("1-0", "0-1", "1/2-1/2", "*").
+     */
+    void AddGame(const std::string& white, const std::string& black, const std::string& result);
+
+    /**
+     * @brief Adds all pairs of another table (built over disjoint games) into this one.
+     * @param other Table to merge.
+     */
+    void MergeWith(const HeadToHead& other);
+
+    /**
+     * @brief Folds the pairs of aliases into those of their canonical names.
+     *
+     * Games between an alias and its own canonical name are dropped, as
+     * AddGame() drops games of a player against itself.
+     * @param aliases Alias to canonical name; names not in the map are kept.
+     */
+    void MergeAliases(const utils::StringMap<std::string>& aliases);
+
+    /**
+     * @brief Returns the record of a against b.
+     * @param a First player's name.
+     * @param b Second player's name.
+     * @param record Receives the record from a's point of view.
+     * @return False if the players never met.
+     */
+    bool GetRecord(const std::string& a, const std::string& b, PairRecord& record) const;
+
+    /**
+     * @brief Returns the number of interned players.
+     */
+    std::size_t GetPlayerCount() const;
+
+    /**
+     * @brief Returns the number of distinct pairs that met.
+     */
+    std::size_t GetPairCount() const;
+
+    /**
+     * @brief Builds the dense crosstable for a player set.
+     * @param players Players in row/column order; unknown names get empty rows.
+     * @param threads Worker threads; 0 selects the hardware concurrency.
+     * @return Dense matrix.
+     */
+    Matrix BuildMatrix(const std::vector<std::string>& players, unsigned threads = 0) const;
+
+    /**
+     * @brief Writes the crosstable of a player set as CSV ("score/games" cells).
+     * @param filename Output file path.
+     * @param players Players in row/column order.
+     * @param threads Worker threads used to fill and format rows.
+     * @return True on success, false on I/O failure.
+     */
+    bool ExportCrosstableCSV(const std::string& filename, const std::vector<std::string>& players,
+                             unsigned threads = 0) const;
+
+private:
+    std::uint32_t Intern(const std::string& name);
+    static std::uint64_t Key(std::uint32_t a, std::uint32_t b);
+    void AddPairs(const HeadToHead& other, const std::vector<std::uint32_t>& remap);
+
+    std::unordered_map<std::string, std::uint32_t> ids;
+    std::vector<std::string> names;
+    std::unordered_map<std::uint64_t, PairRecord> pairs;  ///< Keyed by (lower ID, higher ID), oriented to the lower ID
+};
+
+} // namespace chessDataLib
@@ -0,0 +1,171 @@
+#pragma once
+
+#include "board.hpp"
+#include "memoryReport.hpp"
+#include "movePool.hpp"
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace chessDataLib {
+
+/**
+ * @brief 64-bit material signature of a position.
+ *
+ * One 4-bit count per color and piece kind, kings implied. Bishops are split
+ * by square color so that bishop endings can be told apart: per color, bits
+ * hold pawns, knights, light-squared bishops, dark-squared bishops, rooks and
+ * queens, in that order (White in bits 0-23, Black in bits 24-47).
+ */
+using MaterialKey = std::uint64_t;
+
+/**
+ * @brief Plies of one game during which a material signature held.
+ */
+struct MaterialPosting {
+    std::uint32_t game = 0;       ///< Game ID (index into the loaded games)
+    std::uint16_t firstPly = 0;   ///< First ply with the signature (0 = start position)
+    std::uint16_t lastPly = 0;    ///< Last ply with the signature
+};
+
+/**
+ * @brief Inverted index from material signature to the games and plies that reach it.
+ *
+ * Material only ever decreases (captures, promotions), so a game holds each
+ * signature for one contiguous ply range. Postings are collected while games
+ * are replayed and then laid out per signature, sorted by game, in one flat
+ * array; a lookup is a binary search over the distinct signatures.
+ */
+class MaterialIndex {
+public:
+    /**
+     * @brief Postings of one signature (view into the index).
+     */
+    struct PostingList {
+        const MaterialPosting* data = nullptr;
+        std::size_t size = 0;
+
+        const MaterialPosting* begin() const { return data; }
+        const MaterialPosting* end() const { return data + size; }
+        bool empty() const { return size == 0; }
+    };
+
+    /**
+     * @brief Computes the signature of a position.
+     */
+    static MaterialKey KeyOf(const Board& board);
+
+    /**
+     * @brief Returns the count of a piece type for a color (bishops of both square colors summed).
+     */
+    static int Count(MaterialKey key, Color color, PieceType type);
+
+    /**
+     * @brief Returns the number of bishops of a color on light or dark squares.
+     */
+    static int BishopCount(MaterialKey key, Color color, bool lightSquares);
+
+    /**
+     * @brief Swaps the White and Black halves of a signature.
+     */
+    static MaterialKey Mirror(MaterialKey key);
+
+    /**
+     * @brief Folds light-squared bishops into the dark-squared count.
+     *
+     * Signatures parsed from text have no bishop colors; compare against
+     * Normalize(key).
+     */
+    static MaterialKey Normalize(MaterialKey key);
+
+    /**
+     * @brief Formats a signature as text, e.g. "KRPvKR".
+     */
+    static std::string ToString(MaterialKey key);
+
+    /**
+     * @brief Parses text such as "KRPvKR" or "KBPPvKB" into a normalized signature.
+     * @param text White's pieces, 'v', Black's pieces; each side starts with K.
+     * @param key Receives the normalized signature.
+     * @return False if the text is malformed.
+     */
+    static bool ParseSignature(const std::string& text, MaterialKey& key);
+
+    /**
+     * @brief Checks whether each side has exactly one bishop, on opposite colors, and no knights, rooks or queens.
+     */
+    static bool IsOppositeColoredBishops(MaterialKey key);
+
+    /**
+     * @brief Replays packed moves and records the signatures passed through.
+     * @param game Game ID stored in the postings.
+     * @param start Position before the first move.
+     * @param moves Legal mainline moves from start.
+     */
+    void AddGame(std::uint32_t game, const Board& start, MoveSpan moves);
+
+    /**
+     * @brief Adds the postings of another index, shifting its game IDs.
+     * @param other Index over disjoint games.
+     * @param gameOffset Added to other's game IDs.
+     */
+    void MergeWith(const MaterialIndex& other, std::uint32_t gameOffset);
+
+    /**
+     * @brief Lays out postings added since the last call for lookup.
+     */
+    void Finalize();
+
+    /**
+     * @brief Returns the postings of one signature, sorted by game.
+     */
+    PostingList Find(MaterialKey key) const;
+
+    /**
+     * @brief Returns the postings of all signatures matching a predicate, sorted by game and ply.
+     */
+    std::vector<MaterialPosting> FindIf(const std::function<bool(MaterialKey)>& predicate) const;
+
+    /**
+     * @brief Returns the postings of a textual signature such as "KRPvKR".
+     * @param text Signature, see ParseSignature().
+     * @param eitherSide Also match the signature with colors reversed.
+     * @return Postings sorted by game and ply (empty if the text is malformed).
+     */
+    std::vector<MaterialPosting> FindSignature(const std::string& text, bool eitherSide = true) const;
+
+    /**
+     * @brief Returns the postings of opposite-colored bishop positions.
+     * @param pawnsAllowed Also match positions with pawns on the board.
+     */
+    std::vector<MaterialPosting> FindOppositeColoredBishops(bool pawnsAllowed = true) const;
+
+    /**
+     * @brief Returns the distinct signatures, sorted.
+     */
+    const std::vector<MaterialKey>& GetKeys() const;
+
+    /**
+     * @brief Returns the number of postings (finalized or not).
+     */
+    std::size_t GetPostingCount() const;
+
+    /**
+     * @brief Estimates the heap usage of the index.
+     */
+    MemoryUsage GetMemoryUsage() const;
+
+private:
+    struct PendingPosting {
+        MaterialKey key;
+        MaterialPosting posting;
+    };
+
+    std::vector<MaterialKey> keys;              ///< Distinct signatures, sorted
+    std::vector<std::uint64_t> offsets;         ///< Postings of keys[i]: [offsets[i], offsets[i + 1])
+    std::vector<MaterialPosting> postings;      ///< All postings, grouped by signature
+    std::vector<PendingPosting> pending;        ///< Added since the last Finalize()
+};
+
+} // namespace chessDataLib
@@ -0,0 +1,136 @@
+#pragma once
+
+#include "utils/flatHashMap.hpp"
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace chessDataLib {
+
+/**
+ * @brief Approximate heap usage of one component of the loaded database.
+ *
+ * Figures are estimates derived from container sizes and capacities; they do
+ * not include allocator bookkeeping and are meant for sizing and regression
+ * tracking rather than exact accounting.
+ */
+struct MemoryUsage {
+    std::size_t objects = 0;          ///< Number of top-level objects walked
+    std::size_t inlineBytes = 0;      ///< sizeof() of objects stored in containers
+    std::size_t containerBytes = 0;   ///< Buckets, hash nodes and vector slack
+    std::size_t stringHeapBytes = 0;  ///< Heap blocks owned by std::string
+    std::size_t ssoStrings = 0;       ///< Strings stored inline (small string optimization)
+    std::size_t heapStrings = 0;      ///< Strings that allocated a heap block
+    std::size_t hashBuckets = 0;      ///< Bucket slots of all hash tables walked
+    std::size_t hashElements = 0;     ///< Elements of all hash tables walked
+
+    /**
+     * @brief Returns the sum of inline, container and string heap bytes.
+     */
+    std::size_t TotalBytes() const;
+
+    /**
+     * @brief Returns elements per bucket over all hash tables walked.
+     * @return Load factor, or 0 if no hash table was walked.
+     */
+    double LoadFactor() const;
+
+    /**
+     * @brief Accumulates another usage record into this one.
+     */
+    MemoryUsage& operator+=(const MemoryUsage& other);
+};
+
+/**
+ * @brief Per-component memory breakdown of a loaded database.
+ */
+class MemoryReport {
+public:
+    /**
+     * @brief Named entry of the report.
+     */
+    struct Component {
+        std::string name;
+        MemoryUsage usage;
+    };
+
+    /**
+     * @brief Appends a component to the report.
+     * @param name Component label (e.g. "games", "players").
+     * @param usage Usage measured for that component.
+     */
+    void Add(const std::string& name, const MemoryUsage& usage);
+
+    /**
+     * @brief Returns the components in insertion order.
+     */
+    const std::vector<Component>& GetComponents() const;
+
+    /**
+     * @brief Returns the sum of all components.
+     */
+    MemoryUsage GetTotal() const;
+
+    /**
+     * @brief Returns a human-readable table of the report.
+     */
+    std::string ToString() const;
+
+private:
+    std::vector<Component> components;
+};
+
+namespace utils {
+
+// Capacity of an empty std::string, i.e. the inline (SSO) buffer size
+std::size_t SmallStringCapacity();
+
+// Account the heap block of a string (inline footprint is the caller's business)
+void AccountString(const std::string& s, MemoryUsage& usage);
+
+// Account a vector of strings: slack + element footprint + string heap
+void AccountStrings(const std::vector<std::string>& v, MemoryUsage& usage);
+
+// Account a std::unordered_map: buckets, nodes (with cached hash) and string keys.
+// visit(value, usage) adds whatever the mapped values own on the heap.
+template <typename V, typename Visit>
+void AccountHashMap(const std::unordered_map<std::string, V>& m, MemoryUsage& usage, Visit visit) {
+    // libstdc++ node: next pointer + value + cached hash code for std::string keys
+    constexpr std::size_t nodeBytes = sizeof(void*) + sizeof(std::pair<const std::string, V>) + sizeof(std::size_t);
+    usage.containerBytes += m.bucket_count() * sizeof(void*);
+    usage.containerBytes += m.size() * nodeBytes;
+    usage.hashBuckets += m.bucket_count();
+    usage.hashElements += m.size();
+    for (const auto& kv : m) {
+        AccountString(kv.first, usage);
+        visit(kv.second, usage);
+    }
+}
+
+template <typename V>
+void AccountHashMap(const std::unordered_map<std::string, V>& m, MemoryUsage& usage) {
+    AccountHashMap(m, usage, [](const V&, MemoryUsage&) {});
+}
+
+// Account a flat StringMap: one control byte and one inline slot per capacity
+// slot, plus string keys. visit(value, usage) as above.
+template <typename V, typename Visit>
+void AccountHashMap(const StringMap<V>& m, MemoryUsage& usage, Visit visit) {
+    usage.containerBytes += m.capacity() * (1 + sizeof(typename StringMap<V>::value_type));
+    usage.hashBuckets += m.capacity();
+    usage.hashElements += m.size();
+    for (const auto& kv : m) {
+        AccountString(kv.first, usage);
+        visit(kv.second, usage);
+    }
+}
+
+template <typename V>
+void AccountHashMap(const StringMap<V>& m, MemoryUsage& usage) {
+    AccountHashMap(m, usage, [](const V&, MemoryUsage&) {});
+}
+
+} // namespace utils
+
+} // namespace chessDataLib
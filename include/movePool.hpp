@@ -0,0 +1,92 @@
+#pragma once
+
+#include "board.hpp"
+#include "memoryReport.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace chessDataLib {
+
+/**
+ * @brief Read-only view of a contiguous run of packed moves.
+ *
+ * Valid while the pool it points into is alive.
+ */
+struct MoveSpan {
+    const PackedMove* data = nullptr;  ///< First move
+    std::size_t size = 0;              ///< Number of moves (plies)
+
+    const PackedMove* begin() const { return data; }
+    const PackedMove* end() const { return data + size; }
+    PackedMove operator[](std::size_t i) const { return data[i]; }
+    bool empty() const { return size == 0; }
+};
+
+/**
+ * @brief Handle to a game's packed moves inside its owner's MovePool.
+ *
+ * 16 bytes on 64-bit targets; copying a game touches no reference count.
+ */
+struct MovesRef {
+    static constexpr std::uint64_t kNone = ~0ull;
+
+    std::uint64_t offset = kNone;  ///< Offset of the first move in the pool; kNone if none stored
+    std::uint32_t count = 0;       ///< Number of plies
+};
+
+/**
+ * @brief Append-only store of the packed mainline moves of many games.
+ *
+ * Games keep an offset and a ply count into the pool (MovesRef) instead of
+ * their own move vectors, so a database costs two bytes per ply plus one
+ * MovesRef per game. Moves live in segments, typically one per load, that
+ * are never reallocated once added: views stay valid while more segments
+ * are appended. Offsets run on across segments.
+ */
+class MovePool {
+public:
+    /**
+     * @brief Adds a segment of moves and returns the offset of its first move.
+     * @param moves Packed moves, taken over without a copy.
+     */
+    std::uint64_t AddSegment(std::vector<PackedMove> moves);
+
+    /**
+     * @brief Returns a view of a range within one segment (empty if out of range).
+     * @param offset Offset of the first move.
+     * @param count Number of moves.
+     */
+    MoveSpan View(std::uint64_t offset, std::uint32_t count) const;
+
+    /**
+     * @brief Returns the moves a handle points to (empty if none are stored).
+     */
+    MoveSpan View(const MovesRef& ref) const;
+
+    /**
+     * @brief Returns the number of moves stored.
+     */
+    std::uint64_t Size() const;
+
+    /**
+     * @brief Returns the number of segments added.
+     */
+    std::size_t GetSegmentCount() const;
+
+    /**
+     * @brief Estimates the heap usage of the pool.
+     */
+    MemoryUsage GetMemoryUsage() const;
+
+private:
+    struct Segment {
+        std::uint64_t base = 0;          ///< Offset of the first move
+        std::vector<PackedMove> moves;   ///< Heap block; moving the Segment keeps it in place
+    };
+
+    std::vector<Segment> segments;
+    std::uint64_t size = 0;
+};
+
+} // namespace chessDataLib
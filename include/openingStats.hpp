@@ -0,0 +1,170 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace chessDataLib {
+
+/**
+ * @brief Aggregated results of a slice of the opening table.
+ */
+struct OpeningTotals {
+    std::uint64_t games = 0;        ///< Games in the slice (any result)
+    std::uint64_t whiteWins = 0;    ///< Games won by White
+    std::uint64_t draws = 0;        ///< Drawn games
+    std::uint64_t blackWins = 0;    ///< Games won by Black
+    std::uint64_t ratedGames = 0;   ///< Games where both Elo ratings are known
+    std::uint64_t whiteEloSum = 0;  ///< Sum of White ratings over rated games
+    std::uint64_t blackEloSum = 0;  ///< Sum of Black ratings over rated games
+
+    /**
+     * @brief Returns White's score percentage over decided and drawn games.
+     */
+    double GetWhiteScorePercentage() const;
+
+    /**
+     * @brief Returns the average White rating over rated games.
+     */
+    double GetAverageWhiteElo() const;
+
+    /**
+     * @brief Returns the average Black rating over rated games.
+     */
+    double GetAverageBlackElo() const;
+};
+
+/**
+ * @brief Selection of ECO codes, rating range and years to aggregate.
+ *
+ * The rating filter applies to the lower of the two ratings, so minElo = 2400
+ * selects games where both players are rated 2400 or more. Ratings are only
+ * kept per band of OpeningStats::kBandWidth points, so the filter counts the
+ * bands that lie wholly inside [minElo, maxElo]: minElo = 2450 starts at 2600
+ * and maxElo = 2400 ends at 2399. Bounds are exact when minElo and maxElo + 1
+ * are multiples of the band width. The last band also holds ratings above it.
+ */
+struct OpeningQuery {
+    std::string ecoFirst = "A00";  ///< First ECO code (inclusive)
+    std::string ecoLast = "E99";   ///< Last ECO code (inclusive)
+    int minElo = 0;                ///< Lowest rating (inclusive, whole bands); 0 with maxElo 0 also admits unrated
+    int maxElo = 0;                ///< Highest rating (inclusive, whole bands); 0 means no upper bound
+    int yearFirst = 0;             ///< First year (inclusive); 0 with yearLast 0 means no year filter (see OpeningStats::Slice())
+    int yearLast = 0;              ///< Last year (inclusive); 0 means no upper bound
+};
+
+/**
+ * @brief Columnar per-opening result table.
+ *
+ * Every ECO code A00–E99 maps to one of 500 slots. Counters are kept in
+ * dense structure-of-arrays columns indexed by (year bucket, rating band,
+ * ECO slot), so slicing a query sums contiguous runs of ECO slots.
+ */
+class OpeningStats {
+public:
+    static constexpr int kEcoSlots = 500;     ///< A00..E99
+    static constexpr int kBandWidth = 200;    ///< Elo points per rating band
+    static constexpr int kRatedBands = 16;    ///< Bands 0..3199; higher ratings go to the last band
+    static constexpr int kUnratedBand = kRatedBands;  ///< Band of games with a missing rating
+    static constexpr int kBands = kRatedBands + 1;
+
+    /**
+     * @brief Constructs a table without a year dimension.
+     */
+    OpeningStats();
+
+    /**
+     * @brief Constructs a table with one bucket per year in [firstYear, firstYear + years).
+     *
+     * Games without a year or outside the range go to an extra bucket that is
+     * only included by queries without a year filter.
+     * @param firstYear First year covered.
+     * @param years Number of years covered; 0 disables the year dimension.
+     */
+    OpeningStats(int firstYear, int years);
+
+    /**
+     * @brief Maps an ECO code ("A00".."E99") to its slot.
+     * @return Slot in [0, kEcoSlots), or -1 if the code is invalid.
+     */
+    static int EcoIndex(const std::string& eco);
+
+    /**
+     * @brief Returns the ECO code of a slot.
+     */
+    static std::string EcoCode(int index);
+
+    /**
+     * @brief Adds one game to the table.
+     * @param eco ECO code of the game.
+     * @param result Result string ("1-0", "0-1", "1/2-1/2", "*").
+     * @param whiteElo White rating, 0 if unknown.
+     * @param blackElo Black rating, 0 if unknown.
+     * @param year Year the game was played, 0 if unknown.
+     */
+    void AddGame(const std::string& eco, const std::string& result, int whiteElo, int blackElo, int year);
+
+    /**
+     * @brief Adds the counters of a table with the same dimensions.
+     * @return False if the dimensions differ.
+     */
+    bool MergeWith(const OpeningStats& other);
+
+    /**
+     * @brief Sums the counters selected by a query.
+     *
+     * A year filter on a table without a year dimension (GetYearCount() == 0)
+     * is unsupported and selects nothing, rather than all years.
+     */
+    OpeningTotals Slice(const OpeningQuery& query) const;
+
+    /**
+     * @brief Returns per-ECO totals for a query, one entry per slot.
+     *
+     * All zero for a year filter on a table without a year dimension.
+     */
+    std::vector<OpeningTotals> SliceByEco(const OpeningQuery& query) const;
+
+    /**
+     * @brief Returns the number of games without a valid ECO code.
+     */
+    std::uint64_t GetUnclassifiedGames() const;
+
+    /**
+     * @brief Returns the number of games outside the year dimension (always 0 without one).
+     */
+    std::uint64_t GetUndatedGames() const;
+
+    /**
+     * @brief Returns the first year of the year dimension (0 if disabled).
+     */
+    int GetFirstYear() const;
+
+    /**
+     * @brief Returns the number of year buckets (0 if disabled).
+     */
+    int GetYearCount() const;
+
+private:
+    std::size_t Cell(int yearBucket, int band, int eco) const;
+    // Calls visit(firstCell, ecoFirst, count) for every contiguous ECO run selected by the query
+    void ForEachRun(const OpeningQuery& query,
+                    const std::function<void(std::size_t, int, int)>& visit) const;
+
+    int firstYear = 0;
+    int years = 0;
+    std::uint64_t unclassifiedGames = 0;
+    std::uint64_t undatedGames = 0;
+
+    // Structure-of-arrays columns, one entry per (year bucket, band, ECO) cell
+    std::vector<std::uint32_t> games;
+    std::vector<std::uint32_t> whiteWins;
+    std::vector<std::uint32_t> draws;
+    std::vector<std::uint32_t> blackWins;
+    std::vector<std::uint32_t> ratedGames;
+    std::vector<std::uint64_t> whiteEloSum;
+    std::vector<std::uint64_t> blackEloSum;
+};
+
+} // namespace chessDataLib
@@ -1,14 +1,43 @@
 #pragma once
 
 #include "databaseStats.hpp"
+#include "gameSampler.hpp"
+#include "gameIndex.hpp"
+#include "PGNExporter.hpp"
+#include "arrowWriter.hpp"
+#include "PGNValidator.hpp"
+#include "headToHead.hpp"
+#include "materialIndex.hpp"
+#include "openingStats.hpp"
+#include "playerNameResolver.hpp"
+#include "progress.hpp"
+#include "memoryReport.hpp"
+#include "statsSnapshot.hpp"
+#include "timeSeriesStats.hpp"
+#include "utils/flatHashMap.hpp"
+#include <cstdint>
 #include <functional>
 #include <memory>
 #include <string>
 #include <vector>
-#include <unordered_map>
 
 namespace chessDataLib {
 
+/**
+ * @brief Sort order and memory budget of Parser::ExportPlayerStatsCSV(filename, options).
+ */
+struct PlayerExportOptions {
+    /**
+     * @brief Column the rows are sorted by.
+     */
+    enum class Key { Games, Score, Wins, Name };
+
+    Key key = Key::Games;                     ///< Sort column; ties are broken by ascending name
+    bool descending = true;                   ///< Largest (or last name) first
+    std::size_t memoryBudget = 256u << 20;    ///< Bytes of rows held in memory before a sorted run is spilled
+    std::string tempDirectory;                ///< Spill directory; empty selects the system temporary directory
+};
+
 /**
  * @brief Parses PGN files and extracts structured chess data.
  * 
@@ -18,6 +47,9 @@ class Parser {
 public:
     /**
      * @brief Callback type for reporting parsing progress.
+     *
+     * Called at the start, once per completed chunk and at the end. See
+     * SetProgressHandler() for throttled reports with rates and an ETA.
      * @param percent Completion percentage (0–100).
      * @param message Status message.
      */
@@ -31,6 +63,16 @@ public:
      */
     static DatabaseStats AnalyzeFile(const std::string& filename, ProgressCallback callback = nullptr);
 
+    /**
+     * @brief Returns cached statistics for an unchanged file, parsing and caching otherwise.
+     * @param filename Path to PGN file.
+     * @param cache Snapshot cache consulted and updated.
+     * @param callback Optional progress callback.
+     * @return Aggregated database statistics.
+     */
+    static DatabaseStats AnalyzeFile(const std::string& filename, StatsSnapshotCache& cache,
+                                     ProgressCallback callback = nullptr);
+
     /**
      * @brief Constructs a new parser instance.
      */
@@ -49,12 +91,277 @@ public:
      */
     bool LoadFile(const std::string& filename, ProgressCallback callback = nullptr);
 
+    /**
+     * @brief Loads and parses several PGN files in parallel.
+     *
+     * Files, and byte-range chunks of files larger than the chunk size, are
+     * scheduled largest-first on a work-stealing thread pool. Each worker
+     * aggregates into its own player/tournament maps, which are merged once
+     * all work is done. Games keep file order, then chunk order.
+     * @param filenames Paths to PGN files.
+     * @param callback Optional progress callback, invoked as work completes.
+     * @return True if every file could be opened.
+     */
+    bool LoadFiles(const std::vector<std::string>& filenames, ProgressCallback callback = nullptr);
+
+    /**
+     * @brief Loads all matching PGN files of a directory in parallel.
+     * @param directory Directory to scan (non-recursive).
+     * @param pattern Shell-style file name pattern ('*' and '?').
+     * @param callback Optional progress callback.
+     * @return True if the directory exists and every matching file was loaded.
+     */
+    bool LoadDirectory(const std::string& directory, const std::string& pattern = "*.pgn",
+                       ProgressCallback callback = nullptr);
+
+    /**
+     * @brief Sets a handler for throttled progress reports while loading.
+     *
+     * Workers publish processed bytes and games every few hundred games; the
+     * handler runs at most once per interval, on one worker at a time, with
+     * the byte position, instantaneous MB/s and games/s and an ETA. A final
+     * report with finished set follows every load. Works alongside the
+     * per-call ProgressCallback.
+     * @param handler Receives reports; empty to disable.
+     * @param options Report interval.
+     */
+    void SetProgressHandler(ProgressHandler handler, const ProgressOptions& options = ProgressOptions());
+
+    /**
+     * @brief Sets a token that stops loads when cancelled.
+     *
+     * Workers poll it between chunks and every few hundred games. A cancelled
+     * load returns false and discards its partial results, leaving previously
+     * loaded data untouched.
+     * @param token Token shared with the caller.
+     */
+    void SetCancellationToken(const CancellationToken& token);
+
+    /**
+     * @brief Sets the number of worker threads used for loading.
+     * @param count Thread count; 0 selects the hardware concurrency.
+     */
+    void SetThreadCount(unsigned count);
+
+    /**
+     * @brief Sets the size above which files are split into chunks.
+     * @param bytes Target chunk size in bytes.
+     */
+    void SetChunkSize(std::uint64_t bytes);
+
+    /**
+     * @brief Sets how many decoded move lists each source file keeps in its LRU cache.
+     * @param entries Cache capacity per file; 0 (default) disables caching.
+     */
+    void SetMoveListCacheSize(std::size_t entries);
+
+    /**
+     * @brief Returns the raw move text of a game loaded, read or sampled by this parser.
+     * @param game Game whose handle points into GetSources().
+     * @return Copy of the move text bytes, empty if the game has no handle.
+     */
+    std::string GetMoveText(const Game& game) const;
+
+    /**
+     * @brief Returns the mainline SAN moves of a game of this parser, decoded on first access.
+     *
+     * Decoded lists are shared through the source's LRU cache when enabled.
+     * @param game Game whose handle points into GetSources().
+     * @return Shared, immutable move list (empty if the game has no handle).
+     */
+    std::shared_ptr<const std::vector<std::string>> GetMoveList(const Game& game) const;
+
+    /**
+     * @brief Returns the table of source files that games' move text handles point into.
+     *
+     * Loaded, indexed and sampled files are added and stay mapped for the
+     * parser's lifetime.
+     */
+    const SourceTable& GetSources() const;
+
+    /**
+     * @brief Enables storing each game's mainline as packed 16-bit moves.
+     *
+     * Mainlines are replayed on a board while loading (from the FEN tag when
+     * present) and each load adds one segment to the parser's move pool;
+     * GetMoves() then returns a view into it. Replay stops at the first
+     * unresolvable move. Games read from an indexed file carry no packed
+     * moves. Off by default; costs a board replay per game and two bytes per ply.
+     * @param enabled True to store moves for games loaded from now on.
+     */
+    void SetStoreMoves(bool enabled);
+
+    /**
+     * @brief Returns the packed mainline moves (see PackedMove) of a loaded game.
+     *
+     * Replay them with Board::Unpack from the game's start position. The view
+     * stays valid across later loads, for the parser's lifetime.
+     * @param game Game from GetGames().
+     * @return View of the moves, empty if none were stored.
+     */
+    MoveSpan GetMoves(const Game& game) const;
+
+    /**
+     * @brief Returns the pool holding the packed moves of loaded games.
+     */
+    const MovePool& GetMovePool() const;
+
+    /**
+     * @brief Enables the material-signature index.
+     *
+     * Each game's mainline is replayed while loading and every material
+     * signature it passes through is posted, with its ply range, under the
+     * game's index in GetGames(). Off by default; independent of SetStoreMoves().
+     * @param enabled True to index games loaded from now on.
+     */
+    void SetIndexMaterial(bool enabled);
+
+    /**
+     * @brief Returns the material-signature index of loaded games.
+     */
+    const MaterialIndex& GetMaterialIndex() const;
+
+    /**
+     * @brief Opens a PGN file for random access through its game offset index.
+     *
+     * Uses the "<file>.idx" sidecar when it matches the file, otherwise scans
+     * the file once and writes the sidecar. Does not parse any game.
+     * @param filename Path to PGN file.
+     * @return False if the file cannot be read.
+     */
+    bool OpenIndexed(const std::string& filename);
+
+    /**
+     * @brief Returns the number of games in the indexed file.
+     */
+    std::size_t GetIndexedGameCount() const;
+
+    /**
+     * @brief Reads and parses a single game of the indexed file.
+     * @param index Game number (0-based).
+     * @param game Receives the parsed game.
+     * @return False if no file is open, the index is out of range or the read fails.
+     */
+    bool GetGameAt(std::size_t index, Game& game) const;
+
+    /**
+     * @brief Reads and parses a contiguous range of games of the indexed file.
+     *
+     * The games carry a move text handle but no packed moves.
+     * @param first First game number (0-based).
+     * @param count Number of games; clamped to the end of the file.
+     * @return Parsed games, empty if nothing is open or first is out of range.
+     */
+    std::vector<Game> ReadGames(std::size_t first, std::size_t count) const;
+
+    /**
+     * @brief Reads a uniform random sample of the games of the indexed file.
+     *
+     * Picks game numbers from the offset index and parses only those games.
+     * @param count Sample size (all games if the file holds fewer).
+     * @param seed Random seed.
+     * @return Sampled games in file order, empty if nothing is open.
+     */
+    std::vector<Game> SampleIndexedGames(std::size_t count, std::uint64_t seed = 0) const;
+
+    /**
+     * @brief Draws a uniform random sample of the games of PGN files.
+     *
+     * Does not load anything into the parser. Only game boundaries are
+     * scanned; games outside the sample are never tokenized.
+     * @param filenames Paths to PGN files, sampled as one stream.
+     * @param count Sample size (all games if the files hold fewer).
+     * @param games Receives the sampled games in input order.
+     * @param seed Random seed.
+     * @return False if a file cannot be opened.
+     */
+    bool SampleGames(const std::vector<std::string>& filenames, std::size_t count, std::vector<Game>& games,
+                     std::uint64_t seed = 0) const;
+
+    /**
+     * @brief Draws a uniform random sample of games within each stratum.
+     *
+     * Does not load anything into the parser. See GameSampler::ByEloBand(),
+     * ByYear() and ByTimeControl() for built-in strata.
+     * @param filenames Paths to PGN files, sampled as one stream.
+     * @param countPerStratum Sample size per stratum.
+     * @param stratum Stratum of a game's tags.
+     * @param samples Receives the sampled games of each stratum in input order.
+     * @param seed Random seed.
+     * @return False if a file cannot be opened.
+     */
+    bool SampleGamesStratified(const std::vector<std::string>& filenames, std::size_t countPerStratum,
+                               const GameSampler::StratumFunction& stratum,
+                               std::map<std::string, std::vector<Game>>& samples, std::uint64_t seed = 0) const;
+
+    /**
+     * @brief Replays every game of the files on a board and reports problems.
+     *
+     * Does not load anything into the parser; uses its thread count and chunk size.
+     * @param filenames Paths to PGN files.
+     * @param report Receives illegal or ambiguous moves and bad tags and results.
+     * @return True if every file could be opened.
+     */
+    bool ValidateFiles(const std::vector<std::string>& filenames, ValidationReport& report) const;
+
+    /**
+     * @brief Copies the games of the files that satisfy a predicate to a new PGN file.
+     *
+     * Selected games are copied byte for byte from the sources, not re-serialized.
+     * Does not load anything into the parser; uses its thread count and chunk size.
+     * @param filenames Paths to PGN files.
+     * @param output Output file path; must not name one of the files.
+     * @param predicate Returns true for games to keep; called concurrently.
+     * @param summary Optional counters of the run.
+     * @return False if the output is one of the files, a file cannot be opened or writing fails.
+     */
+    bool ExportFilteredPGN(const std::vector<std::string>& filenames, const std::string& output,
+                           const PGNExporter::Predicate& predicate, PGNExporter::Summary* summary = nullptr) const;
+
     /**
      * @brief Returns aggregated statistics after parsing.
+     *
+     * The reference is into state that loads modify; from other threads
+     * use GetStatsSnapshot() instead.
      * @return Reference to the DatabaseStats object.
      */
     const DatabaseStats& GetStats() const;
 
+    /**
+     * @brief Enables publishing immutable copies of the statistics.
+     *
+     * When enabled, the parser copies its statistics after every completed
+     * load and name resolution and swaps the copy in atomically, starting
+     * with the current state. During a load, each parsed chunk is folded
+     * into the load's running totals, and a snapshot of the earlier loads
+     * plus those totals is published whenever the interval has passed since
+     * the last one; its tournament views stay as of the last completed
+     * load. A cancelled load republishes the statistics without it. Off by
+     * default, since each published copy costs a copy of the stats.
+     * @param enabled True to publish.
+     * @param intervalSeconds Minimum time between snapshots published during a load; 0 publishes after every chunk.
+     */
+    void SetPublishStats(bool enabled, double intervalSeconds = 1.0);
+
+    /**
+     * @brief Returns the latest published statistics.
+     *
+     * Lock-free and safe to call from any thread while loads run on another:
+     * readers never wait for ingestion and only ever see a complete
+     * snapshot, which stays valid for as long as the pointer is held (see
+     * utils::SnapshotCell).
+     * @return Published statistics; empty until the first publication.
+     */
+    std::shared_ptr<const DatabaseStats> GetStatsSnapshot() const;
+
+    /**
+     * @brief Returns the number of statistics snapshots published so far.
+     *
+     * Safe to call from any thread; a changed value means GetStatsSnapshot()
+     * returns a newer snapshot.
+     */
+    std::uint64_t GetStatsVersion() const;
+
     /**
      * @brief Returns the list of parsed games.
      * @return Reference to the vector of Game objects.
@@ -63,15 +370,67 @@ public:
 
     /**
      * @brief Returns the map of parsed player statistics.
-     * @return Reference to the unordered map of Player objects.
+     * @return Reference to the map of Player objects.
      */
-    const std::unordered_map<std::string, Player>& GetPlayerStats() const;
+    const utils::StringMap<Player>& GetPlayerStats() const;
+
+    /**
+     * @brief Merges players whose names resolve to the same canonical name.
+     *
+     * Every loaded player name is resolved in parallel; each entry resolved
+     * to another name is folded into that name's entry with
+     * Player::MergeWith() and removed. Opponent lists, tournaments, the
+     * head-to-head table and the time series are rewritten to the canonical
+     * names the same way, so all of them agree with GetStats(). Games keep
+     * the names as spelled in the files.
+     * @param resolver Built name resolver.
+     * @return Number of player entries merged away.
+     */
+    std::size_t ResolvePlayerNames(const PlayerNameResolver& resolver);
 
     /**
      * @brief Returns the map of parsed tournaments.
-     * @return Reference to the unordered map of Tournament objects.
+     * @return Reference to the map of Tournament objects.
+     */
+    const utils::StringMap<Tournament>& GetTournaments() const;
+
+    /**
+     * @brief Returns the head-to-head pair table built during loading.
+     * @return Reference to the HeadToHead table.
      */
-    const std::unordered_map<std::string, Tournament>& GetTournaments() const;
+    const HeadToHead& GetHeadToHead() const;
+
+    /**
+     * @brief Returns the per-ECO result table built during loading.
+     * @return Reference to the OpeningStats table.
+     */
+    const OpeningStats& GetOpeningStats() const;
+
+    /**
+     * @brief Enables the year dimension of the opening table.
+     *
+     * Resets the opening table, so call it before loading.
+     * @param firstYear First year covered.
+     * @param years Number of years covered; 0 disables the year dimension.
+     */
+    void SetOpeningYearRange(int firstYear, int years);
+
+    /**
+     * @brief Returns the per-year or per-month aggregates built during loading.
+     * @return Reference to the TimeSeriesStats table; disabled unless SetTimeSeriesRange() was called.
+     */
+    const TimeSeriesStats& GetTimeSeriesStats() const;
+
+    /**
+     * @brief Enables the time-bucketed aggregates.
+     *
+     * Resets the table, so call it before loading.
+     * @param firstYear First year covered.
+     * @param years Number of years covered; 0 disables the table.
+     * @param granularity One bucket per year or per month.
+     */
+    void SetTimeSeriesRange(int firstYear, int years,
+                            TimeSeriesStats::Granularity granularity = TimeSeriesStats::Granularity::Year);
 
     /**
      * @brief Exports player statistics to a CSV file.
@@ -80,6 +439,20 @@ public:
     // Returns true on success, false on I/O failure
     bool ExportPlayerStatsCSV(const std::string& filename) const;
 
+    /**
+     * @brief Exports player statistics to a CSV file, sorted.
+     *
+     * Same columns as ExportPlayerStatsCSV(filename). Rows are sorted in
+     * parallel in memory while they fit options.memoryBudget; larger tables
+     * are spilled as sorted runs to options.tempDirectory and merged while
+     * the file is written. Score is the percentage of points over decided
+     * and drawn games.
+     * @param filename Output file path.
+     * @param options Sort column, direction, memory budget and spill directory.
+     */
+    // Returns true on success, false on I/O failure
+    bool ExportPlayerStatsCSV(const std::string& filename, const PlayerExportOptions& options) const;
+
     /**
      * @brief Exports tournament statistics to a CSV file.
      * @param filename Output file path.
@@ -87,6 +460,54 @@ public:
     // Returns true on success, false on I/O failure
     bool ExportTournamentsCSV(const std::string& filename) const;
 
+    /**
+     * @brief Exports the standings of every tournament to a CSV file.
+     *
+     * One row per player and tournament, computed from the recorded games
+     * with Tournament::ComputeStandings().
+     * @param filename Output file path.
+     */
+    // Returns true on success, false on I/O failure
+    bool ExportStandingsCSV(const std::string& filename) const;
+
+    /**
+     * @brief Exports one row per loaded game to an Arrow IPC file or stream.
+     *
+     * Tag columns are dictionary-encoded strings; Elo columns are nullable
+     * int32 (null when missing or non-numeric); "moves" is the move count.
+     * @param filename Output file path (".arrow"/".feather" for files, ".arrows" for streams).
+     * @param format File (Feather v2) or stream container.
+     * @param batchRows Rows per record batch.
+     * @return False on I/O failure.
+     */
+    bool ExportGamesArrow(const std::string& filename, ArrowWriter::Format format = ArrowWriter::Format::File,
+                          std::size_t batchRows = 65536) const;
+
+    /**
+     * @brief Exports the columns of ExportPlayerStatsCSV() plus timing and blunder counts to Arrow.
+     * @param filename Output file path.
+     * @param format File (Feather v2) or stream container.
+     * @return False on I/O failure.
+     */
+    bool ExportPlayersArrow(const std::string& filename, ArrowWriter::Format format = ArrowWriter::Format::File) const;
+
+    /**
+     * @brief Exports the columns of ExportTournamentsCSV() plus player counts to Arrow.
+     * @param filename Output file path.
+     * @param format File (Feather v2) or stream container.
+     * @return False on I/O failure.
+     */
+    bool ExportTournamentsArrow(const std::string& filename,
+                                ArrowWriter::Format format = ArrowWriter::Format::File) const;
+
+    /**
+     * @brief Walks the loaded database and reports approximate heap usage per component.
+     *
+     * Linear in the number of games, players and tournaments; performs no copies.
+     * @return Report with "games", "players", "tournaments" and "stats" components.
+     */
+    MemoryReport GetMemoryReport() const;
+
 private:
     struct Impl; ///< Internal implementation (Pimpl idiom)
     std::unique_ptr<Impl> pimpl;
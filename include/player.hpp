@@ -1,8 +1,10 @@
 #pragma once
 
+#include "memoryReport.hpp"
+#include "utils/flatHashMap.hpp"
+#include <cstdint>
 #include <string>
 #include <vector>
-#include <unordered_map>
 
 namespace chessDataLib {
 
@@ -24,8 +26,12 @@ private:
     int losses = 0;         ///< Number of losses
     int draws = 0;          ///< Number of draws
 
+    int64_t timeSpentCentis = 0;  ///< Clock time consumed, from [%clk] annotations
+    int timedMoves = 0;           ///< Moves with a measurable clock delta
+    int blunders = 0;             ///< Moves losing 3+ pawns, from [%eval] annotations
+
     std::vector<std::string> opponents;  ///< List of opponent names
-    std::unordered_map<std::string, int> openingFrequency; ///< Opening usage frequency
+    utils::StringMap<int> openingFrequency; ///< Opening usage frequency
 
 public:
     // === Getters ===
@@ -90,6 +96,30 @@ public:
      */
     double GetDrawPercentage() const;
 
+    /**
+     * @brief Returns the total clock time consumed in centiseconds.
+     * @return Time spent over all timed moves.
+     */
+    int64_t GetTimeSpentCentis() const;
+
+    /**
+     * @brief Returns the number of moves with a measurable clock delta.
+     * @return Timed move count.
+     */
+    int GetTimedMoves() const;
+
+    /**
+     * @brief Calculates the average time per move in seconds.
+     * @return Average seconds per timed move, 0 if none.
+     */
+    double GetAverageMoveTimeSeconds() const;
+
+    /**
+     * @brief Returns the number of blunders detected from evaluations.
+     * @return Blunder count.
+     */
+    int GetBlunderCount() const;
+
     /**
      * @brief Returns the list of opponents.
      * @return Vector of opponent names.
@@ -100,7 +130,7 @@ public:
      * @brief Returns the frequency of openings used.
      * @return Unordered map of opening names and their usage count.
      */
-    const std::unordered_map<std::string, int> GetOpeningFrequency() const;
+    const utils::StringMap<int>& GetOpeningFrequency() const;
 
     // === Setters ===
 
@@ -154,9 +184,9 @@ public:
 
     /**
      * @brief Sets the opening frequency map.
-     * @param val New unordered map of opening usage.
+     * @param val New map of opening usage.
      */
-    void SetOpeningFrequency(const std::unordered_map<std::string, int>& val);
+    void SetOpeningFrequency(const utils::StringMap<int>& val);
 
     // === Incremental updates ===
 
@@ -180,6 +210,19 @@ public:
      */
     void IncrementDrawCount();
 
+    /**
+     * @brief Adds clock usage from one game.
+     * @param centis Time consumed in centiseconds.
+     * @param moves Number of timed moves it covers.
+     */
+    void AddTimeUsage(int64_t centis, int moves);
+
+    /**
+     * @brief Adds blunders detected in one game.
+     * @param count Number of blunders.
+     */
+    void AddBlunders(int count);
+
     /**
      * @brief Adds an opponent to the player's list if not already present.
      * @param name Opponent's name.
@@ -205,11 +248,28 @@ public:
      */
     void MergeWith(const Player& other);
 
+    /**
+     * @brief Renames opponents that are aliases to their canonical names.
+     *
+     * Opponents that become duplicates are listed once, in first-seen order.
+     * @param aliases Alias to canonical name; names not in the map are kept.
+     */
+    void MergeAliases(const utils::StringMap<std::string>& aliases);
+
     /**
      * @brief Returns a formatted string summary of the player's statistics.
      * @return String containing name, game counts, results, and percentages.
      */
     std::string ToString() const;
+
+    // === Memory accounting ===
+
+    /**
+     * @brief Returns the heap memory owned by the name, opponent list and opening map.
+     *
+     * The player's own footprint is accounted by the container holding it.
+     */
+    MemoryUsage GetMemoryUsage() const;
 };
 
 } // namespace chessDataLib
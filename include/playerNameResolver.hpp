@@ -0,0 +1,158 @@
+#pragma once
+
+#include "memoryReport.hpp"
+#include "utils/flatHashMap.hpp"
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace chessDataLib {
+
+/**
+ * @brief Maps the spellings of player names found in PGN files to canonical names.
+ *
+ * Holds a list of canonical names (e.g. a rating list) and an optional alias
+ * table. A name is resolved, in order, by:
+ *  1. the alias table, by exact spelling or normalized form;
+ *  2. an exact canonical name;
+ *  3. the normalized form (see Normalize()), also with surname and given
+ *     names swapped for "Surname Given" spellings without a comma;
+ *  4. initials: "Carlsen, M" or "M. Carlsen" matches the only canonical
+ *     player with that surname and matching given-name initials;
+ *  5. fuzzy matching: the canonical name at the smallest edit distance of
+ *     the normalized form, if it is unique and within the distance budget.
+ *
+ * Fuzzy candidates come from a trigram inverted index over the normalized
+ * canonical names. A name within k edits shares all but at most 3k of its
+ * trigrams, so only the 3k + 1 rarest trigram posting lists of the query are
+ * scanned, and only over names whose length is within k. Each posting
+ * carries a 64-bit trigram signature of its name, so candidates whose
+ * signatures differ in more than 3k bits either way are dropped during the
+ * sequential scan; the rest are verified with the bit-parallel edit
+ * distance of utils::EditDistanceMatcher. The search radius grows one edit
+ * at a time, so most typos are settled with four lists.
+ *
+ * Call Build() after adding names and before resolving. Resolving is
+ * read-only and may run concurrently.
+ */
+class PlayerNameResolver {
+public:
+    /**
+     * @brief How a name was resolved.
+     */
+    enum class MatchKind { None, Alias, Exact, Normalized, Initials, Fuzzy };
+
+    /**
+     * @brief Result of resolving one name.
+     */
+    struct Match {
+        MatchKind kind = MatchKind::None;
+        std::string canonical;  ///< Canonical name; empty if unresolved
+        int distance = 0;       ///< Edit distance of the normalized forms (fuzzy matches only)
+
+        bool IsResolved() const { return kind != MatchKind::None; }
+    };
+
+    /**
+     * @brief Returns the normalized form of a name used for matching.
+     *
+     * Folds Latin accents to ASCII, lowercases, treats '.', '-' and '_' as
+     * spaces, drops other punctuation and reorders to "surname, given names":
+     * "Carlsen, Magnus", "Carlsen,Magnus." and "Magnus Carlsen" all give
+     * "carlsen, magnus". Without a comma the last word is taken as the
+     * surname, unless it is a lone initial ("Carlsen M").
+     */
+    static std::string Normalize(std::string_view name);
+
+    /**
+     * @brief Adds a canonical player name.
+     */
+    void AddCanonical(const std::string& name);
+
+    /**
+     * @brief Adds a spelling that always resolves to a canonical name (added if absent).
+     */
+    void AddAlias(const std::string& alias, const std::string& canonical);
+
+    /**
+     * @brief Reads an alias table with one "alias<TAB>canonical" pair per line.
+     *
+     * Empty lines and lines starting with '#' are skipped.
+     * @return False if the file cannot be opened.
+     */
+    bool LoadAliases(const std::string& path);
+
+    /**
+     * @brief Sets the largest edit distance accepted by fuzzy matching.
+     *
+     * The budget also shrinks with the name: at most one edit per six
+     * bytes of the normalized form, so short names are never fuzzy-matched.
+     * @param distance Maximum distance; 0 disables fuzzy matching.
+     */
+    void SetMaxDistance(int distance);
+
+    /**
+     * @brief Builds the lookup tables and the trigram index.
+     */
+    void Build();
+
+    /**
+     * @brief Resolves one name to a canonical name.
+     */
+    Match Resolve(std::string_view name) const;
+
+    /**
+     * @brief Resolves many names, in parallel.
+     * @param names Names to resolve.
+     * @param threadCount Thread count; 0 selects the hardware concurrency.
+     * @return One match per name, in order.
+     */
+    std::vector<Match> ResolveAll(const std::vector<std::string>& names, unsigned threadCount = 0) const;
+
+    /**
+     * @brief Lists the canonical names within the fuzzy distance budget of a name.
+     * @param name Name to look up.
+     * @param limit Maximum number of suggestions.
+     * @return Suggestions by increasing distance, then canonical order.
+     */
+    std::vector<Match> Suggest(std::string_view name, std::size_t limit = 5) const;
+
+    /**
+     * @brief Returns the number of canonical names.
+     */
+    std::size_t GetCanonicalCount() const;
+
+    /**
+     * @brief Returns the heap memory of the names, lookup tables and trigram index.
+     */
+    MemoryUsage GetMemoryUsage() const;
+
+private:
+    Match ResolveWith(std::string_view name) const;
+    bool MatchInitials(const std::string& key, std::uint32_t& id) const;
+    void FindFuzzy(const std::string& key, int maxDistance, std::vector<std::pair<int, std::uint32_t>>& found) const;
+    Match MakeMatch(MatchKind kind, std::uint32_t id, int distance = 0) const;
+
+    std::vector<std::string> names;         ///< Canonical names by ID
+    std::vector<std::string> keys;          ///< Normalized canonical names by ID
+    utils::StringMap<std::uint32_t> byName;
+    utils::StringMap<std::uint32_t> byKey;  ///< First canonical name of each normalized form
+    utils::StringMap<std::uint32_t> aliases;               ///< By spelling and by normalized form
+    utils::StringMap<std::vector<std::uint32_t>> bySurname; ///< Canonical IDs of each normalized surname
+    int maxDistance = 2;
+
+    // Trigram index in CSR layout over slots: canonical IDs ordered by the
+    // length of their normalized name, so that a length window is one slot
+    // range. Postings of the trigram numbered i in gramIndex are
+    // gramPostings[gramOffsets[i], gramOffsets[i + 1]), sorted by slot;
+    // gramSignatures holds, per posting, one bit per hashed trigram of its name.
+    utils::FlatHashMap<std::uint32_t, std::uint32_t> gramIndex;
+    std::vector<std::uint32_t> gramOffsets;
+    std::vector<std::uint32_t> gramPostings;
+    std::vector<std::uint64_t> gramSignatures;
+    std::vector<std::uint32_t> slotIds;  ///< Canonical ID of each slot
+    std::vector<std::uint32_t> lengthStarts;    ///< First slot of each key length, then the slot count
+};
+
+} // namespace chessDataLib
@@ -0,0 +1,124 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+
+namespace chessDataLib {
+
+/**
+ * @brief Snapshot of a long-running operation, passed to progress handlers.
+ */
+struct ProgressInfo {
+    std::uint64_t bytesDone = 0;    ///< Input bytes processed
+    std::uint64_t bytesTotal = 0;   ///< Input bytes planned
+    std::uint64_t gamesDone = 0;    ///< Games processed
+    double elapsedSeconds = 0;      ///< Since the operation started
+    double bytesPerSecond = 0;      ///< Since the previous report
+    double gamesPerSecond = 0;      ///< Since the previous report
+    double etaSeconds = -1;         ///< Estimated time left at the average rate; -1 if unknown
+    bool finished = false;          ///< Last report of the operation
+    bool cancelled = false;         ///< The operation was stopped by a CancellationToken
+
+    /**
+     * @brief Returns the completion percentage (0-100) by bytes.
+     */
+    int GetPercent() const {
+        if (finished && !cancelled) return 100;
+        return bytesTotal ? static_cast<int>(bytesDone * 100 / bytesTotal) : 0;
+    }
+};
+
+/**
+ * @brief Receives throttled progress reports. Called from one thread at a time.
+ */
+using ProgressHandler = std::function<void(const ProgressInfo&)>;
+
+/**
+ * @brief How often a ProgressReporter calls its handler.
+ */
+struct ProgressOptions {
+    double intervalSeconds = 0.25;  ///< Minimum time between reports
+    std::uint64_t intervalBytes = 0; ///< Also report after this many bytes; 0 reports by time only
+};
+
+/**
+ * @brief Cooperative cancellation flag shared between a caller and a running operation.
+ *
+ * Copies share one flag, so the caller keeps a copy and cancels from any
+ * thread; the operation polls it between units of work.
+ */
+class CancellationToken {
+public:
+    CancellationToken() : flag(std::make_shared<std::atomic<bool>>(false)) {}
+
+    /**
+     * @brief Requests cancellation.
+     */
+    void Cancel() const { flag->store(true, std::memory_order_relaxed); }
+
+    /**
+     * @brief Checks whether cancellation was requested.
+     */
+    bool IsCancelled() const { return flag->load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Clears the request so the token can be reused.
+     */
+    void Reset() const { flag->store(false, std::memory_order_relaxed); }
+
+private:
+    std::shared_ptr<std::atomic<bool>> flag;
+};
+
+/**
+ * @brief Thread-safe progress accumulator that throttles calls to a handler.
+ *
+ * Workers add processed bytes and games in batches; counters are atomics
+ * and the handler runs only when the interval has passed, on whichever
+ * worker gets there first (others never wait for it).
+ */
+class ProgressReporter {
+public:
+    /**
+     * @brief Starts timing an operation.
+     * @param handler Receives reports; may be empty.
+     * @param options Report interval.
+     * @param bytesTotal Input bytes planned.
+     */
+    ProgressReporter(ProgressHandler handler, ProgressOptions options, std::uint64_t bytesTotal);
+
+    /**
+     * @brief Adds processed work and reports if the interval has passed.
+     */
+    void Advance(std::uint64_t bytes, std::uint64_t games);
+
+    /**
+     * @brief Sends the final report.
+     * @param cancelled Whether the operation was cancelled.
+     */
+    void Finish(bool cancelled);
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    void Report(Clock::time_point now, bool finished, bool cancelled);
+
+    ProgressHandler handler;
+    ProgressOptions options;
+    std::uint64_t bytesTotal;
+    Clock::time_point start;
+    std::atomic<std::uint64_t> bytes{0};
+    std::atomic<std::uint64_t> games{0};
+    std::atomic<std::int64_t> nextReportNanos{0};  ///< Since start
+    std::atomic<std::uint64_t> nextReportBytes{0};
+    std::mutex reportMutex;
+    std::uint64_t lastBytes = 0;  ///< Guarded by reportMutex
+    std::uint64_t lastGames = 0;
+    Clock::time_point lastTime;
+};
+
+} // namespace chessDataLib
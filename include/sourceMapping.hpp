@@ -0,0 +1,137 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace chessDataLib {
+
+/**
+ * @brief Read-only view of a PGN source file shared by the games parsed from it.
+ *
+ * On POSIX systems the file is memory-mapped, so bytes are only resident while
+ * the OS keeps them cached; elsewhere it is read into memory once. Holds an
+ * optional LRU cache of decoded move lists keyed by move text offset.
+ */
+class SourceMapping {
+public:
+    /**
+     * @brief Maps a file.
+     * @param filename Path to the file.
+     * @return Shared mapping, or nullptr if the file cannot be opened.
+     */
+    static std::shared_ptr<SourceMapping> Open(const std::string& filename);
+
+    ~SourceMapping();
+    SourceMapping(const SourceMapping&) = delete;
+    SourceMapping& operator=(const SourceMapping&) = delete;
+
+    /**
+     * @brief Returns the first byte of the mapped file.
+     */
+    const char* Data() const;
+
+    /**
+     * @brief Returns the size of the mapped file in bytes.
+     */
+    std::uint64_t Size() const;
+
+    /**
+     * @brief Returns the path the mapping was opened from.
+     */
+    const std::string& GetPath() const;
+
+    /**
+     * @brief Sets how many decoded move lists are kept; 0 disables caching.
+     * @param entries Maximum number of cached move lists.
+     */
+    void SetMoveListCacheCapacity(std::size_t entries);
+
+    /**
+     * @brief Decodes the mainline SAN moves of a move text range.
+     *
+     * Served from the LRU cache when enabled and present.
+     * @param offset Offset of the move text in the file.
+     * @param length Length of the move text in bytes.
+     * @return Shared, immutable move list (empty if the range is out of bounds).
+     */
+    std::shared_ptr<const std::vector<std::string>> GetMoveList(std::uint64_t offset, std::uint32_t length) const;
+
+private:
+    SourceMapping() = default;
+
+    using MoveList = std::shared_ptr<const std::vector<std::string>>;
+    using LruList = std::list<std::pair<std::uint64_t, MoveList>>;
+
+    std::string path;
+    const char* data = nullptr;
+    std::uint64_t size = 0;
+    bool mapped = false;           ///< True if data came from mmap
+    std::vector<char> fallback;    ///< Owned copy when mmap is unavailable
+
+    mutable std::mutex cacheMutex;
+    std::size_t cacheCapacity = 0;
+    mutable LruList lru;
+    mutable std::unordered_map<std::uint64_t, LruList::iterator> lruIndex;
+};
+
+/**
+ * @brief Lightweight handle to a game's move text inside a SourceMapping.
+ *
+ * 16 bytes: the source is named by its id in the owner's SourceTable, so
+ * copying a game touches no reference count.
+ */
+struct MoveTextRef {
+    static constexpr std::uint32_t kNoSource = 0xFFFFFFFFu;
+
+    std::uint64_t offset = 0;          ///< Offset of the move text in the source
+    std::uint32_t length = 0;          ///< Length of the move text in bytes
+    std::uint32_t source = kNoSource;  ///< Id of the source in a SourceTable; kNoSource if none
+};
+
+/**
+ * @brief Append-only table of the mappings that MoveTextRef ids point into.
+ *
+ * Ids are positions in the table and stay valid, with their sources mapped,
+ * for the table's lifetime. Adding and resolving are thread-safe.
+ */
+class SourceTable {
+public:
+    /**
+     * @brief Adds a mapping and returns its id.
+     */
+    std::uint32_t Add(std::shared_ptr<const SourceMapping> source);
+
+    /**
+     * @brief Returns the mapping with an id, or nullptr if there is none.
+     */
+    const SourceMapping* Get(std::uint32_t id) const;
+
+    /**
+     * @brief Returns the number of mappings added.
+     */
+    std::size_t Size() const;
+
+    /**
+     * @brief Returns the raw move text a handle points to.
+     * @return Copy of the move text bytes, empty if the handle does not resolve.
+     */
+    std::string GetMoveText(const MoveTextRef& ref) const;
+
+    /**
+     * @brief Returns the mainline SAN moves a handle points to (see SourceMapping::GetMoveList).
+     * @return Shared, immutable move list (empty if the handle does not resolve).
+     */
+    std::shared_ptr<const std::vector<std::string>> GetMoveList(const MoveTextRef& ref) const;
+
+private:
+    mutable std::mutex mutex;
+    std::vector<std::shared_ptr<const SourceMapping>> sources;
+};
+
+} // namespace chessDataLib
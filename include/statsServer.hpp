@@ -0,0 +1,134 @@
+#pragma once
+
+#include "utils/snapshotCell.hpp"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace chessDataLib {
+
+class DatabaseStats;
+class Parser;
+
+/**
+ * @brief Serves stats lookups over a local Unix domain socket.
+ *
+ * Line protocol: one request per line, one response line per request, in
+ * order; clients may pipeline. A request is a command, then its arguments
+ * separated by tabs; a single argument, or OPENING's ECO codes, may follow
+ * a space instead. Responses are "OK" or "ERR" followed by tab-separated
+ * fields:
+ *
+ *     PING                        OK  PONG
+ *     STATS                       OK  games players tournaments whiteWins blackWins draws unknown
+ *     PLAYER <name>               OK  name games wins draws losses
+ *     TOURNAMENT <name>           OK  name games players leader leaderScore
+ *     OPENING <eco>[ <lastEco>]   OK  games whiteWins draws blackWins whiteScore%
+ *     H2H <player>\t<opponent>   OK  games wins draws losses
+ *     GAME <index>                OK  event date round white black result eco
+ *
+ * OPENING, H2H and GAME need a dataset loaded from PGN; snapshots carry
+ * players and tournaments only.
+ *
+ * Linux only: a fixed pool of threads shares one epoll instance. Each
+ * connection is registered one-shot, so exactly one thread at a time reads
+ * it, answers every complete line and writes the responses back, without
+ * handing requests between threads. A thread reads at most 256 KiB per
+ * wakeup, and a client with more than 1 MiB of unread responses is neither
+ * read from nor answered until it catches up. The dataset is swapped
+ * atomically with SetDataset(), so it can be reloaded while queries are
+ * being served.
+ */
+class StatsServer {
+public:
+    /**
+     * @brief Immutable data answered from.
+     */
+    struct Dataset {
+        std::shared_ptr<const DatabaseStats> stats;  ///< Never null
+        std::shared_ptr<const Parser> parser;        ///< Set when loaded from PGN
+    };
+
+    /**
+     * @brief Loads a dataset from a stats snapshot or, failing that, a PGN file.
+     * @param path Snapshot written by StatsSnapshot::Save(), or a PGN file.
+     * @param threadCount Loading threads; 0 selects the hardware concurrency.
+     * @return The dataset, or null if the file cannot be read.
+     */
+    static std::shared_ptr<const Dataset> LoadDataset(const std::string& path, unsigned threadCount = 0);
+
+    StatsServer();
+    ~StatsServer();
+
+    StatsServer(const StatsServer&) = delete;
+    StatsServer& operator=(const StatsServer&) = delete;
+
+    /**
+     * @brief Replaces the dataset; requests already running finish on the old one.
+     */
+    void SetDataset(std::shared_ptr<const Dataset> dataset);
+
+    /**
+     * @brief Binds the socket and starts the worker threads.
+     *
+     * A stale socket file at the path is replaced.
+     * @param socketPath Filesystem path of the socket.
+     * @param threadCount Worker threads; 0 selects the hardware concurrency.
+     * @return False if the socket cannot be set up or epoll is unavailable.
+     */
+    bool Start(const std::string& socketPath, unsigned threadCount = 0);
+
+    /**
+     * @brief Stops the workers, closes all connections and removes the socket file.
+     */
+    void Stop();
+
+    /**
+     * @brief Returns true between a successful Start() and Stop().
+     */
+    bool IsRunning() const;
+
+    /**
+     * @brief Answers one request line (without the newline) against the current dataset.
+     */
+    std::string HandleRequest(std::string_view line) const;
+
+    /**
+     * @brief Returns the number of requests answered over the socket.
+     */
+    std::uint64_t GetRequestCount() const;
+
+    /**
+     * @brief Returns the number of connections accepted.
+     */
+    std::uint64_t GetConnectionCount() const;
+
+private:
+    struct Connection;
+
+    static void Answer(const Dataset& data, std::string_view line, std::string& out);
+    void Run();
+    void Accept();
+    void Serve(Connection* connection, std::uint32_t events);
+    void Close(Connection* connection);
+
+    utils::SnapshotCell<Dataset> dataset;
+    std::string path;
+    int listenFd = -1;
+    int epollFd = -1;
+    int wakeFd = -1;
+    std::atomic<bool> stopping{false};
+    std::vector<std::thread> workers;
+    std::mutex connectionsMutex;
+    std::unordered_map<Connection*, std::unique_ptr<Connection>> connections;
+    std::atomic<std::uint64_t> requests{0};
+    std::atomic<std::uint64_t> accepted{0};
+};
+
+} // namespace chessDataLib
@@ -0,0 +1,144 @@
+#pragma once
+
+#include "databaseStats.hpp"
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace chessDataLib {
+
+/**
+ * @brief Identity of a file's contents as seen by the snapshot cache.
+ *
+ * The content hash covers the first, middle and last 64 KiB of the file plus
+ * its size, so computing it costs three small reads regardless of file size.
+ */
+struct FileIdentity {
+    std::string path;          ///< Absolute path of the file
+    std::uint64_t size = 0;    ///< Size in bytes
+    std::int64_t mtime = 0;    ///< Last write time in file-clock ticks
+    std::uint64_t hash = 0;    ///< Sampled content hash
+
+    /**
+     * @brief Computes the identity of a file on disk.
+     * @param filename Path to the file.
+     * @param out Receives the identity.
+     * @return False if the file cannot be read.
+     */
+    static bool FromFile(const std::string& filename, FileIdentity& out);
+
+    bool operator==(const FileIdentity& other) const;
+    bool operator!=(const FileIdentity& other) const;
+};
+
+/**
+ * @brief Compact binary serialization of DatabaseStats, including players and tournaments.
+ */
+class StatsSnapshot {
+public:
+    /**
+     * @brief Serializes stats and the identity of their source into a blob.
+     * @param identity Identity of the source file.
+     * @param stats Statistics to serialize.
+     * @return Binary blob.
+     */
+    static std::string Serialize(const FileIdentity& identity, const DatabaseStats& stats);
+
+    /**
+     * @brief Restores stats and source identity from a blob.
+     * @param blob Data produced by Serialize.
+     * @param identity Receives the stored identity.
+     * @param stats Receives the statistics.
+     * @return False if the blob is truncated, corrupt or of another version.
+     */
+    static bool Deserialize(const std::string& blob, FileIdentity& identity, DatabaseStats& stats);
+
+    /**
+     * @brief Writes a snapshot file atomically (temporary file + rename).
+     * @return False on I/O failure.
+     */
+    static bool Save(const std::string& filename, const FileIdentity& identity, const DatabaseStats& stats);
+
+    /**
+     * @brief Reads a snapshot file.
+     *
+     * The magic and version are checked first; other files, such as PGN
+     * databases, are rejected after reading 8 bytes.
+     * @return False if the file is missing or invalid.
+     */
+    static bool Load(const std::string& filename, FileIdentity& identity, DatabaseStats& stats);
+};
+
+/**
+ * @brief Cache of DatabaseStats snapshots keyed by file identity.
+ *
+ * Snapshots are kept in memory and persisted as one file per source in the
+ * cache directory, so they survive process restarts. A lookup only succeeds
+ * if the source's path, size, mtime and sampled content hash are unchanged.
+ * Safe to share between threads.
+ */
+class StatsSnapshotCache {
+public:
+    /**
+     * @brief Constructs a cache persisting to a directory.
+     * @param directory Cache directory; created on first store. Empty keeps the cache in memory only.
+     */
+    explicit StatsSnapshotCache(const std::string& directory = "");
+
+    /**
+     * @brief Looks up a valid snapshot for a file.
+     * @param filename Source PGN file.
+     * @param stats Receives the cached statistics on a hit.
+     * @return True on a hit.
+     */
+    bool Lookup(const std::string& filename, DatabaseStats& stats);
+
+    /**
+     * @brief Stores a snapshot for a file's current contents.
+     *
+     * Only safe when the file cannot have changed since the statistics were
+     * computed; otherwise capture the identity first and use Store(identity, stats).
+     * @param filename Source PGN file.
+     * @param stats Statistics computed from it.
+     * @return False if the file or the snapshot could not be accessed.
+     */
+    bool Store(const std::string& filename, const DatabaseStats& stats);
+
+    /**
+     * @brief Stores a snapshot under an identity captured before the statistics were computed.
+     *
+     * A file modified while it was parsed then no longer matches the stored
+     * identity, so its stale statistics are never returned.
+     * @param identity Identity of the source file, taken before parsing.
+     * @param stats Statistics computed from it.
+     * @return False if the snapshot could not be written.
+     */
+    bool Store(const FileIdentity& identity, const DatabaseStats& stats);
+
+    /**
+     * @brief Returns the number of successful lookups.
+     */
+    std::uint64_t GetHits() const;
+
+    /**
+     * @brief Returns the number of failed lookups.
+     */
+    std::uint64_t GetMisses() const;
+
+private:
+    std::string SnapshotPath(const std::string& absolutePath) const;
+
+    struct Entry {
+        FileIdentity identity;
+        DatabaseStats stats;
+    };
+
+    std::string directory;
+    mutable std::mutex mutex;
+    std::unordered_map<std::string, Entry> entries;
+    std::uint64_t hits = 0;
+    std::uint64_t misses = 0;
+};
+
+} // namespace chessDataLib
@@ -0,0 +1,205 @@
+#pragma once
+
+#include "memoryReport.hpp"
+#include "utils/flatHashMap.hpp"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace chessDataLib {
+
+/**
+ * @brief Aggregated games of one time bucket.
+ *
+ * For the whole database and for openings, wins and losses are White's and
+ * both players' ratings are summed; for a player they are the player's own
+ * results and rating.
+ */
+struct TimeBucketTotals {
+    std::uint64_t games = 0;    ///< Games in the bucket (any result)
+    std::uint64_t wins = 0;     ///< Games won
+    std::uint64_t draws = 0;    ///< Drawn games
+    std::uint64_t losses = 0;   ///< Games lost
+    std::uint64_t ratings = 0;  ///< Known ratings summed in eloSum
+    std::uint64_t eloSum = 0;   ///< Sum of known ratings
+
+    /**
+     * @brief Returns the score percentage over decided and drawn games.
+     */
+    double GetScorePercentage() const;
+
+    /**
+     * @brief Returns the average of the known ratings, 0 if none.
+     */
+    double GetAverageElo() const;
+};
+
+/**
+ * @brief Game counts, results and ratings per year or month.
+ *
+ * Buckets cover [firstYear, firstYear + years), one per year or, with
+ * monthly granularity, 13 per year: one for games whose month is unknown,
+ * then January to December. Games without a year or outside the range are
+ * only counted by GetUndatedGames().
+ *
+ * The whole database and each ECO code A00–E99 have a dense row of bucket
+ * cells, so a trend query such as the Sicilian's share per year scans a
+ * handful of contiguous rows. Players get a row covering only the buckets
+ * from their first to their last game, grown as games arrive.
+ */
+class TimeSeriesStats {
+public:
+    /**
+     * @brief Bucket width.
+     */
+    enum class Granularity { Year, Month };
+
+    static constexpr int kEcoSlots = 500;  ///< A00..E99, as in OpeningStats
+
+    /**
+     * @brief Constructs a disabled table; AddGame() only counts undated games.
+     */
+    TimeSeriesStats();
+
+    /**
+     * @brief Constructs a table with buckets for [firstYear, firstYear + years).
+     * @param firstYear First year covered.
+     * @param years Number of years covered; 0 disables the table.
+     * @param granularity One bucket per year or per month.
+     */
+    TimeSeriesStats(int firstYear, int years, Granularity granularity = Granularity::Year);
+
+    /**
+     * @brief Returns the first year covered (0 if disabled).
+     */
+    int GetFirstYear() const;
+
+    /**
+     * @brief Returns the number of years covered (0 if disabled).
+     */
+    int GetYearCount() const;
+
+    /**
+     * @brief Returns the bucket width.
+     */
+    Granularity GetGranularity() const;
+
+    /**
+     * @brief Returns the number of buckets of every series.
+     */
+    int GetBucketCount() const;
+
+    /**
+     * @brief Returns the bucket of a packed date (see utils::PackDate()).
+     * @return Bucket index, or -1 if the date has no year or is out of range.
+     */
+    int BucketOf(std::uint32_t packedDate) const;
+
+    /**
+     * @brief Returns the packed date of a bucket: its year, and its month for monthly buckets.
+     */
+    std::uint32_t BucketDate(int bucket) const;
+
+    /**
+     * @brief Adds one game.
+     * @param packedDate Date packed with utils::PackDate().
+     * @param eco ECO code; games without a valid code only count for the whole database.
+     * @param white White player's name.
+     * @param black Black player's name.
+     * @param result Result string ("1-0", "0-1", "1/2-1/2", "*").
+     * @param whiteElo White rating, 0 if unknown.
+     * @param blackElo Black rating, 0 if unknown.
+     */
+    void AddGame(std::uint32_t packedDate, const std::string& eco, const std::string& white,
+                 const std::string& black, const std::string& result, int whiteElo, int blackElo);
+
+    /**
+     * @brief Adds the counters of a table with the same buckets.
+     * @return False if the buckets differ.
+     */
+    bool MergeWith(const TimeSeriesStats& other);
+
+    /**
+     * @brief Folds the series of aliases into those of their canonical names.
+     * @param aliases Alias to canonical name; names not in the map are kept.
+     */
+    void MergeAliases(const utils::StringMap<std::string>& aliases);
+
+    /**
+     * @brief Returns the series of the whole database, one entry per bucket.
+     */
+    std::vector<TimeBucketTotals> GetSeries() const;
+
+    /**
+     * @brief Returns the summed series of a range of ECO codes (inclusive).
+     * @return One entry per bucket; all zero if a code is invalid.
+     */
+    std::vector<TimeBucketTotals> GetOpeningSeries(const std::string& ecoFirst, const std::string& ecoLast) const;
+
+    /**
+     * @brief Returns the percentage of each bucket's games played in a range of ECO codes.
+     */
+    std::vector<double> GetOpeningShare(const std::string& ecoFirst, const std::string& ecoLast) const;
+
+    /**
+     * @brief Returns a player's series; all zero for unknown players.
+     */
+    std::vector<TimeBucketTotals> GetPlayerSeries(const std::string& player) const;
+
+    /**
+     * @brief Folds a monthly series into one entry per year; yearly series are returned as is.
+     */
+    std::vector<TimeBucketTotals> ToYears(const std::vector<TimeBucketTotals>& series) const;
+
+    /**
+     * @brief Returns the number of games without a year or outside the range.
+     */
+    std::uint64_t GetUndatedGames() const;
+
+    /**
+     * @brief Returns the number of players with a series.
+     */
+    std::size_t GetPlayerCount() const;
+
+    /**
+     * @brief Returns the heap memory of the dense rows and player series.
+     */
+    MemoryUsage GetMemoryUsage() const;
+
+private:
+    // Counters of one bucket; 32 bytes
+    struct Cell {
+        std::uint32_t games = 0;
+        std::uint32_t wins = 0;
+        std::uint32_t draws = 0;
+        std::uint32_t losses = 0;
+        std::uint32_t ratings = 0;
+        std::uint64_t eloSum = 0;
+
+        void Add(int points, int elo);
+        void Add(const Cell& other);
+    };
+
+    // A player's cells for buckets [first, first + cells.size())
+    struct PlayerSeries {
+        int first = 0;
+        std::vector<Cell> cells;
+
+        Cell& At(int bucket);
+    };
+
+    static void Accumulate(const Cell* row, int buckets, std::vector<TimeBucketTotals>& out);
+    void AddPlayerSeries(const std::string& name, const PlayerSeries& theirs);
+
+    int firstYear = 0;
+    int years = 0;
+    Granularity granularity = Granularity::Year;
+    int buckets = 0;
+    std::uint64_t undatedGames = 0;
+
+    std::vector<Cell> table;  ///< Row 0: whole database; row 1 + slot: ECO slot; buckets cells per row
+    utils::StringMap<std::uint32_t> playerIds;
+    std::vector<PlayerSeries> players;
+};
+
+} // namespace chessDataLib
@@ -1,15 +1,92 @@
 #pragma once
 
+#include "memoryReport.hpp"
+#include "utils/flatHashMap.hpp"
+#include <cstdint>
 #include <string>
 #include <vector>
-#include <unordered_map>
 
 namespace chessDataLib {
 
+/**
+ * @brief One game of a tournament, with players as indices into Tournament::GetPlayers().
+ */
+struct TournamentGame {
+    static constexpr std::uint8_t kUnfinished = 255;  ///< whitePoints of a game without a decisive or drawn result
+
+    std::uint32_t white = 0;
+    std::uint32_t black = 0;
+    std::uint16_t round = 0;                ///< Leading number of the Round tag; 0 if missing
+    std::uint8_t whitePoints = kUnfinished; ///< White's score in half points: 2, 1 or 0
+};
+
+/**
+ * @brief A player's line in the standings of a tournament.
+ *
+ * Tie-breaks count finished games only:
+ *  - Buchholz: sum of the opponents' scores;
+ *  - Sonneborn-Berger: sum of the scores of beaten opponents plus half the
+ *    scores of drawn opponents;
+ *  - Median Buchholz: Buchholz without the highest and lowest opponent
+ *    score, for players with at least three games (Buchholz otherwise).
+ */
+struct TournamentStanding {
+    std::uint32_t player = 0;  ///< Index into Tournament::GetPlayers()
+    std::string name;
+    int rank = 0;  ///< 1-based; players equal on score and all tie-breaks share a rank
+    int games = 0;
+    int wins = 0;
+    int draws = 0;
+    int losses = 0;
+    double score = 0.0;
+    double buchholz = 0.0;
+    double sonnebornBerger = 0.0;
+    double medianBuchholz = 0.0;
+};
+
+/**
+ * @brief Standings with each player's game per round.
+ *
+ * Columns are the round numbers when every game has one and no player
+ * plays twice in a round; otherwise they number each player's games in
+ * file order.
+ */
+struct Crosstable {
+    /**
+     * @brief One player's game in one column.
+     */
+    struct Cell {
+        int opponent = -1;  ///< Row of the opponent; -1 if no game
+        bool white = false;
+        std::uint8_t points = TournamentGame::kUnfinished;  ///< Half points scored
+    };
+
+    std::vector<TournamentStanding> rows;  ///< In standings order
+    std::vector<int> columns;              ///< Round numbers, or 1..n for game sequences
+    bool byRound = true;
+    std::vector<Cell> cells;               ///< rows.size() x columns.size(), row-major
+
+    /**
+     * @brief Returns the cell of a row and column.
+     */
+    const Cell& At(std::size_t row, std::size_t column) const;
+
+    /**
+     * @brief Formats the table as text, one line per row.
+     *
+     * Cells read as opponent rank, colour and result, e.g. "3w1", "12b=", "7b0";
+     * unfinished games show '*' as result.
+     */
+    std::string ToString() const;
+};
+
 /**
  * @brief Represents a chess tournament with player participation statistics.
  * 
  * Tracks tournament name, total games, unique players, and per-player game counts.
+ * Games recorded with RecordGame() are also kept in a compact array
+ * (12 bytes per game), from which standings, tie-breaks and crosstables are
+ * computed without going back to the PGN.
  */
 class Tournament {
 private:
@@ -18,7 +95,12 @@ private:
     int uniquePlayers = 0;  ///< Number of distinct players
 
     std::vector<std::string> players;  ///< List of unique player names
-    std::unordered_map<std::string, int> playerGameCount;  ///< Games played per player
+    utils::StringMap<int> playerGameCount;  ///< Games played per player
+    utils::StringMap<std::uint32_t> playerIndex;  ///< Index of each player in players
+    std::vector<TournamentGame> games;  ///< Recorded games in file order
+
+    std::uint32_t IndexPlayer(const std::string& player);
+    void AppendFrom(const Tournament& other, const utils::StringMap<std::string>* aliases);
 
 public:
     // === Constructors ===
@@ -62,9 +144,15 @@ public:
 
     /**
      * @brief Returns the map of player names to game counts.
-     * @return Reference to the unordered map.
+     * @return Reference to the map.
+     */
+    const utils::StringMap<int>& GetPlayerGameCount() const;
+
+    /**
+     * @brief Returns the games recorded with RecordGame(), in file order.
+     * @return Reference to the game array.
      */
-    const std::unordered_map<std::string, int>& GetPlayerGameCount() const;
+    const std::vector<TournamentGame>& GetGames() const;
 
     // === Setters ===
 
@@ -94,16 +182,22 @@ public:
 
     /**
      * @brief Sets the map of player game counts.
-     * @param val New unordered map of player game counts.
+     * @param val New map of player game counts.
      */
-    void SetPlayerGameCount(const std::unordered_map<std::string, int>& val);
+    void SetPlayerGameCount(const utils::StringMap<int>& val);
+
+    /**
+     * @brief Sets the recorded games; player indices refer to GetPlayers().
+     * @param val New vector of games.
+     */
+    void SetGames(const std::vector<TournamentGame>& val);
 
     // === Helpers ===
 
     /**
      * @brief Adds a player to the tournament and updates statistics.
      * 
-     * Increments total game count. If the player is new, adds to list and increments unique count.
+     * Increments the player's game count. If the player is new, adds to list and increments unique count.
      * @param player Name of the player.
      */
     void AddPlayer(const std::string& player);
@@ -114,6 +208,63 @@ public:
      * Increments the totalGames counter by one.
      */
     void AddGame();
+
+    /**
+     * @brief Counts a game and its players, and records it for standings.
+     * @param white White player's name.
+     * @param black Black player's name.
+     * @param round Round tag; its leading number is kept ("3.1" is round 3).
+     * @param result Result tag; anything but "1-0", "0-1" and "1/2-1/2" is unfinished.
+     */
+    void RecordGame(const std::string& white, const std::string& black,
+                    const std::string& round, const std::string& result);
+
+    /**
+     * @brief Merges games and player participation from another tournament into this one.
+     * @param other The tournament whose data will be merged.
+     */
+    void MergeWith(const Tournament& other);
+
+    /**
+     * @brief Renames aliases to their canonical names in players, counts and games.
+     *
+     * Standings then list each canonical player once; a game between an
+     * alias and its own canonical name stays recorded.
+     * @param aliases Alias to canonical name; names not in the map are kept.
+     */
+    void MergeAliases(const utils::StringMap<std::string>& aliases);
+
+    // === Standings ===
+
+    /**
+     * @brief Computes the standings from the recorded games.
+     *
+     * Two passes over the game array: scores first, then tie-breaks from
+     * the opponents' scores. Sorted by score, Buchholz, Sonneborn-Berger,
+     * Median Buchholz and name.
+     * @return One line per player, including players without finished games.
+     */
+    std::vector<TournamentStanding> ComputeStandings() const;
+
+    /**
+     * @brief Returns the recorded games of one round, in file order.
+     * @param round Round number; 0 selects games without a round.
+     */
+    std::vector<TournamentGame> GetPairings(int round) const;
+
+    /**
+     * @brief Builds the crosstable of the recorded games.
+     */
+    Crosstable BuildCrosstable() const;
+
+    // === Memory accounting ===
+
+    /**
+     * @brief Returns the heap memory owned by the name, player list, player maps and games.
+     *
+     * The tournament's own footprint is accounted by the container holding it.
+     */
+    MemoryUsage GetMemoryUsage() const;
 };
 
 } // namespace chessDataLib
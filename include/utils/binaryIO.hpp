@@ -0,0 +1,141 @@
+#pragma once
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+namespace chessDataLib::utils {
+
+// Appends little-endian fixed-width and LEB128 varint values to a byte string
+class BinaryWriter {
+public:
+    void U8(std::uint8_t v) { out.push_back(static_cast<char>(v)); }
+
+    void U32(std::uint32_t v) {
+        for (int i = 0; i < 4; ++i) U8(static_cast<std::uint8_t>(v >> (8 * i)));
+    }
+
+    void U64(std::uint64_t v) {
+        for (int i = 0; i < 8; ++i) U8(static_cast<std::uint8_t>(v >> (8 * i)));
+    }
+
+    void F64(double v) {
+        std::uint64_t bits;
+        std::memcpy(&bits, &v, sizeof bits);
+        U64(bits);
+    }
+
+    void VarU(std::uint64_t v) {
+        while (v >= 0x80) {
+            U8(static_cast<std::uint8_t>(v | 0x80));
+            v >>= 7;
+        }
+        U8(static_cast<std::uint8_t>(v));
+    }
+
+    // zig-zag so that small negative values stay short
+    void VarI(std::int64_t v) { VarU((static_cast<std::uint64_t>(v) << 1) ^ static_cast<std::uint64_t>(v >> 63)); }
+
+    void Str(const std::string& s) {
+        VarU(s.size());
+        out.append(s);
+    }
+
+    void Raw(const void* data, std::size_t size) { out.append(static_cast<const char*>(data), size); }
+
+    std::string& Data() { return out; }
+
+private:
+    std::string out;
+};
+
+// Reads values written by BinaryWriter; every call fails (returns false)
+// once the input is exhausted, so callers can check once at the end
+class BinaryReader {
+public:
+    BinaryReader(const char* data, std::size_t size) : p(data), end(data + size) {}
+
+    bool U8(std::uint8_t& v) {
+        if (p >= end) return ok = false;
+        v = static_cast<std::uint8_t>(*p++);
+        return true;
+    }
+
+    bool U32(std::uint32_t& v) {
+        std::uint64_t wide = 0;
+        if (!Fixed(wide, 4)) return false;
+        v = static_cast<std::uint32_t>(wide);
+        return true;
+    }
+
+    bool U64(std::uint64_t& v) { return Fixed(v, 8); }
+
+    bool F64(double& v) {
+        std::uint64_t bits = 0;
+        if (!U64(bits)) return false;
+        std::memcpy(&v, &bits, sizeof v);
+        return true;
+    }
+
+    bool VarU(std::uint64_t& v) {
+        v = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            std::uint8_t b;
+            if (!U8(b)) return false;
+            v |= static_cast<std::uint64_t>(b & 0x7f) << shift;
+            if (!(b & 0x80)) return true;
+        }
+        return ok = false;
+    }
+
+    bool VarI(std::int64_t& v) {
+        std::uint64_t u = 0;
+        if (!VarU(u)) return false;
+        v = static_cast<std::int64_t>((u >> 1) ^ (~(u & 1) + 1));
+        return true;
+    }
+
+    bool Str(std::string& s) {
+        std::uint64_t len = 0;
+        if (!VarU(len) || len > static_cast<std::uint64_t>(end - p)) return ok = false;
+        s.assign(p, static_cast<std::size_t>(len));
+        p += len;
+        return true;
+    }
+
+    bool Raw(void* data, std::size_t size) {
+        if (size > static_cast<std::size_t>(end - p)) return ok = false;
+        std::memcpy(data, p, size);
+        p += size;
+        return true;
+    }
+
+    bool Ok() const { return ok; }
+    bool AtEnd() const { return p == end; }
+    std::size_t Remaining() const { return static_cast<std::size_t>(end - p); }
+
+private:
+    bool Fixed(std::uint64_t& v, int bytes) {
+        if (end - p < bytes) return ok = false;
+        v = 0;
+        for (int i = 0; i < bytes; ++i) v |= static_cast<std::uint64_t>(static_cast<std::uint8_t>(p[i])) << (8 * i);
+        p += bytes;
+        return true;
+    }
+
+    const char* p;
+    const char* end;
+    bool ok = true;
+};
+
+// 64-bit FNV-1a, continuing from seed
+inline std::uint64_t Fnv1a64(const void* data, std::size_t size, std::uint64_t seed = 14695981039346656037ull) {
+    const auto* b = static_cast<const unsigned char*>(data);
+    std::uint64_t h = seed;
+    for (std::size_t i = 0; i < size; ++i) {
+        h ^= b[i];
+        h *= 1099511628211ull;
+    }
+    return h;
+}
+
+} // namespace chessDataLib::utils
@@ -0,0 +1,39 @@
+#pragma once
+#include <cstdint>
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+namespace chessDataLib::utils {
+
+// Index of the lowest set bit of x; x must not be zero.
+// Uses the compiler intrinsic where there is one, a shift loop elsewhere.
+inline int CountTrailingZeros(std::uint32_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctz(x);
+#elif defined(_MSC_VER)
+    unsigned long i;
+    _BitScanForward(&i, x);
+    return static_cast<int>(i);
+#else
+    int n = 0;
+    for (; !(x & 1u); x >>= 1) ++n;
+    return n;
+#endif
+}
+
+inline int CountTrailingZeros(std::uint64_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(x);
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_ARM64))
+    unsigned long i;
+    _BitScanForward64(&i, x);
+    return static_cast<int>(i);
+#else
+    const std::uint32_t low = static_cast<std::uint32_t>(x);
+    return low ? CountTrailingZeros(low) : 32 + CountTrailingZeros(static_cast<std::uint32_t>(x >> 32));
+#endif
+}
+
+} // namespace chessDataLib::utils
@@ -0,0 +1,42 @@
+#pragma once
+#include "utils/scan.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace chessDataLib::utils {
+
+// A byte range of one input file, starting at a game start
+struct ChunkTask {
+    std::size_t file = 0;    // index of the file in the planned inputs
+    std::uint64_t begin = 0;
+    std::uint64_t end = 0;
+};
+
+// Cuts mapped inputs into tasks of about chunkSize bytes, each starting at a
+// game start (or the start of its file), in file order. Sources are pointers
+// to objects with Data() and Size(), e.g. SourceMapping; null entries (files
+// that failed to open) and empty files get no task.
+template <typename SourcePtr>
+std::vector<ChunkTask> PlanChunks(const std::vector<SourcePtr>& sources, std::uint64_t chunkSize) {
+    std::vector<ChunkTask> tasks;
+    for (std::size_t f = 0; f < sources.size(); ++f) {
+        if (!sources[f]) continue;
+        const char* data = sources[f]->Data();
+        const std::uint64_t size = sources[f]->Size();
+        const std::uint64_t chunks = std::max<std::uint64_t>(1, size / std::max<std::uint64_t>(1, chunkSize));
+        std::uint64_t begin = 0;
+        for (std::uint64_t k = 1; k < chunks; ++k) {
+            const std::uint64_t cut =
+                static_cast<std::uint64_t>(FindGameStart(data, data + size / chunks * k, data + size) - data);
+            if (cut <= begin) continue;
+            tasks.push_back({f, begin, cut});
+            begin = cut;
+        }
+        if (begin < size) tasks.push_back({f, begin, size});
+    }
+    return tasks;
+}
+
+} // namespace chessDataLib::utils
@@ -0,0 +1,25 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace chessDataLib::utils {
+
+// Dates packed into 32 bits as (year << 9) | (month << 5) | day, so packed
+// dates compare like the dates they encode. A zero field is unknown:
+// "1990.??.??" packs with month and day 0, and a date without a year packs
+// to 0. A day is only kept when the month is known.
+std::uint32_t PackDate(int year, int month, int day);
+
+// Parse a PGN date ("YYYY.MM.DD", '?' for unknown digits; '-' and '/' are
+// also accepted as separators). Out-of-range months and days are unknown.
+std::uint32_t PackDate(std::string_view date);
+
+inline int DateYear(std::uint32_t packed) { return static_cast<int>(packed >> 9); }
+inline int DateMonth(std::uint32_t packed) { return static_cast<int>((packed >> 5) & 15); }
+inline int DateDay(std::uint32_t packed) { return static_cast<int>(packed & 31); }
+
+// PGN form of a packed date, e.g. "1990.03.??"; "????.??.??" for 0
+std::string FormatDate(std::uint32_t packed);
+
+} // namespace chessDataLib::utils
@@ -0,0 +1,35 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace chessDataLib::utils {
+
+// Levenshtein distance between a and b (byte-wise; unit cost insert, delete
+// and substitute). Returns limit + 1 as soon as the distance is known to
+// exceed limit.
+int EditDistance(std::string_view a, std::string_view b, int limit = 1 << 30);
+
+// Levenshtein distance from one fixed pattern to many texts.
+//
+// Patterns of up to 64 bytes use the bit-parallel algorithm of Myers (1999)
+// in Hyyro's formulation for global distance: the pattern's positions of
+// each byte value are precomputed as bitmasks, and a whole column of the DP
+// matrix is then advanced per text byte with a handful of 64-bit word
+// operations. Longer patterns fall back to a banded DP.
+class EditDistanceMatcher {
+public:
+    explicit EditDistanceMatcher(std::string_view pattern);
+
+    // Distance from the pattern to text, or limit + 1 if it exceeds limit
+    int Distance(std::string_view text, int limit) const;
+
+    const std::string& GetPattern() const { return pattern; }
+
+private:
+    std::string pattern;
+    std::array<std::uint64_t, 256> peq{};  // bit i of peq[c]: pattern[i] == c
+};
+
+} // namespace chessDataLib::utils
@@ -0,0 +1,55 @@
+#pragma once
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace chessDataLib::utils {
+
+// Sorts byte-string records in std::string order within a memory budget.
+// Records are buffered until their heap footprint reaches the budget; the
+// buffer is then sorted in parallel (chunks sorted on a WorkStealingPool,
+// then merged pairwise) and spilled to a run file. Finish() streams the
+// records out in order: straight from the buffer when nothing was spilled,
+// otherwise through a k-way merge of the runs, in several passes when there
+// are more runs than can be merged at once. Callers encode their sort key
+// as an order-preserving byte prefix of each record.
+class ExternalSorter {
+public:
+    // tempDirectory: where runs are spilled; empty selects the system
+    // temporary directory. threadCount == 0 selects the hardware concurrency.
+    ExternalSorter(std::size_t memoryBudget, std::string tempDirectory = std::string(), unsigned threadCount = 0);
+    ~ExternalSorter();  // removes the run files
+
+    ExternalSorter(const ExternalSorter&) = delete;
+    ExternalSorter& operator=(const ExternalSorter&) = delete;
+
+    // Returns false once a spill has failed
+    bool Add(std::string record);
+
+    // Calls emit(record) for every record in order; emit returns false to
+    // stop. Returns false on I/O failure, including a run file cut short,
+    // or if emit stopped.
+    bool Finish(const std::function<bool(const std::string&)>& emit);
+
+    // Number of runs spilled so far
+    std::size_t GetRunCount() const { return spilled; }
+
+private:
+    void SortBuffer();
+    bool Spill();
+    bool Merge(const std::vector<std::string>& inputs, const std::function<bool(const std::string&)>& emit);
+    std::string NewRunPath();
+
+    std::size_t budget;
+    std::string directory;
+    unsigned threads;
+    std::vector<std::string> buffer;
+    std::size_t bufferBytes = 0;
+    std::vector<std::string> runs;  // paths of runs not yet merged
+    std::vector<std::string> files; // every run file created, for cleanup
+    std::size_t spilled = 0;
+    bool failed = false;
+};
+
+} // namespace chessDataLib::utils
@@ -0,0 +1,167 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace chessDataLib::utils {
+
+// Minimal FlatBuffers serializer, enough to emit schema-defined metadata
+// (e.g. Arrow IPC messages) without the flatc toolchain.
+//
+// Objects are laid out front to back: a table is written with placeholder
+// offsets, then its children are written after it and the placeholders are
+// patched, so every uoffset points forward as the format requires. Each
+// table's vtable is written just before it. Positions are relative to the
+// start of the buffer, which the caller must place at an 8-byte boundary.
+class FlatBufferBuilder {
+public:
+    // Writes one object and returns its position
+    using Writer = std::function<std::uint32_t(FlatBufferBuilder&)>;
+
+    // Fields of a table, by field id (declaration order in the schema)
+    class Table {
+    public:
+        Table& Bool(std::uint16_t id, bool v) { return Scalar(id, v ? 1 : 0, 1); }
+        Table& U8(std::uint16_t id, std::uint8_t v) { return Scalar(id, v, 1); }
+        Table& I16(std::uint16_t id, std::int16_t v) { return Scalar(id, static_cast<std::uint16_t>(v), 2); }
+        Table& I32(std::uint16_t id, std::int32_t v) { return Scalar(id, static_cast<std::uint32_t>(v), 4); }
+        Table& I64(std::uint16_t id, std::int64_t v) { return Scalar(id, static_cast<std::uint64_t>(v), 8); }
+
+        // Field holding an offset to a child object (table, vector or string)
+        Table& Offset(std::uint16_t id, Writer child) {
+            fields.push_back({id, 4, 0, std::move(child)});
+            return *this;
+        }
+
+    private:
+        friend class FlatBufferBuilder;
+
+        struct Field {
+            std::uint16_t id;
+            std::uint8_t size;
+            std::uint64_t value;
+            Writer child;
+        };
+
+        Table& Scalar(std::uint16_t id, std::uint64_t value, std::uint8_t size) {
+            fields.push_back({id, size, value, nullptr});
+            return *this;
+        }
+
+        std::vector<Field> fields;
+    };
+
+    // Writes a table and its children
+    std::uint32_t WriteTable(const Table& table) {
+        // Inline layout: soffset to the vtable, then fields by decreasing size
+        std::vector<const Table::Field*> order;
+        std::uint16_t fieldSlots = 0;
+        for (const auto& f : table.fields) {
+            order.push_back(&f);
+            fieldSlots = std::max<std::uint16_t>(fieldSlots, static_cast<std::uint16_t>(f.id + 1));
+        }
+        std::stable_sort(order.begin(), order.end(), [](const Table::Field* a, const Table::Field* b) {
+            return a->size > b->size;
+        });
+        std::vector<std::uint16_t> fieldOffsets(fieldSlots, 0);
+        std::uint32_t inlineSize = 4;
+        for (const auto* f : order) {
+            inlineSize = Align(inlineSize, f->size);
+            fieldOffsets[f->id] = static_cast<std::uint16_t>(inlineSize);
+            inlineSize += f->size;
+        }
+        inlineSize = Align(inlineSize, 4);
+
+        // vtable, then the table at an 8-byte boundary
+        Pad(2);
+        const std::uint32_t vtable = Size();
+        Put16(static_cast<std::uint16_t>(4 + 2 * fieldSlots));
+        Put16(static_cast<std::uint16_t>(inlineSize));
+        for (std::uint16_t off : fieldOffsets) Put16(off);
+        Pad(8);
+        const std::uint32_t start = Size();
+        buf.resize(buf.size() + inlineSize, 0);
+        Patch32(start, start - vtable);
+        for (const auto* f : order) {
+            if (!f->child) std::memcpy(&buf[start + fieldOffsets[f->id]], &f->value, f->size);  // little-endian host
+        }
+
+        for (const auto* f : order) {
+            if (f->child) PatchOffset(start + fieldOffsets[f->id], f->child(*this));
+        }
+        return start;
+    }
+
+    std::uint32_t WriteString(const std::string& s) {
+        Pad(4);
+        const std::uint32_t start = Size();
+        Put32(static_cast<std::uint32_t>(s.size()));
+        buf.insert(buf.end(), s.begin(), s.end());
+        buf.push_back(0);
+        return start;
+    }
+
+    // Vector of tables, vectors or strings
+    std::uint32_t WriteOffsetVector(const std::vector<Writer>& children) {
+        Pad(4);
+        const std::uint32_t start = Size();
+        Put32(static_cast<std::uint32_t>(children.size()));
+        buf.resize(buf.size() + 4 * children.size(), 0);
+        for (std::size_t i = 0; i < children.size(); ++i) {
+            PatchOffset(start + 4 + 4 * static_cast<std::uint32_t>(i), children[i](*this));
+        }
+        return start;
+    }
+
+    // Vector of structs or scalars, copied as raw little-endian bytes
+    std::uint32_t WriteRawVector(const void* data, std::size_t count, std::size_t elementSize, std::size_t align) {
+        // The length prefix sits right before the aligned elements
+        while ((Size() + 4) % std::max<std::size_t>(align, 4) != 0) buf.push_back(0);
+        const std::uint32_t start = Size();
+        Put32(static_cast<std::uint32_t>(count));
+        const auto* bytes = static_cast<const std::uint8_t*>(data);
+        buf.insert(buf.end(), bytes, bytes + count * elementSize);
+        return start;
+    }
+
+    // Writes the root offset followed by the root object; returns the finished buffer
+    std::vector<std::uint8_t> Finish(const Writer& root) {
+        buf.clear();
+        Put32(0);
+        PatchOffset(0, root(*this));
+        Pad(8);
+        return std::move(buf);
+    }
+
+private:
+    static std::uint32_t Align(std::uint32_t v, std::uint32_t a) { return (v + a - 1) / a * a; }
+
+    std::uint32_t Size() const { return static_cast<std::uint32_t>(buf.size()); }
+
+    void Pad(std::size_t a) {
+        while (buf.size() % a != 0) buf.push_back(0);
+    }
+
+    void Put16(std::uint16_t v) {
+        buf.push_back(static_cast<std::uint8_t>(v));
+        buf.push_back(static_cast<std::uint8_t>(v >> 8));
+    }
+
+    void Put32(std::uint32_t v) {
+        for (int i = 0; i < 4; ++i) buf.push_back(static_cast<std::uint8_t>(v >> (8 * i)));
+    }
+
+    void Patch32(std::uint32_t at, std::uint32_t v) {
+        for (int i = 0; i < 4; ++i) buf[at + i] = static_cast<std::uint8_t>(v >> (8 * i));
+    }
+
+    // uoffsets are relative to their own position and always point forward
+    void PatchOffset(std::uint32_t at, std::uint32_t target) { Patch32(at, target - at); }
+
+    std::vector<std::uint8_t> buf;
+};
+
+} // namespace chessDataLib::utils
@@ -0,0 +1,355 @@
+#pragma once
+#include "utils/bits.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace chessDataLib::utils {
+
+// Transparent string hash/equality: lets string-keyed maps be probed with a
+// std::string_view or const char* without building a std::string
+struct StringHash {
+    using is_transparent = void;
+    std::size_t operator()(std::string_view s) const noexcept { return std::hash<std::string_view>()(s); }
+};
+
+struct StringEqual {
+    using is_transparent = void;
+    bool operator()(std::string_view a, std::string_view b) const noexcept { return a == b; }
+};
+
+// Open-addressing hash map in the style of a Swiss table.
+//
+// Entries live in one flat slot array next to an array of control bytes, one
+// per slot: empty, deleted, or the low 7 bits of the entry's hash. A lookup
+// hashes once, then compares a whole group of 16 control bytes against those
+// 7 bits with one SSE2 compare (a scalar loop elsewhere), touching slots only
+// for candidate matches. Groups are probed triangularly until one with an
+// empty byte is found. The table grows at a load factor of 7/8.
+//
+// Differences from std::unordered_map: elements are std::pair<K, V> (keys
+// must not be modified through iterators), and any insertion may move
+// elements, invalidating references and iterators.
+template <typename K, typename V, typename Hash = std::hash<K>, typename Equal = std::equal_to<K>>
+class FlatHashMap {
+public:
+    using key_type = K;
+    using mapped_type = V;
+    using value_type = std::pair<K, V>;
+    using size_type = std::size_t;
+
+    static constexpr std::size_t kGroupWidth = 16;
+
+    template <bool Const>
+    class Iterator {
+    public:
+        using Map = std::conditional_t<Const, const FlatHashMap, FlatHashMap>;
+        using reference = std::conditional_t<Const, const value_type&, value_type&>;
+        using pointer = std::conditional_t<Const, const value_type*, value_type*>;
+
+        Iterator() = default;
+        Iterator(Map* m, std::size_t i) : map(m), index(i) { SkipFree(); }
+        template <bool C, typename = std::enable_if_t<Const && !C>>
+        Iterator(const Iterator<C>& o) : map(o.map), index(o.index) {}
+
+        reference operator*() const { return map->slots[index]; }
+        pointer operator->() const { return &map->slots[index]; }
+        Iterator& operator++() {
+            ++index;
+            SkipFree();
+            return *this;
+        }
+        bool operator==(const Iterator& o) const { return index == o.index; }
+        bool operator!=(const Iterator& o) const { return index != o.index; }
+
+    private:
+        friend class FlatHashMap;
+        friend class Iterator<!Const>;
+        void SkipFree() {
+            while (index < map->slotCount && map->ctrl[index] < 0) ++index;
+        }
+        Map* map = nullptr;
+        std::size_t index = 0;
+    };
+
+    using iterator = Iterator<false>;
+    using const_iterator = Iterator<true>;
+
+    FlatHashMap() = default;
+
+    FlatHashMap(const FlatHashMap& other) {
+        Reserve(other.live);
+        for (const auto& kv : other) InsertNew(Hashed(kv.first), kv.first, kv.second);
+    }
+
+    FlatHashMap(FlatHashMap&& other) noexcept { Swap(other); }
+
+    FlatHashMap& operator=(const FlatHashMap& other) {
+        if (this != &other) {
+            FlatHashMap copy(other);
+            Swap(copy);
+        }
+        return *this;
+    }
+
+    FlatHashMap& operator=(FlatHashMap&& other) noexcept {
+        if (this != &other) {
+            FlatHashMap moved(std::move(other));
+            Swap(moved);
+        }
+        return *this;
+    }
+
+    ~FlatHashMap() { Release(); }
+
+    // === Capacity ===
+
+    std::size_t size() const { return live; }
+    bool empty() const { return live == 0; }
+    std::size_t capacity() const { return slotCount; }
+    void reserve(std::size_t n) { Reserve(n); }
+
+    void clear() {
+        DestroyAll();
+        if (slotCount) std::memset(ctrl, kEmpty, slotCount);
+        live = 0;
+        deleted = 0;
+    }
+
+    void swap(FlatHashMap& other) noexcept { Swap(other); }
+
+    // === Iteration ===
+
+    iterator begin() { return iterator(this, 0); }
+    iterator end() { return iterator(this, slotCount); }
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, slotCount); }
+
+    // === Lookup (heterogeneous when Hash and Equal accept Key) ===
+
+    template <typename Key>
+    iterator find(const Key& key) {
+        return iterator(this, FindIndex(key, Hashed(key)));
+    }
+
+    template <typename Key>
+    const_iterator find(const Key& key) const {
+        return const_iterator(this, FindIndex(key, Hashed(key)));
+    }
+
+    template <typename Key>
+    bool contains(const Key& key) const {
+        return FindIndex(key, Hashed(key)) != slotCount;
+    }
+
+    template <typename Key>
+    std::size_t count(const Key& key) const {
+        return contains(key) ? 1 : 0;
+    }
+
+    template <typename Key>
+    V& at(const Key& key) {
+        const std::size_t i = FindIndex(key, Hashed(key));
+        if (i == slotCount) throw std::out_of_range("FlatHashMap::at");
+        return slots[i].second;
+    }
+
+    template <typename Key>
+    const V& at(const Key& key) const {
+        const std::size_t i = FindIndex(key, Hashed(key));
+        if (i == slotCount) throw std::out_of_range("FlatHashMap::at");
+        return slots[i].second;
+    }
+
+    // === Modifiers ===
+
+    // Inserts (key, V(args...)) unless the key is present; the key is only
+    // converted to K when an entry is created
+    template <typename Key, typename... Args>
+    std::pair<iterator, bool> try_emplace(Key&& key, Args&&... args) {
+        const std::size_t hash = Hashed(key);
+        const std::size_t found = FindIndex(key, hash);
+        if (found != slotCount) return {iterator(this, found), false};
+        const std::size_t i = InsertNew(hash, std::forward<Key>(key), std::forward<Args>(args)...);
+        return {iterator(this, i), true};
+    }
+
+    template <typename Key, typename... Args>
+    std::pair<iterator, bool> emplace(Key&& key, Args&&... args) {
+        return try_emplace(std::forward<Key>(key), std::forward<Args>(args)...);
+    }
+
+    std::pair<iterator, bool> insert(const value_type& kv) { return try_emplace(kv.first, kv.second); }
+
+    template <typename Key>
+    V& operator[](Key&& key) {
+        return try_emplace(std::forward<Key>(key)).first->second;
+    }
+
+    template <typename Key>
+    std::size_t erase(const Key& key) {
+        const std::size_t i = FindIndex(key, Hashed(key));
+        if (i == slotCount) return 0;
+        slots[i].~value_type();
+        ctrl[i] = kDeleted;
+        --live;
+        ++deleted;
+        return 1;
+    }
+
+private:
+    static constexpr std::int8_t kEmpty = -128;   // 0b10000000
+    static constexpr std::int8_t kDeleted = -2;   // 0b11111110
+    static constexpr std::size_t kMinCapacity = kGroupWidth;
+
+    template <typename Key>
+    std::size_t Hashed(const Key& key) const {
+        // Hash functions such as std::hash<integer> are not avalanching; mix once
+        std::uint64_t h = static_cast<std::uint64_t>(Hash()(key));
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccdull;
+        h ^= h >> 33;
+        return static_cast<std::size_t>(h);
+    }
+
+    static std::int8_t H2(std::size_t hash) { return static_cast<std::int8_t>(hash & 0x7f); }
+
+    // Bitmask of the bytes of a group equal to b
+    static std::uint32_t Match(const std::int8_t* group, std::int8_t b) {
+#if defined(__SSE2__)
+        const __m128i g = _mm_loadu_si128(reinterpret_cast<const __m128i*>(group));
+        return static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(g, _mm_set1_epi8(b))));
+#else
+        std::uint32_t mask = 0;
+        for (std::size_t i = 0; i < kGroupWidth; ++i) mask |= static_cast<std::uint32_t>(group[i] == b) << i;
+        return mask;
+#endif
+    }
+
+    // Bitmask of the empty or deleted bytes of a group (sign bit set)
+    static std::uint32_t MatchFree(const std::int8_t* group) {
+#if defined(__SSE2__)
+        return static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(group))));
+#else
+        std::uint32_t mask = 0;
+        for (std::size_t i = 0; i < kGroupWidth; ++i) mask |= static_cast<std::uint32_t>(group[i] < 0) << i;
+        return mask;
+#endif
+    }
+
+    template <typename Key>
+    std::size_t FindIndex(const Key& key, std::size_t hash) const {
+        if (slotCount == 0) return slotCount;
+        const std::size_t groupMask = slotCount / kGroupWidth - 1;
+        std::size_t group = (hash >> 7) & groupMask;
+        const std::int8_t h2 = H2(hash);
+        for (std::size_t step = 1;; ++step) {
+            const std::int8_t* g = ctrl + group * kGroupWidth;
+            for (std::uint32_t m = Match(g, h2); m; m &= m - 1) {
+                const std::size_t i = group * kGroupWidth + static_cast<std::size_t>(CountTrailingZeros(m));
+                if (Equal()(slots[i].first, key)) return i;
+            }
+            if (Match(g, kEmpty)) return slotCount;
+            if (step > groupMask) return slotCount;  // every group visited
+            group = (group + step) & groupMask;
+        }
+    }
+
+    // Places a new entry for a key known to be absent
+    template <typename Key, typename... Args>
+    std::size_t InsertNew(std::size_t hash, Key&& key, Args&&... args) {
+        if ((live + deleted + 1) * 8 > slotCount * 7) {
+            // Reclaim tombstones in place when they, not live entries, fill the table
+            Rehash(live * 2 >= slotCount ? slotCount * 2 : slotCount);
+        }
+        const std::size_t groupMask = slotCount / kGroupWidth - 1;
+        std::size_t group = (hash >> 7) & groupMask;
+        for (std::size_t step = 1;; ++step) {
+            const std::uint32_t m = MatchFree(ctrl + group * kGroupWidth);
+            if (m) {
+                const std::size_t i = group * kGroupWidth + static_cast<std::size_t>(CountTrailingZeros(m));
+                new (&slots[i]) value_type(std::piecewise_construct, std::forward_as_tuple(std::forward<Key>(key)),
+                                           std::forward_as_tuple(std::forward<Args>(args)...));
+                if (ctrl[i] == kDeleted) --deleted;
+                ctrl[i] = H2(hash);
+                ++live;
+                return i;
+            }
+            group = (group + step) & groupMask;
+        }
+    }
+
+    void Reserve(std::size_t n) {
+        if ((n + deleted) * 8 <= slotCount * 7) return;
+        std::size_t want = kMinCapacity;
+        while (n * 8 > want * 7) want *= 2;
+        if (want > slotCount) Rehash(want);
+    }
+
+    void Rehash(std::size_t newCapacity) {
+        if (newCapacity < kMinCapacity) newCapacity = kMinCapacity;
+        FlatHashMap next;
+        next.Allocate(newCapacity);
+        for (std::size_t i = 0; i < slotCount; ++i) {
+            if (ctrl[i] < 0) continue;
+            const std::size_t hash = Hashed(slots[i].first);
+            next.InsertNew(hash, std::move(slots[i].first), std::move(slots[i].second));
+        }
+        Swap(next);
+    }
+
+    void Allocate(std::size_t n) {
+        ctrl = static_cast<std::int8_t*>(::operator new(n));
+        std::memset(ctrl, kEmpty, n);
+        slots = static_cast<value_type*>(::operator new(n * sizeof(value_type), std::align_val_t(alignof(value_type))));
+        slotCount = n;
+    }
+
+    void DestroyAll() {
+        for (std::size_t i = 0; i < slotCount; ++i) {
+            if (ctrl[i] >= 0) slots[i].~value_type();
+        }
+    }
+
+    void Release() {
+        if (!slotCount) return;
+        DestroyAll();
+        ::operator delete(ctrl);
+        ::operator delete(slots, std::align_val_t(alignof(value_type)));
+        ctrl = nullptr;
+        slots = nullptr;
+        slotCount = live = deleted = 0;
+    }
+
+    void Swap(FlatHashMap& o) noexcept {
+        std::swap(ctrl, o.ctrl);
+        std::swap(slots, o.slots);
+        std::swap(slotCount, o.slotCount);
+        std::swap(live, o.live);
+        std::swap(deleted, o.deleted);
+    }
+
+    std::int8_t* ctrl = nullptr;
+    value_type* slots = nullptr;
+    std::size_t slotCount = 0;  // 0 or a power of two >= kGroupWidth
+    std::size_t live = 0;       // entries
+    std::size_t deleted = 0;    // tombstones
+};
+
+// String-keyed flat map probed with std::string, std::string_view or const char*
+template <typename V>
+using StringMap = FlatHashMap<std::string, V, StringHash, StringEqual>;
+
+} // namespace chessDataLib::utils
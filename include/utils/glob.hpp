@@ -0,0 +1,9 @@
+#pragma once
+#include <string>
+
+namespace chessDataLib::utils {
+
+// Match a file name against a shell-style pattern supporting '*' and '?'
+bool MatchGlob(const std::string& pattern, const std::string& name);
+
+} // namespace chessDataLib::utils
@@ -0,0 +1,77 @@
+#pragma once
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace chessDataLib::utils {
+
+// Uniform sample of k items from a stream of unknown length, using Li's
+// Algorithm L: after the reservoir fills, the number of items to pass over
+// before the next replacement is drawn directly, so the cost is O(k log(n/k))
+// random draws instead of one per item. Callers count items with Skip() and
+// only materialize an item when Wants() is true.
+template <typename T>
+class Reservoir {
+public:
+    Reservoir(std::size_t capacity, std::uint64_t seed) : k(capacity), rng(seed) {
+        items.reserve(k);
+        if (k > 0) w = std::exp(std::log(Uniform()) / static_cast<double>(k));
+        next = k > 0 ? 0 : std::numeric_limits<std::uint64_t>::max();
+    }
+
+    // Whether the next item of the stream is taken
+    bool Wants() const { return seen == next; }
+
+    // Items that can be passed over before the next one is taken
+    std::uint64_t Gap() const { return next - seen; }
+
+    // Passes over items that are not taken
+    void Skip(std::uint64_t count = 1) { seen += count; }
+
+    // Takes the next item; only valid when Wants() is true
+    void Add(T item) {
+        if (items.size() < k) {
+            items.push_back(std::move(item));
+            ++seen;
+            next = items.size() < k ? seen : seen + Jump();
+            return;
+        }
+        items[std::uniform_int_distribution<std::size_t>(0, k - 1)(rng)] = std::move(item);
+        w *= std::exp(std::log(Uniform()) / static_cast<double>(k));
+        ++seen;
+        next = seen + Jump();
+    }
+
+    // Offers an item, taking it if the reservoir wants it
+    void Offer(T item) {
+        if (Wants()) Add(std::move(item));
+        else Skip();
+    }
+
+    std::uint64_t Seen() const { return seen; }
+    const std::vector<T>& Items() const { return items; }
+    std::vector<T>& Items() { return items; }
+
+private:
+    // Uniform in (0, 1]
+    double Uniform() { return 1.0 - std::uniform_real_distribution<double>(0.0, 1.0)(rng); }
+
+    // Items skipped before the next replacement
+    std::uint64_t Jump() {
+        if (w >= 1.0) return 0;
+        const double skip = std::floor(std::log(Uniform()) / std::log1p(-w));
+        return skip >= 9e18 ? std::numeric_limits<std::uint64_t>::max() / 2 : static_cast<std::uint64_t>(skip);
+    }
+
+    std::size_t k;
+    std::mt19937_64 rng;
+    double w = 1.0;
+    std::uint64_t seen = 0;
+    std::uint64_t next = 0;  ///< Stream position of the next item taken
+    std::vector<T> items;
+};
+
+} // namespace chessDataLib::utils
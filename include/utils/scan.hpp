@@ -0,0 +1,47 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+namespace chessDataLib::utils {
+
+// Find the first occurrence of the two-byte sequence (a, b) in [begin, end).
+// Uses SSE2 when available, falling back to a memchr loop.
+// Returns end if the sequence does not occur.
+const char* FindPair(const char* begin, const char* end, char a, char b);
+
+// Find the first game start at or after p: a '[' opening a line that follows
+// an empty line ("\n\n[" or "\n\r\n["). Bytes in [begin, p) are only used
+// to look back across the boundary. Returns end if there is none.
+const char* FindGameStart(const char* begin, const char* p, const char* end);
+
+// Find the first game of a file whose bytes start at begin: a '[' after
+// leading whitespace or a UTF-8 BOM, else the first game start after them.
+// Returns end if there is none.
+const char* FindFirstGame(const char* begin, const char* end);
+
+// Bitmask of the '\n' bytes in [p, p + 64): bit i is set if p[i] == '\n'.
+// Uses AVX2 or SSE2 when available; p must have 64 readable bytes.
+std::uint64_t NewlineMask64(const char* p);
+
+// Walks the line breaks of [begin, end) one 64-byte block at a time, in the
+// style of a structural index: each block is classified once into a bitmask
+// and successive breaks are popped off it with count-trailing-zeros.
+class LineScanner {
+public:
+    LineScanner(const char* begin, const char* end);
+
+    // First '\n' at or after p (p must not move backwards between calls);
+    // returns end if there is none
+    const char* Next(const char* p);
+
+    // Restarts on a new range, e.g. after a read buffer was refilled
+    void Reset(const char* begin, const char* end);
+
+private:
+    const char* block;     // start of the classified block
+    const char* blockEnd;  // end of the classified block
+    const char* end;
+    std::uint64_t mask;  // newlines of the block not yet returned
+};
+
+} // namespace chessDataLib::utils
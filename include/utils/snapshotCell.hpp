@@ -0,0 +1,82 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+namespace chessDataLib::utils {
+
+// Read-copy-update cell for an immutable value. A writer builds a new value
+// off to the side and publishes it with one atomic pointer swap; readers
+// take a shared_ptr to whatever is current and keep it alive for as long as
+// they use it, so they never see a half-written value and never wait for
+// the writer.
+//
+// Load() is lock-free. The current value sits in a node reached through an
+// atomic pointer; a reader announces itself in the reader count of the
+// current epoch, copies the shared_ptr out of the node (one atomic
+// reference-count increment) and withdraws. It retries only if a publisher
+// moved the epoch on in between. Publish() swaps in a new node, moves the
+// epoch on and waits for the readers counted under the old epoch to
+// withdraw before freeing the old node; the old value itself lives on in
+// the copies readers took. Publishers are serialized by a mutex and only
+// ever wait for readers' few-instruction critical sections, never the
+// other way round.
+template <typename T>
+class SnapshotCell {
+public:
+    explicit SnapshotCell(std::shared_ptr<const T> initial = std::make_shared<const T>())
+        : current(new Node{std::move(initial)}) {}
+
+    ~SnapshotCell() { delete current.load(); }
+
+    SnapshotCell(const SnapshotCell&) = delete;
+    SnapshotCell& operator=(const SnapshotCell&) = delete;
+
+    // Current value; never null
+    std::shared_ptr<const T> Load() const {
+        for (;;) {
+            const std::uint64_t seen = epoch.load();
+            std::atomic<std::uint64_t>& count = readers[seen & 1];
+            count.fetch_add(1);
+            if (epoch.load() == seen) {
+                std::shared_ptr<const T> value = current.load()->value;
+                count.fetch_sub(1);
+                return value;
+            }
+            count.fetch_sub(1);  // a publisher moved on; the next epoch sees its node
+        }
+    }
+
+    // Replaces the current value and bumps the version
+    void Publish(std::shared_ptr<const T> value) {
+        std::lock_guard<std::mutex> lock(publishMutex);
+        Node* old = current.exchange(new Node{std::move(value)});
+        const std::uint64_t retired = epoch.fetch_add(1);
+        while (readers[retired & 1].load() != 0) std::this_thread::yield();
+        delete old;
+        version.fetch_add(1, std::memory_order_release);
+    }
+
+    // Number of values published so far; readers can poll it to skip
+    // reloading an unchanged value
+    std::uint64_t GetVersion() const { return version.load(std::memory_order_acquire); }
+
+private:
+    struct Node {
+        std::shared_ptr<const T> value;
+    };
+
+    static_assert(std::atomic<std::uint64_t>::is_always_lock_free, "reader counts must be lock-free");
+    static_assert(std::atomic<Node*>::is_always_lock_free, "the node pointer must be lock-free");
+
+    std::atomic<Node*> current;
+    std::atomic<std::uint64_t> epoch{0};
+    mutable std::atomic<std::uint64_t> readers[2] = {};
+    std::atomic<std::uint64_t> version{0};
+    std::mutex publishMutex;
+};
+
+} // namespace chessDataLib::utils
@@ -0,0 +1,30 @@
+#pragma once
+#include <cstddef>
+#include <functional>
+
+namespace chessDataLib::utils {
+
+// Runs a fixed batch of independent tasks on a set of worker threads.
+// Each worker owns a deque seeded round-robin with task indices; it pops
+// from the back of its own deque and, when empty, steals from the front of
+// the others. Submit tasks largest-first so the big ones start early and the
+// small ones fill the gaps.
+class WorkStealingPool {
+public:
+    using Task = std::function<void(std::size_t task, unsigned worker)>;
+
+    // threadCount == 0 selects std::thread::hardware_concurrency()
+    explicit WorkStealingPool(unsigned threadCount = 0);
+
+    unsigned GetThreadCount() const;
+
+    // Runs fn(task, worker) for every task in [0, taskCount) and blocks until
+    // all complete. worker is in [0, GetThreadCount()). The first exception
+    // thrown by a task is rethrown here after all workers have stopped.
+    void Run(std::size_t taskCount, const Task& fn);
+
+private:
+    unsigned threadCount;
+};
+
+} // namespace chessDataLib::utils
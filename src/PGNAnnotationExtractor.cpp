@@ -0,0 +1,186 @@
+#include "PGNAnnotationExtractor.hpp"
+#include "PGNMoveText.hpp"
+#include "utils/scan.hpp"
+#include <algorithm>
+#include <cstring>
+
+namespace chessDataLib {
+
+static inline bool IsSpace(char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+static inline bool IsDigit(char c) {
+    return c >= '0' && c <= '9';
+}
+
+// Longer numbers are malformed; the bound keeps the arithmetic in range
+static constexpr int kMaxNumberDigits = 9;
+
+static void SetColumn(std::vector<int32_t>& column, int ply, int32_t value) {
+    if (value == GameAnnotations::kNoValue) return;
+    if (static_cast<int>(column.size()) <= ply) column.resize(ply + 1, GameAnnotations::kNoValue);
+    column[ply] = value;
+}
+
+// Scan one comment body for "[%cmd value]" entries and attach them to ply
+static void ScanComment(const char* b, const char* e, int ply, GameAnnotations& ann) {
+    const char* q = b;
+    while ((q = utils::FindPair(q, e, '[', '%')) != e) {
+        const char* cmd = q + 2;
+        const char* cmdEnd = cmd;
+        while (cmdEnd < e && ((*cmdEnd >= 'a' && *cmdEnd <= 'z') || (*cmdEnd >= 'A' && *cmdEnd <= 'Z'))) ++cmdEnd;
+
+        const char* val = cmdEnd;
+        while (val < e && IsSpace(*val)) ++val;
+        const char* close = static_cast<const char*>(std::memchr(val, ']', static_cast<std::size_t>(e - val)));
+        if (!close) close = e;
+        const char* valEnd = close;
+        while (valEnd > val && IsSpace(valEnd[-1])) --valEnd;
+
+        const std::size_t len = static_cast<std::size_t>(cmdEnd - cmd);
+        if (len == 3 && std::memcmp(cmd, "clk", 3) == 0) {
+            SetColumn(ann.clocks, ply, PGNAnnotationExtractor::ParseClock(val, valEnd));
+        } else if (len == 4 && std::memcmp(cmd, "eval", 4) == 0) {
+            SetColumn(ann.evals, ply, PGNAnnotationExtractor::ParseEval(val, valEnd));
+        }
+        q = close;
+    }
+}
+
+GameAnnotations PGNAnnotationExtractor::Extract(const std::string& moveText) {
+    return Extract(moveText.data(), moveText.data() + moveText.size());
+}
+
+GameAnnotations PGNAnnotationExtractor::Extract(const char* p, const char* end) {
+    GameAnnotations ann;
+    PGNMoveText::WalkMainline(
+        p, end,
+        [&ann](const char*, const char*) {
+            ann.plies++;
+            return true;
+        },
+        [&ann](const char* b, const char* e) {
+            if (ann.plies > 0) ScanComment(b, e, ann.plies - 1, ann);
+            return true;
+        });
+
+    if (!ann.clocks.empty()) ann.clocks.resize(ann.plies, GameAnnotations::kNoValue);
+    if (!ann.evals.empty()) ann.evals.resize(ann.plies, GameAnnotations::kNoValue);
+    return ann;
+}
+
+int32_t PGNAnnotationExtractor::ParseClock(const char* begin, const char* end) {
+    int64_t seconds = 0;
+    int fields = 0;
+    const char* p = begin;
+    while (p < end) {
+        if (!IsDigit(*p)) return GameAnnotations::kNoValue;
+        int64_t v = 0;
+        for (int digits = 0; p < end && IsDigit(*p); ++digits) {
+            if (digits == kMaxNumberDigits) return GameAnnotations::kNoValue;
+            v = v * 10 + (*p++ - '0');
+        }
+        seconds = seconds * 60 + v;
+        ++fields;
+        if (p < end && *p == ':') {
+            ++p;
+            continue;
+        }
+        break;
+    }
+    if (fields == 0 || fields > 3) return GameAnnotations::kNoValue;
+
+    int64_t centis = seconds * 100;
+    if (p < end && *p == '.') {
+        ++p;
+        int scale = 10;
+        while (p < end && IsDigit(*p)) {
+            centis += (*p++ - '0') * scale;
+            scale /= 10;
+        }
+    }
+    if (p != end || centis > INT32_MAX) return GameAnnotations::kNoValue;
+    return static_cast<int32_t>(centis);
+}
+
+int32_t PGNAnnotationExtractor::ParseEval(const char* begin, const char* end) {
+    const char* p = begin;
+    bool mate = false;
+    if (p < end && *p == '#') {
+        mate = true;
+        ++p;
+    }
+    int sign = 1;
+    if (p < end && (*p == '-' || *p == '+')) {
+        if (*p == '-') sign = -1;
+        ++p;
+    }
+    if (p == end || !IsDigit(*p)) return GameAnnotations::kNoValue;
+
+    int64_t whole = 0;
+    for (int digits = 0; p < end && IsDigit(*p); ++digits) {
+        if (digits == kMaxNumberDigits) return GameAnnotations::kNoValue;
+        whole = whole * 10 + (*p++ - '0');
+    }
+    if (mate) {
+        if (p != end || whole >= GameAnnotations::kMateScore) return GameAnnotations::kNoValue;
+        return static_cast<int32_t>(sign * (GameAnnotations::kMateScore - whole));
+    }
+
+    int64_t centis = whole * 100;
+    if (p < end && *p == '.') {
+        ++p;
+        int digits = 0;
+        int64_t frac = 0;
+        while (p < end && IsDigit(*p)) {
+            if (digits < 3) {
+                frac = frac * 10 + (*p - '0');
+                ++digits;
+            }
+            ++p;
+        }
+        while (digits < 3) {
+            frac *= 10;
+            ++digits;
+        }
+        centis += (frac + 5) / 10; // round to centipawns
+    }
+    if (p != end || centis >= GameAnnotations::kMateScore) return GameAnnotations::kNoValue;
+    return static_cast<int32_t>(sign * centis);
+}
+
+void PGNAnnotationExtractor::ComputeTimeUsage(const std::vector<int32_t>& clocks, bool white,
+                                              int64_t& spentCentis, int& timedMoves, bool whiteMovesFirst) {
+    spentCentis = 0;
+    timedMoves = 0;
+    int32_t prev = GameAnnotations::kNoValue;
+    for (std::size_t i = white == whiteMovesFirst ? 0 : 1; i < clocks.size(); i += 2) {
+        int32_t cur = clocks[i];
+        if (cur == GameAnnotations::kNoValue) continue;
+        if (prev != GameAnnotations::kNoValue) {
+            spentCentis += std::max<int32_t>(0, prev - cur);
+            timedMoves++;
+        }
+        prev = cur;
+    }
+}
+
+int PGNAnnotationExtractor::CountBlunders(const std::vector<int32_t>& evals, bool white, int thresholdCentipawns,
+                                          bool whiteMovesFirst) {
+    // Mate scores are clamped so that "mate vs. +12" does not dominate the swing
+    auto clamp = [](int32_t v) { return std::clamp<int32_t>(v, -1000, 1000); };
+
+    // The side's first ply has no evaluation before it when it opens the game
+    int blunders = 0;
+    for (std::size_t i = white == whiteMovesFirst ? 2 : 1; i < evals.size(); i += 2) {
+        int32_t before = evals[i - 1];
+        int32_t after = evals[i];
+        if (before == GameAnnotations::kNoValue || after == GameAnnotations::kNoValue) continue;
+        int32_t loss = white ? clamp(before) - clamp(after) : clamp(after) - clamp(before);
+        if (loss >= thresholdCentipawns) blunders++;
+    }
+    return blunders;
+}
+
+} // namespace chessDataLib
@@ -0,0 +1,262 @@
+#include "PGNExporter.hpp"
+#include "PGNGameBuilder.hpp"
+#include "PGNTagParser.hpp"
+#include "PGNTokenizer.hpp"
+#include "sourceMapping.hpp"
+#include "utils/chunkPlan.hpp"
+#include "utils/workStealingPool.hpp"
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define CHESSDATALIB_HAVE_POSIX_IO 1
+#endif
+
+namespace chessDataLib {
+
+namespace {
+
+// Selected source ranges of one task, adjacent games already coalesced
+struct TaskRanges {
+    std::uint64_t games = 0;
+    std::uint64_t selected = 0;
+    std::vector<std::pair<std::uint64_t, std::uint64_t>> ranges;  ///< [begin, end) source offsets
+};
+
+void AppendRange(std::vector<std::pair<std::uint64_t, std::uint64_t>>& ranges, std::uint64_t begin, std::uint64_t end) {
+    if (!ranges.empty() && ranges.back().second == begin) ranges.back().second = end;
+    else ranges.emplace_back(begin, end);
+}
+
+// True if both paths name the same existing file, through links too
+bool SameFile(const std::string& a, const std::string& b) {
+#ifdef CHESSDATALIB_HAVE_POSIX_IO
+    struct stat sa, sb;
+    return ::stat(a.c_str(), &sa) == 0 && ::stat(b.c_str(), &sb) == 0 && sa.st_dev == sb.st_dev &&
+           sa.st_ino == sb.st_ino;
+#else
+    std::error_code ec;
+    return std::filesystem::equivalent(a, b, ec);
+#endif
+}
+
+// Output file that copies source ranges, in the kernel where possible
+class RangeWriter {
+public:
+    ~RangeWriter() { Close(); }
+
+    bool Open(const std::string& path) {
+#ifdef CHESSDATALIB_HAVE_POSIX_IO
+        fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        return fd >= 0;
+#else
+        out.open(path, std::ios::binary | std::ios::trunc);
+        return out.is_open();
+#endif
+    }
+
+    // Copy [offset, offset + length) of a source; sourceFd may be -1
+    bool Copy(const SourceMapping& source, int sourceFd, std::uint64_t offset, std::uint64_t length) {
+        if (length == 0) return true;
+#if defined(__linux__)
+        if (sourceFd >= 0 && kernelCopy) {
+            loff_t in = static_cast<loff_t>(offset);
+            std::uint64_t left = length;
+            while (left > 0) {
+                const ssize_t n = ::copy_file_range(sourceFd, &in, fd, nullptr, static_cast<std::size_t>(left), 0);
+                if (n <= 0) break;
+                left -= static_cast<std::uint64_t>(n);
+            }
+            if (left == 0) return Track(source.Data() + offset, length);
+            // Unsupported by this file system pair: finish from the mapping
+            kernelCopy = false;
+            offset = static_cast<std::uint64_t>(in);
+            length = left;
+        }
+#else
+        (void)sourceFd;
+#endif
+        return Write(source.Data() + offset, length);
+    }
+
+    bool Write(const char* data, std::uint64_t length) {
+#ifdef CHESSDATALIB_HAVE_POSIX_IO
+        const char* p = data;
+        std::uint64_t left = length;
+        while (left > 0) {
+            const ssize_t n = ::write(fd, p, static_cast<std::size_t>(std::min<std::uint64_t>(left, 1u << 30)));
+            if (n < 0 && errno == EINTR) continue;
+            if (n <= 0) return false;
+            p += n;
+            left -= static_cast<std::uint64_t>(n);
+        }
+#else
+        out.write(data, static_cast<std::streamsize>(length));
+        if (!out) return false;
+#endif
+        return Track(data, length);
+    }
+
+    // Make the output end with a blank line so the next game is separated
+    bool Separate() {
+        if (written == 0) return true;
+        if (last[1] != '\n') return Write("\n\n", 2);
+        if (last[0] != '\n' && last[0] != '\r') return Write("\n", 1);
+        return true;
+    }
+
+    // Make the output end with a line break
+    bool Finish() {
+        return written == 0 || last[1] == '\n' || Write("\n", 1);
+    }
+
+    bool Close() {
+#ifdef CHESSDATALIB_HAVE_POSIX_IO
+        if (fd < 0) return true;
+        const bool ok = ::close(fd) == 0;
+        fd = -1;
+        return ok;
+#else
+        if (!out.is_open()) return true;
+        out.close();
+        return static_cast<bool>(out);
+#endif
+    }
+
+    std::uint64_t GetBytesWritten() const { return written; }
+
+private:
+    bool Track(const char* data, std::uint64_t length) {
+        if (length >= 2) {
+            last[0] = data[length - 2];
+        } else {
+            last[0] = last[1];
+        }
+        last[1] = data[length - 1];
+        written += length;
+        return true;
+    }
+
+#ifdef CHESSDATALIB_HAVE_POSIX_IO
+    int fd = -1;
+#else
+    std::ofstream out;
+#endif
+    bool kernelCopy = true;
+    char last[2] = {0, 0};  ///< Last two bytes written
+    std::uint64_t written = 0;
+};
+
+} // namespace
+
+void PGNExporter::SetThreadCount(unsigned count) {
+    threadCount = count;
+}
+
+void PGNExporter::SetChunkSize(std::uint64_t bytes) {
+    chunkSize = std::max<std::uint64_t>(1, bytes);
+}
+
+bool PGNExporter::ExportFiltered(const std::vector<std::string>& inputs, const std::string& output,
+                                 const Predicate& predicate, Summary* summary) const {
+    Summary counters;
+
+    // Truncating an input that is still mapped would end in SIGBUS or empty output
+    for (const std::string& input : inputs) {
+        if (SameFile(input, output)) {
+            std::cerr << "ExportFiltered: output " << output << " is the input " << input << "\n";
+            return false;
+        }
+    }
+
+    // === Plan: map inputs and cut them into chunks at game starts ===
+    bool allOpened = true;
+    std::vector<std::shared_ptr<SourceMapping>> sources(inputs.size());
+    for (std::size_t f = 0; f < inputs.size(); ++f) {
+        sources[f] = SourceMapping::Open(inputs[f]);
+        if (!sources[f]) {
+            std::cerr << "ExportFiltered: failed to open " << inputs[f] << "\n";
+            allOpened = false;
+            continue;
+        }
+    }
+    const std::vector<utils::ChunkTask> tasks = utils::PlanChunks(sources, chunkSize);
+
+    // === Filter: each game's range runs up to the next game, so neighbours coalesce ===
+    std::vector<TaskRanges> results(tasks.size());
+    utils::WorkStealingPool pool(threadCount);
+    pool.Run(tasks.size(), [&](std::size_t i, unsigned) {
+        const utils::ChunkTask& task = tasks[i];
+        const std::shared_ptr<SourceMapping>& source = sources[task.file];
+        PGNTokenizer tokenizer(source->Data() + task.begin, static_cast<std::size_t>(task.end - task.begin), task.begin);
+        TaskRanges& result = results[i];
+
+        bool pending = false;  // previous game selected, its end not yet known
+        std::uint64_t pendingBegin = 0;
+        while (tokenizer.NextGame()) {
+            const std::uint64_t offset = tokenizer.GetCurrentGameOffset();
+            if (pending) AppendRange(result.ranges, pendingBegin, offset);
+
+            const Game game = PGNGameBuilder::Build(PGNTagParser::Parse(tokenizer.GetCurrentTagLines()),
+                                                    tokenizer.GetCurrentMoveText());
+            result.games++;
+            pending = predicate(game);
+            pendingBegin = offset;
+            if (pending) result.selected++;
+        }
+        if (pending) AppendRange(result.ranges, pendingBegin, task.end);
+    });
+
+    // === Copy: ranges in plan order, coalesced across chunk boundaries ===
+    RangeWriter writer;
+    if (!writer.Open(output)) {
+        std::cerr << "ExportFiltered: failed to open " << output << "\n";
+        return false;
+    }
+
+    bool ok = true;
+    std::size_t t = 0;
+    while (t < tasks.size() && ok) {
+        const std::size_t file = tasks[t].file;
+        std::vector<std::pair<std::uint64_t, std::uint64_t>> ranges;
+        for (; t < tasks.size() && tasks[t].file == file; ++t) {
+            counters.gamesScanned += results[t].games;
+            counters.gamesWritten += results[t].selected;
+            for (const auto& r : results[t].ranges) AppendRange(ranges, r.first, r.second);
+        }
+        if (ranges.empty()) continue;
+
+        int sourceFd = -1;
+#ifdef CHESSDATALIB_HAVE_POSIX_IO
+        sourceFd = ::open(inputs[file].c_str(), O_RDONLY);
+#endif
+        for (const auto& r : ranges) {
+            if (!writer.Separate() || !writer.Copy(*sources[file], sourceFd, r.first, r.second - r.first)) {
+                std::cerr << "ExportFiltered: failed to write " << output << "\n";
+                ok = false;
+                break;
+            }
+        }
+#ifdef CHESSDATALIB_HAVE_POSIX_IO
+        if (sourceFd >= 0) ::close(sourceFd);
+#endif
+        counters.ranges += ranges.size();
+    }
+
+    if (ok && (!writer.Finish() || !writer.Close())) {
+        std::cerr << "ExportFiltered: failed to write " << output << "\n";
+        ok = false;
+    }
+    counters.bytesWritten = writer.GetBytesWritten();
+    if (summary) *summary = counters;
+    return ok && allOpened;
+}
+
+} // namespace chessDataLib
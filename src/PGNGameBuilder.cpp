@@ -1,6 +1,5 @@
 #include "PGNGameBuilder.hpp"
-#include <regex>
-#include <sstream>
+#include "PGNAnnotationExtractor.hpp"
 
 namespace chessDataLib {
 
@@ -19,33 +18,13 @@ Game PGNGameBuilder::Build(const std::unordered_map<std::string, std::string>& t
     if (tags.count("ECO")) game.SetEco(tags.at("ECO"));
     if (tags.count("Opening")) game.SetOpening(tags.at("Opening"));
 
-    // Robustly detect move count by finding move-number tokens like "1." or "23."
-    try {
-        std::regex mvnum(R"((\d+)\s*\.)");
-        std::string s = moveText;
-        std::size_t lastMoveNumber = 0;
-        for (std::sregex_iterator it(s.begin(), s.end(), mvnum), end; it != end; ++it) {
-            lastMoveNumber = std::stoul((*it)[1].str());
-        }
-        if (lastMoveNumber > 0) {
-            // lastMoveNumber is the index of the last full move; store as full-move count
-            game.SetMoveCount(static_cast<int>(lastMoveNumber));
-        } else {
-            // fallback: attempt to count move tokens (naive)
-            std::istringstream iss(s);
-            std::string tok;
-            int moves = 0;
-            while (iss >> tok) {
-                // ignore move numbers if token ends with '.'
-                if (!tok.empty() && tok.back() == '.') continue;
-                ++moves;
-            }
-            // convert ply to move pairs (approx)
-            game.SetMoveCount((moves + 1) / 2);
-        }
-    } catch (...) {
-        // keep prior/default move-count if anything goes wrong
-    }
+    // Single pass over the move text: counts mainline plies and collects
+    // [%clk]/[%eval] comment commands into compact per-ply columns
+    GameAnnotations ann = PGNAnnotationExtractor::Extract(moveText);
+    game.SetMoveCount((ann.plies + 1) / 2);
+    game.SetPlyCount(ann.plies);
+    if (!ann.clocks.empty()) game.SetClocks(std::move(ann.clocks));
+    if (!ann.evals.empty()) game.SetEvals(std::move(ann.evals));
 
     return game;
 }
@@ -0,0 +1,48 @@
+#include "PGNMoveText.hpp"
+#include <cstring>
+
+namespace chessDataLib {
+
+namespace {
+
+constexpr auto kSkipComment = [](const char*, const char*) { return true; };
+
+} // namespace
+
+bool PGNMoveText::IsMoveToken(const char* p, const char* end) {
+    if (end - p >= 3 && p[0] == '0' && p[1] == '-' && p[2] == '0') return true; // "0-0" castling
+    if (IsDigit(*p)) {
+        while (p < end && IsDigit(*p)) ++p;
+        if (p == end || *p != '.') return false; // result token such as "1-0" or "1/2-1/2"
+        while (p < end && *p == '.') ++p;
+        if (p == end) return false;
+    }
+    char c = *p;
+    if (c >= 'a' && c <= 'h') return true;
+    if (c == 'K' || c == 'Q' || c == 'R' || c == 'B' || c == 'N' || c == 'O') return true;
+    return c == '-' && end - p >= 2 && p[1] == '-'; // "--" null move
+}
+
+std::vector<std::string> PGNMoveText::MainlineMoves(const char* p, const char* end) {
+    std::vector<std::string> moves;
+    WalkMainline(p, end, [&moves](const char* b, const char* e) {
+        moves.emplace_back(b, e);
+        return true;
+    }, kSkipComment);
+    return moves;
+}
+
+std::size_t PGNMoveText::EncodeMainline(const char* p, const char* end, Board& board, std::vector<PackedMove>& out) {
+    std::size_t count = 0;
+    Move move;
+    WalkMainline(p, end, [&](const char* b, const char* e) {
+        if (board.ParseSan(b, e, move) != SanStatus::Ok) return false;
+        board.MakeMove(move);
+        out.push_back(Board::Pack(move));
+        ++count;
+        return true;
+    }, kSkipComment);
+    return count;
+}
+
+} // namespace chessDataLib
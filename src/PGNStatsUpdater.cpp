@@ -1,4 +1,5 @@
 #include "PGNStatsUpdater.hpp"
+#include "PGNAnnotationExtractor.hpp"
 #include "player.hpp"
 #include "game.hpp"
 #include "tournament.hpp"
@@ -7,48 +8,63 @@
 namespace chessDataLib {
 
 void PGNStatsUpdater::Update(const Game& game,
-                              std::unordered_map<std::string, Player>& players,
-                              std::unordered_map<std::string, Tournament>& tournaments,
-                              DatabaseStats& stats) {
+                              utils::StringMap<Player>& players,
+                              utils::StringMap<Tournament>& tournaments,
+                              DatabaseStats& stats,
+                              bool whiteMovesFirst) {
     const std::string& white = game.GetWhite();
     const std::string& black = game.GetBlack();
     const std::string& result = game.GetResult();
     const std::string& event = game.GetEvent();
 
-    // === Update result counters ===
+    // === Update game and result counters ===
+    stats.SetTotalGames(stats.GetTotalGames() + 1);
     stats.IncrementResultCount(result);
 
     // === Update player stats ===
-    for (const std::string& name : {white, black}) {
-        if (!players.count(name)) {
-            Player player;
-            player.SetName(name);
-            players[name] = player;
-            stats.AddPlayer(name, players[name]);
-        }
-        players[name].IncrementGameCount();
+    // One probe per player; reserving first keeps both references valid
+    players.reserve(players.size() + 2);
+    Player* sides[2];
+    const std::string* names[2] = {&white, &black};
+    for (int i = 0; i < 2; ++i) {
+        auto [it, inserted] = players.try_emplace(*names[i]);
+        if (inserted) it->second.SetName(*names[i]);
+        it->second.IncrementGameCount();
+        sides[i] = &it->second;
     }
+    Player& whitePlayer = *sides[0];
+    Player& blackPlayer = *sides[1];
 
     if (result == "1-0") {
-        players[white].IncrementWinCount();
-        players[black].IncrementLossCount();
+        whitePlayer.IncrementWinCount();
+        blackPlayer.IncrementLossCount();
     } else if (result == "0-1") {
-        players[black].IncrementWinCount();
-        players[white].IncrementLossCount();
+        blackPlayer.IncrementWinCount();
+        whitePlayer.IncrementLossCount();
     } else if (result == "1/2-1/2") {
-        players[white].IncrementDrawCount();
-        players[black].IncrementDrawCount();
+        whitePlayer.IncrementDrawCount();
+        blackPlayer.IncrementDrawCount();
     }
 
-    // === Update tournament stats ===
-    if (!tournaments.count(event)) {
-        tournaments[event] = Tournament(event);
-        stats.AddTournament(event, tournaments[event]);
+    // === Update clock and evaluation stats ===
+    if (!game.GetClocks().empty()) {
+        int64_t spent = 0;
+        int moves = 0;
+        PGNAnnotationExtractor::ComputeTimeUsage(game.GetClocks(), true, spent, moves, whiteMovesFirst);
+        whitePlayer.AddTimeUsage(spent, moves);
+        PGNAnnotationExtractor::ComputeTimeUsage(game.GetClocks(), false, spent, moves, whiteMovesFirst);
+        blackPlayer.AddTimeUsage(spent, moves);
+    }
+    if (!game.GetEvals().empty()) {
+        const int threshold = PGNAnnotationExtractor::kBlunderThreshold;
+        const std::vector<int32_t>& evals = game.GetEvals();
+        whitePlayer.AddBlunders(PGNAnnotationExtractor::CountBlunders(evals, true, threshold, whiteMovesFirst));
+        blackPlayer.AddBlunders(PGNAnnotationExtractor::CountBlunders(evals, false, threshold, whiteMovesFirst));
     }
 
-    tournaments[event].AddGame();
-    tournaments[event].AddPlayer(white);
-    tournaments[event].AddPlayer(black);
+    // === Update tournament stats ===
+    Tournament& tournament = tournaments.try_emplace(event, event).first->second;
+    tournament.RecordGame(white, black, game.GetRound(), result);
 }
 
 } // namespace chessDataLib
@@ -1,39 +1,106 @@
 #include "PGNTokenizer.hpp"
-#include <sstream>
+#include <cstring>
 
 namespace chessDataLib {
 
-PGNTokenizer::PGNTokenizer(std::istream& inputStream) : input(inputStream) {}
+namespace {
+
+constexpr std::size_t kReadBlock = 1 << 20;
+
+} // namespace
+
+PGNTokenizer::PGNTokenizer(std::istream& inputStream, std::uint64_t baseOffset)
+    : input(&inputStream), scanner(nullptr, nullptr), position(baseOffset) {}
+
+PGNTokenizer::PGNTokenizer(const char* data, std::size_t size, std::uint64_t baseOffset)
+    : cursor(data), limit(data + size), exhausted(true), scanner(data, data + size), position(baseOffset) {}
+
+// Moves the unread tail to the front of the buffer and reads behind it.
+// The buffer grows only when a single line does not fit.
+bool PGNTokenizer::Refill() {
+    if (exhausted) return false;
+    const std::size_t tail = static_cast<std::size_t>(limit - cursor);
+    // cursor points into buffer; growing may move it, so keep its offset
+    const std::size_t offset = tail ? static_cast<std::size_t>(cursor - buffer.data()) : 0;
+    if (buffer.size() < tail + kReadBlock) buffer.resize(tail + kReadBlock);
+    if (tail) std::memmove(buffer.data(), buffer.data() + offset, tail);
+
+    input->read(buffer.data() + tail, static_cast<std::streamsize>(buffer.size() - tail));
+    const std::size_t got = static_cast<std::size_t>(input->gcount());
+    if (got == 0 || !*input) exhausted = true;
+
+    cursor = buffer.data();
+    limit = cursor + tail + got;
+    scanner.Reset(cursor, limit);
+    return got > 0;
+}
+
+// Next line without its '\n'; a final line may lack one
+bool PGNTokenizer::NextLine(const char*& begin, const char*& end) {
+    while (true) {
+        const char* nl = scanner.Next(cursor);
+        if (nl != limit) {
+            begin = cursor;
+            end = nl;
+            cursor = nl + 1;
+            position += static_cast<std::uint64_t>(end - begin) + 1;
+            return true;
+        }
+        if (Refill()) continue;
+        if (cursor == limit) return false;
+        begin = cursor;
+        end = limit;
+        cursor = limit;
+        position += static_cast<std::uint64_t>(end - begin);
+        return true;
+    }
+}
 
 bool PGNTokenizer::NextGame() {
-    currentTagLines.clear();
+    // Tag line strings are overwritten in place so their buffers are reused
+    std::size_t tagCount = 0;
     currentMoveText.clear();
 
-    std::string line;
+    gameOffset = gameEnd = moveTextOffset = moveTextEnd = position;
+
     bool inTagSection = true;
+    const char* begin;
+    const char* end;
 
-    while (std::getline(input, line)) {
-        if (line.empty()) {
-            if (!currentTagLines.empty()) {
+    while (NextLine(begin, end)) {
+        const std::uint64_t lineOffset = position - static_cast<std::uint64_t>(cursor - begin);
+        if (end > begin && end[-1] == '\r') --end;
+
+        if (begin == end) {
+            // Detekcija kraja igre: prazna linija nakon poteza
+            if (!currentMoveText.empty()) break;
+            if (tagCount) {
                 inTagSection = false;
             }
             continue;
         }
 
-        if (inTagSection && line.front() == '[') {
-            currentTagLines.push_back(line);
+        if (tagCount == 0 && currentMoveText.empty()) gameOffset = lineOffset;
+        gameEnd = position;
+
+        if (inTagSection && *begin == '[') {
+            if (tagCount < currentTagLines.size()) currentTagLines[tagCount].assign(begin, end);
+            else currentTagLines.emplace_back(begin, end);
+            ++tagCount;
         } else {
             inTagSection = false;
-            currentMoveText += line + " ";
-        }
-
-        // Detekcija kraja igre: prazna linija nakon poteza
-        if (!inTagSection && line.empty() && !currentMoveText.empty()) {
-            break;
+            if (currentMoveText.empty()) moveTextOffset = lineOffset;
+            moveTextEnd = lineOffset + static_cast<std::uint64_t>(end - begin);
+            // Keep the line break: a ';' comment ends at it
+            currentMoveText.append(begin, end);
+            currentMoveText += '\n';
         }
     }
 
-    return !currentTagLines.empty() || !currentMoveText.empty();
+    currentTagLines.resize(tagCount);
+    if (currentMoveText.empty()) moveTextOffset = moveTextEnd = gameEnd;
+
+    return tagCount || !currentMoveText.empty();
 }
 
 const std::vector<std::string>& PGNTokenizer::GetCurrentTagLines() const {
@@ -44,4 +111,20 @@ const std::string& PGNTokenizer::GetCurrentMoveText() const {
     return currentMoveText;
 }
 
+std::uint64_t PGNTokenizer::GetCurrentGameOffset() const {
+    return gameOffset;
+}
+
+std::uint64_t PGNTokenizer::GetCurrentGameLength() const {
+    return gameEnd - gameOffset;
+}
+
+std::uint64_t PGNTokenizer::GetCurrentMoveTextOffset() const {
+    return moveTextOffset;
+}
+
+std::uint64_t PGNTokenizer::GetCurrentMoveTextLength() const {
+    return moveTextEnd - moveTextOffset;
+}
+
 } // namespace chessDataLib
@@ -0,0 +1,393 @@
+#include "PGNValidator.hpp"
+#include "PGNMoveText.hpp"
+#include "board.hpp"
+#include "sourceMapping.hpp"
+#include "utils/chunkPlan.hpp"
+#include "utils/scan.hpp"
+#include "utils/workStealingPool.hpp"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <memory>
+
+namespace chessDataLib {
+
+namespace {
+
+// Findings of one task; game numbers are relative to the task until merged
+struct TaskResult {
+    std::uint64_t games = 0;
+    std::uint64_t gamesWithIssues = 0;
+    std::vector<ValidationIssue> issues;
+};
+
+// Game results as parsed from a tag or a termination token
+enum ResultToken { NoResult, WhiteWins, BlackWins, Draw, Unfinished, BadResult };
+
+inline bool IsSpace(char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+inline bool IsDigit(char c) {
+    return c >= '0' && c <= '9';
+}
+
+bool Equals(const char* b, const char* e, const char* literal) {
+    const std::size_t n = std::strlen(literal);
+    return static_cast<std::size_t>(e - b) == n && std::memcmp(b, literal, n) == 0;
+}
+
+ResultToken ParseResult(const char* b, const char* e) {
+    if (Equals(b, e, "1-0")) return WhiteWins;
+    if (Equals(b, e, "0-1")) return BlackWins;
+    if (Equals(b, e, "1/2-1/2")) return Draw;
+    if (Equals(b, e, "*")) return Unfinished;
+    return BadResult;
+}
+
+bool IsValidElo(const char* b, const char* e) {
+    if (b == e || Equals(b, e, "-") || Equals(b, e, "?")) return true;
+    if (e - b > 4) return false;
+    for (; b < e; ++b) {
+        if (!IsDigit(*b)) return false;
+    }
+    return true;
+}
+
+// "YYYY.MM.DD" where any digit may be '?'; known months and days must be in range
+bool IsValidDate(const char* b, const char* e) {
+    if (e - b != 10 || b[4] != '.' || b[7] != '.') return false;
+    for (int i = 0; i < 10; ++i) {
+        if (i != 4 && i != 7 && !IsDigit(b[i]) && b[i] != '?') return false;
+    }
+    if (IsDigit(b[5]) && IsDigit(b[6])) {
+        const int month = (b[5] - '0') * 10 + (b[6] - '0');
+        if (month < 1 || month > 12) return false;
+    }
+    if (IsDigit(b[8]) && IsDigit(b[9])) {
+        const int day = (b[8] - '0') * 10 + (b[9] - '0');
+        if (day < 1 || day > 31) return false;
+    }
+    return true;
+}
+
+bool IsValidEco(const char* b, const char* e) {
+    if (b == e || Equals(b, e, "?")) return true;
+    return e - b == 3 && b[0] >= 'A' && b[0] <= 'E' && IsDigit(b[1]) && IsDigit(b[2]);
+}
+
+void AddIssue(std::vector<ValidationIssue>& issues, ValidationIssueKind kind, std::uint64_t gameOffset,
+              std::uint64_t offset, std::uint32_t ply, const char* b, const char* e) {
+    ValidationIssue issue;
+    issue.kind = kind;
+    issue.gameOffset = gameOffset;
+    issue.offset = offset;
+    issue.ply = ply;
+    issue.detail.assign(b, e);
+    issues.push_back(std::move(issue));
+}
+
+void WriteJsonString(std::ostream& out, const std::string& s) {
+    static const char hex[] = "0123456789abcdef";
+    out << '"';
+    for (unsigned char c : s) {
+        if (c == '"' || c == '\\') {
+            out << '\\' << c;
+        } else if (c < 0x20) {
+            out << "\\u00" << hex[c >> 4] << hex[c & 15];
+        } else {
+            out << c;
+        }
+    }
+    out << '"';
+}
+
+} // namespace
+
+const char* ToString(ValidationIssueKind kind) {
+    switch (kind) {
+        case ValidationIssueKind::IllegalMove: return "illegal_move";
+        case ValidationIssueKind::AmbiguousMove: return "ambiguous_move";
+        case ValidationIssueKind::MalformedMove: return "malformed_move";
+        case ValidationIssueKind::BadTagLine: return "bad_tag_line";
+        case ValidationIssueKind::BadResultTag: return "bad_result_tag";
+        case ValidationIssueKind::BadEloTag: return "bad_elo_tag";
+        case ValidationIssueKind::BadDateTag: return "bad_date_tag";
+        case ValidationIssueKind::BadEcoTag: return "bad_eco_tag";
+        case ValidationIssueKind::BadFen: return "bad_fen";
+        case ValidationIssueKind::MissingResult: return "missing_result";
+        case ValidationIssueKind::ResultMismatch: return "result_mismatch";
+    }
+    return "unknown";
+}
+
+// === ValidationReport ===
+
+std::size_t ValidationReport::Count(ValidationIssueKind kind) const {
+    return static_cast<std::size_t>(std::count_if(issues.begin(), issues.end(),
+                                                  [kind](const ValidationIssue& i) { return i.kind == kind; }));
+}
+
+bool ValidationReport::WriteJsonLines(const std::string& filename) const {
+    std::ofstream ofs(filename, std::ios::binary);
+    if (!ofs.is_open()) {
+        std::cerr << "WriteJsonLines: failed to open " << filename << "\n";
+        return false;
+    }
+
+    ofs << "{\"type\":\"summary\",\"files\":[";
+    for (std::size_t i = 0; i < files.size(); ++i) {
+        if (i) ofs << ',';
+        WriteJsonString(ofs, files[i]);
+    }
+    ofs << "],\"games\":" << games << ",\"gamesWithIssues\":" << gamesWithIssues
+        << ",\"issues\":" << issues.size() << "}\n";
+
+    for (const auto& issue : issues) {
+        ofs << "{\"type\":\"issue\",\"kind\":\"" << ToString(issue.kind) << "\",\"file\":";
+        WriteJsonString(ofs, issue.file < files.size() ? files[issue.file] : std::string());
+        ofs << ",\"game\":" << issue.game << ",\"gameOffset\":" << issue.gameOffset
+            << ",\"offset\":" << issue.offset << ",\"ply\":" << issue.ply << ",\"detail\":";
+        WriteJsonString(ofs, issue.detail);
+        ofs << "}\n";
+    }
+    return static_cast<bool>(ofs);
+}
+
+// === PGNValidator ===
+
+void PGNValidator::SetThreadCount(unsigned count) {
+    threadCount = count;
+}
+
+void PGNValidator::SetChunkSize(std::uint64_t bytes) {
+    chunkSize = std::max<std::uint64_t>(1, bytes);
+}
+
+bool PGNValidator::ValidateGame(const char* begin, const char* end, std::uint64_t baseOffset,
+                                std::vector<ValidationIssue>& issues) {
+    const std::size_t before = issues.size();
+    auto offsetOf = [&](const char* q) { return baseOffset + static_cast<std::uint64_t>(q - begin); };
+
+    Board board;
+    bool replay = true;
+    ResultToken tagResult = NoResult;
+    const char* p = begin;
+
+    // === Tag section: [Name "value"] lines, checked in place ===
+    while (true) {
+        while (p < end && IsSpace(*p)) ++p;
+        if (p >= end || *p != '[') break;
+
+        const char* line = p;
+        const char* eol = static_cast<const char*>(std::memchr(p, '\n', static_cast<std::size_t>(end - p)));
+        const char* lineEnd = eol ? eol : end;
+        p = eol ? eol + 1 : end;
+        while (lineEnd > line && (lineEnd[-1] == '\r' || lineEnd[-1] == ' ' || lineEnd[-1] == '\t')) --lineEnd;
+
+        const char* q = line + 1;
+        const char* name = q;
+        while (q < lineEnd && (IsDigit(*q) || *q == '_' || ((*q | 0x20) >= 'a' && (*q | 0x20) <= 'z'))) ++q;
+        const char* nameEnd = q;
+        while (q < lineEnd && *q == ' ') ++q;
+        const char* value = q + 1;
+        const char* valueEnd = value;
+        bool ok = name < nameEnd && q < lineEnd && *q == '"';
+        if (ok) {
+            while (valueEnd < lineEnd && *valueEnd != '"') valueEnd += *valueEnd == '\\' ? 2 : 1;
+            q = valueEnd + 1;
+            while (q < lineEnd && *q == ' ') ++q;
+            ok = valueEnd < lineEnd && q + 1 == lineEnd && *q == ']';
+        }
+        if (!ok) {
+            AddIssue(issues, ValidationIssueKind::BadTagLine, baseOffset, offsetOf(line), 0, line, lineEnd);
+            continue;
+        }
+
+        if (Equals(name, nameEnd, "Result")) {
+            tagResult = ParseResult(value, valueEnd);
+            if (tagResult == BadResult) {
+                AddIssue(issues, ValidationIssueKind::BadResultTag, baseOffset, offsetOf(line), 0, value, valueEnd);
+            }
+        } else if (Equals(name, nameEnd, "WhiteElo") || Equals(name, nameEnd, "BlackElo")) {
+            if (!IsValidElo(value, valueEnd)) {
+                AddIssue(issues, ValidationIssueKind::BadEloTag, baseOffset, offsetOf(line), 0, value, valueEnd);
+            }
+        } else if (Equals(name, nameEnd, "Date")) {
+            if (!IsValidDate(value, valueEnd)) {
+                AddIssue(issues, ValidationIssueKind::BadDateTag, baseOffset, offsetOf(line), 0, value, valueEnd);
+            }
+        } else if (Equals(name, nameEnd, "ECO")) {
+            if (!IsValidEco(value, valueEnd)) {
+                AddIssue(issues, ValidationIssueKind::BadEcoTag, baseOffset, offsetOf(line), 0, value, valueEnd);
+            }
+        } else if (Equals(name, nameEnd, "FEN")) {
+            if (!board.SetFen(value, valueEnd)) {
+                AddIssue(issues, ValidationIssueKind::BadFen, baseOffset, offsetOf(line), 0, value, valueEnd);
+                replay = false;
+            }
+        }
+    }
+
+    // === Move text: replay the mainline until the first bad move ===
+    ResultToken termination = NoResult;
+    const char* terminationBegin = end;
+    const char* terminationEnd = end;
+    std::uint32_t ply = 0;
+    int depth = 0; // variation nesting
+    Move move;
+
+    while (p < end && termination == NoResult) {
+        const char c = *p;
+        if (IsSpace(c)) {
+            ++p;
+        } else if (c == '{') {
+            const char* close = static_cast<const char*>(std::memchr(p + 1, '}', static_cast<std::size_t>(end - p - 1)));
+            p = close ? close + 1 : end;
+        } else if (c == ';') {
+            const char* eol = static_cast<const char*>(std::memchr(p, '\n', static_cast<std::size_t>(end - p)));
+            p = eol ? eol + 1 : end;
+        } else if (c == '(') {
+            ++depth;
+            ++p;
+        } else if (c == ')') {
+            if (depth > 0) --depth;
+            ++p;
+        } else {
+            const char* tok = p;
+            while (p < end && !IsSpace(*p) && *p != '{' && *p != '(' && *p != ')' && *p != ';') ++p;
+            if (depth > 0 || *tok == '$') continue;
+
+            const ResultToken result = ParseResult(tok, p);
+            if (result != BadResult) {
+                termination = result;
+                terminationBegin = tok;
+                terminationEnd = p;
+                continue;
+            }
+
+            // Bare move numbers ("12." or "12...") carry no move
+            const char* s = tok;
+            if (IsDigit(*s) && !PGNMoveText::IsMoveToken(tok, p)) {
+                while (s < p && IsDigit(*s)) ++s;
+                while (s < p && *s == '.') ++s;
+                if (s == p) continue;
+            }
+
+            ++ply;
+            if (!replay) continue;
+            if (!PGNMoveText::IsMoveToken(tok, p)) {
+                AddIssue(issues, ValidationIssueKind::MalformedMove, baseOffset, offsetOf(tok), ply, tok, p);
+                replay = false;
+                continue;
+            }
+            if (IsDigit(*s) && !(p - s >= 3 && s[1] == '-')) {
+                while (IsDigit(*s)) ++s;
+                while (*s == '.') ++s;
+            }
+
+            switch (board.ParseSan(s, p, move)) {
+                case SanStatus::Ok:
+                    board.MakeMove(move);
+                    break;
+                case SanStatus::Illegal:
+                    AddIssue(issues, ValidationIssueKind::IllegalMove, baseOffset, offsetOf(tok), ply, s, p);
+                    replay = false;
+                    break;
+                case SanStatus::Ambiguous:
+                    AddIssue(issues, ValidationIssueKind::AmbiguousMove, baseOffset, offsetOf(tok), ply, s, p);
+                    replay = false;
+                    break;
+                case SanStatus::Malformed:
+                    AddIssue(issues, ValidationIssueKind::MalformedMove, baseOffset, offsetOf(tok), ply, s, p);
+                    replay = false;
+                    break;
+            }
+        }
+    }
+
+    // === Termination: present, matching the tag and consistent with mate or stalemate ===
+    if (termination == NoResult) {
+        AddIssue(issues, ValidationIssueKind::MissingResult, baseOffset, offsetOf(end), ply, end, end);
+    } else {
+        bool mismatch = tagResult != NoResult && tagResult != BadResult && tagResult != termination;
+        if (!mismatch && replay && termination != Unfinished) {
+            Move moves[Board::kMaxMoves];
+            if (board.GenerateLegal(moves) == 0) {
+                const ResultToken expected = !board.InCheck() ? Draw
+                                             : board.SideToMove() == White ? BlackWins : WhiteWins;
+                mismatch = termination != expected;
+            }
+        }
+        if (mismatch) {
+            AddIssue(issues, ValidationIssueKind::ResultMismatch, baseOffset, offsetOf(terminationBegin), ply,
+                     terminationBegin, terminationEnd);
+        }
+    }
+    return issues.size() == before;
+}
+
+bool PGNValidator::ValidateFiles(const std::vector<std::string>& filenames, ValidationReport& report) const {
+    report = ValidationReport();
+    report.files = filenames;
+
+    // === Plan: map files and cut them into chunks at game starts ===
+    bool allOpened = true;
+    std::vector<std::shared_ptr<SourceMapping>> sources(filenames.size());
+    for (std::size_t f = 0; f < filenames.size(); ++f) {
+        sources[f] = SourceMapping::Open(filenames[f]);
+        if (!sources[f]) {
+            std::cerr << "ValidateFiles: failed to open " << filenames[f] << "\n";
+            allOpened = false;
+            continue;
+        }
+    }
+    const std::vector<utils::ChunkTask> tasks = utils::PlanChunks(sources, chunkSize);
+
+    // === Execute: each task walks its games and collects issues locally ===
+    std::vector<TaskResult> results(tasks.size());
+    utils::WorkStealingPool pool(threadCount);
+    pool.Run(tasks.size(), [&](std::size_t i, unsigned) {
+        const utils::ChunkTask& task = tasks[i];
+        const char* data = sources[task.file]->Data();
+        const char* end = data + task.end;
+        const char* p = data + task.begin;
+        if (task.begin == 0 && end - p >= 3 && std::memcmp(p, "\xEF\xBB\xBF", 3) == 0) p += 3; // UTF-8 BOM
+        TaskResult& result = results[i];
+
+        while (true) {
+            while (p < end && IsSpace(*p)) ++p;
+            if (p >= end) break;
+            const char* next = utils::FindGameStart(data, p + 1, end);
+            const std::size_t before = result.issues.size();
+            if (!ValidateGame(p, next, static_cast<std::uint64_t>(p - data), result.issues)) {
+                result.gamesWithIssues++;
+                for (std::size_t k = before; k < result.issues.size(); ++k) result.issues[k].game = result.games;
+            }
+            result.games++;
+            p = next;
+        }
+    });
+
+    // === Merge in plan order, turning task-relative game numbers into file-relative ones ===
+    std::size_t issueCount = 0;
+    for (const auto& r : results) issueCount += r.issues.size();
+    report.issues.reserve(issueCount);
+
+    std::uint64_t gamesInFile = 0;
+    for (std::size_t i = 0; i < tasks.size(); ++i) {
+        if (i > 0 && tasks[i].file != tasks[i - 1].file) gamesInFile = 0;
+        for (auto& issue : results[i].issues) {
+            issue.file = static_cast<std::uint32_t>(tasks[i].file);
+            issue.game += gamesInFile;
+            report.issues.push_back(std::move(issue));
+        }
+        gamesInFile += results[i].games;
+        report.games += results[i].games;
+        report.gamesWithIssues += results[i].gamesWithIssues;
+    }
+    return allOpened;
+}
+
+} // namespace chessDataLib
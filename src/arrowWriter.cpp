@@ -0,0 +1,394 @@
+#include "arrowWriter.hpp"
+#include "utils/flatBuffer.hpp"
+#include <iostream>
+
+namespace chessDataLib {
+
+namespace {
+
+using utils::FlatBufferBuilder;
+using Table = FlatBufferBuilder::Table;
+
+// Constants of the Arrow format (Schema.fbs, Message.fbs)
+constexpr std::int16_t kMetadataV5 = 4;
+constexpr std::uint8_t kTypeInt = 2;
+constexpr std::uint8_t kTypeFloatingPoint = 3;
+constexpr std::uint8_t kTypeUtf8 = 5;
+constexpr std::int16_t kPrecisionDouble = 2;
+constexpr std::uint8_t kHeaderSchema = 1;
+constexpr std::uint8_t kHeaderDictionaryBatch = 2;
+constexpr std::uint8_t kHeaderRecordBatch = 3;
+constexpr std::uint32_t kContinuation = 0xFFFFFFFFu;
+constexpr char kMagic[8] = {'A', 'R', 'R', 'O', 'W', '1', 0, 0};
+
+struct FieldNode {
+    std::int64_t length;
+    std::int64_t nullCount;
+};
+
+struct BufferSpec {
+    std::int64_t offset;
+    std::int64_t length;
+};
+
+std::int64_t Padded(std::int64_t n) {
+    return (n + 7) & ~std::int64_t(7);
+}
+
+std::uint32_t WriteIntType(FlatBufferBuilder& b, std::int32_t bits) {
+    Table t;
+    t.I32(0, bits).Bool(1, true);
+    return b.WriteTable(t);
+}
+
+std::uint32_t WriteField(FlatBufferBuilder& b, const ArrowWriter::Field& field, std::int64_t dictionaryId) {
+    using Type = ArrowWriter::Type;
+    Table t;
+    t.Offset(0, [&field](FlatBufferBuilder& fb) { return fb.WriteString(field.name); });
+    t.Bool(1, field.nullable);
+    switch (field.type) {
+        case Type::Int32:
+        case Type::Int64: {
+            const std::int32_t bits = field.type == Type::Int32 ? 32 : 64;
+            t.U8(2, kTypeInt).Offset(3, [bits](FlatBufferBuilder& fb) { return WriteIntType(fb, bits); });
+            break;
+        }
+        case Type::Float64:
+            t.U8(2, kTypeFloatingPoint).Offset(3, [](FlatBufferBuilder& fb) {
+                Table precision;
+                precision.I16(0, kPrecisionDouble);
+                return fb.WriteTable(precision);
+            });
+            break;
+        case Type::Utf8:
+        case Type::DictionaryUtf8:
+            t.U8(2, kTypeUtf8).Offset(3, [](FlatBufferBuilder& fb) { return fb.WriteTable(Table()); });
+            break;
+    }
+    if (field.type == Type::DictionaryUtf8) {
+        t.Offset(4, [dictionaryId](FlatBufferBuilder& fb) {
+            Table encoding;
+            encoding.I64(0, dictionaryId).Offset(1, [](FlatBufferBuilder& ib) { return WriteIntType(ib, 32); });
+            return fb.WriteTable(encoding);
+        });
+    }
+    t.Offset(5, [](FlatBufferBuilder& fb) { return fb.WriteOffsetVector({}); });
+    return b.WriteTable(t);
+}
+
+std::uint32_t WriteSchema(FlatBufferBuilder& b, const std::vector<ArrowWriter::Field>& fields) {
+    std::vector<FlatBufferBuilder::Writer> children;
+    for (std::size_t i = 0; i < fields.size(); ++i) {
+        children.push_back([&fields, i](FlatBufferBuilder& fb) {
+            return WriteField(fb, fields[i], static_cast<std::int64_t>(i));
+        });
+    }
+    Table t;
+    t.I16(0, 0);  // little-endian
+    t.Offset(1, [&children](FlatBufferBuilder& fb) { return fb.WriteOffsetVector(children); });
+    return b.WriteTable(t);
+}
+
+std::uint32_t WriteRecordBatch(FlatBufferBuilder& b, std::int64_t length, const std::vector<FieldNode>& nodes,
+                               const std::vector<BufferSpec>& buffers) {
+    Table t;
+    t.I64(0, length);
+    t.Offset(1, [&nodes](FlatBufferBuilder& fb) {
+        return fb.WriteRawVector(nodes.data(), nodes.size(), sizeof(FieldNode), 8);
+    });
+    t.Offset(2, [&buffers](FlatBufferBuilder& fb) {
+        return fb.WriteRawVector(buffers.data(), buffers.size(), sizeof(BufferSpec), 8);
+    });
+    return b.WriteTable(t);
+}
+
+std::vector<std::uint8_t> MessageBytes(std::uint8_t headerType, const FlatBufferBuilder::Writer& header,
+                                       std::int64_t bodyLength) {
+    FlatBufferBuilder b;
+    return b.Finish([&](FlatBufferBuilder& fb) {
+        Table t;
+        t.I16(0, kMetadataV5).U8(1, headerType).Offset(2, header).I64(3, bodyLength);
+        return fb.WriteTable(t);
+    });
+}
+
+// Lays out body buffers at 8-byte aligned offsets
+class BodyLayout {
+public:
+    void Add(std::string_view bytes) {
+        specs.push_back({length, static_cast<std::int64_t>(bytes.size())});
+        parts.push_back(bytes);
+        length += Padded(static_cast<std::int64_t>(bytes.size()));
+    }
+
+    std::vector<BufferSpec> specs;
+    std::vector<std::string_view> parts;
+    std::int64_t length = 0;
+};
+
+std::string_view Bytes(const void* data, std::size_t size) {
+    return {static_cast<const char*>(data), size};
+}
+
+} // namespace
+
+ArrowWriter::~ArrowWriter() {
+    if (out.is_open()) Close();
+}
+
+bool ArrowWriter::Open(const std::string& filename, std::vector<Field> fields, Format outputFormat) {
+    path = filename;
+    format = outputFormat;
+    out.open(path, std::ios::binary | std::ios::trunc);
+    if (!out.is_open()) {
+        std::cerr << "ArrowWriter: failed to open " << path << "\n";
+        return ok = false;
+    }
+    columns.clear();
+    for (auto& f : fields) {
+        Column column;
+        column.field = std::move(f);
+        columns.push_back(std::move(column));
+    }
+    rows = 0;
+    totalRows = 0;
+    position = 0;
+    dictionaryBlocks.clear();
+    recordBlocks.clear();
+    ok = true;
+
+    if (format == Format::File) WriteBytes(kMagic, sizeof kMagic);
+    std::vector<Field> schema;
+    for (const auto& c : columns) schema.push_back(c.field);
+    WriteMessage(MessageBytes(kHeaderSchema, [&schema](FlatBufferBuilder& b) { return WriteSchema(b, schema); }, 0),
+                 {}, 0, nullptr);
+    return ok;
+}
+
+void ArrowWriter::SetBatchRows(std::size_t count) {
+    batchRows = std::max<std::size_t>(1, count);
+}
+
+// === Row appends ===
+
+void ArrowWriter::SetValid(Column& column, bool valid) {
+    if (rows % 8 == 0) column.validity.push_back(0);
+    if (valid) column.validity.back() |= static_cast<std::uint8_t>(1u << (rows % 8));
+    else column.nullCount++;
+}
+
+void ArrowWriter::AppendInt32(std::size_t c, std::int32_t value) {
+    SetValid(columns[c], true);
+    columns[c].values.insert(columns[c].values.end(), reinterpret_cast<const std::uint8_t*>(&value),
+                             reinterpret_cast<const std::uint8_t*>(&value) + sizeof value);
+}
+
+void ArrowWriter::AppendInt64(std::size_t c, std::int64_t value) {
+    SetValid(columns[c], true);
+    columns[c].values.insert(columns[c].values.end(), reinterpret_cast<const std::uint8_t*>(&value),
+                             reinterpret_cast<const std::uint8_t*>(&value) + sizeof value);
+}
+
+void ArrowWriter::AppendFloat64(std::size_t c, double value) {
+    SetValid(columns[c], true);
+    columns[c].values.insert(columns[c].values.end(), reinterpret_cast<const std::uint8_t*>(&value),
+                             reinterpret_cast<const std::uint8_t*>(&value) + sizeof value);
+}
+
+void ArrowWriter::AppendString(std::size_t c, std::string_view value) {
+    Column& column = columns[c];
+    SetValid(column, true);
+    if (column.field.type == Type::DictionaryUtf8) {
+        const auto next = static_cast<std::int32_t>(column.dictWritten + column.dictOffsets.size() - 1);
+        auto it = column.ids.find(value);
+        std::int32_t id;
+        if (it != column.ids.end()) {
+            id = it->second;
+        } else {
+            id = next;
+            column.ids.try_emplace(std::string(value), id);
+            column.dictData.append(value);
+            column.dictOffsets.push_back(static_cast<std::int32_t>(column.dictData.size()));
+        }
+        column.values.insert(column.values.end(), reinterpret_cast<const std::uint8_t*>(&id),
+                             reinterpret_cast<const std::uint8_t*>(&id) + sizeof id);
+        return;
+    }
+    if (column.offsets.empty()) column.offsets.push_back(0);
+    column.data.append(value);
+    column.offsets.push_back(static_cast<std::int32_t>(column.data.size()));
+}
+
+void ArrowWriter::AppendNull(std::size_t c) {
+    Column& column = columns[c];
+    SetValid(column, false);
+    switch (column.field.type) {
+        case Type::Int32:
+        case Type::DictionaryUtf8:
+            column.values.resize(column.values.size() + 4, 0);
+            break;
+        case Type::Int64:
+        case Type::Float64:
+            column.values.resize(column.values.size() + 8, 0);
+            break;
+        case Type::Utf8:
+            if (column.offsets.empty()) column.offsets.push_back(0);
+            column.offsets.push_back(static_cast<std::int32_t>(column.data.size()));
+            break;
+    }
+}
+
+bool ArrowWriter::EndRow() {
+    rows++;
+    totalRows++;
+    if (rows >= batchRows) return FlushBatch();
+    return ok;
+}
+
+// === Batches ===
+
+bool ArrowWriter::WriteDictionaries() {
+    for (std::size_t c = 0; c < columns.size(); ++c) {
+        Column& column = columns[c];
+        if (column.field.type != Type::DictionaryUtf8) continue;
+        const std::size_t count = column.dictOffsets.size() - 1;
+        const bool delta = column.dictWritten > 0 || !recordBlocks.empty();
+        if (count == 0 && delta) continue;
+
+        BodyLayout body;
+        body.Add({});
+        body.Add(Bytes(column.dictOffsets.data(), column.dictOffsets.size() * sizeof(std::int32_t)));
+        body.Add(column.dictData);
+        const std::vector<FieldNode> nodes = {{static_cast<std::int64_t>(count), 0}};
+        const auto id = static_cast<std::int64_t>(c);
+        const auto metadata = MessageBytes(
+            kHeaderDictionaryBatch,
+            [&](FlatBufferBuilder& b) {
+                Table t;
+                t.I64(0, id);
+                t.Offset(1, [&](FlatBufferBuilder& fb) {
+                    return WriteRecordBatch(fb, static_cast<std::int64_t>(count), nodes, body.specs);
+                });
+                t.Bool(2, delta);
+                return b.WriteTable(t);
+            },
+            body.length);
+        if (!WriteMessage(metadata, body.parts, body.length, &dictionaryBlocks)) return false;
+
+        // Written entries stay interned but their bytes are no longer needed
+        column.dictWritten += count;
+        column.dictData.clear();
+        column.dictOffsets.assign(1, 0);
+    }
+    return ok;
+}
+
+bool ArrowWriter::FlushBatch() {
+    if (!ok || !WriteDictionaries()) return false;
+
+    BodyLayout body;
+    std::vector<FieldNode> nodes;
+    for (Column& column : columns) {
+        nodes.push_back({static_cast<std::int64_t>(rows), column.nullCount});
+        body.Add(column.nullCount ? Bytes(column.validity.data(), column.validity.size()) : std::string_view());
+        if (column.field.type == Type::Utf8) {
+            if (column.offsets.empty()) column.offsets.push_back(0);
+            body.Add(Bytes(column.offsets.data(), column.offsets.size() * sizeof(std::int32_t)));
+            body.Add(column.data);
+        } else {
+            body.Add(Bytes(column.values.data(), column.values.size()));
+        }
+    }
+    const auto length = static_cast<std::int64_t>(rows);
+    const auto metadata = MessageBytes(
+        kHeaderRecordBatch, [&](FlatBufferBuilder& b) { return WriteRecordBatch(b, length, nodes, body.specs); },
+        body.length);
+    WriteMessage(metadata, body.parts, body.length, &recordBlocks);
+
+    for (Column& column : columns) {
+        column.validity.clear();
+        column.nullCount = 0;
+        column.values.clear();
+        column.offsets.clear();
+        column.data.clear();
+    }
+    rows = 0;
+    return ok;
+}
+
+bool ArrowWriter::WriteMessage(const std::vector<std::uint8_t>& metadata, const std::vector<std::string_view>& body,
+                               std::int64_t bodyLength, std::vector<Block>* blocks) {
+    const std::uint64_t start = position;
+    const auto metadataSize = static_cast<std::int32_t>(metadata.size());  // already a multiple of 8
+    WriteBytes(&kContinuation, 4);
+    WriteBytes(&metadataSize, 4);
+    WriteBytes(metadata.data(), metadata.size());
+
+    static const char zeros[8] = {};
+    for (std::string_view part : body) {
+        WriteBytes(part.data(), part.size());
+        WriteBytes(zeros, static_cast<std::size_t>(Padded(static_cast<std::int64_t>(part.size())) -
+                                                   static_cast<std::int64_t>(part.size())));
+    }
+    if (blocks) blocks->push_back({static_cast<std::int64_t>(start), 8 + metadataSize, 0, bodyLength});
+    return ok;
+}
+
+bool ArrowWriter::WriteBytes(const void* data, std::size_t size) {
+    if (!ok || size == 0) return ok;
+    out.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+    position += size;
+    if (!out) {
+        std::cerr << "ArrowWriter: failed to write " << path << "\n";
+        ok = false;
+    }
+    return ok;
+}
+
+bool ArrowWriter::Close() {
+    if (!out.is_open()) return ok;
+    // Always emit one batch so dictionaries exist even for empty outputs
+    if (rows > 0 || recordBlocks.empty()) FlushBatch();
+
+    const std::uint32_t eos[2] = {kContinuation, 0};
+    WriteBytes(eos, sizeof eos);
+
+    if (format == Format::File) {
+        std::vector<Field> schema;
+        for (const auto& c : columns) schema.push_back(c.field);
+        FlatBufferBuilder b;
+        const auto footer = b.Finish([&](FlatBufferBuilder& fb) {
+            Table t;
+            t.I16(0, kMetadataV5);
+            t.Offset(1, [&schema](FlatBufferBuilder& sb) { return WriteSchema(sb, schema); });
+            t.Offset(2, [this](FlatBufferBuilder& vb) {
+                return vb.WriteRawVector(dictionaryBlocks.data(), dictionaryBlocks.size(), sizeof(Block), 8);
+            });
+            t.Offset(3, [this](FlatBufferBuilder& vb) {
+                return vb.WriteRawVector(recordBlocks.data(), recordBlocks.size(), sizeof(Block), 8);
+            });
+            return fb.WriteTable(t);
+        });
+        const auto footerSize = static_cast<std::int32_t>(footer.size());
+        WriteBytes(footer.data(), footer.size());
+        WriteBytes(&footerSize, 4);
+        WriteBytes(kMagic, 6);
+    }
+
+    out.close();
+    if (!out) {
+        std::cerr << "ArrowWriter: failed to write " << path << "\n";
+        ok = false;
+    }
+    return ok;
+}
+
+std::uint64_t ArrowWriter::GetRowCount() const {
+    return totalRows;
+}
+
+std::size_t ArrowWriter::GetBatchCount() const {
+    return recordBlocks.size();
+}
+
+} // namespace chessDataLib
@@ -0,0 +1,48 @@
+#include "basicParser.hpp"
+#include "utils/chunkPlan.hpp"
+#include "utils/workStealingPool.hpp"
+#include <algorithm>
+#include <iostream>
+#include <iterator>
+
+namespace chessDataLib::detail {
+
+bool ParseChunked(const std::vector<std::string>& filenames, unsigned threadCount, std::uint64_t chunkSize,
+                  const ChunkParser& parse, SourceTable& sources, std::vector<Game>& games) {
+    // === Plan: map inputs and cut them into chunks at game starts ===
+    bool allOpened = true;
+    std::vector<std::shared_ptr<SourceMapping>> mapped(filenames.size());
+    std::vector<std::uint32_t> sourceIds(filenames.size(), MoveTextRef::kNoSource);
+    for (std::size_t f = 0; f < filenames.size(); ++f) {
+        mapped[f] = SourceMapping::Open(filenames[f]);
+        if (!mapped[f]) {
+            std::cerr << "BasicParser: failed to open " << filenames[f] << "\n";
+            allOpened = false;
+            continue;
+        }
+        sourceIds[f] = sources.Add(mapped[f]);
+    }
+    const std::vector<utils::ChunkTask> tasks = utils::PlanChunks(mapped, chunkSize);
+
+    // === Execute: largest tasks first, results kept in plan order ===
+    std::vector<std::size_t> order(tasks.size());
+    for (std::size_t i = 0; i < order.size(); ++i) order[i] = i;
+    std::stable_sort(order.begin(), order.end(), [&tasks](std::size_t a, std::size_t b) {
+        return tasks[a].end - tasks[a].begin > tasks[b].end - tasks[b].begin;
+    });
+
+    std::vector<std::vector<Game>> taskGames(tasks.size());
+    utils::WorkStealingPool pool(threadCount);
+    pool.Run(order.size(), [&](std::size_t i, unsigned) {
+        const utils::ChunkTask& task = tasks[order[i]];
+        parse(*mapped[task.file], sourceIds[task.file], task.begin, task.end, taskGames[order[i]]);
+    });
+
+    std::size_t gameCount = games.size();
+    for (const auto& g : taskGames) gameCount += g.size();
+    games.reserve(gameCount);
+    for (auto& g : taskGames) std::move(g.begin(), g.end(), std::back_inserter(games));
+    return allOpened;
+}
+
+} // namespace chessDataLib::detail
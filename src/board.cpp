@@ -0,0 +1,497 @@
+#include "board.hpp"
+#include <cstring>
+#include <initializer_list>
+
+namespace chessDataLib {
+
+namespace {
+
+constexpr std::uint8_t kWhiteKingside = 1;
+constexpr std::uint8_t kWhiteQueenside = 2;
+constexpr std::uint8_t kBlackKingside = 4;
+constexpr std::uint8_t kBlackQueenside = 8;
+
+constexpr int kKnightSteps[8][2] = {{1, 2}, {2, 1}, {2, -1}, {1, -2}, {-1, -2}, {-2, -1}, {-2, 1}, {-1, 2}};
+constexpr int kKingSteps[8][2] = {{1, 0}, {1, 1}, {0, 1}, {-1, 1}, {-1, 0}, {-1, -1}, {0, -1}, {1, -1}};
+constexpr int kRookDirs[4][2] = {{1, 0}, {-1, 0}, {0, 1}, {0, -1}};
+constexpr int kBishopDirs[4][2] = {{1, 1}, {1, -1}, {-1, 1}, {-1, -1}};
+
+inline int File(int sq) { return sq & 7; }
+inline int Rank(int sq) { return sq >> 3; }
+inline bool OnBoard(int file, int rank) { return file >= 0 && file < 8 && rank >= 0 && rank < 8; }
+inline std::uint8_t Make(PieceType t, Color c) { return static_cast<std::uint8_t>(t | (c << 3)); }
+inline PieceType TypeOf(std::uint8_t piece) { return static_cast<PieceType>(piece & 7); }
+inline Color ColorOf(std::uint8_t piece) { return static_cast<Color>(piece >> 3); }
+
+PieceType PieceFromLetter(char c) {
+    switch (c) {
+        case 'N': return Knight;
+        case 'B': return Bishop;
+        case 'R': return Rook;
+        case 'Q': return Queen;
+        case 'K': return King;
+        default: return NoPieceType;
+    }
+}
+
+// Castling rights lost when a move touches a square (king or rook home squares)
+std::uint8_t RightsClearedBy(int sq) {
+    switch (sq) {
+        case 0: return kWhiteQueenside;
+        case 7: return kWhiteKingside;
+        case 4: return kWhiteKingside | kWhiteQueenside;
+        case 56: return kBlackQueenside;
+        case 63: return kBlackKingside;
+        case 60: return kBlackKingside | kBlackQueenside;
+        default: return 0;
+    }
+}
+
+} // namespace
+
+// === Setup ===
+
+Board::Board() {
+    SetStartPosition();
+}
+
+void Board::SetStartPosition() {
+    static const PieceType backRank[8] = {Rook, Knight, Bishop, Queen, King, Bishop, Knight, Rook};
+    std::memset(squares, 0, sizeof squares);
+    for (int f = 0; f < 8; ++f) {
+        squares[f] = Make(backRank[f], White);
+        squares[8 + f] = Make(Pawn, White);
+        squares[48 + f] = Make(Pawn, Black);
+        squares[56 + f] = Make(backRank[f], Black);
+    }
+    kingSquare[White] = 4;
+    kingSquare[Black] = 60;
+    side = White;
+    castling = kWhiteKingside | kWhiteQueenside | kBlackKingside | kBlackQueenside;
+    epSquare = -1;
+    halfmoveClock = 0;
+    fullmoveNumber = 1;
+}
+
+bool Board::SetFen(const char* p, const char* end) {
+    std::memset(squares, 0, sizeof squares);
+    int kings[2] = {0, 0};
+
+    // Piece placement, rank 8 first
+    int rank = 7, file = 0;
+    for (; p < end && *p != ' '; ++p) {
+        const char c = *p;
+        if (c == '/') {
+            if (file != 8 || rank == 0) return false;
+            --rank;
+            file = 0;
+        } else if (c >= '1' && c <= '8') {
+            file += c - '0';
+            if (file > 8) return false;
+        } else {
+            const Color color = (c >= 'a' && c <= 'z') ? Black : White;
+            const PieceType type = c == 'p' || c == 'P' ? Pawn : PieceFromLetter(static_cast<char>(c & ~0x20));
+            if (type == NoPieceType || file > 7) return false;
+            const int sq = rank * 8 + file++;
+            squares[sq] = Make(type, color);
+            if (type == King) {
+                kingSquare[color] = static_cast<std::uint8_t>(sq);
+                kings[color]++;
+            }
+        }
+    }
+    if (rank != 0 || file != 8 || kings[White] != 1 || kings[Black] != 1) return false;
+
+    auto field = [&](const char*& b, const char*& e) {
+        while (p < end && *p == ' ') ++p;
+        b = p;
+        while (p < end && *p != ' ') ++p;
+        e = p;
+        return b < e;
+    };
+
+    const char *b, *e;
+    if (!field(b, e) || e - b != 1 || (*b != 'w' && *b != 'b')) return false;
+    side = *b == 'w' ? White : Black;
+
+    castling = 0;
+    if (field(b, e) && !(e - b == 1 && *b == '-')) {
+        for (; b < e; ++b) {
+            switch (*b) {
+                case 'K': castling |= kWhiteKingside; break;
+                case 'Q': castling |= kWhiteQueenside; break;
+                case 'k': castling |= kBlackKingside; break;
+                case 'q': castling |= kBlackQueenside; break;
+                default: return false;
+            }
+        }
+    }
+
+    epSquare = -1;
+    if (field(b, e) && !(e - b == 1 && *b == '-')) {
+        if (e - b != 2 || b[0] < 'a' || b[0] > 'h' || (b[1] != '3' && b[1] != '6')) return false;
+        epSquare = static_cast<std::int8_t>((b[1] - '1') * 8 + (b[0] - 'a'));
+    }
+
+    halfmoveClock = 0;
+    fullmoveNumber = 1;
+    if (field(b, e)) {
+        int v = 0;
+        for (; b < e && *b >= '0' && *b <= '9'; ++b) v = v * 10 + (*b - '0');
+        halfmoveClock = static_cast<std::uint16_t>(v);
+    }
+    if (field(b, e)) {
+        int v = 0;
+        for (; b < e && *b >= '0' && *b <= '9'; ++b) v = v * 10 + (*b - '0');
+        fullmoveNumber = static_cast<std::uint16_t>(v ? v : 1);
+    }
+    return true;
+}
+
+// === Queries ===
+
+std::uint8_t Board::PieceAt(int square) const {
+    return squares[square];
+}
+
+Color Board::SideToMove() const {
+    return side;
+}
+
+int Board::EnPassantSquare() const {
+    return epSquare;
+}
+
+std::uint8_t Board::CastlingRights() const {
+    return castling;
+}
+
+bool Board::IsAttacked(int sq, Color by) const {
+    const int f = File(sq), r = Rank(sq);
+
+    // Pawns attack diagonally forward, so look one rank "behind" the square
+    const int pr = by == White ? r - 1 : r + 1;
+    const std::uint8_t pawn = Make(Pawn, by);
+    if (pr >= 0 && pr < 8) {
+        if (f > 0 && squares[pr * 8 + f - 1] == pawn) return true;
+        if (f < 7 && squares[pr * 8 + f + 1] == pawn) return true;
+    }
+
+    const std::uint8_t knight = Make(Knight, by);
+    for (const auto& s : kKnightSteps) {
+        const int nf = f + s[0], nr = r + s[1];
+        if (OnBoard(nf, nr) && squares[nr * 8 + nf] == knight) return true;
+    }
+
+    const std::uint8_t king = Make(King, by);
+    for (const auto& s : kKingSteps) {
+        const int nf = f + s[0], nr = r + s[1];
+        if (OnBoard(nf, nr) && squares[nr * 8 + nf] == king) return true;
+    }
+
+    const std::uint8_t queen = Make(Queen, by);
+    const std::uint8_t rook = Make(Rook, by);
+    const std::uint8_t bishop = Make(Bishop, by);
+    for (const auto& d : kRookDirs) {
+        for (int nf = f + d[0], nr = r + d[1]; OnBoard(nf, nr); nf += d[0], nr += d[1]) {
+            const std::uint8_t p = squares[nr * 8 + nf];
+            if (!p) continue;
+            if (p == rook || p == queen) return true;
+            break;
+        }
+    }
+    for (const auto& d : kBishopDirs) {
+        for (int nf = f + d[0], nr = r + d[1]; OnBoard(nf, nr); nf += d[0], nr += d[1]) {
+            const std::uint8_t p = squares[nr * 8 + nf];
+            if (!p) continue;
+            if (p == bishop || p == queen) return true;
+            break;
+        }
+    }
+    return false;
+}
+
+bool Board::InCheck() const {
+    return IsAttacked(kingSquare[side], static_cast<Color>(side ^ 1));
+}
+
+// === Move generation ===
+
+void Board::AddPawnMoves(int from, Move* out, int& n) const {
+    const int dir = side == White ? 8 : -8;
+    const int startRank = side == White ? 1 : 6;
+    const int lastRank = side == White ? 7 : 0;
+    const int f = File(from);
+
+    auto add = [&](int to, std::uint8_t flags) {
+        if (Rank(to) == lastRank) {
+            for (std::uint8_t promo : {Queen, Rook, Bishop, Knight}) {
+                out[n++] = {static_cast<std::uint8_t>(from), static_cast<std::uint8_t>(to), promo, flags};
+            }
+        } else {
+            out[n++] = {static_cast<std::uint8_t>(from), static_cast<std::uint8_t>(to), NoPieceType, flags};
+        }
+    };
+
+    const int one = from + dir;
+    if (one >= 0 && one < 64 && !squares[one]) {
+        add(one, 0);
+        const int two = one + dir;
+        if (Rank(from) == startRank && !squares[two]) add(two, Move::kDoublePush);
+    }
+    for (int df : {-1, 1}) {
+        if (f + df < 0 || f + df > 7) continue;
+        const int to = one + df;
+        if (to < 0 || to >= 64) continue;
+        if (squares[to] && ColorOf(squares[to]) != side) add(to, Move::kCapture);
+        else if (to == epSquare) add(to, Move::kCapture | Move::kEnPassant);
+    }
+}
+
+void Board::AddCastling(Move* out, int& n) const {
+    const Color enemy = static_cast<Color>(side ^ 1);
+    const int home = side == White ? 0 : 56;
+    const std::uint8_t kingside = side == White ? kWhiteKingside : kBlackKingside;
+    const std::uint8_t queenside = side == White ? kWhiteQueenside : kBlackQueenside;
+    const std::uint8_t rook = Make(Rook, side);
+
+    if (kingSquare[side] != home + 4 || !(castling & (kingside | queenside))) return;
+    if (IsAttacked(home + 4, enemy)) return;
+
+    if ((castling & kingside) && squares[home + 7] == rook && !squares[home + 5] && !squares[home + 6] &&
+        !IsAttacked(home + 5, enemy) && !IsAttacked(home + 6, enemy)) {
+        out[n++] = {static_cast<std::uint8_t>(home + 4), static_cast<std::uint8_t>(home + 6), NoPieceType, Move::kCastle};
+    }
+    if ((castling & queenside) && squares[home] == rook && !squares[home + 1] && !squares[home + 2] &&
+        !squares[home + 3] && !IsAttacked(home + 3, enemy) && !IsAttacked(home + 2, enemy)) {
+        out[n++] = {static_cast<std::uint8_t>(home + 4), static_cast<std::uint8_t>(home + 2), NoPieceType, Move::kCastle};
+    }
+}
+
+int Board::GeneratePseudoLegal(Move* out) const {
+    int n = 0;
+    for (int from = 0; from < 64; ++from) {
+        const std::uint8_t piece = squares[from];
+        if (!piece || ColorOf(piece) != side) continue;
+        const int f = File(from), r = Rank(from);
+
+        auto target = [&](int nf, int nr) {
+            // Returns false when a slider must stop
+            const int to = nr * 8 + nf;
+            const std::uint8_t victim = squares[to];
+            if (!victim) {
+                out[n++] = {static_cast<std::uint8_t>(from), static_cast<std::uint8_t>(to), NoPieceType, 0};
+                return true;
+            }
+            if (ColorOf(victim) != side) {
+                out[n++] = {static_cast<std::uint8_t>(from), static_cast<std::uint8_t>(to), NoPieceType, Move::kCapture};
+            }
+            return false;
+        };
+
+        switch (TypeOf(piece)) {
+            case Pawn:
+                AddPawnMoves(from, out, n);
+                break;
+            case Knight:
+                for (const auto& s : kKnightSteps) {
+                    if (OnBoard(f + s[0], r + s[1])) target(f + s[0], r + s[1]);
+                }
+                break;
+            case King:
+                for (const auto& s : kKingSteps) {
+                    if (OnBoard(f + s[0], r + s[1])) target(f + s[0], r + s[1]);
+                }
+                break;
+            default: {
+                const PieceType type = TypeOf(piece);
+                if (type == Rook || type == Queen) {
+                    for (const auto& d : kRookDirs) {
+                        for (int nf = f + d[0], nr = r + d[1]; OnBoard(nf, nr) && target(nf, nr); nf += d[0], nr += d[1]) {}
+                    }
+                }
+                if (type == Bishop || type == Queen) {
+                    for (const auto& d : kBishopDirs) {
+                        for (int nf = f + d[0], nr = r + d[1]; OnBoard(nf, nr) && target(nf, nr); nf += d[0], nr += d[1]) {}
+                    }
+                }
+                break;
+            }
+        }
+    }
+    AddCastling(out, n);
+    return n;
+}
+
+bool Board::IsLegal(const Move& move) const {
+    Board next = *this;
+    next.MakeMove(move);
+    return !next.IsAttacked(next.kingSquare[side], next.side);
+}
+
+int Board::GenerateLegal(Move* out) const {
+    Move pseudo[kMaxMoves];
+    const int count = GeneratePseudoLegal(pseudo);
+    int n = 0;
+    for (int i = 0; i < count; ++i) {
+        if (IsLegal(pseudo[i])) out[n++] = pseudo[i];
+    }
+    return n;
+}
+
+void Board::MakeMove(const Move& move) {
+    if (move.flags & Move::kNull) {
+        epSquare = -1;
+        halfmoveClock++;
+        if (side == Black) fullmoveNumber++;
+        side = static_cast<Color>(side ^ 1);
+        return;
+    }
+
+    const std::uint8_t piece = squares[move.from];
+    const bool pawnMove = TypeOf(piece) == Pawn;
+
+    if (move.flags & Move::kEnPassant) {
+        squares[move.to + (side == White ? -8 : 8)] = 0;
+    }
+    if (move.flags & Move::kCastle) {
+        const bool kingside = move.to > move.from;
+        const int rookFrom = kingside ? move.from + 3 : move.from - 4;
+        const int rookTo = kingside ? move.from + 1 : move.from - 1;
+        squares[rookTo] = squares[rookFrom];
+        squares[rookFrom] = 0;
+    }
+
+    squares[move.to] = move.promotion ? Make(static_cast<PieceType>(move.promotion), side) : piece;
+    squares[move.from] = 0;
+    if (TypeOf(piece) == King) kingSquare[side] = move.to;
+
+    castling &= static_cast<std::uint8_t>(~(RightsClearedBy(move.from) | RightsClearedBy(move.to)));
+    epSquare = (move.flags & Move::kDoublePush) ? static_cast<std::int8_t>((move.from + move.to) / 2) : -1;
+    halfmoveClock = (pawnMove || (move.flags & Move::kCapture)) ? 0 : halfmoveClock + 1;
+    if (side == Black) fullmoveNumber++;
+    side = static_cast<Color>(side ^ 1);
+}
+
+// === Packed moves ===
+
+namespace {
+
+constexpr PackedMove kPromotionKind = 1 << 14;
+constexpr PackedMove kEnPassantKind = 2 << 14;
+constexpr PackedMove kCastleKind = 3 << 14;
+
+} // namespace
+
+PackedMove Board::Pack(const Move& move) {
+    if (move.flags & Move::kNull) return 0;
+    PackedMove packed = static_cast<PackedMove>(move.from | (move.to << 6));
+    if (move.promotion) packed |= static_cast<PackedMove>(kPromotionKind | ((move.promotion - Knight) << 12));
+    else if (move.flags & Move::kEnPassant) packed |= kEnPassantKind;
+    else if (move.flags & Move::kCastle) packed |= kCastleKind;
+    return packed;
+}
+
+Move Board::Unpack(PackedMove packed) const {
+    if (packed == 0) return {0, 0, NoPieceType, Move::kNull};
+    Move move;
+    move.from = static_cast<std::uint8_t>(packed & 63);
+    move.to = static_cast<std::uint8_t>((packed >> 6) & 63);
+    switch (packed & kCastleKind) {
+        case kPromotionKind:
+            move.promotion = static_cast<std::uint8_t>(Knight + ((packed >> 12) & 3));
+            break;
+        case kEnPassantKind:
+            move.flags = Move::kCapture | Move::kEnPassant;
+            return move;
+        case kCastleKind:
+            move.flags = Move::kCastle;
+            return move;
+        default:
+            break;
+    }
+    if (squares[move.to]) move.flags |= Move::kCapture;
+    if (TypeOf(squares[move.from]) == Pawn && (move.to - move.from == 16 || move.from - move.to == 16)) {
+        move.flags |= Move::kDoublePush;
+    }
+    return move;
+}
+
+// === SAN ===
+
+SanStatus Board::ParseSan(const char* b, const char* e, Move& move) const {
+    // Strip check/mate marks and annotation glyphs
+    while (e > b && (e[-1] == '+' || e[-1] == '#' || e[-1] == '!' || e[-1] == '?')) --e;
+    if (e - b < 2) return SanStatus::Malformed;
+
+    if (e - b == 2 && b[0] == '-' && b[1] == '-') {
+        move = {0, 0, NoPieceType, Move::kNull};
+        return SanStatus::Ok;
+    }
+
+    Move moves[kMaxMoves];
+
+    // Castling: "O-O", "O-O-O" (also written with zeros)
+    if (b[0] == 'O' || b[0] == '0') {
+        const char c = b[0];
+        int len = static_cast<int>(e - b);
+        bool kingside = len == 3 && b[1] == '-' && b[2] == c;
+        bool queenside = len == 5 && b[1] == '-' && b[2] == c && b[3] == '-' && b[4] == c;
+        if (!kingside && !queenside) return SanStatus::Malformed;
+        const int count = GeneratePseudoLegal(moves);
+        for (int i = 0; i < count; ++i) {
+            if ((moves[i].flags & Move::kCastle) && (moves[i].to > moves[i].from) == kingside && IsLegal(moves[i])) {
+                move = moves[i];
+                return SanStatus::Ok;
+            }
+        }
+        return SanStatus::Illegal;
+    }
+
+    PieceType type = PieceFromLetter(b[0]);
+    const char* p = b;
+    if (type != NoPieceType) ++p;
+    else type = Pawn;
+
+    // Promotion suffix: "=Q" or bare "Q" after the destination
+    std::uint8_t promotion = NoPieceType;
+    if (type == Pawn && e - p >= 3) {
+        const PieceType promo = PieceFromLetter(e[-1]);
+        if (promo != NoPieceType && promo != King) {
+            promotion = promo;
+            --e;
+            if (e[-1] == '=') --e;
+        }
+    }
+
+    // Destination is the last two characters
+    if (e - p < 2) return SanStatus::Malformed;
+    const char df = e[-2], dr = e[-1];
+    if (df < 'a' || df > 'h' || dr < '1' || dr > '8') return SanStatus::Malformed;
+    const int to = (dr - '1') * 8 + (df - 'a');
+
+    // Everything in between: disambiguation and capture marks
+    int fromFile = -1, fromRank = -1;
+    for (const char* q = p; q < e - 2; ++q) {
+        if (*q >= 'a' && *q <= 'h') fromFile = *q - 'a';
+        else if (*q >= '1' && *q <= '8') fromRank = *q - '1';
+        else if (*q != 'x' && *q != ':' && *q != '-') return SanStatus::Malformed;
+    }
+    if (type == Pawn && fromFile < 0) fromFile = to & 7;
+
+    const int count = GeneratePseudoLegal(moves);
+    int matches = 0;
+    for (int i = 0; i < count; ++i) {
+        const Move& m = moves[i];
+        if (m.to != to || (m.flags & Move::kCastle) || TypeOf(squares[m.from]) != type) continue;
+        if (fromFile >= 0 && File(m.from) != fromFile) continue;
+        if (fromRank >= 0 && Rank(m.from) != fromRank) continue;
+        if (m.promotion != promotion) continue;
+        if (!IsLegal(m)) continue;
+        if (++matches == 1) move = m;
+    }
+    if (matches == 0) return SanStatus::Illegal;
+    return matches == 1 ? SanStatus::Ok : SanStatus::Ambiguous;
+}
+
+} // namespace chessDataLib
@@ -26,6 +26,20 @@ void DatabaseStats::IncrementResultCount(const std::string& resultRaw) {
     else ++unknownResults;
 }
 
+void DatabaseStats::MergeCounters(const DatabaseStats& other) {
+    totalGames += other.totalGames;
+    whiteWins += other.whiteWins;
+    blackWins += other.blackWins;
+    draws += other.draws;
+    unknownResults += other.unknownResults;
+    parsingTimeSeconds += other.parsingTimeSeconds;
+    histograms.MergeWith(other.histograms);
+}
+
+void DatabaseStats::AddToHistograms(int plies, const std::string& result, int whiteElo, int blackElo) {
+    histograms.AddGame(plies, NormalizeResultToken(result), whiteElo, blackElo);
+}
+
 // === Getters ===
 
 int DatabaseStats::GetTotalGames() const {
@@ -84,14 +98,18 @@ const std::vector<std::string>& DatabaseStats::GetPlayerNames() const {
     return playerNames;
 }
 
-const std::unordered_map<std::string, Player>& DatabaseStats::GetPlayerStats() const {
+const utils::StringMap<Player>& DatabaseStats::GetPlayerStats() const {
     return playerStats;
 }
 
-const std::unordered_map<std::string, Tournament>& DatabaseStats::GetTournaments() const {
+const utils::StringMap<Tournament>& DatabaseStats::GetTournaments() const {
     return tournaments;
 }
 
+const GameHistograms& DatabaseStats::GetHistograms() const {
+    return histograms;
+}
+
 // === Setters ===
 
 void DatabaseStats::SetTotalGames(int val) {
@@ -150,14 +168,18 @@ void DatabaseStats::SetPlayerNames(const std::vector<std::string>& val) {
     playerNames = val;
 }
 
-void DatabaseStats::SetPlayerStats(const std::unordered_map<std::string, Player>& val) {
+void DatabaseStats::SetPlayerStats(const utils::StringMap<Player>& val) {
     playerStats = val;
 }
 
-void DatabaseStats::SetTournaments(const std::unordered_map<std::string, Tournament>& val) {
+void DatabaseStats::SetTournaments(const utils::StringMap<Tournament>& val) {
     tournaments = val;
 }
 
+void DatabaseStats::SetHistograms(const GameHistograms& val) {
+    histograms = val;
+}
+
 // === Helpers ===
 
 void DatabaseStats::AddTournament(const std::string& name, const Tournament& tournament) {
@@ -172,6 +194,23 @@ void DatabaseStats::AddTournament(const std::string& name, const Tournament& tou
     }
 }
 
+// === Memory accounting ===
+
+MemoryUsage DatabaseStats::GetMemoryUsage() const {
+    MemoryUsage usage;
+    utils::AccountString(mostActivePlayer, usage);
+    utils::AccountString(largestTournament, usage);
+    utils::AccountStrings(tournamentNames, usage);
+    utils::AccountStrings(playerNames, usage);
+    utils::AccountHashMap(playerStats, usage, [](const Player& p, MemoryUsage& u) {
+        u += p.GetMemoryUsage();
+    });
+    utils::AccountHashMap(tournaments, usage, [](const Tournament& t, MemoryUsage& u) {
+        u += t.GetMemoryUsage();
+    });
+    return usage;
+}
+
 void DatabaseStats::AddPlayer(const std::string& name, const Player& stats) {
     playerStats[name] = stats;
     playerNames.push_back(name);
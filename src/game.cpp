@@ -1,4 +1,5 @@
 #include "game.hpp"
+#include "utils/date.hpp"
 
 namespace chessDataLib {
 
@@ -16,6 +17,10 @@ const std::string& Game::GetDate() const {
     return date;
 }
 
+std::uint32_t Game::GetPackedDate() const {
+    return packedDate;
+}
+
 const std::string& Game::GetRound() const {
     return round;
 }
@@ -52,6 +57,34 @@ int Game::GetMoveCount() const {
     return moveCount;
 }
 
+int Game::GetPlyCount() const {
+    return plyCount;
+}
+
+const std::vector<int32_t>& Game::GetClocks() const {
+    return clocks;
+}
+
+const std::vector<int32_t>& Game::GetEvals() const {
+    return evals;
+}
+
+bool Game::HasMoveText() const {
+    return moveTextRef.source != MoveTextRef::kNoSource;
+}
+
+const MoveTextRef& Game::GetMoveTextRef() const {
+    return moveTextRef;
+}
+
+bool Game::HasMoves() const {
+    return movesRef.offset != MovesRef::kNone;
+}
+
+const MovesRef& Game::GetMovesRef() const {
+    return movesRef;
+}
+
 // === Setters ===
 
 void Game::SetEvent(const std::string& val) {
@@ -64,6 +97,7 @@ void Game::SetSite(const std::string& val) {
 
 void Game::SetDate(const std::string& val) {
     date = val;
+    packedDate = utils::PackDate(val);
 }
 
 void Game::SetRound(const std::string& val) {
@@ -102,6 +136,26 @@ void Game::SetMoveCount(int val) {
     moveCount = val;
 }
 
+void Game::SetPlyCount(int val) {
+    plyCount = val;
+}
+
+void Game::SetClocks(std::vector<int32_t> val) {
+    clocks = std::move(val);
+}
+
+void Game::SetEvals(std::vector<int32_t> val) {
+    evals = std::move(val);
+}
+
+void Game::SetMoveTextRef(MoveTextRef val) {
+    moveTextRef = std::move(val);
+}
+
+void Game::SetMovesRef(MovesRef val) {
+    movesRef = std::move(val);
+}
+
 // === Result helpers ===
 
 bool Game::IsWhiteWin() const {
@@ -120,4 +174,16 @@ bool Game::IsUnknownResult() const {
     return result == "*";
 }
 
+// === Memory accounting ===
+
+MemoryUsage Game::GetMemoryUsage() const {
+    MemoryUsage usage;
+    for (const std::string* s : {&event, &site, &date, &round, &white, &black,
+                                 &result, &whiteElo, &blackElo, &eco, &opening}) {
+        utils::AccountString(*s, usage);
+    }
+    usage.containerBytes += (clocks.capacity() + evals.capacity()) * sizeof(int32_t);
+    return usage;
+}
+
 } // namespace chessDataLib
@@ -0,0 +1,130 @@
+#include "gameHistograms.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace chessDataLib {
+
+// === RatingGapBin ===
+
+double RatingGapBin::GetDecisiveRate() const {
+    return games ? 100.0 * (whiteWins + blackWins) / games : 0.0;
+}
+
+double RatingGapBin::GetExpectedScore() const {
+    return games ? expectedMicros / 1e6 / games : 0.0;
+}
+
+double RatingGapBin::GetActualScore() const {
+    return games ? (whiteWins + 0.5 * draws) / games : 0.0;
+}
+
+// === Binning ===
+
+GameHistograms::Outcome GameHistograms::OutcomeOf(const std::string& result) {
+    if (result == "1-0") return Outcome::WhiteWin;
+    if (result == "1/2-1/2") return Outcome::Draw;
+    if (result == "0-1") return Outcome::BlackWin;
+    return Outcome::Unfinished;
+}
+
+int GameHistograms::PlyBinOf(int plies) {
+    return std::clamp(plies / kPlyBinWidth, 0, kPlyBins - 1);
+}
+
+int GameHistograms::GapBinOf(int gap) {
+    // Shift before dividing so negative gaps round down
+    return std::clamp((std::clamp(gap, -kGapRange, kGapRange) + kGapRange) / kGapBinWidth, 0, kGapBins - 1);
+}
+
+int GameHistograms::GapBinStart(int bin) {
+    return -kGapRange + bin * kGapBinWidth;
+}
+
+// === Updates ===
+
+void GameHistograms::AddGame(int plies, const std::string& result, int whiteElo, int blackElo) {
+    const Outcome outcome = OutcomeOf(result);
+    const int o = static_cast<int>(outcome);
+    lengths[o][PlyBinOf(plies)]++;
+    plySums[o] += static_cast<std::uint64_t>(std::max(0, plies));
+
+    if (outcome == Outcome::Unfinished || whiteElo <= 0 || blackElo <= 0) return;
+    const int gap = whiteElo - blackElo;
+    RatingGapBin& bin = gaps[GapBinOf(gap)];
+    bin.games++;
+    if (outcome == Outcome::WhiteWin) bin.whiteWins++;
+    else if (outcome == Outcome::Draw) bin.draws++;
+    else bin.blackWins++;
+    // Fixed point keeps merged sums independent of the order games arrive in
+    const double expected = 1.0 / (1.0 + std::pow(10.0, -gap / 400.0));
+    bin.expectedMicros += static_cast<std::uint64_t>(std::llround(expected * 1e6));
+}
+
+void GameHistograms::MergeWith(const GameHistograms& other) {
+    for (int o = 0; o < kOutcomes; ++o) {
+        for (int b = 0; b < kPlyBins; ++b) lengths[o][b] += other.lengths[o][b];
+        plySums[o] += other.plySums[o];
+    }
+    for (int b = 0; b < kGapBins; ++b) {
+        gaps[b].games += other.gaps[b].games;
+        gaps[b].whiteWins += other.gaps[b].whiteWins;
+        gaps[b].draws += other.gaps[b].draws;
+        gaps[b].blackWins += other.gaps[b].blackWins;
+        gaps[b].expectedMicros += other.gaps[b].expectedMicros;
+    }
+}
+
+// === Queries ===
+
+std::uint64_t GameHistograms::GetGames() const {
+    std::uint64_t games = 0;
+    for (const auto& histogram : lengths) {
+        for (const std::uint64_t count : histogram) games += count;
+    }
+    return games;
+}
+
+GameHistograms::LengthHistogram GameHistograms::GetLengthHistogram() const {
+    LengthHistogram total{};
+    for (const auto& histogram : lengths) {
+        for (int b = 0; b < kPlyBins; ++b) total[b] += histogram[b];
+    }
+    return total;
+}
+
+const GameHistograms::LengthHistogram& GameHistograms::GetLengthHistogram(Outcome outcome) const {
+    return lengths[static_cast<int>(outcome)];
+}
+
+std::uint64_t GameHistograms::GetPlySum(Outcome outcome) const {
+    return plySums[static_cast<int>(outcome)];
+}
+
+double GameHistograms::GetAverageLength() const {
+    std::uint64_t plies = 0;
+    for (const std::uint64_t sum : plySums) plies += sum;
+    const std::uint64_t games = GetGames();
+    return games ? static_cast<double>(plies) / games : 0.0;
+}
+
+double GameHistograms::GetAverageLength(Outcome outcome) const {
+    const LengthHistogram& histogram = GetLengthHistogram(outcome);
+    std::uint64_t games = 0;
+    for (const std::uint64_t count : histogram) games += count;
+    return games ? static_cast<double>(GetPlySum(outcome)) / games : 0.0;
+}
+
+const GameHistograms::RatingGapHistogram& GameHistograms::GetRatingGaps() const {
+    return gaps;
+}
+
+void GameHistograms::SetLengthHistogram(Outcome outcome, const LengthHistogram& counts, std::uint64_t plySum) {
+    lengths[static_cast<int>(outcome)] = counts;
+    plySums[static_cast<int>(outcome)] = plySum;
+}
+
+void GameHistograms::SetRatingGaps(const RatingGapHistogram& val) {
+    gaps = val;
+}
+
+} // namespace chessDataLib
@@ -0,0 +1,151 @@
+#include "gameIndex.hpp"
+#include "utils/binaryIO.hpp"
+#include "utils/scan.hpp"
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
+namespace chessDataLib {
+
+namespace {
+
+constexpr std::uint32_t kIndexMagic = 0x494c4443; // "CDLI"
+constexpr std::uint32_t kIndexVersion = 1;
+constexpr std::size_t kScanBlock = 4 << 20;
+constexpr std::size_t kLookBack = 3;
+
+} // namespace
+
+bool GameIndex::Build(const std::string& filename) {
+    FileIdentity identity;
+    if (!FileIdentity::FromFile(filename, identity)) return false;
+    std::ifstream in(filename, std::ios::binary);
+    if (!in.is_open()) return false;
+
+    offsets.clear();
+    source = identity;
+
+    // Each block is prefixed with the last kLookBack bytes of the previous one,
+    // so boundaries straddling two blocks are still recognized
+    std::vector<char> buf(kLookBack + kScanBlock);
+    std::size_t carried = 0;
+    std::uint64_t blockStart = 0;
+    bool first = true;
+
+    while (in) {
+        in.read(buf.data() + carried, static_cast<std::streamsize>(kScanBlock));
+        const std::size_t got = static_cast<std::size_t>(in.gcount());
+        if (got == 0) break;
+        const char* begin = buf.data();
+        const char* end = begin + carried + got;
+        const char* p = begin + carried;
+
+        if (first) {
+            const char* q = utils::FindFirstGame(p, end);
+            if (q != end) {
+                offsets.push_back(static_cast<std::uint64_t>(q - begin));
+                p = q + 1;
+            }
+            first = false;
+        }
+
+        while ((p = utils::FindGameStart(begin, p, end)) != end) {
+            offsets.push_back(blockStart + static_cast<std::uint64_t>(p - begin) - carried);
+            ++p;
+        }
+
+        const std::size_t keep = std::min<std::size_t>(kLookBack, carried + got);
+        std::copy(end - keep, end, buf.data());
+        blockStart += got;
+        carried = keep;
+    }
+    return true;
+}
+
+bool GameIndex::Save(const std::string& filename) const {
+    utils::BinaryWriter w;
+    w.U32(kIndexMagic);
+    w.U32(kIndexVersion);
+    w.Str(source.path);
+    w.U64(source.size);
+    w.U64(static_cast<std::uint64_t>(source.mtime));
+    w.U64(source.hash);
+    w.VarU(offsets.size());
+    std::uint64_t prev = 0;
+    for (std::uint64_t off : offsets) {
+        w.VarU(off - prev); // delta-encoded: typically 2 bytes per game
+        prev = off;
+    }
+
+    std::ofstream out(filename, std::ios::binary | std::ios::trunc);
+    if (!out.is_open()) return false;
+    out.write(w.Data().data(), static_cast<std::streamsize>(w.Data().size()));
+    return static_cast<bool>(out);
+}
+
+bool GameIndex::Load(const std::string& filename) {
+    std::ifstream in(filename, std::ios::binary);
+    if (!in.is_open()) return false;
+    std::ostringstream buf;
+    buf << in.rdbuf();
+    const std::string blob = buf.str();
+
+    utils::BinaryReader r(blob.data(), blob.size());
+    std::uint32_t magic = 0, version = 0;
+    if (!r.U32(magic) || !r.U32(version) || magic != kIndexMagic || version != kIndexVersion) return false;
+
+    FileIdentity identity;
+    std::uint64_t mtime = 0, count = 0;
+    r.Str(identity.path);
+    r.U64(identity.size);
+    r.U64(mtime);
+    r.U64(identity.hash);
+    identity.mtime = static_cast<std::int64_t>(mtime);
+    if (!r.VarU(count) || count > blob.size()) return false;
+
+    std::vector<std::uint64_t> loaded;
+    loaded.reserve(static_cast<std::size_t>(count));
+    std::uint64_t off = 0;
+    for (std::uint64_t i = 0; i < count; ++i) {
+        std::uint64_t delta = 0;
+        if (!r.VarU(delta)) return false;
+        off += delta;
+        loaded.push_back(off);
+    }
+    if (!r.AtEnd()) return false;
+
+    source = identity;
+    offsets = std::move(loaded);
+    return true;
+}
+
+bool GameIndex::LoadOrBuild(const std::string& filename) {
+    FileIdentity current;
+    if (!FileIdentity::FromFile(filename, current)) return false;
+
+    const std::string sidecar = SidecarPath(filename);
+    if (Load(sidecar) && source == current) return true;
+
+    if (!Build(filename)) return false;
+    Save(sidecar); // a read-only directory only costs a rebuild next time
+    return true;
+}
+
+std::string GameIndex::SidecarPath(const std::string& filename) {
+    return filename + ".idx";
+}
+
+std::size_t GameIndex::Size() const {
+    return offsets.size();
+}
+
+GameLocation GameIndex::At(std::size_t index) const {
+    const std::uint64_t next = index + 1 < offsets.size() ? offsets[index + 1] : source.size;
+    return {offsets[index], next - offsets[index]};
+}
+
+const FileIdentity& GameIndex::GetSource() const {
+    return source;
+}
+
+} // namespace chessDataLib
@@ -0,0 +1,206 @@
+#include "gameSampler.hpp"
+#include "PGNGameBuilder.hpp"
+#include "PGNTagParser.hpp"
+#include "PGNTokenizer.hpp"
+#include "sourceMapping.hpp"
+#include "utils/reservoir.hpp"
+#include "utils/scan.hpp"
+#include <algorithm>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <unordered_set>
+
+namespace chessDataLib {
+
+namespace {
+
+// A sampled game: input file and offset of its first tag line
+struct Location {
+    std::size_t file = 0;
+    std::uint64_t offset = 0;
+};
+
+int LeadingInt(const std::string& s, std::size_t& i) {
+    int value = 0;
+    const std::size_t start = i;
+    while (i < s.size() && i - start < 9 && s[i] >= '0' && s[i] <= '9') value = value * 10 + (s[i++] - '0');
+    return value;
+}
+
+const std::string* FindTag(const std::unordered_map<std::string, std::string>& tags, const char* name) {
+    const auto it = tags.find(name);
+    return it == tags.end() ? nullptr : &it->second;
+}
+
+// Stable across platforms, unlike std::hash
+std::uint64_t Fnv1a(const std::string& s) {
+    std::uint64_t h = 14695981039346656037ull;
+    for (unsigned char c : s) h = (h ^ c) * 1099511628211ull;
+    return h;
+}
+
+// Maps the inputs; failed ones stay null
+bool MapInputs(const std::vector<std::string>& filenames, const char* caller,
+               std::vector<std::shared_ptr<SourceMapping>>& sources) {
+    bool allOpened = true;
+    sources.assign(filenames.size(), nullptr);
+    for (std::size_t f = 0; f < filenames.size(); ++f) {
+        sources[f] = SourceMapping::Open(filenames[f]);
+        if (!sources[f]) {
+            std::cerr << caller << ": failed to open " << filenames[f] << "\n";
+            allOpened = false;
+        }
+    }
+    return allOpened;
+}
+
+// Builds the games at the given locations, in input order; a file enters the
+// table (ids[file]) when its first game is built
+std::vector<Game> BuildGames(std::vector<Location> locations, const std::vector<std::shared_ptr<SourceMapping>>& mapped,
+                             SourceTable* sources, std::vector<std::uint32_t>& ids) {
+    std::sort(locations.begin(), locations.end(), [](const Location& a, const Location& b) {
+        return a.file != b.file ? a.file < b.file : a.offset < b.offset;
+    });
+    std::vector<Game> games;
+    games.reserve(locations.size());
+    for (const Location& loc : locations) {
+        const std::shared_ptr<SourceMapping>& source = mapped[loc.file];
+        PGNTokenizer tokenizer(source->Data() + loc.offset, static_cast<std::size_t>(source->Size() - loc.offset),
+                               loc.offset);
+        if (!tokenizer.NextGame()) continue;
+        Game game = PGNGameBuilder::Build(PGNTagParser::Parse(tokenizer.GetCurrentTagLines()),
+                                          tokenizer.GetCurrentMoveText());
+        if (sources) {
+            if (ids[loc.file] == MoveTextRef::kNoSource) ids[loc.file] = sources->Add(source);
+            game.SetMoveTextRef({tokenizer.GetCurrentMoveTextOffset(),
+                                 static_cast<std::uint32_t>(tokenizer.GetCurrentMoveTextLength()), ids[loc.file]});
+        }
+        games.push_back(std::move(game));
+    }
+    return games;
+}
+
+} // namespace
+
+// === Strata ===
+
+GameSampler::StratumFunction GameSampler::ByEloBand(int width) {
+    width = std::max(1, width);
+    return [width](const std::unordered_map<std::string, std::string>& tags) -> std::string {
+        const std::string* white = FindTag(tags, "WhiteElo");
+        const std::string* black = FindTag(tags, "BlackElo");
+        std::size_t i = 0, j = 0;
+        const int w = white ? LeadingInt(*white, i) : 0;
+        const int b = black ? LeadingInt(*black, j) : 0;
+        if (w <= 0 || b <= 0) return "unrated";
+        const int low = (w + b) / 2 / width * width;
+        return std::to_string(low) + "-" + std::to_string(low + width - 1);
+    };
+}
+
+GameSampler::StratumFunction GameSampler::ByYear() {
+    return [](const std::unordered_map<std::string, std::string>& tags) -> std::string {
+        const std::string* date = FindTag(tags, "Date");
+        if (!date || date->size() < 4) return "unknown";
+        for (int i = 0; i < 4; ++i) {
+            if ((*date)[i] < '0' || (*date)[i] > '9') return "unknown";
+        }
+        return date->substr(0, 4);
+    };
+}
+
+GameSampler::StratumFunction GameSampler::ByTimeControl() {
+    return [](const std::unordered_map<std::string, std::string>& tags) -> std::string {
+        const std::string* tc = FindTag(tags, "TimeControl");
+        if (!tc) return "unknown";
+        std::size_t i = 0;
+        const int base = LeadingInt(*tc, i);
+        if (i == 0) return "unknown";
+        if (i < tc->size() && (*tc)[i] == '/') return "classical";  // "40/7200": moves per period
+        int increment = 0;
+        if (i < tc->size() && (*tc)[i] == '+') increment = LeadingInt(*tc, ++i);
+        const long long seconds = base + 40ll * increment;
+        if (seconds < 180) return "bullet";
+        if (seconds < 480) return "blitz";
+        if (seconds < 1500) return "rapid";
+        return "classical";
+    };
+}
+
+void GameSampler::SetSeed(std::uint64_t value) {
+    seed = value;
+}
+
+// === Sampling ===
+
+bool GameSampler::SampleUniform(const std::vector<std::string>& filenames, std::size_t count,
+                                std::vector<Game>& games, SourceTable* sources) const {
+    std::vector<std::shared_ptr<SourceMapping>> mapped;
+    const bool allOpened = MapInputs(filenames, "SampleUniform", mapped);
+
+    utils::Reservoir<Location> reservoir(count, seed);
+    for (std::size_t f = 0; f < mapped.size(); ++f) {
+        if (!mapped[f]) continue;
+        const char* data = mapped[f]->Data();
+        const char* end = data + mapped[f]->Size();
+
+        for (const char* p = utils::FindFirstGame(data, end); p != end; p = utils::FindGameStart(data, p + 1, end)) {
+            reservoir.Offer({f, static_cast<std::uint64_t>(p - data)});
+        }
+    }
+
+    std::vector<std::uint32_t> ids(mapped.size(), MoveTextRef::kNoSource);
+    games = BuildGames(std::move(reservoir.Items()), mapped, sources, ids);
+    return allOpened;
+}
+
+bool GameSampler::SampleStratified(const std::vector<std::string>& filenames, std::size_t countPerStratum,
+                                   const StratumFunction& stratum,
+                                   std::map<std::string, std::vector<Game>>& samples, SourceTable* sources) const {
+    std::vector<std::shared_ptr<SourceMapping>> mapped;
+    const bool allOpened = MapInputs(filenames, "SampleStratified", mapped);
+
+    std::map<std::string, utils::Reservoir<Location>> reservoirs;
+    for (std::size_t f = 0; f < mapped.size(); ++f) {
+        if (!mapped[f]) continue;
+        PGNTokenizer tokenizer(mapped[f]->Data(), static_cast<std::size_t>(mapped[f]->Size()));
+        while (tokenizer.NextGame()) {
+            const std::string key = stratum(PGNTagParser::Parse(tokenizer.GetCurrentTagLines()));
+            auto it = reservoirs.find(key);
+            if (it == reservoirs.end()) {
+                it = reservoirs.emplace(key, utils::Reservoir<Location>(countPerStratum, seed ^ Fnv1a(key))).first;
+            }
+            it->second.Offer({f, tokenizer.GetCurrentGameOffset()});
+        }
+    }
+
+    samples.clear();
+    std::vector<std::uint32_t> ids(mapped.size(), MoveTextRef::kNoSource);
+    for (auto& kv : reservoirs) samples.emplace(kv.first, BuildGames(std::move(kv.second.Items()), mapped, sources, ids));
+    return allOpened;
+}
+
+std::vector<std::size_t> GameSampler::SampleIndices(const GameIndex& index, std::size_t count) const {
+    const std::size_t n = index.Size();
+    std::vector<std::size_t> chosen;
+    if (count >= n) {
+        chosen.resize(n);
+        for (std::size_t i = 0; i < n; ++i) chosen[i] = i;
+        return chosen;
+    }
+
+    // Floyd: one draw per chosen element, no pass over the n candidates
+    std::mt19937_64 rng(seed);
+    std::unordered_set<std::size_t> picked;
+    picked.reserve(count * 2);
+    for (std::size_t j = n - count; j < n; ++j) {
+        const std::size_t t = std::uniform_int_distribution<std::size_t>(0, j)(rng);
+        picked.insert(picked.count(t) ? j : t);
+    }
+    chosen.assign(picked.begin(), picked.end());
+    std::sort(chosen.begin(), chosen.end());
+    return chosen;
+}
+
+} // namespace chessDataLib
@@ -0,0 +1,200 @@
+#include "headToHead.hpp"
+#include "utils/csv.hpp"
+#include "utils/workStealingPool.hpp"
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+
+namespace chessDataLib {
+
+namespace {
+
+constexpr std::size_t kRowBlock = 64;
+
+PairRecord Flip(const PairRecord& r) {
+    return {r.games, r.losses, r.wins, r.draws};
+}
+
+// Append "score/games" with half points, e.g. "3.5/6"
+void AppendCell(std::string& out, float score, std::uint32_t games) {
+    const unsigned halves = static_cast<unsigned>(score * 2.0f + 0.5f);
+    out += std::to_string(halves / 2);
+    if (halves & 1) out += ".5";
+    out += '/';
+    out += std::to_string(games);
+}
+
+} // namespace
+
+// === PairRecord ===
+
+double PairRecord::GetScore() const {
+    return wins + 0.5 * draws;
+}
+
+// === Matrix ===
+
+std::size_t HeadToHead::Matrix::Size() const {
+    return players.size();
+}
+
+// === HeadToHead ===
+
+std::uint32_t HeadToHead::Intern(const std::string& name) {
+    auto it = ids.find(name);
+    if (it != ids.end()) return it->second;
+    const auto id = static_cast<std::uint32_t>(names.size());
+    ids.emplace(name, id);
+    names.push_back(name);
+    return id;
+}
+
+std::uint64_t HeadToHead::Key(std::uint32_t a, std::uint32_t b) {
+    return (static_cast<std::uint64_t>(std::min(a, b)) << 32) | std::max(a, b);
+}
+
+void HeadToHead::AddGame(const std::string& white, const std::string& black, const std::string& result) {
+    const std::uint32_t w = Intern(white);
+    const std::uint32_t b = Intern(black);
+    if (w == b) return;
+
+    PairRecord& r = pairs[Key(w, b)];
+    const bool whiteIsFirst = w < b;
+    r.games++;
+    if (result == "1-0") (whiteIsFirst ? r.wins : r.losses)++;
+    else if (result == "0-1") (whiteIsFirst ? r.losses : r.wins)++;
+    else if (result == "1/2-1/2") r.draws++;
+}
+
+void HeadToHead::MergeWith(const HeadToHead& other) {
+    std::vector<std::uint32_t> remap(other.names.size());
+    for (std::size_t i = 0; i < other.names.size(); ++i) remap[i] = Intern(other.names[i]);
+    AddPairs(other, remap);
+}
+
+void HeadToHead::MergeAliases(const utils::StringMap<std::string>& aliases) {
+    HeadToHead merged;
+    std::vector<std::uint32_t> remap(names.size());
+    for (std::size_t i = 0; i < names.size(); ++i) {
+        auto it = aliases.find(names[i]);
+        remap[i] = merged.Intern(it == aliases.end() ? names[i] : it->second);
+    }
+    merged.AddPairs(*this, remap);
+    *this = std::move(merged);
+}
+
+// Adds the pairs of other with its player IDs mapped to this table's
+void HeadToHead::AddPairs(const HeadToHead& other, const std::vector<std::uint32_t>& remap) {
+    for (const auto& kv : other.pairs) {
+        const std::uint32_t a = remap[kv.first >> 32];
+        const std::uint32_t b = remap[kv.first & 0xffffffffu];
+        if (a == b) continue;
+        const PairRecord add = a < b ? kv.second : Flip(kv.second);
+        PairRecord& r = pairs[Key(a, b)];
+        r.games += add.games;
+        r.wins += add.wins;
+        r.losses += add.losses;
+        r.draws += add.draws;
+    }
+}
+
+bool HeadToHead::GetRecord(const std::string& a, const std::string& b, PairRecord& record) const {
+    auto ia = ids.find(a);
+    auto ib = ids.find(b);
+    if (ia == ids.end() || ib == ids.end()) return false;
+    auto it = pairs.find(Key(ia->second, ib->second));
+    if (it == pairs.end()) return false;
+    record = ia->second < ib->second ? it->second : Flip(it->second);
+    return true;
+}
+
+std::size_t HeadToHead::GetPlayerCount() const {
+    return names.size();
+}
+
+std::size_t HeadToHead::GetPairCount() const {
+    return pairs.size();
+}
+
+HeadToHead::Matrix HeadToHead::BuildMatrix(const std::vector<std::string>& players, unsigned threads) const {
+    Matrix m;
+    m.players = players;
+    const std::size_t n = players.size();
+    m.scores.assign(n * n, 0.0f);
+    m.games.assign(n * n, 0);
+    if (n == 0) return m;
+
+    // Global ID -> row, then bucket the pairs inside the set by row so each
+    // row block can be filled independently with sequential writes
+    std::vector<std::int32_t> local(names.size(), -1);
+    for (std::size_t i = 0; i < n; ++i) {
+        auto it = ids.find(players[i]);
+        if (it != ids.end()) local[it->second] = static_cast<std::int32_t>(i);
+    }
+
+    struct Cell {
+        std::uint32_t col;
+        const PairRecord* record;
+        bool flipped;
+    };
+    std::vector<std::vector<Cell>> rows(n);
+    for (const auto& kv : pairs) {
+        const std::int32_t a = local[kv.first >> 32];
+        const std::int32_t b = local[kv.first & 0xffffffffu];
+        if (a < 0 || b < 0) continue;
+        rows[a].push_back({static_cast<std::uint32_t>(b), &kv.second, false});
+        rows[b].push_back({static_cast<std::uint32_t>(a), &kv.second, true});
+    }
+
+    utils::WorkStealingPool pool(threads);
+    pool.Run((n + kRowBlock - 1) / kRowBlock, [&](std::size_t block, unsigned) {
+        const std::size_t end = std::min(n, (block + 1) * kRowBlock);
+        for (std::size_t i = block * kRowBlock; i < end; ++i) {
+            float* scoreRow = m.scores.data() + i * n;
+            std::uint32_t* gameRow = m.games.data() + i * n;
+            for (const Cell& c : rows[i]) {
+                const PairRecord r = c.flipped ? Flip(*c.record) : *c.record;
+                scoreRow[c.col] = static_cast<float>(r.GetScore());
+                gameRow[c.col] = r.games;
+            }
+        }
+    });
+    return m;
+}
+
+bool HeadToHead::ExportCrosstableCSV(const std::string& filename, const std::vector<std::string>& players,
+                                     unsigned threads) const {
+    std::ofstream ofs(filename, std::ios::binary);
+    if (!ofs.is_open()) {
+        std::cerr << "ExportCrosstableCSV: failed to open " << filename << "\n";
+        return false;
+    }
+
+    const Matrix m = BuildMatrix(players, threads);
+    const std::size_t n = m.Size();
+
+    ofs << "Player";
+    for (const auto& name : players) ofs << ',' << utils::EscapeCSVField(name);
+    ofs << '\n';
+
+    // Rows are formatted in parallel blocks and written in order
+    std::vector<std::string> lines(n);
+    utils::WorkStealingPool pool(threads);
+    pool.Run((n + kRowBlock - 1) / kRowBlock, [&](std::size_t block, unsigned) {
+        const std::size_t end = std::min(n, (block + 1) * kRowBlock);
+        for (std::size_t i = block * kRowBlock; i < end; ++i) {
+            std::string& line = lines[i];
+            line.reserve(n * 4 + players[i].size() + 1);
+            line += utils::EscapeCSVField(players[i]);
+            for (std::size_t j = 0; j < n; ++j) {
+                line += ',';
+                if (m.games[i * n + j]) AppendCell(line, m.scores[i * n + j], m.games[i * n + j]);
+            }
+            line += '\n';
+        }
+    });
+    for (const auto& line : lines) ofs.write(line.data(), static_cast<std::streamsize>(line.size()));
+    return static_cast<bool>(ofs);
+}
+
+} // namespace chessDataLib
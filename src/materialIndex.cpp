@@ -0,0 +1,258 @@
+#include "materialIndex.hpp"
+#include <algorithm>
+
+namespace chessDataLib {
+
+namespace {
+
+// Nibble slots within one color's 24 bits
+enum Slot : int { PawnSlot, KnightSlot, LightBishopSlot, DarkBishopSlot, RookSlot, QueenSlot, kSlots };
+
+constexpr int kColorShift = 4 * kSlots;
+constexpr MaterialKey kColorMask = (MaterialKey(1) << kColorShift) - 1;
+constexpr char kSlotLetters[kSlots] = {'P', 'N', 'B', 'B', 'R', 'Q'};
+
+int Shift(Color color, int slot) {
+    return color * kColorShift + 4 * slot;
+}
+
+int Nibble(MaterialKey key, Color color, int slot) {
+    return static_cast<int>((key >> Shift(color, slot)) & 0xF);
+}
+
+void Increment(MaterialKey& key, Color color, int slot) {
+    if (Nibble(key, color, slot) < 15) key += MaterialKey(1) << Shift(color, slot);
+}
+
+int SlotOf(PieceType type, int square) {
+    switch (type) {
+        case Pawn: return PawnSlot;
+        case Knight: return KnightSlot;
+        case Bishop: return ((square & 7) + (square >> 3)) & 1 ? LightBishopSlot : DarkBishopSlot;
+        case Rook: return RookSlot;
+        case Queen: return QueenSlot;
+        default: return -1;
+    }
+}
+
+bool ByGameAndPly(const MaterialPosting& a, const MaterialPosting& b) {
+    return a.game != b.game ? a.game < b.game : a.firstPly < b.firstPly;
+}
+
+} // namespace
+
+// === Signatures ===
+
+MaterialKey MaterialIndex::KeyOf(const Board& board) {
+    MaterialKey key = 0;
+    for (int sq = 0; sq < 64; ++sq) {
+        const std::uint8_t piece = board.PieceAt(sq);
+        if (!piece) continue;
+        const int slot = SlotOf(static_cast<PieceType>(piece & 7), sq);
+        if (slot >= 0) Increment(key, static_cast<Color>(piece >> 3), slot);
+    }
+    return key;
+}
+
+int MaterialIndex::Count(MaterialKey key, Color color, PieceType type) {
+    switch (type) {
+        case Pawn: return Nibble(key, color, PawnSlot);
+        case Knight: return Nibble(key, color, KnightSlot);
+        case Bishop: return Nibble(key, color, LightBishopSlot) + Nibble(key, color, DarkBishopSlot);
+        case Rook: return Nibble(key, color, RookSlot);
+        case Queen: return Nibble(key, color, QueenSlot);
+        case King: return 1;
+        default: return 0;
+    }
+}
+
+int MaterialIndex::BishopCount(MaterialKey key, Color color, bool lightSquares) {
+    return Nibble(key, color, lightSquares ? LightBishopSlot : DarkBishopSlot);
+}
+
+MaterialKey MaterialIndex::Mirror(MaterialKey key) {
+    return ((key & kColorMask) << kColorShift) | ((key >> kColorShift) & kColorMask);
+}
+
+MaterialKey MaterialIndex::Normalize(MaterialKey key) {
+    for (Color color : {White, Black}) {
+        const int bishops = std::min(15, Count(key, color, Bishop));
+        key &= ~((MaterialKey(0xF) << Shift(color, LightBishopSlot)) | (MaterialKey(0xF) << Shift(color, DarkBishopSlot)));
+        key |= MaterialKey(bishops) << Shift(color, DarkBishopSlot);
+    }
+    return key;
+}
+
+std::string MaterialIndex::ToString(MaterialKey key) {
+    std::string text;
+    for (Color color : {White, Black}) {
+        if (color == Black) text += 'v';
+        text += 'K';
+        // Strongest pieces first, as in "KQRvKR"
+        for (int slot : {QueenSlot, RookSlot, LightBishopSlot, DarkBishopSlot, KnightSlot, PawnSlot}) {
+            text.append(static_cast<std::size_t>(Nibble(key, color, slot)), kSlotLetters[slot]);
+        }
+    }
+    return text;
+}
+
+bool MaterialIndex::ParseSignature(const std::string& text, MaterialKey& key) {
+    key = 0;
+    Color color = White;
+    bool expectKing = true;
+    for (char c : text) {
+        if (expectKing) {
+            if (c != 'K') return false;
+            expectKing = false;
+            continue;
+        }
+        int slot;
+        switch (c) {
+            case 'P': slot = PawnSlot; break;
+            case 'N': slot = KnightSlot; break;
+            case 'B': slot = DarkBishopSlot; break;
+            case 'R': slot = RookSlot; break;
+            case 'Q': slot = QueenSlot; break;
+            case 'v':
+                if (color == Black) return false;
+                color = Black;
+                expectKing = true;
+                continue;
+            default: return false;
+        }
+        if (Nibble(key, color, slot) == 15) return false;
+        Increment(key, color, slot);
+    }
+    return color == Black && !expectKing;
+}
+
+bool MaterialIndex::IsOppositeColoredBishops(MaterialKey key) {
+    for (Color color : {White, Black}) {
+        if (Count(key, color, Bishop) != 1 || Count(key, color, Knight) || Count(key, color, Rook) ||
+            Count(key, color, Queen)) {
+            return false;
+        }
+    }
+    return BishopCount(key, White, true) != BishopCount(key, Black, true);
+}
+
+// === Building ===
+
+void MaterialIndex::AddGame(std::uint32_t game, const Board& start, MoveSpan moves) {
+    constexpr std::size_t kMaxPly = 0xFFFF;
+    Board board = start;
+    MaterialKey key = KeyOf(board);
+    std::size_t first = 0;
+    const std::size_t plies = std::min(moves.size, kMaxPly);
+    for (std::size_t i = 0; i < plies; ++i) {
+        const Move move = board.Unpack(moves[i]);
+        board.MakeMove(move);
+        if (!(move.flags & Move::kCapture) && !move.promotion) continue;
+        const MaterialKey next = KeyOf(board);
+        if (next == key) continue;
+        pending.push_back({key, {game, static_cast<std::uint16_t>(first), static_cast<std::uint16_t>(i)}});
+        key = next;
+        first = i + 1;
+    }
+    pending.push_back({key, {game, static_cast<std::uint16_t>(first), static_cast<std::uint16_t>(plies)}});
+}
+
+void MaterialIndex::MergeWith(const MaterialIndex& other, std::uint32_t gameOffset) {
+    pending.reserve(pending.size() + other.postings.size() + other.pending.size());
+    for (std::size_t k = 0; k < other.keys.size(); ++k) {
+        for (std::uint64_t i = other.offsets[k]; i < other.offsets[k + 1]; ++i) {
+            MaterialPosting p = other.postings[i];
+            p.game += gameOffset;
+            pending.push_back({other.keys[k], p});
+        }
+    }
+    for (PendingPosting p : other.pending) {
+        p.posting.game += gameOffset;
+        pending.push_back(p);
+    }
+}
+
+void MaterialIndex::Finalize() {
+    if (pending.empty()) return;
+
+    // Fold the laid-out postings back in, then regroup by signature
+    pending.reserve(pending.size() + postings.size());
+    for (std::size_t k = 0; k < keys.size(); ++k) {
+        for (std::uint64_t i = offsets[k]; i < offsets[k + 1]; ++i) pending.push_back({keys[k], postings[i]});
+    }
+    std::sort(pending.begin(), pending.end(), [](const PendingPosting& a, const PendingPosting& b) {
+        return a.key != b.key ? a.key < b.key : ByGameAndPly(a.posting, b.posting);
+    });
+
+    keys.clear();
+    offsets.clear();
+    postings.clear();
+    postings.reserve(pending.size());
+    for (const PendingPosting& p : pending) {
+        if (keys.empty() || keys.back() != p.key) {
+            keys.push_back(p.key);
+            offsets.push_back(postings.size());
+        }
+        postings.push_back(p.posting);
+    }
+    offsets.push_back(postings.size());
+    pending.clear();
+    pending.shrink_to_fit();
+}
+
+// === Queries ===
+
+MaterialIndex::PostingList MaterialIndex::Find(MaterialKey key) const {
+    const auto it = std::lower_bound(keys.begin(), keys.end(), key);
+    if (it == keys.end() || *it != key) return {};
+    const std::size_t k = static_cast<std::size_t>(it - keys.begin());
+    return {postings.data() + offsets[k], static_cast<std::size_t>(offsets[k + 1] - offsets[k])};
+}
+
+std::vector<MaterialPosting> MaterialIndex::FindIf(const std::function<bool(MaterialKey)>& predicate) const {
+    std::vector<MaterialPosting> result;
+    for (std::size_t k = 0; k < keys.size(); ++k) {
+        if (!predicate(keys[k])) continue;
+        result.insert(result.end(), postings.begin() + static_cast<std::ptrdiff_t>(offsets[k]),
+                      postings.begin() + static_cast<std::ptrdiff_t>(offsets[k + 1]));
+    }
+    std::sort(result.begin(), result.end(), ByGameAndPly);
+    return result;
+}
+
+std::vector<MaterialPosting> MaterialIndex::FindSignature(const std::string& text, bool eitherSide) const {
+    MaterialKey target;
+    if (!ParseSignature(text, target)) return {};
+    return FindIf([target, eitherSide](MaterialKey key) {
+        const MaterialKey normalized = Normalize(key);
+        return normalized == target || (eitherSide && Mirror(normalized) == target);
+    });
+}
+
+std::vector<MaterialPosting> MaterialIndex::FindOppositeColoredBishops(bool pawnsAllowed) const {
+    return FindIf([pawnsAllowed](MaterialKey key) {
+        return IsOppositeColoredBishops(key) && (pawnsAllowed || (!Count(key, White, Pawn) && !Count(key, Black, Pawn)));
+    });
+}
+
+const std::vector<MaterialKey>& MaterialIndex::GetKeys() const {
+    return keys;
+}
+
+std::size_t MaterialIndex::GetPostingCount() const {
+    return postings.size() + pending.size();
+}
+
+MemoryUsage MaterialIndex::GetMemoryUsage() const {
+    MemoryUsage usage;
+    usage.objects = keys.size();
+    usage.inlineBytes = keys.size() * sizeof(MaterialKey) + offsets.size() * sizeof(std::uint64_t) +
+                        postings.size() * sizeof(MaterialPosting) + pending.size() * sizeof(PendingPosting);
+    usage.containerBytes = (keys.capacity() - keys.size()) * sizeof(MaterialKey) +
+                           (offsets.capacity() - offsets.size()) * sizeof(std::uint64_t) +
+                           (postings.capacity() - postings.size()) * sizeof(MaterialPosting) +
+                           (pending.capacity() - pending.size()) * sizeof(PendingPosting);
+    return usage;
+}
+
+} // namespace chessDataLib
@@ -0,0 +1,97 @@
+#include "memoryReport.hpp"
+#include <iomanip>
+#include <sstream>
+
+namespace chessDataLib {
+
+// === MemoryUsage ===
+
+std::size_t MemoryUsage::TotalBytes() const {
+    return inlineBytes + containerBytes + stringHeapBytes;
+}
+
+double MemoryUsage::LoadFactor() const {
+    return hashBuckets ? static_cast<double>(hashElements) / hashBuckets : 0.0;
+}
+
+MemoryUsage& MemoryUsage::operator+=(const MemoryUsage& other) {
+    objects += other.objects;
+    inlineBytes += other.inlineBytes;
+    containerBytes += other.containerBytes;
+    stringHeapBytes += other.stringHeapBytes;
+    ssoStrings += other.ssoStrings;
+    heapStrings += other.heapStrings;
+    hashBuckets += other.hashBuckets;
+    hashElements += other.hashElements;
+    return *this;
+}
+
+// === MemoryReport ===
+
+void MemoryReport::Add(const std::string& name, const MemoryUsage& usage) {
+    components.push_back({name, usage});
+}
+
+const std::vector<MemoryReport::Component>& MemoryReport::GetComponents() const {
+    return components;
+}
+
+MemoryUsage MemoryReport::GetTotal() const {
+    MemoryUsage total;
+    for (const auto& c : components) total += c.usage;
+    return total;
+}
+
+std::string MemoryReport::ToString() const {
+    std::ostringstream out;
+    auto row = [&out](const std::string& name, const MemoryUsage& u) {
+        out << std::left << std::setw(14) << name << std::right
+            << std::setw(10) << u.objects
+            << std::setw(14) << u.TotalBytes()
+            << std::setw(14) << u.containerBytes
+            << std::setw(14) << u.stringHeapBytes
+            << std::setw(10) << u.heapStrings
+            << std::setw(10) << u.ssoStrings
+            << std::setw(8) << std::fixed << std::setprecision(2) << u.LoadFactor() << "\n";
+    };
+
+    out << std::left << std::setw(14) << "Component" << std::right
+        << std::setw(10) << "Objects"
+        << std::setw(14) << "Bytes"
+        << std::setw(14) << "Container"
+        << std::setw(14) << "StrHeap"
+        << std::setw(10) << "HeapStr"
+        << std::setw(10) << "SSOStr"
+        << std::setw(8) << "Load" << "\n";
+    for (const auto& c : components) row(c.name, c.usage);
+    row("total", GetTotal());
+    return out.str();
+}
+
+// === Accounting helpers ===
+
+namespace utils {
+
+std::size_t SmallStringCapacity() {
+    static const std::size_t capacity = std::string().capacity();
+    return capacity;
+}
+
+void AccountString(const std::string& s, MemoryUsage& usage) {
+    if (s.capacity() > SmallStringCapacity()) {
+        usage.stringHeapBytes += s.capacity() + 1;
+        usage.heapStrings++;
+    } else {
+        usage.ssoStrings++;
+    }
+}
+
+void AccountStrings(const std::vector<std::string>& v, MemoryUsage& usage) {
+    usage.inlineBytes += v.size() * sizeof(std::string);
+    usage.containerBytes += (v.capacity() - v.size()) * sizeof(std::string);
+    for (const auto& s : v) AccountString(s, usage);
+}
+
+} // namespace utils
+
+} // namespace chessDataLib
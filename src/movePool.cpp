@@ -0,0 +1,49 @@
+#include "movePool.hpp"
+#include <algorithm>
+
+namespace chessDataLib {
+
+std::uint64_t MovePool::AddSegment(std::vector<PackedMove> moves) {
+    const std::uint64_t base = size;
+    if (moves.empty()) return base;
+    size += moves.size();
+    segments.push_back({base, std::move(moves)});
+    return base;
+}
+
+MoveSpan MovePool::View(std::uint64_t offset, std::uint32_t count) const {
+    // Last segment starting at or before offset
+    auto it = std::upper_bound(segments.begin(), segments.end(), offset,
+                               [](std::uint64_t value, const Segment& s) { return value < s.base; });
+    if (it == segments.begin()) return {};
+    const Segment& segment = *--it;
+    const std::uint64_t local = offset - segment.base;
+    if (local > segment.moves.size() || count > segment.moves.size() - local) return {};
+    return {segment.moves.data() + local, count};
+}
+
+MoveSpan MovePool::View(const MovesRef& ref) const {
+    if (ref.offset == MovesRef::kNone) return {};
+    return View(ref.offset, ref.count);
+}
+
+std::uint64_t MovePool::Size() const {
+    return size;
+}
+
+std::size_t MovePool::GetSegmentCount() const {
+    return segments.size();
+}
+
+MemoryUsage MovePool::GetMemoryUsage() const {
+    MemoryUsage usage;
+    usage.objects = 1;
+    usage.containerBytes = segments.capacity() * sizeof(Segment);
+    for (const Segment& s : segments) {
+        usage.inlineBytes += s.moves.size() * sizeof(PackedMove);
+        usage.containerBytes += (s.moves.capacity() - s.moves.size()) * sizeof(PackedMove);
+    }
+    return usage;
+}
+
+} // namespace chessDataLib
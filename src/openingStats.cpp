@@ -0,0 +1,186 @@
+#include "openingStats.hpp"
+#include <algorithm>
+
+namespace chessDataLib {
+
+// === OpeningTotals ===
+
+double OpeningTotals::GetWhiteScorePercentage() const {
+    const std::uint64_t decided = whiteWins + draws + blackWins;
+    return decided ? 100.0 * (whiteWins + 0.5 * draws) / decided : 0.0;
+}
+
+double OpeningTotals::GetAverageWhiteElo() const {
+    return ratedGames ? static_cast<double>(whiteEloSum) / ratedGames : 0.0;
+}
+
+double OpeningTotals::GetAverageBlackElo() const {
+    return ratedGames ? static_cast<double>(blackEloSum) / ratedGames : 0.0;
+}
+
+// === OpeningStats ===
+
+OpeningStats::OpeningStats() : OpeningStats(0, 0) {}
+
+OpeningStats::OpeningStats(int first, int count) : firstYear(count > 0 ? first : 0), years(std::max(0, count)) {
+    // Without a year dimension there is a single bucket; with one, an extra
+    // trailing bucket holds undated and out-of-range games
+    const std::size_t cells = static_cast<std::size_t>(years + 1) * kBands * kEcoSlots;
+    games.assign(cells, 0);
+    whiteWins.assign(cells, 0);
+    draws.assign(cells, 0);
+    blackWins.assign(cells, 0);
+    ratedGames.assign(cells, 0);
+    whiteEloSum.assign(cells, 0);
+    blackEloSum.assign(cells, 0);
+}
+
+int OpeningStats::EcoIndex(const std::string& eco) {
+    if (eco.size() != 3) return -1;
+    const char letter = eco[0];
+    if (letter < 'A' || letter > 'E' || eco[1] < '0' || eco[1] > '9' || eco[2] < '0' || eco[2] > '9') return -1;
+    return (letter - 'A') * 100 + (eco[1] - '0') * 10 + (eco[2] - '0');
+}
+
+std::string OpeningStats::EcoCode(int index) {
+    if (index < 0 || index >= kEcoSlots) return std::string();
+    return {static_cast<char>('A' + index / 100), static_cast<char>('0' + index / 10 % 10),
+            static_cast<char>('0' + index % 10)};
+}
+
+std::size_t OpeningStats::Cell(int yearBucket, int band, int eco) const {
+    return (static_cast<std::size_t>(yearBucket) * kBands + band) * kEcoSlots + eco;
+}
+
+void OpeningStats::AddGame(const std::string& eco, const std::string& result, int whiteElo, int blackElo, int year) {
+    const int ecoIndex = EcoIndex(eco);
+    if (ecoIndex < 0) {
+        unclassifiedGames++;
+        return;
+    }
+
+    const bool rated = whiteElo > 0 && blackElo > 0;
+    const int band = rated ? std::min(std::min(whiteElo, blackElo) / kBandWidth, kRatedBands - 1) : kUnratedBand;
+
+    int yearBucket = 0;
+    if (years > 0) {
+        yearBucket = year - firstYear;
+        if (year <= 0 || yearBucket < 0 || yearBucket >= years) {
+            yearBucket = years;
+            undatedGames++;
+        }
+    }
+
+    const std::size_t c = Cell(yearBucket, band, ecoIndex);
+    games[c]++;
+    if (result == "1-0") whiteWins[c]++;
+    else if (result == "0-1") blackWins[c]++;
+    else if (result == "1/2-1/2") draws[c]++;
+    if (rated) {
+        ratedGames[c]++;
+        whiteEloSum[c] += static_cast<std::uint64_t>(whiteElo);
+        blackEloSum[c] += static_cast<std::uint64_t>(blackElo);
+    }
+}
+
+bool OpeningStats::MergeWith(const OpeningStats& other) {
+    if (other.firstYear != firstYear || other.years != years) return false;
+    // Plain element-wise adds over contiguous columns; compilers vectorize these
+    const std::size_t n = games.size();
+    for (std::size_t i = 0; i < n; ++i) games[i] += other.games[i];
+    for (std::size_t i = 0; i < n; ++i) whiteWins[i] += other.whiteWins[i];
+    for (std::size_t i = 0; i < n; ++i) draws[i] += other.draws[i];
+    for (std::size_t i = 0; i < n; ++i) blackWins[i] += other.blackWins[i];
+    for (std::size_t i = 0; i < n; ++i) ratedGames[i] += other.ratedGames[i];
+    for (std::size_t i = 0; i < n; ++i) whiteEloSum[i] += other.whiteEloSum[i];
+    for (std::size_t i = 0; i < n; ++i) blackEloSum[i] += other.blackEloSum[i];
+    unclassifiedGames += other.unclassifiedGames;
+    undatedGames += other.undatedGames;
+    return true;
+}
+
+void OpeningStats::ForEachRun(const OpeningQuery& query,
+                              const std::function<void(std::size_t, int, int)>& visit) const {
+    const int ecoFirst = std::max(0, EcoIndex(query.ecoFirst));
+    const int ecoLast = EcoIndex(query.ecoLast) < 0 ? kEcoSlots - 1 : EcoIndex(query.ecoLast);
+    if (ecoFirst > ecoLast) return;
+    const int count = ecoLast - ecoFirst + 1;
+
+    // Only bands lying wholly inside [minElo, maxElo]: round minElo up and maxElo + 1 down to band edges
+    const bool eloFilter = query.minElo > 0 || query.maxElo > 0;
+    const int bandFirst = std::min((std::max(query.minElo, 0) + kBandWidth - 1) / kBandWidth, kRatedBands - 1);
+    const int bandLast = query.maxElo > 0 ? std::min((query.maxElo + 1) / kBandWidth - 1, kRatedBands - 1)
+                                          : kRatedBands - 1;
+
+    int bucketFirst = 0;
+    int bucketLast = years; // includes the undated bucket
+    if (query.yearFirst != 0 || query.yearLast != 0) {
+        // Without a year dimension no cell is known to match the filter
+        if (years == 0) return;
+        bucketFirst = std::max(0, query.yearFirst - firstYear);
+        bucketLast = query.yearLast != 0 ? std::min(years - 1, query.yearLast - firstYear) : years - 1;
+    }
+
+    for (int bucket = bucketFirst; bucket <= bucketLast; ++bucket) {
+        for (int band = bandFirst; band <= bandLast; ++band) visit(Cell(bucket, band, ecoFirst), ecoFirst, count);
+        if (!eloFilter) visit(Cell(bucket, kUnratedBand, ecoFirst), ecoFirst, count);
+    }
+}
+
+template <typename T>
+static std::uint64_t SumRun(const std::vector<T>& column, std::size_t begin, int count) {
+    std::uint64_t sum = 0;
+    const T* p = column.data() + begin;
+    for (int i = 0; i < count; ++i) sum += p[i];
+    return sum;
+}
+
+OpeningTotals OpeningStats::Slice(const OpeningQuery& query) const {
+    OpeningTotals total;
+    ForEachRun(query, [&](std::size_t begin, int, int count) {
+        total.games += SumRun(games, begin, count);
+        total.whiteWins += SumRun(whiteWins, begin, count);
+        total.draws += SumRun(draws, begin, count);
+        total.blackWins += SumRun(blackWins, begin, count);
+        total.ratedGames += SumRun(ratedGames, begin, count);
+        total.whiteEloSum += SumRun(whiteEloSum, begin, count);
+        total.blackEloSum += SumRun(blackEloSum, begin, count);
+    });
+    return total;
+}
+
+std::vector<OpeningTotals> OpeningStats::SliceByEco(const OpeningQuery& query) const {
+    std::vector<OpeningTotals> perEco(kEcoSlots);
+    ForEachRun(query, [&](std::size_t begin, int ecoFirst, int count) {
+        for (int i = 0; i < count; ++i) {
+            const std::size_t c = begin + i;
+            OpeningTotals& t = perEco[ecoFirst + i];
+            t.games += games[c];
+            t.whiteWins += whiteWins[c];
+            t.draws += draws[c];
+            t.blackWins += blackWins[c];
+            t.ratedGames += ratedGames[c];
+            t.whiteEloSum += whiteEloSum[c];
+            t.blackEloSum += blackEloSum[c];
+        }
+    });
+    return perEco;
+}
+
+std::uint64_t OpeningStats::GetUnclassifiedGames() const {
+    return unclassifiedGames;
+}
+
+std::uint64_t OpeningStats::GetUndatedGames() const {
+    return undatedGames;
+}
+
+int OpeningStats::GetFirstYear() const {
+    return firstYear;
+}
+
+int OpeningStats::GetYearCount() const {
+    return years;
+}
+
+} // namespace chessDataLib
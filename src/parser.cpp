@@ -1,25 +1,416 @@
 #include "parser.hpp"
+#include "PGNGameBuilder.hpp"
+#include "PGNMoveText.hpp"
+#include "PGNStatsUpdater.hpp"
+#include "PGNTagParser.hpp"
+#include "PGNTokenizer.hpp"
+#include "sourceMapping.hpp"
+#include "utils/chunkPlan.hpp"
 #include "utils/csv.hpp"
+#include "utils/date.hpp"
+#include "utils/externalSort.hpp"
+#include "utils/glob.hpp"
+#include "utils/snapshotCell.hpp"
+#include "utils/workStealingPool.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <filesystem>
 #include <fstream>
 #include <iostream>
+#include <iterator>
 #include <limits>
+#include <mutex>
+#include <sstream>
 
 namespace chessDataLib {
 
 // === Internal implementation ===
 
+namespace {
+
+constexpr std::uint64_t kDefaultChunkSize = 32ull << 20;
+
+// Aggregates owned by one worker thread, merged after all tasks finish
+struct WorkerState {
+    utils::StringMap<Player> players;
+    DatabaseStats stats;
+    HeadToHead headToHead;
+    OpeningStats openings;
+    TimeSeriesStats timeSeries;
+};
+
+// Folds one state's aggregates into another's, or into the parser's
+void MergeWorker(WorkerState& from, utils::StringMap<Player>& players, DatabaseStats& stats, HeadToHead& headToHead,
+                 OpeningStats& openings, TimeSeriesStats& timeSeries) {
+    for (auto& kv : from.players) {
+        auto it = players.find(kv.first);
+        if (it == players.end()) players.emplace(kv.first, std::move(kv.second));
+        else it->second.MergeWith(kv.second);
+    }
+    stats.MergeCounters(from.stats);
+    headToHead.MergeWith(from.headToHead);
+    openings.MergeWith(from.openings);
+    timeSeries.MergeWith(from.timeSeries);
+}
+
+// Sets the player and tournament views of stats from the merged maps
+void FillViews(DatabaseStats& stats, const utils::StringMap<Player>& players,
+               const utils::StringMap<Tournament>& tournaments) {
+    std::vector<std::string> playerNames;
+    std::vector<std::string> tournamentNames;
+    playerNames.reserve(players.size());
+    tournamentNames.reserve(tournaments.size());
+
+    std::string mostActive;
+    int maxGames = 0;
+    for (const auto& kv : players) {
+        playerNames.push_back(kv.first);
+        if (kv.second.GetTotalGames() > maxGames) {
+            maxGames = kv.second.GetTotalGames();
+            mostActive = kv.first;
+        }
+    }
+
+    std::string largest;
+    int maxInTournament = 0;
+    for (const auto& kv : tournaments) {
+        tournamentNames.push_back(kv.first);
+        if (kv.second.GetTotalGames() > maxInTournament) {
+            maxInTournament = kv.second.GetTotalGames();
+            largest = kv.first;
+        }
+    }
+
+    stats.SetUniquePlayers(static_cast<int>(players.size()));
+    stats.SetUniqueTournaments(static_cast<int>(tournaments.size()));
+    stats.SetPlayerNames(playerNames);
+    stats.SetTournamentNames(tournamentNames);
+    stats.SetPlayerStats(players);
+    stats.SetTournaments(tournaments);
+    stats.SetMostActivePlayer(mostActive);
+    stats.SetMaxGamesByPlayer(maxGames);
+    stats.SetLargestTournament(largest);
+    stats.SetMaxGamesInTournament(maxInTournament);
+}
+
+// Leading decimal digits of a tag value ("2450", "1999.??.??"); 0 if none
+int ParseLeadingInt(const std::string& s) {
+    int value = 0;
+    for (std::size_t i = 0; i < s.size() && i < 9 && s[i] >= '0' && s[i] <= '9'; ++i) value = value * 10 + (s[i] - '0');
+    return value;
+}
+
+// Position a game starts from: its FEN tag, else the standard start
+bool StartPosition(const std::unordered_map<std::string, std::string>& tags, Board& board) {
+    const auto fen = tags.find("FEN");
+    return fen == tags.end() || board.SetFen(fen->second.data(), fen->second.data() + fen->second.size());
+}
+
+// Whether the first ply is White's: false for a FEN start with Black to move
+bool WhiteMovesFirst(const std::unordered_map<std::string, std::string>& tags) {
+    if (tags.find("FEN") == tags.end()) return true;
+    Board board;
+    return !StartPosition(tags, board) || board.SideToMove() == White;
+}
+
+// Replay a game's mainline from its start position into out
+std::uint32_t EncodeMoves(const std::unordered_map<std::string, std::string>& tags, const std::string& moveText,
+                          std::vector<PackedMove>& out) {
+    Board board;
+    if (!StartPosition(tags, board)) return 0;
+    return static_cast<std::uint32_t>(
+        PGNMoveText::EncodeMainline(moveText.data(), moveText.data() + moveText.size(), board, out));
+}
+
+// Optional outputs and hooks of ParseRange
+struct RangeOptions {
+    std::vector<PackedMove>* moves = nullptr;  ///< Receives packed mainlines (task-relative MovesRef offsets)
+    MaterialIndex* material = nullptr;         ///< Receives material postings under task-relative game IDs
+    ProgressReporter* progress = nullptr;      ///< Advanced every kProgressGames games
+    const CancellationToken* cancel = nullptr; ///< Polled every kProgressGames games
+};
+
+// Games between progress updates and cancellation checks: rare enough that
+// the atomics and clock read vanish next to parsing
+constexpr std::uint64_t kProgressGames = 256;
+
+// Tokenize a byte range of a mapped source and aggregate its games, which keep
+// a handle to their move text.
+// Tournaments are kept per task, since their game lists are ordered.
+// Returns false if cancelled part way.
+bool ParseRange(const SourceMapping& source, std::uint32_t sourceId, const utils::ChunkTask& task,
+                WorkerState& state, utils::StringMap<Tournament>& tournaments, std::vector<Game>& games,
+                const RangeOptions& options) {
+    std::vector<PackedMove>* moves = options.moves;
+    MaterialIndex* material = options.material;
+    PGNTokenizer tokenizer(source.Data() + task.begin, static_cast<std::size_t>(task.end - task.begin), task.begin);
+    std::vector<PackedMove> scratch;
+    std::uint64_t reported = task.begin;
+    std::uint64_t pendingGames = 0;
+    while (tokenizer.NextGame()) {
+        if (++pendingGames == kProgressGames) {
+            if (options.cancel && options.cancel->IsCancelled()) return false;
+            const std::uint64_t offset = tokenizer.GetCurrentGameOffset();
+            if (options.progress) options.progress->Advance(offset - reported, pendingGames);
+            reported = offset;
+            pendingGames = 0;
+        }
+        const auto tags = PGNTagParser::Parse(tokenizer.GetCurrentTagLines());
+        Game game = PGNGameBuilder::Build(tags, tokenizer.GetCurrentMoveText());
+        game.SetMoveTextRef({tokenizer.GetCurrentMoveTextOffset(),
+                             static_cast<std::uint32_t>(tokenizer.GetCurrentMoveTextLength()), sourceId});
+        if (moves || material) {
+            std::vector<PackedMove>& out = moves ? *moves : scratch;
+            if (!moves) scratch.clear();
+            const std::size_t offset = out.size();
+            const std::uint32_t count = EncodeMoves(tags, tokenizer.GetCurrentMoveText(), out);
+            if (moves) game.SetMovesRef({offset, count});
+            Board start;
+            if (material && StartPosition(tags, start)) {
+                material->AddGame(static_cast<std::uint32_t>(games.size()), start, {out.data() + offset, count});
+            }
+        }
+        PGNStatsUpdater::Update(game, state.players, tournaments, state.stats, WhiteMovesFirst(tags));
+        state.headToHead.AddGame(game.GetWhite(), game.GetBlack(), game.GetResult());
+        const int whiteElo = ParseLeadingInt(game.GetWhiteElo());
+        const int blackElo = ParseLeadingInt(game.GetBlackElo());
+        state.stats.AddToHistograms(game.GetPlyCount(), game.GetResult(), whiteElo, blackElo);
+        state.openings.AddGame(game.GetEco(), game.GetResult(), whiteElo, blackElo,
+                               utils::DateYear(game.GetPackedDate()));
+        state.timeSeries.AddGame(game.GetPackedDate(), game.GetEco(), game.GetWhite(), game.GetBlack(),
+                                 game.GetResult(), whiteElo, blackElo);
+        games.push_back(std::move(game));
+    }
+    if (options.progress) options.progress->Advance(task.end - reported, pendingGames);
+    return true;
+}
+
+} // namespace
+
 struct Parser::Impl {
     DatabaseStats stats;
     std::vector<Game> games;
-    std::unordered_map<std::string, Player> players;
-    std::unordered_map<std::string, Tournament> tournaments;
+    utils::StringMap<Player> players;
+    utils::StringMap<Tournament> tournaments;
+    HeadToHead headToHead;
+    OpeningStats openings;
+    TimeSeriesStats timeSeries;
+
+    SourceTable sources;
+    std::string indexedFile;
+    GameIndex index;
+    std::shared_ptr<SourceMapping> indexedSource;
+    std::uint32_t indexedSourceId = MoveTextRef::kNoSource;
+
+    unsigned threadCount = 0;
+    std::uint64_t chunkSize = kDefaultChunkSize;
+    std::size_t moveListCacheSize = 0;
+    bool storeMoves = false;
+    MovePool movePool;
+    bool indexMaterial = false;
+    MaterialIndex materialIndex;
+    ProgressHandler progressHandler;
+    ProgressOptions progressOptions;
+    CancellationToken cancellation;
+    bool publishStats = false;
+    double publishIntervalSeconds = 1.0;
+    std::chrono::steady_clock::time_point lastPublished;
+    utils::SnapshotCell<DatabaseStats> publishedStats;
+
+    void InitWorker(WorkerState& w) const {
+        w.openings = OpeningStats(openings.GetFirstYear(), openings.GetYearCount());
+        w.timeSeries =
+            TimeSeriesStats(timeSeries.GetFirstYear(), timeSeries.GetYearCount(), timeSeries.GetGranularity());
+    }
+
+    std::shared_ptr<SourceMapping> MapSource(const std::string& filename) const {
+        auto source = SourceMapping::Open(filename);
+        if (source) source->SetMoveListCacheCapacity(moveListCacheSize);
+        return source;
+    }
 
-    bool ParseFile(const std::string& filename, Parser::ProgressCallback callback) {
-        // Placeholder: implement PGN parsing logic here
+    bool ParseFiles(const std::vector<std::string>& filenames, Parser::ProgressCallback callback) {
+        const auto startTime = std::chrono::steady_clock::now();
         if (callback) callback(0, "Starting parsing...");
-        // Simulate parsing
+
+        // === Plan: split large files into chunks aligned to game starts ===
+        bool allOpened = true;
+        std::vector<std::shared_ptr<SourceMapping>> mapped(filenames.size());
+        std::vector<std::uint32_t> sourceIds(filenames.size(), MoveTextRef::kNoSource);
+        std::uint64_t totalBytes = 0;
+        for (std::size_t f = 0; f < filenames.size(); ++f) {
+            mapped[f] = MapSource(filenames[f]);
+            if (!mapped[f]) {
+                std::cerr << "LoadFiles: failed to open " << filenames[f] << "\n";
+                allOpened = false;
+                continue;
+            }
+            sourceIds[f] = sources.Add(mapped[f]);
+            totalBytes += mapped[f]->Size();
+        }
+        const std::vector<utils::ChunkTask> tasks = utils::PlanChunks(mapped, chunkSize);
+
+        // === Execute: largest tasks first, results kept in plan order ===
+        std::vector<std::size_t> order(tasks.size());
+        for (std::size_t i = 0; i < order.size(); ++i) order[i] = i;
+        std::stable_sort(order.begin(), order.end(), [&tasks](std::size_t a, std::size_t b) {
+            return tasks[a].end - tasks[a].begin > tasks[b].end - tasks[b].begin;
+        });
+
+        utils::WorkStealingPool pool(threadCount);
+        std::vector<WorkerState> workers(pool.GetThreadCount());
+        for (auto& w : workers) InitWorker(w);
+        std::vector<std::vector<Game>> taskGames(tasks.size());
+        std::vector<utils::StringMap<Tournament>> taskTournaments(tasks.size());
+        std::vector<std::vector<PackedMove>> taskMoves(storeMoves ? tasks.size() : 0);
+        std::vector<MaterialIndex> taskMaterial(indexMaterial ? tasks.size() : 0);
+        std::mutex progressMutex;
+        std::uint64_t bytesDone = 0;
+        ProgressReporter progress(progressHandler, progressOptions, totalBytes);
+        std::atomic<bool> cancelled{false};
+        // When publishing, each task parses into its own state and folds it
+        // into workers[0] under this lock, so snapshots can be cut between tasks
+        std::mutex foldMutex;
+        bool publishedPartial = false;
+
+        pool.Run(order.size(), [&](std::size_t i, unsigned worker) {
+            // Cancelled: remaining tasks return at once and nothing is merged
+            if (cancelled.load(std::memory_order_relaxed)) return;
+            if (cancellation.IsCancelled()) {
+                cancelled = true;
+                return;
+            }
+            const utils::ChunkTask& task = tasks[order[i]];
+            RangeOptions options;
+            options.moves = storeMoves ? &taskMoves[order[i]] : nullptr;
+            options.material = indexMaterial ? &taskMaterial[order[i]] : nullptr;
+            options.progress = &progress;
+            options.cancel = &cancellation;
+            WorkerState local;
+            if (publishStats) InitWorker(local);
+            if (!ParseRange(*mapped[task.file], sourceIds[task.file], task, publishStats ? local : workers[worker],
+                            taskTournaments[order[i]], taskGames[order[i]], options)) {
+                cancelled = true;
+                return;
+            }
+            if (publishStats) {
+                std::lock_guard<std::mutex> lock(foldMutex);
+                WorkerState& running = workers[0];
+                MergeWorker(local, running.players, running.stats, running.headToHead, running.openings,
+                            running.timeSeries);
+                if (PublishDue()) {
+                    PublishSnapshot(StatsWith(running));
+                    publishedPartial = true;
+                }
+            }
+            if (callback) {
+                std::lock_guard<std::mutex> lock(progressMutex);
+                bytesDone += task.end - task.begin;
+                const int percent = totalBytes ? static_cast<int>(bytesDone * 100 / totalBytes) : 100;
+                callback(std::min(percent, 99), "Parsed " + filenames[task.file]);
+            }
+        });
+
+        if (cancelled) {
+            // Take back totals of the abandoned load that readers may have seen
+            if (publishedPartial) PublishStats();
+            progress.Finish(true);
+            std::cerr << "LoadFiles: cancelled\n";
+            return false;
+        }
+        progress.Finish(false);
+
+        // === Merge per-task games and per-worker aggregates ===
+        std::size_t gameCount = games.size();
+        for (const auto& g : taskGames) gameCount += g.size();
+        games.reserve(gameCount);
+
+        // One new pool segment per load, so views into earlier loads stay put
+        if (storeMoves) {
+            std::size_t moveCount = 0;
+            for (const auto& m : taskMoves) moveCount += m.size();
+            std::vector<PackedMove> segment;
+            segment.reserve(moveCount);
+            const std::uint64_t segmentBase = movePool.Size();
+            for (std::size_t t = 0; t < tasks.size(); ++t) {
+                const std::uint64_t base = segmentBase + segment.size();
+                segment.insert(segment.end(), taskMoves[t].begin(), taskMoves[t].end());
+                taskMoves[t] = std::vector<PackedMove>();
+                for (auto& game : taskGames[t]) {
+                    MovesRef ref = game.GetMovesRef();
+                    game.SetMovesRef({ref.offset + base, ref.count});
+                }
+            }
+            movePool.AddSegment(std::move(segment));
+        }
+        if (indexMaterial) {
+            std::size_t base = games.size();
+            for (std::size_t t = 0; t < tasks.size(); ++t) {
+                materialIndex.MergeWith(taskMaterial[t], static_cast<std::uint32_t>(base));
+                base += taskGames[t].size();
+            }
+            materialIndex.Finalize();
+        }
+        for (auto& g : taskGames) {
+            std::move(g.begin(), g.end(), std::back_inserter(games));
+        }
+        // Plan order keeps each tournament's games in file order
+        for (auto& t : taskTournaments) {
+            for (auto& kv : t) {
+                auto it = tournaments.find(kv.first);
+                if (it == tournaments.end()) tournaments.emplace(kv.first, std::move(kv.second));
+                else it->second.MergeWith(kv.second);
+            }
+            t = utils::StringMap<Tournament>();
+        }
+
+        for (auto& w : workers) MergeWorker(w, players, stats, headToHead, openings, timeSeries);
+
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - startTime;
+        stats.SetParsingTimeSeconds(stats.GetParsingTimeSeconds() + elapsed.count());
+        RefreshStats();
+        PublishStats();
+
         if (callback) callback(100, "Parsing complete.");
-        return true;
+        return allOpened;
+    }
+
+    // Rebuild the player/tournament views of stats from the merged maps
+    void RefreshStats() {
+        FillViews(stats, players, tournaments);
+    }
+
+    // Statistics of the loaded data plus a running load's totals so far;
+    // tournament views stay as of the last completed load, since tournaments
+    // are merged in file order once all tasks are done
+    DatabaseStats StatsWith(const WorkerState& running) const {
+        DatabaseStats out = stats;
+        out.MergeCounters(running.stats);
+        utils::StringMap<Player> merged = players;
+        for (const auto& kv : running.players) {
+            auto it = merged.find(kv.first);
+            if (it == merged.end()) merged.emplace(kv.first, kv.second);
+            else it->second.MergeWith(kv.second);
+        }
+        FillViews(out, merged, tournaments);
+        return out;
+    }
+
+    // Whether the publish interval has passed since the last snapshot
+    bool PublishDue() const {
+        const std::chrono::duration<double> since = std::chrono::steady_clock::now() - lastPublished;
+        return since.count() >= publishIntervalSeconds;
+    }
+
+    void PublishSnapshot(DatabaseStats snapshot) {
+        publishedStats.Publish(std::make_shared<const DatabaseStats>(std::move(snapshot)));
+        lastPublished = std::chrono::steady_clock::now();
+    }
+
+    // Copy stats off to the side, then swap the copy in for readers
+    void PublishStats() {
+        if (publishStats) PublishSnapshot(stats);
     }
 };
 
@@ -30,25 +421,278 @@ Parser::Parser() : pimpl(std::make_unique<Impl>()) {}
 Parser::~Parser() = default;
 
 bool Parser::LoadFile(const std::string& filename, ProgressCallback callback) {
-    return pimpl->ParseFile(filename, callback);
+    return pimpl->ParseFiles({filename}, callback);
+}
+
+bool Parser::LoadFiles(const std::vector<std::string>& filenames, ProgressCallback callback) {
+    return pimpl->ParseFiles(filenames, callback);
+}
+
+bool Parser::LoadDirectory(const std::string& directory, const std::string& pattern, ProgressCallback callback) {
+    std::error_code ec;
+    std::vector<std::string> filenames;
+    for (std::filesystem::directory_iterator it(directory, ec), end; !ec && it != end; it.increment(ec)) {
+        if (it->is_regular_file(ec) && utils::MatchGlob(pattern, it->path().filename().string())) {
+            filenames.push_back(it->path().string());
+        }
+    }
+    if (ec) {
+        std::cerr << "LoadDirectory: failed to read " << directory << ": " << ec.message() << "\n";
+        return false;
+    }
+    std::sort(filenames.begin(), filenames.end());
+    return pimpl->ParseFiles(filenames, callback);
+}
+
+bool Parser::ValidateFiles(const std::vector<std::string>& filenames, ValidationReport& report) const {
+    PGNValidator validator;
+    validator.SetThreadCount(pimpl->threadCount);
+    validator.SetChunkSize(pimpl->chunkSize);
+    return validator.ValidateFiles(filenames, report);
+}
+
+bool Parser::ExportFilteredPGN(const std::vector<std::string>& filenames, const std::string& output,
+                               const PGNExporter::Predicate& predicate, PGNExporter::Summary* summary) const {
+    PGNExporter exporter;
+    exporter.SetThreadCount(pimpl->threadCount);
+    exporter.SetChunkSize(pimpl->chunkSize);
+    return exporter.ExportFiltered(filenames, output, predicate, summary);
+}
+
+bool Parser::OpenIndexed(const std::string& filename) {
+    GameIndex index;
+    if (!index.LoadOrBuild(filename)) {
+        std::cerr << "OpenIndexed: failed to index " << filename << "\n";
+        return false;
+    }
+    pimpl->indexedFile = filename;
+    pimpl->index = std::move(index);
+    pimpl->indexedSource = pimpl->MapSource(filename);
+    pimpl->indexedSourceId =
+        pimpl->indexedSource ? pimpl->sources.Add(pimpl->indexedSource) : MoveTextRef::kNoSource;
+    return true;
+}
+
+std::size_t Parser::GetIndexedGameCount() const {
+    return pimpl->index.Size();
+}
+
+bool Parser::GetGameAt(std::size_t index, Game& game) const {
+    std::vector<Game> games = ReadGames(index, 1);
+    if (games.empty()) return false;
+    game = std::move(games.front());
+    return true;
+}
+
+std::vector<Game> Parser::ReadGames(std::size_t first, std::size_t count) const {
+    std::vector<Game> games;
+    const GameIndex& index = pimpl->index;
+    if (pimpl->indexedFile.empty() || first >= index.Size() || count == 0) return games;
+
+    const std::size_t last = std::min(index.Size(), first + count) - 1;
+    const std::uint64_t begin = index.At(first).offset;
+    const std::uint64_t end = index.At(last).offset + index.At(last).length;
+
+    // Parse straight from the mapping when available, otherwise read just the range
+    const std::shared_ptr<SourceMapping>& source = pimpl->indexedSource;
+    const bool fromSource = source && end <= source->Size();
+    std::string buffer;
+    const char* data = nullptr;
+    if (fromSource) {
+        data = source->Data() + begin;
+    } else {
+        std::ifstream in(pimpl->indexedFile, std::ios::binary);
+        buffer.resize(static_cast<std::size_t>(end - begin));
+        in.seekg(static_cast<std::streamoff>(begin));
+        in.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        if (static_cast<std::size_t>(in.gcount()) != buffer.size()) return games;
+        data = buffer.data();
+    }
+
+    PGNTokenizer tokenizer(data, static_cast<std::size_t>(end - begin), begin);
+    games.reserve(last - first + 1);
+    while (games.size() <= last - first && tokenizer.NextGame()) {
+        const auto tags = PGNTagParser::Parse(tokenizer.GetCurrentTagLines());
+        Game game = PGNGameBuilder::Build(tags, tokenizer.GetCurrentMoveText());
+        if (fromSource) {
+            game.SetMoveTextRef({tokenizer.GetCurrentMoveTextOffset(),
+                                 static_cast<std::uint32_t>(tokenizer.GetCurrentMoveTextLength()),
+                                 pimpl->indexedSourceId});
+        }
+        games.push_back(std::move(game));
+    }
+    return games;
+}
+
+std::vector<Game> Parser::SampleIndexedGames(std::size_t count, std::uint64_t seed) const {
+    std::vector<Game> games;
+    if (pimpl->indexedFile.empty()) return games;
+    GameSampler sampler;
+    sampler.SetSeed(seed);
+    const std::vector<std::size_t> chosen = sampler.SampleIndices(pimpl->index, count);
+
+    // Read runs of consecutive game numbers with one tokenizer each
+    games.reserve(chosen.size());
+    for (std::size_t i = 0; i < chosen.size();) {
+        std::size_t j = i + 1;
+        while (j < chosen.size() && chosen[j] == chosen[j - 1] + 1) ++j;
+        for (Game& game : ReadGames(chosen[i], j - i)) games.push_back(std::move(game));
+        i = j;
+    }
+    return games;
+}
+
+bool Parser::SampleGames(const std::vector<std::string>& filenames, std::size_t count, std::vector<Game>& games,
+                         std::uint64_t seed) const {
+    GameSampler sampler;
+    sampler.SetSeed(seed);
+    return sampler.SampleUniform(filenames, count, games, &pimpl->sources);
+}
+
+bool Parser::SampleGamesStratified(const std::vector<std::string>& filenames, std::size_t countPerStratum,
+                                   const GameSampler::StratumFunction& stratum,
+                                   std::map<std::string, std::vector<Game>>& samples, std::uint64_t seed) const {
+    GameSampler sampler;
+    sampler.SetSeed(seed);
+    return sampler.SampleStratified(filenames, countPerStratum, stratum, samples, &pimpl->sources);
+}
+
+void Parser::SetThreadCount(unsigned count) {
+    pimpl->threadCount = count;
+}
+
+void Parser::SetChunkSize(std::uint64_t bytes) {
+    pimpl->chunkSize = bytes ? bytes : kDefaultChunkSize;
+}
+
+void Parser::SetMoveListCacheSize(std::size_t entries) {
+    pimpl->moveListCacheSize = entries;
+}
+
+std::string Parser::GetMoveText(const Game& game) const {
+    return pimpl->sources.GetMoveText(game.GetMoveTextRef());
+}
+
+std::shared_ptr<const std::vector<std::string>> Parser::GetMoveList(const Game& game) const {
+    return pimpl->sources.GetMoveList(game.GetMoveTextRef());
+}
+
+const SourceTable& Parser::GetSources() const {
+    return pimpl->sources;
+}
+
+void Parser::SetStoreMoves(bool enabled) {
+    pimpl->storeMoves = enabled;
+}
+
+MoveSpan Parser::GetMoves(const Game& game) const {
+    return pimpl->movePool.View(game.GetMovesRef());
+}
+
+const MovePool& Parser::GetMovePool() const {
+    return pimpl->movePool;
+}
+
+void Parser::SetProgressHandler(ProgressHandler handler, const ProgressOptions& options) {
+    pimpl->progressHandler = std::move(handler);
+    pimpl->progressOptions = options;
+}
+
+void Parser::SetCancellationToken(const CancellationToken& token) {
+    pimpl->cancellation = token;
+}
+
+void Parser::SetIndexMaterial(bool enabled) {
+    pimpl->indexMaterial = enabled;
+}
+
+const MaterialIndex& Parser::GetMaterialIndex() const {
+    return pimpl->materialIndex;
 }
 
 const DatabaseStats& Parser::GetStats() const {
     return pimpl->stats;
 }
 
+void Parser::SetPublishStats(bool enabled, double intervalSeconds) {
+    pimpl->publishStats = enabled;
+    pimpl->publishIntervalSeconds = std::max(0.0, intervalSeconds);
+    pimpl->PublishStats();
+}
+
+std::shared_ptr<const DatabaseStats> Parser::GetStatsSnapshot() const {
+    return pimpl->publishedStats.Load();
+}
+
+std::uint64_t Parser::GetStatsVersion() const {
+    return pimpl->publishedStats.GetVersion();
+}
+
 const std::vector<Game>& Parser::GetGames() const {
     return pimpl->games;
 }
 
-const std::unordered_map<std::string, Player>& Parser::GetPlayerStats() const {
+const utils::StringMap<Player>& Parser::GetPlayerStats() const {
     return pimpl->players;
 }
 
-const std::unordered_map<std::string, Tournament>& Parser::GetTournaments() const {
+std::size_t Parser::ResolvePlayerNames(const PlayerNameResolver& resolver) {
+    std::vector<std::string> names;
+    names.reserve(pimpl->players.size());
+    for (const auto& kv : pimpl->players) names.push_back(kv.first);
+    const std::vector<PlayerNameResolver::Match> matches = resolver.ResolveAll(names, pimpl->threadCount);
+
+    // Take the entries out first: insertions into the map move its elements
+    std::vector<std::pair<std::string, Player>> moved;
+    utils::StringMap<std::string> aliases;
+    for (std::size_t i = 0; i < names.size(); ++i) {
+        if (!matches[i].IsResolved() || matches[i].canonical == names[i]) continue;
+        auto it = pimpl->players.find(names[i]);
+        moved.emplace_back(matches[i].canonical, std::move(it->second));
+        pimpl->players.erase(names[i]);
+        aliases.try_emplace(names[i], matches[i].canonical);
+    }
+    if (moved.empty()) return 0;
+    for (auto& [canonical, player] : moved) {
+        auto [it, inserted] = pimpl->players.try_emplace(canonical);
+        if (inserted) it->second.SetName(canonical);
+        it->second.MergeWith(player);
+    }
+
+    // Every other per-player aggregate follows, so lookups by canonical name agree
+    for (auto& kv : pimpl->players) kv.second.MergeAliases(aliases);
+    for (auto& kv : pimpl->tournaments) kv.second.MergeAliases(aliases);
+    pimpl->headToHead.MergeAliases(aliases);
+    pimpl->timeSeries.MergeAliases(aliases);
+    pimpl->RefreshStats();
+    pimpl->PublishStats();
+    return moved.size();
+}
+
+const utils::StringMap<Tournament>& Parser::GetTournaments() const {
     return pimpl->tournaments;
 }
 
+const HeadToHead& Parser::GetHeadToHead() const {
+    return pimpl->headToHead;
+}
+
+const OpeningStats& Parser::GetOpeningStats() const {
+    return pimpl->openings;
+}
+
+void Parser::SetOpeningYearRange(int firstYear, int years) {
+    pimpl->openings = OpeningStats(firstYear, years);
+}
+
+const TimeSeriesStats& Parser::GetTimeSeriesStats() const {
+    return pimpl->timeSeries;
+}
+
+void Parser::SetTimeSeriesRange(int firstYear, int years, TimeSeriesStats::Granularity granularity) {
+    pimpl->timeSeries = TimeSeriesStats(firstYear, years, granularity);
+}
+
 // CSV-safe ExportPlayerStatsCSV
 bool Parser::ExportPlayerStatsCSV(const std::string& path) const {
     std::ofstream ofs(path);
@@ -84,6 +728,112 @@ bool Parser::ExportPlayerStatsCSV(const std::string& path) const {
     return true;
 }
 
+namespace {
+
+// Appends v so that byte order matches numeric order
+void AppendOrderedU64(std::string& key, std::uint64_t v, bool descending) {
+    if (descending) v = ~v;
+    for (int shift = 56; shift >= 0; shift -= 8) key.push_back(static_cast<char>(v >> shift));
+}
+
+// floor(numerator * 2^62 / denominator) by binary long division, for
+// numerator <= 2 * denominator. Distinct fractions with denominators below
+// 2^31 differ by at least 2^-62, so they never share a value.
+std::uint64_t ScaledFraction(std::uint64_t numerator, std::uint64_t denominator) {
+    std::uint64_t quotient = numerator / denominator;
+    std::uint64_t remainder = numerator % denominator;
+    for (int bit = 0; bit < 62; ++bit) {
+        quotient <<= 1;
+        remainder <<= 1;
+        if (remainder >= denominator) {
+            remainder -= denominator;
+            quotient |= 1;
+        }
+    }
+    return quotient;
+}
+
+// Sort key: column bytes, then the name as tie-break, then '\0'
+std::string PlayerSortKey(const Player& p, const PlayerExportOptions& options) {
+    std::string key;
+    const std::string& name = p.GetName();
+    switch (options.key) {
+    case PlayerExportOptions::Key::Games:
+        AppendOrderedU64(key, static_cast<std::uint64_t>(std::max(0, p.GetTotalGames())), options.descending);
+        break;
+    case PlayerExportOptions::Key::Wins:
+        AppendOrderedU64(key, static_cast<std::uint64_t>(std::max(0, p.GetWinsCount())), options.descending);
+        break;
+    case PlayerExportOptions::Key::Score: {
+        // Half points per game, scaled so equal scores get equal keys and
+        // different scores different ones
+        const std::uint64_t wins = static_cast<std::uint64_t>(std::max(0, p.GetWinsCount()));
+        const std::uint64_t draws = static_cast<std::uint64_t>(std::max(0, p.GetDrawCount()));
+        const std::uint64_t decided = wins + draws + static_cast<std::uint64_t>(std::max(0, p.GetLossCount()));
+        const std::uint64_t score = decided ? ScaledFraction(2 * wins + draws, decided) : 0;
+        AppendOrderedU64(key, score, options.descending);
+        break;
+    }
+    case PlayerExportOptions::Key::Name:
+        if (options.descending) {
+            for (const char c : name) key.push_back(static_cast<char>(~static_cast<unsigned char>(c)));
+            key.push_back('\xff');
+            return key;
+        }
+        break;
+    }
+    key += name;
+    key.push_back('\0');
+    return key;
+}
+
+} // namespace
+
+// Rows are sort key + CSV line + 4-byte line length, so sorting the records
+// as byte strings sorts the rows and each line can be cut back out
+bool Parser::ExportPlayerStatsCSV(const std::string& path, const PlayerExportOptions& options) const {
+    std::ofstream ofs(path, std::ios::binary);
+    if (!ofs.is_open()) {
+        std::cerr << "ExportPlayerStatsCSV: failed to open " << path << "\n";
+        return false;
+    }
+    ofs << "Player,TotalGames,Wins,Losses,Draws,WinPct,LossPct,DrawPct\n";
+
+    utils::ExternalSorter sorter(options.memoryBudget, options.tempDirectory, pimpl->threadCount);
+    std::ostringstream line;
+    for (const auto& kv : pimpl->players) {
+        const Player& p = kv.second;
+        line.str(std::string());
+        line << utils::EscapeCSVField(p.GetName()) << ',' << p.GetTotalGames() << ',' << p.GetWinsCount() << ','
+             << p.GetLossCount() << ',' << p.GetDrawCount() << ',' << p.GetWinPercentage() << ','
+             << p.GetLossPercentage() << ',' << p.GetDrawPercentage() << '\n';
+        std::string record = PlayerSortKey(p, options);
+        const std::string text = line.str();
+        const auto size = static_cast<std::uint32_t>(text.size());
+        record += text;
+        for (int shift = 0; shift < 32; shift += 8) record.push_back(static_cast<char>(size >> shift));
+        if (!sorter.Add(std::move(record))) {
+            std::cerr << "ExportPlayerStatsCSV: failed to spill rows\n";
+            return false;
+        }
+    }
+
+    const bool sorted = sorter.Finish([&ofs](const std::string& record) {
+        std::uint32_t size = 0;
+        for (int i = 0; i < 4; ++i) {
+            size |= static_cast<std::uint32_t>(static_cast<unsigned char>(record[record.size() - 4 + i])) << (8 * i);
+        }
+        ofs.write(record.data() + record.size() - 4 - size, size);
+        return static_cast<bool>(ofs);
+    });
+    ofs.close();
+    if (!sorted || !ofs) {
+        std::cerr << "ExportPlayerStatsCSV: failed to write " << path << "\n";
+        return false;
+    }
+    return true;
+}
+
 // CSV-safe ExportTournamentsCSV
 bool Parser::ExportTournamentsCSV(const std::string& path) const {
     std::ofstream ofs(path);
@@ -118,6 +868,196 @@ bool Parser::ExportTournamentsCSV(const std::string& path) const {
     return true;
 }
 
+// CSV-safe ExportStandingsCSV
+bool Parser::ExportStandingsCSV(const std::string& path) const {
+    std::ofstream ofs(path);
+    if (!ofs.is_open()) {
+        std::cerr << "ExportStandingsCSV: failed to open " << path << "\n";
+        return false;
+    }
+
+    ofs << "Tournament,Rank,Player,Games,Wins,Draws,Losses,Score,Buchholz,SonnebornBerger,MedianBuchholz\n";
+    for (const auto& kv : pimpl->tournaments) {
+        const std::string tournament = chessDataLib::utils::EscapeCSVField(kv.second.GetName());
+        for (const TournamentStanding& s : kv.second.ComputeStandings()) {
+            ofs
+                << tournament << ','
+                << s.rank << ','
+                << chessDataLib::utils::EscapeCSVField(s.name) << ','
+                << s.games << ','
+                << s.wins << ','
+                << s.draws << ','
+                << s.losses << ','
+                << s.score << ','
+                << s.buchholz << ','
+                << s.sonnebornBerger << ','
+                << s.medianBuchholz << '\n';
+        }
+    }
+
+    return true;
+}
+
+// === Arrow export ===
+
+bool Parser::ExportGamesArrow(const std::string& path, ArrowWriter::Format format, std::size_t batchRows) const {
+    using Type = ArrowWriter::Type;
+    enum { Event, Site, Date, Round, White, Black, Result, WhiteElo, BlackElo, Eco, Opening, Moves };
+    ArrowWriter writer;
+    writer.SetBatchRows(batchRows);
+    if (!writer.Open(path,
+                     {{"event", Type::DictionaryUtf8},
+                      {"site", Type::DictionaryUtf8},
+                      {"date", Type::DictionaryUtf8},
+                      {"round", Type::DictionaryUtf8},
+                      {"white", Type::DictionaryUtf8},
+                      {"black", Type::DictionaryUtf8},
+                      {"result", Type::DictionaryUtf8},
+                      {"white_elo", Type::Int32, true},
+                      {"black_elo", Type::Int32, true},
+                      {"eco", Type::DictionaryUtf8},
+                      {"opening", Type::DictionaryUtf8},
+                      {"moves", Type::Int32}},
+                     format)) {
+        return false;
+    }
+
+    const auto appendElo = [&writer](std::size_t column, const std::string& elo) {
+        const int value = ParseLeadingInt(elo);
+        if (value > 0) writer.AppendInt32(column, value);
+        else writer.AppendNull(column);
+    };
+    for (const Game& g : pimpl->games) {
+        writer.AppendString(Event, g.GetEvent());
+        writer.AppendString(Site, g.GetSite());
+        writer.AppendString(Date, g.GetDate());
+        writer.AppendString(Round, g.GetRound());
+        writer.AppendString(White, g.GetWhite());
+        writer.AppendString(Black, g.GetBlack());
+        writer.AppendString(Result, g.GetResult());
+        appendElo(WhiteElo, g.GetWhiteElo());
+        appendElo(BlackElo, g.GetBlackElo());
+        writer.AppendString(Eco, g.GetEco());
+        writer.AppendString(Opening, g.GetOpening());
+        writer.AppendInt32(Moves, g.GetMoveCount());
+        if (!writer.EndRow()) return false;
+    }
+    return writer.Close();
+}
+
+bool Parser::ExportPlayersArrow(const std::string& path, ArrowWriter::Format format) const {
+    using Type = ArrowWriter::Type;
+    enum { Name, Total, AsWhite, AsBlack, Wins, Losses, Draws, WinPct, LossPct, DrawPct, TimeSpent, TimedMoves, Blunders };
+    ArrowWriter writer;
+    if (!writer.Open(path,
+                     {{"player", Type::Utf8},
+                      {"total_games", Type::Int32},
+                      {"games_white", Type::Int32},
+                      {"games_black", Type::Int32},
+                      {"wins", Type::Int32},
+                      {"losses", Type::Int32},
+                      {"draws", Type::Int32},
+                      {"win_pct", Type::Float64},
+                      {"loss_pct", Type::Float64},
+                      {"draw_pct", Type::Float64},
+                      {"time_spent_centis", Type::Int64},
+                      {"timed_moves", Type::Int32},
+                      {"blunders", Type::Int32}},
+                     format)) {
+        return false;
+    }
+
+    for (const auto& kv : pimpl->players) {
+        const Player& p = kv.second;
+        writer.AppendString(Name, p.GetName());
+        writer.AppendInt32(Total, p.GetTotalGames());
+        writer.AppendInt32(AsWhite, p.GetGamesAsWhiteCount());
+        writer.AppendInt32(AsBlack, p.GetGamesAsBlackCount());
+        writer.AppendInt32(Wins, p.GetWinsCount());
+        writer.AppendInt32(Losses, p.GetLossCount());
+        writer.AppendInt32(Draws, p.GetDrawCount());
+        writer.AppendFloat64(WinPct, p.GetWinPercentage());
+        writer.AppendFloat64(LossPct, p.GetLossPercentage());
+        writer.AppendFloat64(DrawPct, p.GetDrawPercentage());
+        writer.AppendInt64(TimeSpent, p.GetTimeSpentCentis());
+        writer.AppendInt32(TimedMoves, p.GetTimedMoves());
+        writer.AppendInt32(Blunders, p.GetBlunderCount());
+        if (!writer.EndRow()) return false;
+    }
+    return writer.Close();
+}
+
+bool Parser::ExportTournamentsArrow(const std::string& path, ArrowWriter::Format format) const {
+    using Type = ArrowWriter::Type;
+    enum { Name, Games, UniquePlayers, TopPlayer };
+    ArrowWriter writer;
+    if (!writer.Open(path,
+                     {{"tournament", Type::Utf8},
+                      {"games", Type::Int32},
+                      {"unique_players", Type::Int32},
+                      {"top_player", Type::DictionaryUtf8, true}},
+                     format)) {
+        return false;
+    }
+
+    for (const auto& kv : pimpl->tournaments) {
+        const Tournament& t = kv.second;
+        const std::string* topPlayer = nullptr;
+        int topCount = -1;
+        for (const auto& pp : t.GetPlayerGameCount()) {
+            if (pp.second > topCount) {
+                topCount = pp.second;
+                topPlayer = &pp.first;
+            }
+        }
+        writer.AppendString(Name, t.GetName());
+        writer.AppendInt32(Games, t.GetTotalGames());
+        writer.AppendInt32(UniquePlayers, t.GetUniquePlayers());
+        if (topPlayer) writer.AppendString(TopPlayer, *topPlayer);
+        else writer.AppendNull(TopPlayer);
+        if (!writer.EndRow()) return false;
+    }
+    return writer.Close();
+}
+
+// === Memory accounting ===
+
+MemoryReport Parser::GetMemoryReport() const {
+    MemoryReport report;
+
+    MemoryUsage games;
+    games.objects = pimpl->games.size();
+    games.inlineBytes = pimpl->games.size() * sizeof(Game);
+    games.containerBytes = (pimpl->games.capacity() - pimpl->games.size()) * sizeof(Game);
+    for (const auto& g : pimpl->games) games += g.GetMemoryUsage();
+    report.Add("games", games);
+
+    MemoryUsage players;
+    players.objects = pimpl->players.size();
+    utils::AccountHashMap(pimpl->players, players, [](const Player& p, MemoryUsage& u) {
+        u += p.GetMemoryUsage();
+    });
+    report.Add("players", players);
+
+    MemoryUsage tournaments;
+    tournaments.objects = pimpl->tournaments.size();
+    utils::AccountHashMap(pimpl->tournaments, tournaments, [](const Tournament& t, MemoryUsage& u) {
+        u += t.GetMemoryUsage();
+    });
+    report.Add("tournaments", tournaments);
+
+    MemoryUsage stats = pimpl->stats.GetMemoryUsage();
+    stats.objects = 1;
+    stats.inlineBytes += sizeof(DatabaseStats);
+    report.Add("stats", stats);
+
+    if (pimpl->movePool.Size() > 0) report.Add("moves", pimpl->movePool.GetMemoryUsage());
+    if (pimpl->materialIndex.GetPostingCount() > 0) report.Add("material", pimpl->materialIndex.GetMemoryUsage());
+    if (pimpl->timeSeries.GetBucketCount() > 0) report.Add("time series", pimpl->timeSeries.GetMemoryUsage());
+
+    return report;
+}
+
 // === Static analysis ===
 
 DatabaseStats Parser::AnalyzeFile(const std::string& filename, ProgressCallback callback) {
@@ -126,4 +1066,20 @@ DatabaseStats Parser::AnalyzeFile(const std::string& filename, ProgressCallback
     return parser.GetStats();
 }
 
+DatabaseStats Parser::AnalyzeFile(const std::string& filename, StatsSnapshotCache& cache, ProgressCallback callback) {
+    DatabaseStats stats;
+    if (cache.Lookup(filename, stats)) {
+        if (callback) callback(100, "Loaded cached snapshot.");
+        return stats;
+    }
+
+    // Identity taken before parsing: a file changed during the parse no longer
+    // matches it, so the stats of the old contents are never served for the new
+    FileIdentity identity;
+    const bool identified = FileIdentity::FromFile(filename, identity);
+    Parser parser;
+    if (parser.LoadFile(filename, callback) && identified) cache.Store(identity, parser.GetStats());
+    return parser.GetStats();
+}
+
 } // namespace chessDataLib
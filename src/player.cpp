@@ -46,11 +46,27 @@ double Player::GetDrawPercentage() const {
     return totalGames ? (100.0 * draws / totalGames) : 0.0;
 }
 
+int64_t Player::GetTimeSpentCentis() const {
+    return timeSpentCentis;
+}
+
+int Player::GetTimedMoves() const {
+    return timedMoves;
+}
+
+double Player::GetAverageMoveTimeSeconds() const {
+    return timedMoves ? (timeSpentCentis / 100.0 / timedMoves) : 0.0;
+}
+
+int Player::GetBlunderCount() const {
+    return blunders;
+}
+
 const std::vector<std::string> Player::GetOpponents() const {
     return opponents;
 }
 
-const std::unordered_map<std::string, int> Player::GetOpeningFrequency() const {
+const utils::StringMap<int>& Player::GetOpeningFrequency() const {
     return openingFrequency;
 }
 
@@ -88,7 +104,7 @@ void Player::SetOpponents(const std::vector<std::string>& val) {
     opponents = val;
 }
 
-void Player::SetOpeningFrequency(const std::unordered_map<std::string, int>& val) {
+void Player::SetOpeningFrequency(const utils::StringMap<int>& val) {
     openingFrequency = val;
 }
 
@@ -110,6 +126,15 @@ void Player::IncrementDrawCount() {
     draws++;
 }
 
+void Player::AddTimeUsage(int64_t centis, int moves) {
+    timeSpentCentis += centis;
+    timedMoves += moves;
+}
+
+void Player::AddBlunders(int count) {
+    blunders += count;
+}
+
 void Player::AddOpponent(const std::string& opponentName) {
     if (std::find(opponents.begin(), opponents.end(), opponentName) == opponents.end()) {
         opponents.push_back(opponentName);
@@ -127,6 +152,9 @@ void Player::ResetStats() {
     wins = 0;
     losses = 0;
     draws = 0;
+    timeSpentCentis = 0;
+    timedMoves = 0;
+    blunders = 0;
     opponents.clear();
     openingFrequency.clear();
 }
@@ -138,6 +166,9 @@ void Player::MergeWith(const Player& other) {
     wins += other.wins;
     losses += other.losses;
     draws += other.draws;
+    timeSpentCentis += other.timeSpentCentis;
+    timedMoves += other.timedMoves;
+    blunders += other.blunders;
 
     for (const auto& opp : other.opponents) {
         AddOpponent(opp);
@@ -148,6 +179,15 @@ void Player::MergeWith(const Player& other) {
     }
 }
 
+void Player::MergeAliases(const utils::StringMap<std::string>& aliases) {
+    std::vector<std::string> renamed;
+    renamed.swap(opponents);
+    for (const auto& opp : renamed) {
+        auto it = aliases.find(opp);
+        AddOpponent(it == aliases.end() ? opp : it->second);
+    }
+}
+
 std::string Player::ToString() const {
     std::ostringstream out;
     out << "Player: " << name << "\n"
@@ -162,4 +202,14 @@ std::string Player::ToString() const {
     return out.str();
 }
 
+// === Memory accounting ===
+
+MemoryUsage Player::GetMemoryUsage() const {
+    MemoryUsage usage;
+    utils::AccountString(name, usage);
+    utils::AccountStrings(opponents, usage);
+    utils::AccountHashMap(openingFrequency, usage);
+    return usage;
+}
+
 } // namespace chessDataLib
@@ -0,0 +1,435 @@
+#include "playerNameResolver.hpp"
+#include "utils/editDistance.hpp"
+#include "utils/workStealingPool.hpp"
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+
+namespace chessDataLib {
+
+namespace {
+
+// ASCII base letters of U+00C0-U+00FF (Latin-1 Supplement); ' ' for the
+// multiplication and division signs
+const char kLatin1[] = "AAAAAAACEEEEIIIIDNOOOOO OUUUUYTsaaaaaaaceeeeiiiidnooooo ouuuuyty";
+// ASCII base letters of U+0100-U+017F (Latin Extended-A)
+const char kLatinExtendedA[] =
+    "AaAaAaCcCcCcCcDdDdEeEeEeEeEeGgGgGgGgHhHhIiIiIiIiIiJjJjKkkLlLlLlLlLlNnNnNnnNnOoOoOoOoRrRrRrSsSsSsSsTtTtTtUuUuUuUuUuUu"
+    "WwYyYZzZzZzs";
+static_assert(sizeof(kLatin1) == 64 + 1, "one letter per code point");
+static_assert(sizeof(kLatinExtendedA) == 128 + 1, "one letter per code point");
+
+// Lowercase particles that belong to the surname ("van der Wiel", "de Firmian")
+bool IsParticle(const std::string& word) {
+    static const char* const kParticles[] = {"van", "von", "der", "den", "de", "del", "della", "di", "da", "du", "le", "la"};
+    for (const char* p : kParticles) {
+        if (word == p) return true;
+    }
+    return false;
+}
+
+char FoldAscii(unsigned char c) {
+    if (c >= 'A' && c <= 'Z') return static_cast<char>(c - 'A' + 'a');
+    if ((c >= 'a' && c <= 'z') || (c >= '0' && c <= '9') || c == ',' || c == '-') return static_cast<char>(c);
+    if (c == ' ' || c == '\t' || c == '.' || c == '_') return ' ';
+    return 0;  // other punctuation is dropped
+}
+
+// Words of a name, folded, with the range of words forming the surname
+struct NameParts {
+    std::vector<std::string> words;
+    std::size_t surnameBegin = 0;
+    std::size_t surnameEnd = 0;
+    bool hasComma = false;
+};
+
+NameParts Split(std::string_view name) {
+    NameParts parts;
+    std::string word;
+    std::size_t commaWords = 0;
+    const auto flush = [&] {
+        if (!word.empty()) parts.words.push_back(std::move(word));
+        word.clear();
+    };
+    for (std::size_t i = 0; i < name.size(); ++i) {
+        const unsigned char c = static_cast<unsigned char>(name[i]);
+        char folded;
+        if (c < 0x80) {
+            folded = FoldAscii(c);
+        } else if (c >= 0xC3 && c <= 0xC5 && i + 1 < name.size() &&
+                   (static_cast<unsigned char>(name[i + 1]) & 0xC0) == 0x80) {
+            const unsigned codePoint = ((c & 0x1Fu) << 6) | (static_cast<unsigned char>(name[++i]) & 0x3Fu);
+            folded = codePoint < 0x100 ? kLatin1[codePoint - 0xC0] : kLatinExtendedA[codePoint - 0x100];
+            folded = FoldAscii(static_cast<unsigned char>(folded));
+        } else {
+            word.push_back(static_cast<char>(c));  // other scripts are kept byte for byte
+            continue;
+        }
+        if (folded == ',') {
+            flush();
+            if (!parts.hasComma) commaWords = parts.words.size();
+            parts.hasComma = true;
+        } else if (folded == ' ') {
+            flush();
+        } else if (folded) {
+            word.push_back(folded);
+        }
+    }
+    flush();
+
+    const std::size_t n = parts.words.size();
+    if (parts.hasComma && commaWords > 0) {
+        parts.surnameEnd = commaWords;
+    } else if (n >= 2 && parts.words[n - 1].size() == 1 && parts.words[0].size() > 1) {
+        parts.surnameEnd = 1;  // "Carlsen M": surname first, initial last
+    } else if (n > 0) {
+        parts.surnameBegin = n - 1;
+        while (parts.surnameBegin > 1 && IsParticle(parts.words[parts.surnameBegin - 1])) --parts.surnameBegin;
+        parts.surnameEnd = n;
+    }
+    return parts;
+}
+
+// "surname, given names", hyphens spelled as spaces
+std::string Join(const NameParts& parts) {
+    std::string key;
+    const auto append = [&key](const std::string& word) {
+        if (!key.empty() && key.back() != ' ') key.push_back(' ');
+        for (char c : word) key.push_back(c == '-' ? ' ' : c);
+    };
+    for (std::size_t i = parts.surnameBegin; i < parts.surnameEnd; ++i) append(parts.words[i]);
+    bool given = false;
+    for (std::size_t i = 0; i < parts.words.size(); ++i) {
+        if (i >= parts.surnameBegin && i < parts.surnameEnd) continue;
+        if (!given) key += ",";
+        given = true;
+        append(parts.words[i]);
+    }
+    return key;
+}
+
+std::string_view SurnameOf(std::string_view key) {
+    const std::size_t comma = key.find(',');
+    return comma == std::string_view::npos ? key : key.substr(0, comma);
+}
+
+// Given-name words of a normalized key
+std::vector<std::string_view> GivenWordsOf(std::string_view key) {
+    std::vector<std::string_view> words;
+    const std::size_t comma = key.find(',');
+    if (comma == std::string_view::npos) return words;
+    std::size_t i = comma + 1;
+    while (i < key.size()) {
+        while (i < key.size() && key[i] == ' ') ++i;
+        const std::size_t start = i;
+        while (i < key.size() && key[i] != ' ') ++i;
+        if (i > start) words.push_back(key.substr(start, i - start));
+    }
+    return words;
+}
+
+std::uint32_t GramAt(const std::string& padded, std::size_t i) {
+    return (std::uint32_t(static_cast<unsigned char>(padded[i])) << 16) |
+           (std::uint32_t(static_cast<unsigned char>(padded[i + 1])) << 8) |
+           std::uint32_t(static_cast<unsigned char>(padded[i + 2]));
+}
+
+// Distinct trigrams of a key, with begin and end markers
+std::vector<std::uint32_t> GramsOf(const std::string& key) {
+    const std::string padded = "\x01" + key + "\x02";
+    std::vector<std::uint32_t> grams;
+    grams.reserve(key.size());
+    for (std::size_t i = 0; i + 2 < padded.size(); ++i) grams.push_back(GramAt(padded, i));
+    std::sort(grams.begin(), grams.end());
+    grams.erase(std::unique(grams.begin(), grams.end()), grams.end());
+    return grams;
+}
+
+// Signature bit of a trigram (multiplicative hash to 6 bits)
+std::uint64_t SignatureBit(std::uint32_t gram) {
+    return std::uint64_t(1) << ((gram * 0x9E3779B1u) >> 26);
+}
+
+// Set bits of x; SWAR unless the target has POPCNT, where the builtin
+// would otherwise be a library call
+int PopCount(std::uint64_t x) {
+#if defined(__POPCNT__)
+    return __builtin_popcountll(x);
+#else
+    x -= (x >> 1) & 0x5555555555555555ull;
+    x = (x & 0x3333333333333333ull) + ((x >> 2) & 0x3333333333333333ull);
+    x = (x + (x >> 4)) & 0x0F0F0F0F0F0F0F0Full;
+    return static_cast<int>((x * 0x0101010101010101ull) >> 56);
+#endif
+}
+
+} // namespace
+
+// === Normalization ===
+
+std::string PlayerNameResolver::Normalize(std::string_view name) {
+    return Join(Split(name));
+}
+
+// === Building ===
+
+void PlayerNameResolver::AddCanonical(const std::string& name) {
+    if (byName.contains(name)) return;
+    byName.emplace(name, static_cast<std::uint32_t>(names.size()));
+    names.push_back(name);
+    keys.push_back(Normalize(name));
+}
+
+void PlayerNameResolver::AddAlias(const std::string& alias, const std::string& canonical) {
+    AddCanonical(canonical);
+    const std::uint32_t id = byName.at(canonical);
+    aliases[alias] = id;
+    aliases[Normalize(alias)] = id;
+}
+
+bool PlayerNameResolver::LoadAliases(const std::string& path) {
+    std::ifstream in(path);
+    if (!in.is_open()) {
+        std::cerr << "LoadAliases: failed to open " << path << "\n";
+        return false;
+    }
+    std::string line;
+    while (std::getline(in, line)) {
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (line.empty() || line[0] == '#') continue;
+        const std::size_t tab = line.find('\t');
+        if (tab == std::string::npos || tab == 0 || tab + 1 == line.size()) continue;
+        AddAlias(line.substr(0, tab), line.substr(tab + 1));
+    }
+    return true;
+}
+
+void PlayerNameResolver::SetMaxDistance(int distance) {
+    maxDistance = std::max(0, distance);
+}
+
+void PlayerNameResolver::Build() {
+    byKey.clear();
+    bySurname.clear();
+    byKey.reserve(keys.size());
+    for (std::uint32_t id = 0; id < keys.size(); ++id) {
+        byKey.try_emplace(keys[id], id);
+        bySurname[std::string(SurnameOf(keys[id]))].push_back(id);
+    }
+
+    // Slots: IDs by key length
+    slotIds.resize(keys.size());
+    for (std::uint32_t id = 0; id < keys.size(); ++id) slotIds[id] = id;
+    std::stable_sort(slotIds.begin(), slotIds.end(),
+                     [this](std::uint32_t a, std::uint32_t b) { return keys[a].size() < keys[b].size(); });
+    const std::size_t maxLength = keys.empty() ? 0 : keys[slotIds.back()].size();
+    lengthStarts.assign(maxLength + 2, 0);
+    for (std::uint32_t id : slotIds) ++lengthStarts[keys[id].size() + 1];
+    for (std::size_t len = 1; len < lengthStarts.size(); ++len) lengthStarts[len] += lengthStarts[len - 1];
+
+    std::vector<std::uint64_t> pairs;  // gram << 32 | slot
+    std::vector<std::uint64_t> signatures(slotIds.size(), 0);
+    pairs.reserve(keys.size() * 16);
+    for (std::uint32_t slot = 0; slot < slotIds.size(); ++slot) {
+        for (std::uint32_t gram : GramsOf(keys[slotIds[slot]])) {
+            pairs.push_back(std::uint64_t(gram) << 32 | slot);
+            signatures[slot] |= SignatureBit(gram);
+        }
+    }
+    std::sort(pairs.begin(), pairs.end());
+
+    gramIndex.clear();
+    gramOffsets.clear();
+    gramPostings.clear();
+    gramSignatures.clear();
+    gramPostings.reserve(pairs.size());
+    gramSignatures.reserve(pairs.size());
+    std::uint32_t lastGram = 0;
+    for (std::uint64_t pair : pairs) {
+        const std::uint32_t gram = static_cast<std::uint32_t>(pair >> 32);
+        if (gramOffsets.empty() || gram != lastGram) {
+            gramIndex.emplace(gram, static_cast<std::uint32_t>(gramOffsets.size()));
+            gramOffsets.push_back(static_cast<std::uint32_t>(gramPostings.size()));
+            lastGram = gram;
+        }
+        gramPostings.push_back(static_cast<std::uint32_t>(pair));
+        gramSignatures.push_back(signatures[static_cast<std::uint32_t>(pair)]);
+    }
+    gramOffsets.push_back(static_cast<std::uint32_t>(gramPostings.size()));
+}
+
+// === Resolving ===
+
+PlayerNameResolver::Match PlayerNameResolver::Resolve(std::string_view name) const {
+    return ResolveWith(name);
+}
+
+std::vector<PlayerNameResolver::Match> PlayerNameResolver::ResolveAll(const std::vector<std::string>& queries,
+                                                                      unsigned threadCount) const {
+    constexpr std::size_t kBlock = 1024;
+    std::vector<Match> matches(queries.size());
+    utils::WorkStealingPool pool(threadCount);
+    pool.Run((queries.size() + kBlock - 1) / kBlock, [&](std::size_t block, unsigned) {
+        const std::size_t end = std::min(queries.size(), (block + 1) * kBlock);
+        for (std::size_t i = block * kBlock; i < end; ++i) matches[i] = ResolveWith(queries[i]);
+    });
+    return matches;
+}
+
+std::vector<PlayerNameResolver::Match> PlayerNameResolver::Suggest(std::string_view name, std::size_t limit) const {
+    std::vector<std::pair<int, std::uint32_t>> found;
+    FindFuzzy(Normalize(name), maxDistance, found);
+    std::sort(found.begin(), found.end());
+    if (found.size() > limit) found.resize(limit);
+
+    std::vector<Match> suggestions;
+    suggestions.reserve(found.size());
+    for (const auto& [distance, id] : found) suggestions.push_back(MakeMatch(MatchKind::Fuzzy, id, distance));
+    return suggestions;
+}
+
+PlayerNameResolver::Match PlayerNameResolver::ResolveWith(std::string_view name) const {
+    if (auto it = aliases.find(name); it != aliases.end()) return MakeMatch(MatchKind::Alias, it->second);
+    if (auto it = byName.find(name); it != byName.end()) return MakeMatch(MatchKind::Exact, it->second);
+
+    NameParts parts = Split(name);
+    const std::string key = Join(parts);
+    if (auto it = aliases.find(key); it != aliases.end()) return MakeMatch(MatchKind::Alias, it->second);
+    if (auto it = byKey.find(key); it != byKey.end()) return MakeMatch(MatchKind::Normalized, it->second);
+    if (!parts.hasComma && parts.words.size() >= 2 && parts.surnameBegin != 0) {
+        // "Carlsen Magnus": try the first word as the surname
+        parts.surnameBegin = 0;
+        parts.surnameEnd = 1;
+        if (auto it = byKey.find(Join(parts)); it != byKey.end()) return MakeMatch(MatchKind::Normalized, it->second);
+    }
+
+    std::uint32_t id = 0;
+    if (MatchInitials(key, id)) return MakeMatch(MatchKind::Initials, id);
+
+    const int budget = std::min(maxDistance, static_cast<int>(key.size() / 6));
+    // Widen the search one edit at a time: small radii scan fewer lists,
+    // and the nearest names are all found at the first radius that has any
+    std::vector<std::pair<int, std::uint32_t>> found;
+    for (int radius = 1; radius <= budget && found.empty(); ++radius) FindFuzzy(key, radius, found);
+    if (found.empty()) return Match();
+    const auto best = std::min_element(found.begin(), found.end());
+    for (const auto& candidate : found) {
+        if (candidate.first == best->first && candidate.second != best->second) return Match();  // ambiguous
+    }
+    return MakeMatch(MatchKind::Fuzzy, best->second, best->first);
+}
+
+bool PlayerNameResolver::MatchInitials(const std::string& key, std::uint32_t& id) const {
+    const std::vector<std::string_view> initials = GivenWordsOf(key);
+    if (initials.empty()) return false;
+    for (std::string_view word : initials) {
+        if (word.size() != 1) return false;
+    }
+    const auto it = bySurname.find(SurnameOf(key));
+    if (it == bySurname.end()) return false;
+
+    bool found = false;
+    for (std::uint32_t candidate : it->second) {
+        const std::vector<std::string_view> given = GivenWordsOf(keys[candidate]);
+        if (given.size() < initials.size()) continue;
+        bool matches = true;
+        for (std::size_t i = 0; i < initials.size() && matches; ++i) matches = given[i][0] == initials[i][0];
+        if (!matches) continue;
+        if (found) return false;  // ambiguous
+        found = true;
+        id = candidate;
+    }
+    return found;
+}
+
+void PlayerNameResolver::FindFuzzy(const std::string& key, int distance,
+                                   std::vector<std::pair<int, std::uint32_t>>& found) const {
+    if (distance <= 0 || gramPostings.empty()) return;
+    const std::size_t k = static_cast<std::size_t>(distance);
+    const auto slotsFrom = [this](std::size_t length) {
+        return lengthStarts[std::min(length, lengthStarts.size() - 1)];
+    };
+    const std::uint32_t firstSlot = slotsFrom(key.size() > k ? key.size() - k : 0);
+    const std::uint32_t lastSlot = slotsFrom(key.size() + k + 1);
+
+    // Posting lists of the query's trigrams; absent trigrams give empty lists
+    struct List {
+        std::uint32_t begin, end;
+    };
+    std::vector<List> lists;
+    std::uint64_t signature = 0;
+    for (std::uint32_t gram : GramsOf(key)) {
+        signature |= SignatureBit(gram);
+        const auto it = gramIndex.find(gram);
+        if (it == gramIndex.end()) lists.push_back({0, 0});
+        else lists.push_back({gramOffsets[it->second], gramOffsets[it->second + 1]});
+    }
+    // Every edit destroys at most three trigrams, so a match lacks at most 3k
+    // of the query's distinct trigrams and is in one of the 3k + 1 rarest
+    // lists; with fewer trigrams there is nothing to filter on
+    const std::size_t lost = 3 * k;
+    if (lists.size() <= lost) return;
+    std::partial_sort(lists.begin(), lists.begin() + static_cast<std::ptrdiff_t>(lost + 1), lists.end(),
+                      [](const List& a, const List& b) { return a.end - a.begin < b.end - b.begin; });
+    for (std::size_t l = 0; l <= lost; ++l) {
+        const auto first = gramPostings.begin() + lists[l].begin;
+        const auto last = gramPostings.begin() + lists[l].end;
+        const auto begin = std::lower_bound(first, last, firstSlot);
+        lists[l] = {static_cast<std::uint32_t>(begin - gramPostings.begin()),
+                    static_cast<std::uint32_t>(std::lower_bound(begin, last, lastSlot) - gramPostings.begin())};
+    }
+
+    // Postings carry the signature of their name, so the scan is sequential;
+    // likewise each side may lack at most 3k of the other's signature bits
+    const utils::EditDistanceMatcher matcher(key);
+    const std::size_t before = found.size();
+    for (std::size_t l = 0; l <= lost; ++l) {
+        for (std::uint32_t p = lists[l].begin; p < lists[l].end; ++p) {
+            const std::uint64_t other = gramSignatures[p];
+            if (static_cast<std::size_t>(PopCount(signature & ~other)) > lost ||
+                static_cast<std::size_t>(PopCount(other & ~signature)) > lost) {
+                continue;
+            }
+            const std::uint32_t id = slotIds[gramPostings[p]];
+            const int d = matcher.Distance(keys[id], distance);
+            if (d <= distance) found.emplace_back(d, id);
+        }
+    }
+    // A name in several of the scanned lists is found once per list
+    std::sort(found.begin() + static_cast<std::ptrdiff_t>(before), found.end());
+    found.erase(std::unique(found.begin() + static_cast<std::ptrdiff_t>(before), found.end()), found.end());
+}
+
+PlayerNameResolver::Match PlayerNameResolver::MakeMatch(MatchKind kind, std::uint32_t id, int distance) const {
+    Match match;
+    match.kind = kind;
+    match.canonical = names[id];
+    match.distance = distance;
+    return match;
+}
+
+// === Queries ===
+
+std::size_t PlayerNameResolver::GetCanonicalCount() const {
+    return names.size();
+}
+
+MemoryUsage PlayerNameResolver::GetMemoryUsage() const {
+    MemoryUsage usage;
+    usage.objects = names.size();
+    utils::AccountStrings(names, usage);
+    utils::AccountStrings(keys, usage);
+    utils::AccountHashMap(byName, usage);
+    utils::AccountHashMap(byKey, usage);
+    utils::AccountHashMap(aliases, usage);
+    utils::AccountHashMap(bySurname, usage, [](const std::vector<std::uint32_t>& ids, MemoryUsage& u) {
+        u.containerBytes += ids.capacity() * sizeof(std::uint32_t);
+    });
+    usage.containerBytes += gramIndex.capacity() * (1 + sizeof(std::pair<std::uint32_t, std::uint32_t>));
+    usage.inlineBytes += (gramOffsets.capacity() + gramPostings.capacity() +
+                          slotIds.capacity() + lengthStarts.capacity()) * sizeof(std::uint32_t) +
+                         gramSignatures.capacity() * sizeof(std::uint64_t);
+    return usage;
+}
+
+} // namespace chessDataLib
@@ -0,0 +1,66 @@
+#include "progress.hpp"
+
+namespace chessDataLib {
+
+ProgressReporter::ProgressReporter(ProgressHandler progressHandler, ProgressOptions progressOptions,
+                                   std::uint64_t total)
+    : handler(std::move(progressHandler)), options(progressOptions), bytesTotal(total), start(Clock::now()),
+      lastTime(start) {
+    nextReportNanos = static_cast<std::int64_t>(options.intervalSeconds * 1e9);
+    nextReportBytes = options.intervalBytes ? options.intervalBytes : UINT64_MAX;
+}
+
+void ProgressReporter::Advance(std::uint64_t addedBytes, std::uint64_t addedGames) {
+    const std::uint64_t done = bytes.fetch_add(addedBytes, std::memory_order_relaxed) + addedBytes;
+    games.fetch_add(addedGames, std::memory_order_relaxed);
+    if (!handler) return;
+
+    const Clock::time_point now = Clock::now();
+    const std::int64_t nanos = std::chrono::duration_cast<std::chrono::nanoseconds>(now - start).count();
+    if (nanos < nextReportNanos.load(std::memory_order_relaxed) &&
+        done < nextReportBytes.load(std::memory_order_relaxed)) {
+        return;
+    }
+
+    // One reporter at a time; the others carry on parsing
+    std::unique_lock<std::mutex> lock(reportMutex, std::try_to_lock);
+    if (!lock.owns_lock()) return;
+    nextReportNanos.store(nanos + static_cast<std::int64_t>(options.intervalSeconds * 1e9), std::memory_order_relaxed);
+    if (options.intervalBytes) nextReportBytes.store(done + options.intervalBytes, std::memory_order_relaxed);
+    Report(now, false, false);
+}
+
+void ProgressReporter::Finish(bool cancelled) {
+    if (!handler) return;
+    std::lock_guard<std::mutex> lock(reportMutex);
+    Report(Clock::now(), true, cancelled);
+}
+
+void ProgressReporter::Report(Clock::time_point now, bool finished, bool cancelled) {
+    ProgressInfo info;
+    info.bytesDone = bytes.load(std::memory_order_relaxed);
+    info.bytesTotal = bytesTotal;
+    info.gamesDone = games.load(std::memory_order_relaxed);
+    info.elapsedSeconds = std::chrono::duration<double>(now - start).count();
+    info.finished = finished;
+    info.cancelled = cancelled;
+
+    const double window = std::chrono::duration<double>(now - lastTime).count();
+    if (window > 0) {
+        info.bytesPerSecond = static_cast<double>(info.bytesDone - lastBytes) / window;
+        info.gamesPerSecond = static_cast<double>(info.gamesDone - lastGames) / window;
+    }
+    if (finished) {
+        info.etaSeconds = 0;
+    } else if (info.bytesDone > 0 && info.elapsedSeconds > 0 && bytesTotal >= info.bytesDone) {
+        const double rate = static_cast<double>(info.bytesDone) / info.elapsedSeconds;
+        info.etaSeconds = static_cast<double>(bytesTotal - info.bytesDone) / rate;
+    }
+    lastBytes = info.bytesDone;
+    lastGames = info.gamesDone;
+    lastTime = now;
+
+    handler(info);
+}
+
+} // namespace chessDataLib
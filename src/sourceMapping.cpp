@@ -0,0 +1,133 @@
+#include "sourceMapping.hpp"
+#include "PGNMoveText.hpp"
+#include <fstream>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define CHESSDATALIB_HAVE_MMAP 1
+#endif
+
+namespace chessDataLib {
+
+std::shared_ptr<SourceMapping> SourceMapping::Open(const std::string& filename) {
+    std::shared_ptr<SourceMapping> m(new SourceMapping());
+    m->path = filename;
+
+#ifdef CHESSDATALIB_HAVE_MMAP
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0) return nullptr;
+    struct stat st;
+    if (::fstat(fd, &st) != 0) {
+        ::close(fd);
+        return nullptr;
+    }
+    m->size = static_cast<std::uint64_t>(st.st_size);
+    if (m->size > 0) {
+        void* p = ::mmap(nullptr, static_cast<std::size_t>(m->size), PROT_READ, MAP_PRIVATE, fd, 0);
+        if (p != MAP_FAILED) {
+            m->data = static_cast<const char*>(p);
+            m->mapped = true;
+        }
+    }
+    ::close(fd); // the mapping keeps its own reference to the file
+    if (m->mapped || m->size == 0) return m;
+#endif
+
+    std::ifstream in(filename, std::ios::binary | std::ios::ate);
+    if (!in.is_open()) return nullptr;
+    m->size = static_cast<std::uint64_t>(in.tellg());
+    m->fallback.resize(static_cast<std::size_t>(m->size));
+    in.seekg(0);
+    in.read(m->fallback.data(), static_cast<std::streamsize>(m->fallback.size()));
+    m->data = m->fallback.data();
+    return m;
+}
+
+SourceMapping::~SourceMapping() {
+#ifdef CHESSDATALIB_HAVE_MMAP
+    if (mapped) ::munmap(const_cast<char*>(data), static_cast<std::size_t>(size));
+#endif
+}
+
+const char* SourceMapping::Data() const {
+    return data;
+}
+
+std::uint64_t SourceMapping::Size() const {
+    return size;
+}
+
+const std::string& SourceMapping::GetPath() const {
+    return path;
+}
+
+void SourceMapping::SetMoveListCacheCapacity(std::size_t entries) {
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    cacheCapacity = entries;
+    while (lru.size() > cacheCapacity) {
+        lruIndex.erase(lru.back().first);
+        lru.pop_back();
+    }
+}
+
+std::shared_ptr<const std::vector<std::string>> SourceMapping::GetMoveList(std::uint64_t offset, std::uint32_t length) const {
+    if (offset > size || length > size - offset) return std::make_shared<const std::vector<std::string>>();
+
+    {
+        std::lock_guard<std::mutex> lock(cacheMutex);
+        auto it = lruIndex.find(offset);
+        if (it != lruIndex.end()) {
+            lru.splice(lru.begin(), lru, it->second);
+            return it->second->second;
+        }
+    }
+
+    // Decode outside the lock; a concurrent miss on the same game just decodes twice
+    auto moves = std::make_shared<const std::vector<std::string>>(
+        PGNMoveText::MainlineMoves(data + offset, data + offset + length));
+
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    if (cacheCapacity == 0 || lruIndex.count(offset)) return moves;
+    lru.emplace_front(offset, moves);
+    lruIndex[offset] = lru.begin();
+    if (lru.size() > cacheCapacity) {
+        lruIndex.erase(lru.back().first);
+        lru.pop_back();
+    }
+    return moves;
+}
+
+// === SourceTable ===
+
+std::uint32_t SourceTable::Add(std::shared_ptr<const SourceMapping> source) {
+    std::lock_guard<std::mutex> lock(mutex);
+    sources.push_back(std::move(source));
+    return static_cast<std::uint32_t>(sources.size() - 1);
+}
+
+const SourceMapping* SourceTable::Get(std::uint32_t id) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return id < sources.size() ? sources[id].get() : nullptr;
+}
+
+std::size_t SourceTable::Size() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return sources.size();
+}
+
+std::string SourceTable::GetMoveText(const MoveTextRef& ref) const {
+    const SourceMapping* src = Get(ref.source);
+    if (!src || ref.offset > src->Size() || ref.length > src->Size() - ref.offset) return std::string();
+    return std::string(src->Data() + ref.offset, ref.length);
+}
+
+std::shared_ptr<const std::vector<std::string>> SourceTable::GetMoveList(const MoveTextRef& ref) const {
+    const SourceMapping* src = Get(ref.source);
+    if (!src) return std::make_shared<const std::vector<std::string>>();
+    return src->GetMoveList(ref.offset, ref.length);
+}
+
+} // namespace chessDataLib
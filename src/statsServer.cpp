@@ -0,0 +1,448 @@
+#include "statsServer.hpp"
+#include "databaseStats.hpp"
+#include "parser.hpp"
+#include "statsSnapshot.hpp"
+#include <algorithm>
+#include <charconv>
+#include <cstdio>
+#include <filesystem>
+#include <iostream>
+
+#if defined(__linux__)
+#include <cerrno>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#define CHESSDATALIB_HAVE_EPOLL 1
+#endif
+
+namespace chessDataLib {
+
+namespace fs = std::filesystem;
+
+namespace {
+
+constexpr std::size_t kMaxLine = 64 * 1024;  // longer requests close the connection
+constexpr std::size_t kReadSize = 64 * 1024;
+constexpr std::size_t kMaxReadPerWakeup = 4 * kReadSize;  // one client cannot hold a thread for long
+constexpr std::size_t kMaxPendingOutput = 1024 * 1024;    // past this, stop reading until the client reads
+constexpr int kMaxEvents = 16;
+
+// epoll tags of the two non-connection descriptors; connections are tagged
+// with their (aligned, hence never 1 or 2) Connection pointer
+constexpr std::uint64_t kListenTag = 1;
+constexpr std::uint64_t kWakeTag = 2;
+
+// Splits a request into its command and arguments. Arguments are
+// tab-separated; without tabs the rest of the line is one argument, except
+// for OPENING, whose ECO codes may also be separated by a space.
+std::string_view SplitCommand(std::string_view line, std::vector<std::string_view>& args) {
+    args.clear();
+    const std::size_t sep = line.find_first_of(" \t");
+    if (sep == std::string_view::npos) return line;
+    const std::string_view command = line.substr(0, sep);
+    std::string_view rest = line.substr(sep + 1);
+    char delimiter = '\t';
+    if (rest.find('\t') == std::string_view::npos) {
+        if (command != "OPENING") {
+            args.push_back(rest);
+            return command;
+        }
+        delimiter = ' ';
+    }
+    for (std::size_t next; (next = rest.find(delimiter)) != std::string_view::npos; rest = rest.substr(next + 1)) {
+        args.push_back(rest.substr(0, next));
+    }
+    args.push_back(rest);
+    return command;
+}
+
+void AppendField(std::string& out, std::string_view field) {
+    out += '\t';
+    out += field;
+}
+
+void AppendField(std::string& out, std::uint64_t value) {
+    char buf[24];
+    const auto r = std::to_chars(buf, buf + sizeof(buf), value);
+    out += '\t';
+    out.append(buf, r.ptr);
+}
+
+void AppendField(std::string& out, double value) {
+    char buf[32];
+    const int n = std::snprintf(buf, sizeof(buf), "\t%.1f", value);
+    out.append(buf, static_cast<std::size_t>(n));
+}
+
+void AppendError(std::string& out, std::string_view message) {
+    out += "ERR";
+    AppendField(out, message);
+}
+
+} // namespace
+
+// === Connection ===
+
+struct StatsServer::Connection {
+    int fd = -1;
+    std::string in;
+    std::string out;
+    std::size_t written = 0;  ///< Bytes of out already sent
+    bool closing = false;     ///< Close once out is flushed
+};
+
+// === Dataset ===
+
+std::shared_ptr<const StatsServer::Dataset> StatsServer::LoadDataset(const std::string& path, unsigned threadCount) {
+    auto data = std::make_shared<Dataset>();
+    FileIdentity identity;
+    auto stats = std::make_shared<DatabaseStats>();
+    if (StatsSnapshot::Load(path, identity, *stats)) {
+        data->stats = std::move(stats);
+        return data;
+    }
+
+    auto parser = std::make_shared<Parser>();
+    parser->SetThreadCount(threadCount);
+    if (!parser->LoadFile(path)) return nullptr;
+    // Aliases the parser's stats: no copy, kept alive by the parser
+    data->stats = std::shared_ptr<const DatabaseStats>(parser, &parser->GetStats());
+    data->parser = std::move(parser);
+    return data;
+}
+
+// === Lifecycle ===
+
+StatsServer::StatsServer()
+    : dataset(std::make_shared<const Dataset>(Dataset{std::make_shared<const DatabaseStats>(), nullptr})) {}
+
+StatsServer::~StatsServer() {
+    Stop();
+}
+
+void StatsServer::SetDataset(std::shared_ptr<const Dataset> data) {
+    if (data && data->stats) dataset.Publish(std::move(data));
+}
+
+bool StatsServer::IsRunning() const {
+    return listenFd >= 0;
+}
+
+std::uint64_t StatsServer::GetRequestCount() const {
+    return requests.load(std::memory_order_relaxed);
+}
+
+std::uint64_t StatsServer::GetConnectionCount() const {
+    return accepted.load(std::memory_order_relaxed);
+}
+
+// === Request handling ===
+
+std::string StatsServer::HandleRequest(std::string_view line) const {
+    std::string out;
+    Answer(*dataset.Load(), line, out);
+    return out;
+}
+
+void StatsServer::Answer(const Dataset& data, std::string_view line, std::string& out) {
+    if (!line.empty() && line.back() == '\r') line.remove_suffix(1);
+    thread_local std::vector<std::string_view> args;
+    const std::string_view command = SplitCommand(line, args);
+    const DatabaseStats& stats = *data.stats;
+
+    if (command == "PING") {
+        out += "OK\tPONG";
+    } else if (command == "STATS") {
+        out += "OK";
+        AppendField(out, static_cast<std::uint64_t>(stats.GetTotalGames()));
+        AppendField(out, static_cast<std::uint64_t>(stats.GetUniquePlayers()));
+        AppendField(out, static_cast<std::uint64_t>(stats.GetUniqueTournaments()));
+        AppendField(out, static_cast<std::uint64_t>(stats.GetWhiteWins()));
+        AppendField(out, static_cast<std::uint64_t>(stats.GetBlackWins()));
+        AppendField(out, static_cast<std::uint64_t>(stats.GetDraws()));
+        AppendField(out, static_cast<std::uint64_t>(stats.GetUnknownResults()));
+    } else if (command == "PLAYER" && args.size() == 1) {
+        const auto it = stats.GetPlayerStats().find(args[0]);
+        if (it == stats.GetPlayerStats().end()) return AppendError(out, "unknown player");
+        const Player& p = it->second;
+        out += "OK";
+        AppendField(out, it->first);
+        AppendField(out, static_cast<std::uint64_t>(p.GetTotalGames()));
+        AppendField(out, static_cast<std::uint64_t>(p.GetWinsCount()));
+        AppendField(out, static_cast<std::uint64_t>(p.GetDrawCount()));
+        AppendField(out, static_cast<std::uint64_t>(p.GetLossCount()));
+    } else if (command == "TOURNAMENT" && args.size() == 1) {
+        const auto it = stats.GetTournaments().find(args[0]);
+        if (it == stats.GetTournaments().end()) return AppendError(out, "unknown tournament");
+        const Tournament& t = it->second;
+        const auto standings = t.ComputeStandings();
+        out += "OK";
+        AppendField(out, t.GetName());
+        AppendField(out, static_cast<std::uint64_t>(t.GetTotalGames()));
+        AppendField(out, static_cast<std::uint64_t>(t.GetUniquePlayers()));
+        AppendField(out, standings.empty() ? std::string_view() : std::string_view(standings[0].name));
+        AppendField(out, standings.empty() ? 0.0 : standings[0].score);
+    } else if (command == "OPENING" && (args.size() == 1 || args.size() == 2)) {
+        if (!data.parser) return AppendError(out, "not available from a snapshot");
+        OpeningQuery query;
+        query.ecoFirst = std::string(args[0]);
+        query.ecoLast = std::string(args.back());
+        if (OpeningStats::EcoIndex(query.ecoFirst) < 0 || OpeningStats::EcoIndex(query.ecoLast) < 0) {
+            return AppendError(out, "invalid ECO code");
+        }
+        const OpeningTotals totals = data.parser->GetOpeningStats().Slice(query);
+        out += "OK";
+        AppendField(out, totals.games);
+        AppendField(out, totals.whiteWins);
+        AppendField(out, totals.draws);
+        AppendField(out, totals.blackWins);
+        AppendField(out, totals.GetWhiteScorePercentage());
+    } else if (command == "H2H" && args.size() == 2) {
+        if (!data.parser) return AppendError(out, "not available from a snapshot");
+        PairRecord record;
+        data.parser->GetHeadToHead().GetRecord(std::string(args[0]), std::string(args[1]), record);
+        out += "OK";
+        AppendField(out, static_cast<std::uint64_t>(record.games));
+        AppendField(out, static_cast<std::uint64_t>(record.wins));
+        AppendField(out, static_cast<std::uint64_t>(record.draws));
+        AppendField(out, static_cast<std::uint64_t>(record.losses));
+    } else if (command == "GAME" && args.size() == 1) {
+        if (!data.parser) return AppendError(out, "not available from a snapshot");
+        std::size_t index = 0;
+        const auto r = std::from_chars(args[0].data(), args[0].data() + args[0].size(), index);
+        const auto& games = data.parser->GetGames();
+        if (r.ec != std::errc() || r.ptr != args[0].data() + args[0].size() || index >= games.size()) {
+            return AppendError(out, "invalid game index");
+        }
+        const Game& g = games[index];
+        out += "OK";
+        AppendField(out, g.GetEvent());
+        AppendField(out, g.GetDate());
+        AppendField(out, g.GetRound());
+        AppendField(out, g.GetWhite());
+        AppendField(out, g.GetBlack());
+        AppendField(out, g.GetResult());
+        AppendField(out, g.GetEco());
+    } else {
+        AppendError(out, "unknown command");
+    }
+}
+
+#ifdef CHESSDATALIB_HAVE_EPOLL
+
+// === Socket server ===
+
+bool StatsServer::Start(const std::string& socketPath, unsigned threadCount) {
+    if (IsRunning()) return false;
+    sockaddr_un address{};
+    if (socketPath.empty() || socketPath.size() >= sizeof(address.sun_path)) {
+        std::cerr << "StatsServer: invalid socket path " << socketPath << "\n";
+        return false;
+    }
+    address.sun_family = AF_UNIX;
+    socketPath.copy(address.sun_path, socketPath.size());
+
+    std::error_code ec;
+    if (fs::is_socket(socketPath, ec)) fs::remove(socketPath, ec);
+
+    listenFd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (listenFd < 0 || ::bind(listenFd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+        ::listen(listenFd, SOMAXCONN) != 0) {
+        std::cerr << "StatsServer: failed to bind " << socketPath << "\n";
+        if (listenFd >= 0) ::close(listenFd);
+        listenFd = -1;
+        return false;
+    }
+    path = socketPath;
+
+    epollFd = ::epoll_create1(EPOLL_CLOEXEC);
+    wakeFd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    // The listener is one-shot like the connections; the wake-up fd stays
+    // level-triggered so that it wakes every worker on Stop()
+    epoll_event listenEvent{EPOLLIN | EPOLLONESHOT, {nullptr}};
+    listenEvent.data.u64 = kListenTag;
+    epoll_event wakeEvent{EPOLLIN, {nullptr}};
+    wakeEvent.data.u64 = kWakeTag;
+    if (epollFd < 0 || wakeFd < 0 || ::epoll_ctl(epollFd, EPOLL_CTL_ADD, listenFd, &listenEvent) != 0 ||
+        ::epoll_ctl(epollFd, EPOLL_CTL_ADD, wakeFd, &wakeEvent) != 0) {
+        std::cerr << "StatsServer: failed to set up epoll\n";
+        Stop();
+        return false;
+    }
+
+    stopping = false;
+    if (threadCount == 0) threadCount = std::max(1u, std::thread::hardware_concurrency());
+    for (unsigned i = 0; i < threadCount; ++i) workers.emplace_back([this] { Run(); });
+    return true;
+}
+
+void StatsServer::Stop() {
+    if (listenFd < 0 && epollFd < 0) return;
+    stopping = true;
+    if (wakeFd >= 0) {
+        const std::uint64_t one = 1;
+        [[maybe_unused]] const ssize_t n = ::write(wakeFd, &one, sizeof(one));
+    }
+    for (auto& t : workers) t.join();
+    workers.clear();
+
+    for (auto& kv : connections) ::close(kv.second->fd);
+    connections.clear();
+    for (int* fd : {&listenFd, &epollFd, &wakeFd}) {
+        if (*fd >= 0) ::close(*fd);
+        *fd = -1;
+    }
+    std::error_code ec;
+    if (!path.empty()) fs::remove(path, ec);
+    path.clear();
+}
+
+void StatsServer::Run() {
+    epoll_event events[kMaxEvents];
+    while (!stopping.load(std::memory_order_acquire)) {
+        const int n = ::epoll_wait(epollFd, events, kMaxEvents, -1);
+        if (n < 0 && errno != EINTR) break;
+        for (int i = 0; i < n; ++i) {
+            if (events[i].data.u64 == kWakeTag) return;
+            if (events[i].data.u64 == kListenTag) {
+                Accept();
+            } else {
+                Serve(static_cast<Connection*>(events[i].data.ptr), events[i].events);
+            }
+        }
+    }
+}
+
+void StatsServer::Accept() {
+    while (true) {
+        const int fd = ::accept4(listenFd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) {
+            if (errno == EINTR) continue;
+            break;  // EAGAIN, or out of descriptors: retry on the next event
+        }
+        auto connection = std::make_unique<Connection>();
+        connection->fd = fd;
+        Connection* raw = connection.get();
+        {
+            std::lock_guard<std::mutex> lock(connectionsMutex);
+            connections.emplace(raw, std::move(connection));
+        }
+        epoll_event event{EPOLLIN | EPOLLRDHUP | EPOLLONESHOT, {nullptr}};
+        event.data.ptr = raw;
+        if (::epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event) != 0) {
+            Close(raw);
+            continue;
+        }
+        accepted.fetch_add(1, std::memory_order_relaxed);
+    }
+    epoll_event event{EPOLLIN | EPOLLONESHOT, {nullptr}};
+    event.data.u64 = kListenTag;
+    ::epoll_ctl(epollFd, EPOLL_CTL_MOD, listenFd, &event);
+}
+
+void StatsServer::Serve(Connection* c, std::uint32_t events) {
+    const auto backlogged = [c] { return c->out.size() - c->written > kMaxPendingOutput; };
+
+    // === Read what is available, up to a budget, unless answers are piling up ===
+    if ((events & (EPOLLIN | EPOLLRDHUP | EPOLLHUP | EPOLLERR)) && !backlogged()) {
+        char buf[kReadSize];
+        for (std::size_t budget = kMaxReadPerWakeup; !c->closing && budget > 0;) {
+            const ssize_t n = ::read(c->fd, buf, sizeof(buf));
+            if (n > 0) {
+                c->in.append(buf, static_cast<std::size_t>(n));
+                budget -= std::min(budget, static_cast<std::size_t>(n));
+                if (static_cast<std::size_t>(n) < sizeof(buf)) break;
+            } else if (n == 0) {
+                c->closing = true;
+            } else if (errno == EINTR) {
+                continue;
+            } else {
+                if (errno != EAGAIN && errno != EWOULDBLOCK) c->closing = true;
+                break;
+            }
+        }
+    }
+
+    bool pending = false;
+    for (bool stalled = true; stalled;) {
+        // === Answer complete lines, in order, while the client keeps up ===
+        stalled = false;
+        std::size_t start = 0;
+        if (!c->in.empty()) {
+            const std::shared_ptr<const Dataset> data = dataset.Load();
+            std::uint64_t answered = 0;
+            for (std::size_t end; (end = c->in.find('\n', start)) != std::string::npos; start = end + 1) {
+                if (backlogged()) {
+                    stalled = true;
+                    break;
+                }
+                Answer(*data, std::string_view(c->in).substr(start, end - start), c->out);
+                c->out += '\n';
+                ++answered;
+            }
+            c->in.erase(0, start);
+            requests.fetch_add(answered, std::memory_order_relaxed);
+            // Whole lines may wait for the client; only a partial one counts against the limit
+            if (!stalled && c->in.size() > kMaxLine) {
+                AppendError(c->out, "request too long");
+                c->out += '\n';
+                c->in.clear();
+                c->closing = true;
+            }
+        }
+
+        // === Write back ===
+        while (c->written < c->out.size()) {
+            const ssize_t n = ::send(c->fd, c->out.data() + c->written, c->out.size() - c->written, MSG_NOSIGNAL);
+            if (n > 0) {
+                c->written += static_cast<std::size_t>(n);
+            } else if (n < 0 && errno == EINTR) {
+                continue;
+            } else {
+                if (n == 0 || (errno != EAGAIN && errno != EWOULDBLOCK)) return Close(c);
+                break;
+            }
+        }
+        pending = c->written < c->out.size();
+        if (!pending) {
+            c->out.clear();
+            c->written = 0;
+        }
+        // Lines held back are answered now if the write made room, else on EPOLLOUT
+        stalled = stalled && !backlogged();
+    }
+    if (c->closing && (!pending || (events & (EPOLLHUP | EPOLLERR)))) return Close(c);
+
+    // A client that does not read its answers is not read from either
+    const bool reading = !c->closing && !backlogged();
+    epoll_event event{EPOLLONESHOT | (pending ? EPOLLOUT : 0u) | (reading ? EPOLLIN | EPOLLRDHUP : 0u), {nullptr}};
+    event.data.ptr = c;
+    if (::epoll_ctl(epollFd, EPOLL_CTL_MOD, c->fd, &event) != 0) Close(c);
+}
+
+void StatsServer::Close(Connection* c) {
+    ::epoll_ctl(epollFd, EPOLL_CTL_DEL, c->fd, nullptr);
+    ::close(c->fd);
+    std::lock_guard<std::mutex> lock(connectionsMutex);
+    connections.erase(c);
+}
+
+#else
+
+bool StatsServer::Start(const std::string&, unsigned) {
+    std::cerr << "StatsServer: epoll is not available on this platform\n";
+    return false;
+}
+
+void StatsServer::Stop() {}
+void StatsServer::Run() {}
+void StatsServer::Accept() {}
+void StatsServer::Serve(Connection*, std::uint32_t) {}
+void StatsServer::Close(Connection*) {}
+
+#endif
+
+} // namespace chessDataLib
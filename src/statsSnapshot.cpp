@@ -0,0 +1,448 @@
+#include "statsSnapshot.hpp"
+#include "utils/binaryIO.hpp"
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <vector>
+
+namespace chessDataLib {
+
+namespace fs = std::filesystem;
+
+namespace {
+
+constexpr std::uint32_t kSnapshotMagic = 0x534c4443; // "CDLS"
+constexpr std::uint32_t kSnapshotVersion = 3;
+constexpr std::size_t kHashSample = 1 << 16;
+
+void WriteStrings(utils::BinaryWriter& w, const std::vector<std::string>& v) {
+    w.VarU(v.size());
+    for (const auto& s : v) w.Str(s);
+}
+
+bool ReadStrings(utils::BinaryReader& r, std::vector<std::string>& v) {
+    std::uint64_t n = 0;
+    if (!r.VarU(n)) return false;
+    v.clear();
+    for (std::uint64_t i = 0; i < n && r.Ok(); ++i) {
+        std::string s;
+        r.Str(s);
+        v.push_back(std::move(s));
+    }
+    return r.Ok();
+}
+
+void WriteCounts(utils::BinaryWriter& w, const utils::StringMap<int>& m) {
+    w.VarU(m.size());
+    for (const auto& kv : m) {
+        w.Str(kv.first);
+        w.VarI(kv.second);
+    }
+}
+
+bool ReadCounts(utils::BinaryReader& r, utils::StringMap<int>& m) {
+    std::uint64_t n = 0;
+    if (!r.VarU(n)) return false;
+    m.clear();
+    for (std::uint64_t i = 0; i < n && r.Ok(); ++i) {
+        std::string key;
+        std::int64_t count = 0;
+        r.Str(key);
+        r.VarI(count);
+        m[key] = static_cast<int>(count);
+    }
+    return r.Ok();
+}
+
+void WritePlayer(utils::BinaryWriter& w, const Player& p) {
+    w.Str(p.GetName());
+    w.VarI(p.GetTotalGames());
+    w.VarI(p.GetGamesAsWhiteCount());
+    w.VarI(p.GetGamesAsBlackCount());
+    w.VarI(p.GetWinsCount());
+    w.VarI(p.GetLossCount());
+    w.VarI(p.GetDrawCount());
+    w.VarI(p.GetTimeSpentCentis());
+    w.VarI(p.GetTimedMoves());
+    w.VarI(p.GetBlunderCount());
+    WriteStrings(w, p.GetOpponents());
+    WriteCounts(w, p.GetOpeningFrequency());
+}
+
+bool ReadPlayer(utils::BinaryReader& r, Player& p) {
+    std::string name;
+    std::int64_t total = 0, white = 0, black = 0, wins = 0, losses = 0, draws = 0;
+    std::int64_t spent = 0, timed = 0, blunders = 0;
+    std::vector<std::string> opponents;
+    utils::StringMap<int> openings;
+    r.Str(name);
+    r.VarI(total);
+    r.VarI(white);
+    r.VarI(black);
+    r.VarI(wins);
+    r.VarI(losses);
+    r.VarI(draws);
+    r.VarI(spent);
+    r.VarI(timed);
+    r.VarI(blunders);
+    if (!ReadStrings(r, opponents) || !ReadCounts(r, openings)) return false;
+
+    p.SetName(name);
+    p.SetTotalGames(static_cast<int>(total));
+    p.SetGamesAsWhite(static_cast<int>(white));
+    p.SetGamesAsBlack(static_cast<int>(black));
+    p.SetWins(static_cast<int>(wins));
+    p.SetLosses(static_cast<int>(losses));
+    p.SetDraws(static_cast<int>(draws));
+    p.AddTimeUsage(spent, static_cast<int>(timed));
+    p.AddBlunders(static_cast<int>(blunders));
+    p.SetOpponents(opponents);
+    p.SetOpeningFrequency(openings);
+    return r.Ok();
+}
+
+void WriteTournament(utils::BinaryWriter& w, const Tournament& t) {
+    w.Str(t.GetName());
+    w.VarI(t.GetTotalGames());
+    w.VarI(t.GetUniquePlayers());
+    WriteStrings(w, t.GetPlayers());
+    WriteCounts(w, t.GetPlayerGameCount());
+    w.VarU(t.GetGames().size());
+    for (const auto& g : t.GetGames()) {
+        w.VarU(g.white);
+        w.VarU(g.black);
+        w.VarU(g.round);
+        w.U8(g.whitePoints);
+    }
+}
+
+bool ReadTournament(utils::BinaryReader& r, Tournament& t) {
+    std::string name;
+    std::int64_t total = 0, unique = 0;
+    std::vector<std::string> players;
+    utils::StringMap<int> counts;
+    r.Str(name);
+    r.VarI(total);
+    r.VarI(unique);
+    if (!ReadStrings(r, players) || !ReadCounts(r, counts)) return false;
+
+    std::vector<TournamentGame> games;
+    std::uint64_t n = 0;
+    if (!r.VarU(n)) return false;
+    games.reserve(static_cast<std::size_t>(std::min<std::uint64_t>(n, r.Remaining() / 4)));
+    for (std::uint64_t i = 0; i < n && r.Ok(); ++i) {
+        std::uint64_t white = 0, black = 0, round = 0;
+        TournamentGame g;
+        r.VarU(white);
+        r.VarU(black);
+        r.VarU(round);
+        r.U8(g.whitePoints);
+        if (white >= players.size() || black >= players.size() || round > 65535) return false;
+        g.white = static_cast<std::uint32_t>(white);
+        g.black = static_cast<std::uint32_t>(black);
+        g.round = static_cast<std::uint16_t>(round);
+        games.push_back(g);
+    }
+    if (!r.Ok()) return false;
+
+    t.SetName(name);
+    t.SetTotalGames(static_cast<int>(total));
+    t.SetUniquePlayers(static_cast<int>(unique));
+    t.SetPlayers(players);
+    t.SetPlayerGameCount(counts);
+    t.SetGames(games);
+    return r.Ok();
+}
+
+void WriteHistograms(utils::BinaryWriter& w, const GameHistograms& h) {
+    for (int o = 0; o < GameHistograms::kOutcomes; ++o) {
+        const auto outcome = static_cast<GameHistograms::Outcome>(o);
+        for (const std::uint64_t count : h.GetLengthHistogram(outcome)) w.VarU(count);
+        w.VarU(h.GetPlySum(outcome));
+    }
+    for (const RatingGapBin& bin : h.GetRatingGaps()) {
+        w.VarU(bin.games);
+        w.VarU(bin.whiteWins);
+        w.VarU(bin.draws);
+        w.VarU(bin.blackWins);
+        w.VarU(bin.expectedMicros);
+    }
+}
+
+bool ReadHistograms(utils::BinaryReader& r, GameHistograms& h) {
+    for (int o = 0; o < GameHistograms::kOutcomes; ++o) {
+        GameHistograms::LengthHistogram counts{};
+        std::uint64_t plySum = 0;
+        for (std::uint64_t& count : counts) r.VarU(count);
+        r.VarU(plySum);
+        h.SetLengthHistogram(static_cast<GameHistograms::Outcome>(o), counts, plySum);
+    }
+    GameHistograms::RatingGapHistogram gaps{};
+    for (RatingGapBin& bin : gaps) {
+        r.VarU(bin.games);
+        r.VarU(bin.whiteWins);
+        r.VarU(bin.draws);
+        r.VarU(bin.blackWins);
+        r.VarU(bin.expectedMicros);
+    }
+    h.SetRatingGaps(gaps);
+    return r.Ok();
+}
+
+} // namespace
+
+// === FileIdentity ===
+
+bool FileIdentity::FromFile(const std::string& filename, FileIdentity& out) {
+    std::error_code ec;
+    const fs::path absolute = fs::absolute(filename, ec);
+    if (ec) return false;
+    const auto size = fs::file_size(absolute, ec);
+    if (ec) return false;
+    const auto mtime = fs::last_write_time(absolute, ec);
+    if (ec) return false;
+
+    std::ifstream in(absolute, std::ios::binary);
+    if (!in.is_open()) return false;
+
+    // Sample head, middle and tail; together with size and mtime this catches
+    // appends, truncations and in-place edits without reading the whole file
+    std::vector<char> buf(kHashSample);
+    std::uint64_t h = utils::Fnv1a64(&size, sizeof size);
+    const std::uint64_t offsets[] = {0, size / 2 > kHashSample / 2 ? size / 2 - kHashSample / 2 : 0,
+                                     size > kHashSample ? size - kHashSample : 0};
+    for (std::uint64_t offset : offsets) {
+        in.clear();
+        in.seekg(static_cast<std::streamoff>(offset));
+        in.read(buf.data(), static_cast<std::streamsize>(buf.size()));
+        h = utils::Fnv1a64(buf.data(), static_cast<std::size_t>(in.gcount()), h);
+    }
+
+    out.path = absolute.lexically_normal().string();
+    out.size = size;
+    out.mtime = static_cast<std::int64_t>(mtime.time_since_epoch().count());
+    out.hash = h;
+    return true;
+}
+
+bool FileIdentity::operator==(const FileIdentity& other) const {
+    return size == other.size && mtime == other.mtime && hash == other.hash && path == other.path;
+}
+
+bool FileIdentity::operator!=(const FileIdentity& other) const {
+    return !(*this == other);
+}
+
+// === StatsSnapshot ===
+
+std::string StatsSnapshot::Serialize(const FileIdentity& identity, const DatabaseStats& stats) {
+    utils::BinaryWriter w;
+    w.U32(kSnapshotMagic);
+    w.U32(kSnapshotVersion);
+
+    w.Str(identity.path);
+    w.U64(identity.size);
+    w.U64(static_cast<std::uint64_t>(identity.mtime));
+    w.U64(identity.hash);
+
+    w.VarI(stats.GetTotalGames());
+    w.VarI(stats.GetUniqueTournaments());
+    w.VarI(stats.GetUniquePlayers());
+    w.VarI(stats.GetWhiteWins());
+    w.VarI(stats.GetBlackWins());
+    w.VarI(stats.GetDraws());
+    w.VarI(stats.GetUnknownResults());
+    w.Str(stats.GetMostActivePlayer());
+    w.VarI(stats.GetMaxGamesByPlayer());
+    w.Str(stats.GetLargestTournament());
+    w.VarI(stats.GetMaxGamesInTournament());
+    w.F64(stats.GetParsingTimeSeconds());
+    WriteStrings(w, stats.GetTournamentNames());
+    WriteStrings(w, stats.GetPlayerNames());
+
+    w.VarU(stats.GetPlayerStats().size());
+    for (const auto& kv : stats.GetPlayerStats()) {
+        w.Str(kv.first);
+        WritePlayer(w, kv.second);
+    }
+    w.VarU(stats.GetTournaments().size());
+    for (const auto& kv : stats.GetTournaments()) {
+        w.Str(kv.first);
+        WriteTournament(w, kv.second);
+    }
+    WriteHistograms(w, stats.GetHistograms());
+    return std::move(w.Data());
+}
+
+bool StatsSnapshot::Deserialize(const std::string& blob, FileIdentity& identity, DatabaseStats& stats) {
+    utils::BinaryReader r(blob.data(), blob.size());
+    std::uint32_t magic = 0, version = 0;
+    if (!r.U32(magic) || !r.U32(version) || magic != kSnapshotMagic || version != kSnapshotVersion) return false;
+
+    std::uint64_t mtime = 0;
+    r.Str(identity.path);
+    r.U64(identity.size);
+    r.U64(mtime);
+    r.U64(identity.hash);
+    identity.mtime = static_cast<std::int64_t>(mtime);
+
+    std::int64_t totalGames = 0, uniqueTournaments = 0, uniquePlayers = 0;
+    std::int64_t whiteWins = 0, blackWins = 0, draws = 0, unknown = 0, maxByPlayer = 0, maxInTournament = 0;
+    std::string mostActive, largest;
+    double seconds = 0.0;
+    std::vector<std::string> tournamentNames, playerNames;
+    r.VarI(totalGames);
+    r.VarI(uniqueTournaments);
+    r.VarI(uniquePlayers);
+    r.VarI(whiteWins);
+    r.VarI(blackWins);
+    r.VarI(draws);
+    r.VarI(unknown);
+    r.Str(mostActive);
+    r.VarI(maxByPlayer);
+    r.Str(largest);
+    r.VarI(maxInTournament);
+    r.F64(seconds);
+    if (!ReadStrings(r, tournamentNames) || !ReadStrings(r, playerNames)) return false;
+
+    utils::StringMap<Player> players;
+    std::uint64_t n = 0;
+    if (!r.VarU(n)) return false;
+    players.reserve(static_cast<std::size_t>(std::min<std::uint64_t>(n, blob.size())));
+    for (std::uint64_t i = 0; i < n; ++i) {
+        std::string key;
+        r.Str(key);
+        if (!ReadPlayer(r, players[key])) return false;
+    }
+
+    utils::StringMap<Tournament> tournaments;
+    if (!r.VarU(n)) return false;
+    for (std::uint64_t i = 0; i < n; ++i) {
+        std::string key;
+        r.Str(key);
+        if (!ReadTournament(r, tournaments[key])) return false;
+    }
+    GameHistograms histograms;
+    if (!ReadHistograms(r, histograms) || !r.AtEnd()) return false;
+
+    stats = DatabaseStats();
+    stats.SetTotalGames(static_cast<int>(totalGames));
+    stats.SetUniqueTournaments(static_cast<int>(uniqueTournaments));
+    stats.SetUniquePlayers(static_cast<int>(uniquePlayers));
+    stats.SetWhiteWins(static_cast<int>(whiteWins));
+    stats.SetBlackWins(static_cast<int>(blackWins));
+    stats.SetDraws(static_cast<int>(draws));
+    stats.SetUnknownResults(static_cast<int>(unknown));
+    stats.SetMostActivePlayer(mostActive);
+    stats.SetMaxGamesByPlayer(static_cast<int>(maxByPlayer));
+    stats.SetLargestTournament(largest);
+    stats.SetMaxGamesInTournament(static_cast<int>(maxInTournament));
+    stats.SetParsingTimeSeconds(seconds);
+    stats.SetTournamentNames(tournamentNames);
+    stats.SetPlayerNames(playerNames);
+    stats.SetPlayerStats(players);
+    stats.SetTournaments(tournaments);
+    stats.SetHistograms(histograms);
+    return true;
+}
+
+bool StatsSnapshot::Save(const std::string& filename, const FileIdentity& identity, const DatabaseStats& stats) {
+    const std::string blob = Serialize(identity, stats);
+    const std::string tmp = filename + ".tmp";
+    {
+        std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+        if (!out.is_open()) return false;
+        out.write(blob.data(), static_cast<std::streamsize>(blob.size()));
+        if (!out) return false;
+    }
+    std::error_code ec;
+    fs::rename(tmp, filename, ec);
+    return !ec;
+}
+
+// Checks the fixed-size header before reading the rest, so probing a large
+// non-snapshot file (such as a PGN database) reads only 8 bytes
+bool StatsSnapshot::Load(const std::string& filename, FileIdentity& identity, DatabaseStats& stats) {
+    std::ifstream in(filename, std::ios::binary);
+    if (!in.is_open()) return false;
+    char header[8];
+    if (!in.read(header, sizeof header)) return false;
+    utils::BinaryReader r(header, sizeof header);
+    std::uint32_t magic = 0, version = 0;
+    if (!r.U32(magic) || !r.U32(version) || magic != kSnapshotMagic || version != kSnapshotVersion) return false;
+
+    in.seekg(0, std::ios::end);
+    const std::streamoff size = in.tellg();
+    if (size < static_cast<std::streamoff>(sizeof header)) return false;
+    std::string blob(static_cast<std::size_t>(size), '\0');
+    in.seekg(0);
+    if (!in.read(blob.data(), size)) return false;
+    return Deserialize(blob, identity, stats);
+}
+
+// === StatsSnapshotCache ===
+
+StatsSnapshotCache::StatsSnapshotCache(const std::string& dir) : directory(dir) {}
+
+std::string StatsSnapshotCache::SnapshotPath(const std::string& absolutePath) const {
+    std::ostringstream name;
+    name << std::hex << std::setw(16) << std::setfill('0')
+         << utils::Fnv1a64(absolutePath.data(), absolutePath.size()) << ".stats";
+    return (fs::path(directory) / name.str()).string();
+}
+
+bool StatsSnapshotCache::Lookup(const std::string& filename, DatabaseStats& stats) {
+    FileIdentity current;
+    const bool readable = FileIdentity::FromFile(filename, current);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!readable) {
+        misses++;
+        return false;
+    }
+
+    auto it = entries.find(current.path);
+    if (it == entries.end() && !directory.empty()) {
+        Entry entry;
+        if (StatsSnapshot::Load(SnapshotPath(current.path), entry.identity, entry.stats)) {
+            it = entries.emplace(current.path, std::move(entry)).first;
+        }
+    }
+    if (it == entries.end() || it->second.identity != current) {
+        misses++;
+        return false;
+    }
+
+    stats = it->second.stats;
+    hits++;
+    return true;
+}
+
+bool StatsSnapshotCache::Store(const std::string& filename, const DatabaseStats& stats) {
+    FileIdentity identity;
+    if (!FileIdentity::FromFile(filename, identity)) return false;
+    return Store(identity, stats);
+}
+
+bool StatsSnapshotCache::Store(const FileIdentity& identity, const DatabaseStats& stats) {
+    std::lock_guard<std::mutex> lock(mutex);
+    entries[identity.path] = Entry{identity, stats};
+    if (directory.empty()) return true;
+
+    std::error_code ec;
+    fs::create_directories(directory, ec);
+    return StatsSnapshot::Save(SnapshotPath(identity.path), identity, stats);
+}
+
+std::uint64_t StatsSnapshotCache::GetHits() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return hits;
+}
+
+std::uint64_t StatsSnapshotCache::GetMisses() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return misses;
+}
+
+} // namespace chessDataLib
@@ -0,0 +1,257 @@
+#include "timeSeriesStats.hpp"
+#include "openingStats.hpp"
+#include "utils/date.hpp"
+#include <algorithm>
+
+namespace chessDataLib {
+
+namespace {
+
+constexpr int kMonthBuckets = 13;  // unknown month, then January..December
+
+// Points of White: 2 win, 1 draw, 0 loss, -1 unfinished
+int WhitePoints(const std::string& result) {
+    if (result == "1-0") return 2;
+    if (result == "1/2-1/2") return 1;
+    if (result == "0-1") return 0;
+    return -1;
+}
+
+} // namespace
+
+// === TimeBucketTotals ===
+
+double TimeBucketTotals::GetScorePercentage() const {
+    const std::uint64_t decided = wins + draws + losses;
+    return decided ? 100.0 * (wins + 0.5 * draws) / decided : 0.0;
+}
+
+double TimeBucketTotals::GetAverageElo() const {
+    return ratings ? static_cast<double>(eloSum) / ratings : 0.0;
+}
+
+// === Cells ===
+
+void TimeSeriesStats::Cell::Add(int points, int elo) {
+    games++;
+    if (points == 2) wins++;
+    else if (points == 1) draws++;
+    else if (points == 0) losses++;
+    if (elo > 0) {
+        ratings++;
+        eloSum += static_cast<std::uint64_t>(elo);
+    }
+}
+
+void TimeSeriesStats::Cell::Add(const Cell& other) {
+    games += other.games;
+    wins += other.wins;
+    draws += other.draws;
+    losses += other.losses;
+    ratings += other.ratings;
+    eloSum += other.eloSum;
+}
+
+TimeSeriesStats::Cell& TimeSeriesStats::PlayerSeries::At(int bucket) {
+    if (cells.empty()) {
+        first = bucket;
+    } else if (bucket < first) {
+        cells.insert(cells.begin(), static_cast<std::size_t>(first - bucket), Cell());
+        first = bucket;
+    }
+    const std::size_t index = static_cast<std::size_t>(bucket - first);
+    if (index >= cells.size()) cells.resize(index + 1);
+    return cells[index];
+}
+
+// === TimeSeriesStats ===
+
+TimeSeriesStats::TimeSeriesStats() : TimeSeriesStats(0, 0) {}
+
+TimeSeriesStats::TimeSeriesStats(int first, int count, Granularity g)
+    : firstYear(count > 0 ? first : 0), years(std::max(0, count)), granularity(g) {
+    buckets = years * (granularity == Granularity::Month ? kMonthBuckets : 1);
+    table.assign(static_cast<std::size_t>(kEcoSlots + 1) * buckets, Cell());
+}
+
+int TimeSeriesStats::GetFirstYear() const {
+    return firstYear;
+}
+
+int TimeSeriesStats::GetYearCount() const {
+    return years;
+}
+
+TimeSeriesStats::Granularity TimeSeriesStats::GetGranularity() const {
+    return granularity;
+}
+
+int TimeSeriesStats::GetBucketCount() const {
+    return buckets;
+}
+
+int TimeSeriesStats::BucketOf(std::uint32_t packedDate) const {
+    const int year = utils::DateYear(packedDate) - firstYear;
+    if (packedDate == 0 || year < 0 || year >= years) return -1;
+    return granularity == Granularity::Month ? year * kMonthBuckets + utils::DateMonth(packedDate) : year;
+}
+
+std::uint32_t TimeSeriesStats::BucketDate(int bucket) const {
+    if (bucket < 0 || bucket >= buckets) return 0;
+    if (granularity == Granularity::Year) return utils::PackDate(firstYear + bucket, 0, 0);
+    return utils::PackDate(firstYear + bucket / kMonthBuckets, bucket % kMonthBuckets, 0);
+}
+
+void TimeSeriesStats::AddGame(std::uint32_t packedDate, const std::string& eco, const std::string& white,
+                              const std::string& black, const std::string& result, int whiteElo, int blackElo) {
+    const int bucket = BucketOf(packedDate);
+    if (bucket < 0) {
+        undatedGames++;
+        return;
+    }
+
+    const int points = WhitePoints(result);
+    Cell& all = table[bucket];
+    all.Add(points, whiteElo);
+    if (blackElo > 0) {
+        all.ratings++;
+        all.eloSum += static_cast<std::uint64_t>(blackElo);
+    }
+    const int slot = OpeningStats::EcoIndex(eco);
+    if (slot >= 0) {
+        Cell& opening = table[static_cast<std::size_t>(slot + 1) * buckets + bucket];
+        opening.Add(points, whiteElo);
+        if (blackElo > 0) {
+            opening.ratings++;
+            opening.eloSum += static_cast<std::uint64_t>(blackElo);
+        }
+    }
+
+    // One probe per player; ids stay valid across insertions
+    const auto id = [this](const std::string& name) {
+        auto [it, inserted] = playerIds.try_emplace(name, static_cast<std::uint32_t>(players.size()));
+        if (inserted) players.emplace_back();
+        return it->second;
+    };
+    const std::uint32_t whiteId = id(white);
+    const std::uint32_t blackId = id(black);
+    players[whiteId].At(bucket).Add(points, whiteElo);
+    players[blackId].At(bucket).Add(points < 0 ? -1 : 2 - points, blackElo);
+}
+
+bool TimeSeriesStats::MergeWith(const TimeSeriesStats& other) {
+    if (other.firstYear != firstYear || other.years != years || other.granularity != granularity) return false;
+    undatedGames += other.undatedGames;
+    for (std::size_t i = 0; i < table.size(); ++i) table[i].Add(other.table[i]);
+
+    for (const auto& kv : other.playerIds) AddPlayerSeries(kv.first, other.players[kv.second]);
+    return true;
+}
+
+void TimeSeriesStats::MergeAliases(const utils::StringMap<std::string>& aliases) {
+    const utils::StringMap<std::uint32_t> oldIds = std::move(playerIds);
+    const std::vector<PlayerSeries> oldPlayers = std::move(players);
+    playerIds = utils::StringMap<std::uint32_t>();
+    players.clear();
+    for (const auto& kv : oldIds) {
+        auto it = aliases.find(kv.first);
+        AddPlayerSeries(it == aliases.end() ? kv.first : it->second, oldPlayers[kv.second]);
+    }
+}
+
+void TimeSeriesStats::AddPlayerSeries(const std::string& name, const PlayerSeries& theirs) {
+    if (theirs.cells.empty()) return;
+    auto [it, inserted] = playerIds.try_emplace(name, static_cast<std::uint32_t>(players.size()));
+    if (inserted) players.emplace_back();
+    PlayerSeries& mine = players[it->second];
+    // Touch both ends first so the loop below never reallocates
+    mine.At(theirs.first);
+    mine.At(theirs.first + static_cast<int>(theirs.cells.size()) - 1);
+    for (std::size_t i = 0; i < theirs.cells.size(); ++i) {
+        mine.cells[theirs.first - mine.first + i].Add(theirs.cells[i]);
+    }
+}
+
+void TimeSeriesStats::Accumulate(const Cell* row, int count, std::vector<TimeBucketTotals>& out) {
+    for (int b = 0; b < count; ++b) {
+        TimeBucketTotals& t = out[b];
+        t.games += row[b].games;
+        t.wins += row[b].wins;
+        t.draws += row[b].draws;
+        t.losses += row[b].losses;
+        t.ratings += row[b].ratings;
+        t.eloSum += row[b].eloSum;
+    }
+}
+
+std::vector<TimeBucketTotals> TimeSeriesStats::GetSeries() const {
+    std::vector<TimeBucketTotals> out(buckets);
+    Accumulate(table.data(), buckets, out);
+    return out;
+}
+
+std::vector<TimeBucketTotals> TimeSeriesStats::GetOpeningSeries(const std::string& ecoFirst,
+                                                                const std::string& ecoLast) const {
+    std::vector<TimeBucketTotals> out(buckets);
+    const int first = OpeningStats::EcoIndex(ecoFirst);
+    const int last = OpeningStats::EcoIndex(ecoLast);
+    if (first < 0 || last < 0) return out;
+    for (int slot = first; slot <= last; ++slot) {
+        Accumulate(table.data() + static_cast<std::size_t>(slot + 1) * buckets, buckets, out);
+    }
+    return out;
+}
+
+std::vector<double> TimeSeriesStats::GetOpeningShare(const std::string& ecoFirst, const std::string& ecoLast) const {
+    const std::vector<TimeBucketTotals> opening = GetOpeningSeries(ecoFirst, ecoLast);
+    std::vector<double> share(buckets, 0.0);
+    for (int b = 0; b < buckets; ++b) {
+        if (table[b].games) share[b] = 100.0 * opening[b].games / table[b].games;
+    }
+    return share;
+}
+
+std::vector<TimeBucketTotals> TimeSeriesStats::GetPlayerSeries(const std::string& player) const {
+    std::vector<TimeBucketTotals> out(buckets);
+    const auto it = playerIds.find(player);
+    if (it == playerIds.end()) return out;
+    const PlayerSeries& series = players[it->second];
+    std::vector<TimeBucketTotals> span(series.cells.size());
+    Accumulate(series.cells.data(), static_cast<int>(series.cells.size()), span);
+    std::copy(span.begin(), span.end(), out.begin() + series.first);
+    return out;
+}
+
+std::vector<TimeBucketTotals> TimeSeriesStats::ToYears(const std::vector<TimeBucketTotals>& series) const {
+    if (granularity == Granularity::Year) return series;
+    std::vector<TimeBucketTotals> out(years);
+    for (std::size_t b = 0; b < series.size() && b < static_cast<std::size_t>(buckets); ++b) {
+        TimeBucketTotals& t = out[b / kMonthBuckets];
+        t.games += series[b].games;
+        t.wins += series[b].wins;
+        t.draws += series[b].draws;
+        t.losses += series[b].losses;
+        t.ratings += series[b].ratings;
+        t.eloSum += series[b].eloSum;
+    }
+    return out;
+}
+
+std::uint64_t TimeSeriesStats::GetUndatedGames() const {
+    return undatedGames;
+}
+
+std::size_t TimeSeriesStats::GetPlayerCount() const {
+    return players.size();
+}
+
+MemoryUsage TimeSeriesStats::GetMemoryUsage() const {
+    MemoryUsage usage;
+    usage.containerBytes += table.capacity() * sizeof(Cell);
+    usage.containerBytes += players.capacity() * sizeof(PlayerSeries);
+    for (const PlayerSeries& p : players) usage.containerBytes += p.cells.capacity() * sizeof(Cell);
+    utils::AccountHashMap(playerIds, usage);
+    return usage;
+}
+
+} // namespace chessDataLib
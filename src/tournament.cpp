@@ -1,7 +1,78 @@
 #include "tournament.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <limits>
+#include <numeric>
+#include <tuple>
 
 namespace chessDataLib {
 
+namespace {
+
+// Leading number of a Round tag: "3" and "3.1" give 3; "?", "-" and "" give 0
+std::uint16_t ParseRound(const std::string& round) {
+    unsigned value = 0;
+    for (char c : round) {
+        if (c < '0' || c > '9') break;
+        value = std::min(value * 10 + static_cast<unsigned>(c - '0'), 65535u);
+    }
+    return static_cast<std::uint16_t>(value);
+}
+
+std::uint8_t ParseWhitePoints(const std::string& result) {
+    if (result == "1-0") return 2;
+    if (result == "0-1") return 0;
+    if (result == "1/2-1/2") return 1;
+    return TournamentGame::kUnfinished;
+}
+
+} // namespace
+
+// === Crosstable ===
+
+const Crosstable::Cell& Crosstable::At(std::size_t row, std::size_t column) const {
+    return cells[row * columns.size() + column];
+}
+
+std::string Crosstable::ToString() const {
+    std::size_t nameWidth = 6;
+    for (const auto& row : rows) nameWidth = std::max(nameWidth, row.name.size());
+
+    std::string out;
+    char buf[64];
+    std::snprintf(buf, sizeof(buf), "%4s  ", "Rk");
+    out += buf;
+    out += "Player";
+    out.append(nameWidth - 6, ' ');
+    for (int column : columns) {
+        std::snprintf(buf, sizeof(buf), " %6s", (std::string(byRound ? "R" : "G") + std::to_string(column)).c_str());
+        out += buf;
+    }
+    out += "    Pts     Bh     SB     Md\n";
+
+    for (std::size_t row = 0; row < rows.size(); ++row) {
+        const TournamentStanding& s = rows[row];
+        std::snprintf(buf, sizeof(buf), "%4d  ", s.rank);
+        out += buf;
+        out += s.name;
+        out.append(nameWidth - s.name.size(), ' ');
+        for (std::size_t column = 0; column < columns.size(); ++column) {
+            const Cell& cell = At(row, column);
+            if (cell.opponent < 0) {
+                out += "      -";
+                continue;
+            }
+            const char* result = cell.points == 2 ? "1" : cell.points == 1 ? "=" : cell.points == 0 ? "0" : "*";
+            std::snprintf(buf, sizeof(buf), " %4d%c%s", rows[cell.opponent].rank, cell.white ? 'w' : 'b', result);
+            out += buf;
+        }
+        std::snprintf(buf, sizeof(buf), " %6.1f %6.1f %6.2f %6.1f\n", s.score, s.buchholz, s.sonnebornBerger,
+                      s.medianBuchholz);
+        out += buf;
+    }
+    return out;
+}
+
 // === Constructors ===
 
 Tournament::Tournament(const std::string& name) : name(name) {}
@@ -24,10 +95,14 @@ const std::vector<std::string>& Tournament::GetPlayers() const {
     return players;
 }
 
-const std::unordered_map<std::string, int>& Tournament::GetPlayerGameCount() const {
+const utils::StringMap<int>& Tournament::GetPlayerGameCount() const {
     return playerGameCount;
 }
 
+const std::vector<TournamentGame>& Tournament::GetGames() const {
+    return games;
+}
+
 // === Setters ===
 
 void Tournament::SetName(const std::string& val) {
@@ -44,24 +119,243 @@ void Tournament::SetUniquePlayers(int val) {
 
 void Tournament::SetPlayers(const std::vector<std::string>& val) {
     players = val;
+    playerIndex = utils::StringMap<std::uint32_t>();
+    playerIndex.reserve(players.size());
+    for (std::size_t i = 0; i < players.size(); ++i) {
+        playerIndex.try_emplace(players[i], static_cast<std::uint32_t>(i));
+    }
 }
 
-void Tournament::SetPlayerGameCount(const std::unordered_map<std::string, int>& val) {
+void Tournament::SetPlayerGameCount(const utils::StringMap<int>& val) {
     playerGameCount = val;
 }
 
+void Tournament::SetGames(const std::vector<TournamentGame>& val) {
+    games = val;
+}
+
 // === Helpers ===
 
-void Tournament::AddPlayer(const std::string& player) {
-    if (playerGameCount[player]++ == 0) {
+std::uint32_t Tournament::IndexPlayer(const std::string& player) {
+    auto [it, inserted] = playerIndex.try_emplace(player, static_cast<std::uint32_t>(players.size()));
+    if (inserted) {
         players.push_back(player);
         uniquePlayers++;
     }
-    totalGames++;
+    return it->second;
+}
+
+void Tournament::AddPlayer(const std::string& player) {
+    IndexPlayer(player);
+    playerGameCount[player]++;
 }
 
 void Tournament::AddGame() {
     totalGames++;
 }
 
+void Tournament::RecordGame(const std::string& white, const std::string& black,
+                            const std::string& round, const std::string& result) {
+    AddGame();
+    AddPlayer(white);
+    AddPlayer(black);
+
+    TournamentGame game;
+    game.white = playerIndex.find(white)->second;
+    game.black = playerIndex.find(black)->second;
+    game.round = ParseRound(round);
+    game.whitePoints = ParseWhitePoints(result);
+    games.push_back(game);
+}
+
+void Tournament::MergeWith(const Tournament& other) {
+    AppendFrom(other, nullptr);
+}
+
+void Tournament::MergeAliases(const utils::StringMap<std::string>& aliases) {
+    Tournament merged(name);
+    merged.AppendFrom(*this, &aliases);
+    *this = std::move(merged);
+}
+
+// Adds other's counts and games, renaming its players through aliases if given
+void Tournament::AppendFrom(const Tournament& other, const utils::StringMap<std::string>* aliases) {
+    totalGames += other.totalGames;
+    std::vector<std::uint32_t> remap(other.players.size());
+    for (std::size_t i = 0; i < other.players.size(); ++i) {
+        const std::string& player = other.players[i];
+        const std::string* renamed = &player;
+        if (aliases) {
+            auto it = aliases->find(player);
+            if (it != aliases->end()) renamed = &it->second;
+        }
+        remap[i] = IndexPlayer(*renamed);
+        playerGameCount[*renamed] += other.playerGameCount.at(player);
+    }
+
+    games.reserve(games.size() + other.games.size());
+    for (TournamentGame game : other.games) {
+        game.white = remap[game.white];
+        game.black = remap[game.black];
+        games.push_back(game);
+    }
+}
+
+// === Standings ===
+
+std::vector<TournamentStanding> Tournament::ComputeStandings() const {
+    const std::size_t n = players.size();
+    std::vector<TournamentStanding> standings(n);
+
+    // Pass 1: scores in half points
+    std::vector<int> points(n, 0);
+    for (const TournamentGame& g : games) {
+        if (g.whitePoints == TournamentGame::kUnfinished) continue;
+        TournamentStanding& w = standings[g.white];
+        TournamentStanding& b = standings[g.black];
+        w.games++;
+        b.games++;
+        points[g.white] += g.whitePoints;
+        points[g.black] += 2 - g.whitePoints;
+        if (g.whitePoints == 2) {
+            w.wins++;
+            b.losses++;
+        } else if (g.whitePoints == 0) {
+            b.wins++;
+            w.losses++;
+        } else {
+            w.draws++;
+            b.draws++;
+        }
+    }
+
+    // Pass 2: tie-breaks from the opponents' final scores. Buchholz in half
+    // points, Sonneborn-Berger in quarter points (half points times half points)
+    std::vector<long long> buchholz(n, 0), sonnebornBerger(n, 0);
+    std::vector<int> highest(n, std::numeric_limits<int>::min());
+    std::vector<int> lowest(n, std::numeric_limits<int>::max());
+    for (const TournamentGame& g : games) {
+        if (g.whitePoints == TournamentGame::kUnfinished) continue;
+        const int whiteOpponent = points[g.black];
+        const int blackOpponent = points[g.white];
+        buchholz[g.white] += whiteOpponent;
+        buchholz[g.black] += blackOpponent;
+        sonnebornBerger[g.white] += static_cast<long long>(g.whitePoints) * whiteOpponent;
+        sonnebornBerger[g.black] += static_cast<long long>(2 - g.whitePoints) * blackOpponent;
+        highest[g.white] = std::max(highest[g.white], whiteOpponent);
+        lowest[g.white] = std::min(lowest[g.white], whiteOpponent);
+        highest[g.black] = std::max(highest[g.black], blackOpponent);
+        lowest[g.black] = std::min(lowest[g.black], blackOpponent);
+    }
+
+    for (std::size_t i = 0; i < n; ++i) {
+        TournamentStanding& s = standings[i];
+        s.player = static_cast<std::uint32_t>(i);
+        s.name = players[i];
+        s.score = points[i] / 2.0;
+        s.buchholz = buchholz[i] / 2.0;
+        s.sonnebornBerger = sonnebornBerger[i] / 4.0;
+        const long long median = s.games >= 3 ? buchholz[i] - highest[i] - lowest[i] : buchholz[i];
+        s.medianBuchholz = median / 2.0;
+    }
+
+    const auto tieKey = [](const TournamentStanding& s) {
+        return std::make_tuple(s.score, s.buchholz, s.sonnebornBerger, s.medianBuchholz);
+    };
+    std::sort(standings.begin(), standings.end(),
+              [&tieKey](const TournamentStanding& a, const TournamentStanding& b) {
+                  const auto ka = tieKey(a), kb = tieKey(b);
+                  if (ka != kb) return ka > kb;
+                  return a.name < b.name;
+              });
+    for (std::size_t i = 0; i < n; ++i) {
+        standings[i].rank = i > 0 && tieKey(standings[i]) == tieKey(standings[i - 1])
+                                ? standings[i - 1].rank
+                                : static_cast<int>(i + 1);
+    }
+    return standings;
+}
+
+std::vector<TournamentGame> Tournament::GetPairings(int round) const {
+    std::vector<TournamentGame> pairings;
+    for (const TournamentGame& g : games) {
+        if (g.round == round) pairings.push_back(g);
+    }
+    return pairings;
+}
+
+Crosstable Tournament::BuildCrosstable() const {
+    Crosstable table;
+    table.rows = ComputeStandings();
+    const std::size_t n = players.size();
+    std::vector<int> rowOf(n);
+    for (std::size_t row = 0; row < n; ++row) rowOf[table.rows[row].player] = static_cast<int>(row);
+
+    // Columns by round if rounds are present and unique per player
+    std::vector<int> rounds;
+    rounds.reserve(games.size());
+    for (const TournamentGame& g : games) rounds.push_back(g.round);
+    std::sort(rounds.begin(), rounds.end());
+    rounds.erase(std::unique(rounds.begin(), rounds.end()), rounds.end());
+    table.byRound = !games.empty() && rounds.front() > 0;
+    if (table.byRound) {
+        std::vector<std::pair<std::uint16_t, std::uint32_t>> seats;
+        seats.reserve(games.size() * 2);
+        for (const TournamentGame& g : games) {
+            seats.emplace_back(g.round, g.white);
+            seats.emplace_back(g.round, g.black);
+        }
+        std::sort(seats.begin(), seats.end());
+        table.byRound = std::adjacent_find(seats.begin(), seats.end()) == seats.end();
+    }
+
+    std::vector<int> gameCount(n, 0);
+    if (table.byRound) {
+        table.columns = std::move(rounds);
+    } else {
+        int longest = 0;
+        for (const TournamentGame& g : games) {
+            longest = std::max({longest, ++gameCount[g.white], ++gameCount[g.black]});
+        }
+        table.columns.resize(longest);
+        std::iota(table.columns.begin(), table.columns.end(), 1);
+        std::fill(gameCount.begin(), gameCount.end(), 0);
+    }
+
+    const std::size_t width = table.columns.size();
+    table.cells.resize(n * width);
+    for (const TournamentGame& g : games) {
+        std::size_t whiteColumn, blackColumn;
+        if (table.byRound) {
+            whiteColumn = blackColumn = static_cast<std::size_t>(
+                std::lower_bound(table.columns.begin(), table.columns.end(), g.round) - table.columns.begin());
+        } else {
+            whiteColumn = static_cast<std::size_t>(gameCount[g.white]++);
+            blackColumn = static_cast<std::size_t>(gameCount[g.black]++);
+        }
+        const bool finished = g.whitePoints != TournamentGame::kUnfinished;
+        Crosstable::Cell& w = table.cells[rowOf[g.white] * width + whiteColumn];
+        w.opponent = rowOf[g.black];
+        w.white = true;
+        w.points = g.whitePoints;
+        Crosstable::Cell& b = table.cells[rowOf[g.black] * width + blackColumn];
+        b.opponent = rowOf[g.white];
+        b.white = false;
+        b.points = finished ? static_cast<std::uint8_t>(2 - g.whitePoints) : TournamentGame::kUnfinished;
+    }
+    return table;
+}
+
+// === Memory accounting ===
+
+MemoryUsage Tournament::GetMemoryUsage() const {
+    MemoryUsage usage;
+    utils::AccountString(name, usage);
+    utils::AccountStrings(players, usage);
+    utils::AccountHashMap(playerGameCount, usage);
+    utils::AccountHashMap(playerIndex, usage);
+    usage.containerBytes += games.capacity() * sizeof(TournamentGame);
+    return usage;
+}
+
 } // namespace chessDataLib
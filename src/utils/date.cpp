@@ -0,0 +1,51 @@
+#include "utils/date.hpp"
+
+namespace chessDataLib::utils {
+
+std::uint32_t PackDate(int year, int month, int day) {
+    if (year <= 0 || year >= (1 << 23)) return 0;
+    if (month < 1 || month > 12) month = day = 0;
+    if (day < 1 || day > 31) day = 0;
+    return (static_cast<std::uint32_t>(year) << 9) | (static_cast<std::uint32_t>(month) << 5) |
+           static_cast<std::uint32_t>(day);
+}
+
+// Digits of one field up to the next separator; -1 if any is not a digit
+static int ParseField(std::string_view date, std::size_t& pos, std::size_t maxDigits) {
+    int value = 0;
+    std::size_t digits = 0;
+    bool known = true;
+    for (; pos < date.size() && date[pos] != '.' && date[pos] != '-' && date[pos] != '/'; ++pos, ++digits) {
+        const char c = date[pos];
+        if (c >= '0' && c <= '9') value = value * 10 + (c - '0');
+        else known = false;
+    }
+    if (pos < date.size()) ++pos;  // the separator
+    return known && digits > 0 && digits <= maxDigits ? value : -1;
+}
+
+std::uint32_t PackDate(std::string_view date) {
+    std::size_t pos = 0;
+    const int year = ParseField(date, pos, 6);
+    const int month = ParseField(date, pos, 2);
+    const int day = ParseField(date, pos, 2);
+    return PackDate(year, month, day);
+}
+
+std::string FormatDate(std::uint32_t packed) {
+    std::string out = "????.??.??";
+    const auto put = [&out](std::size_t end, int value, int width) {
+        for (int i = 0; i < width; ++i, value /= 10) out[end - i] = static_cast<char>('0' + value % 10);
+    };
+    const int year = DateYear(packed);
+    if (year > 0) {
+        if (year > 9999) out.replace(0, 4, std::to_string(year));
+        else put(3, year, 4);
+    }
+    const std::size_t shift = out.size() - 10;
+    if (DateMonth(packed) > 0) put(shift + 6, DateMonth(packed), 2);
+    if (DateDay(packed) > 0) put(shift + 9, DateDay(packed), 2);
+    return out;
+}
+
+} // namespace chessDataLib::utils
@@ -0,0 +1,71 @@
+#include "utils/editDistance.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
+
+namespace chessDataLib::utils {
+
+// Two-row DP; stops once a whole row exceeds limit
+static int EditDistanceDP(std::string_view a, std::string_view b, int limit) {
+    std::vector<int> prev(b.size() + 1), cur(b.size() + 1);
+    for (std::size_t j = 0; j <= b.size(); ++j) prev[j] = static_cast<int>(j);
+    for (std::size_t i = 1; i <= a.size(); ++i) {
+        cur[0] = static_cast<int>(i);
+        int rowMin = cur[0];
+        for (std::size_t j = 1; j <= b.size(); ++j) {
+            const int substitute = prev[j - 1] + (a[i - 1] != b[j - 1]);
+            cur[j] = std::min({prev[j] + 1, cur[j - 1] + 1, substitute});
+            rowMin = std::min(rowMin, cur[j]);
+        }
+        if (rowMin > limit) return limit + 1;
+        prev.swap(cur);
+    }
+    return std::min(prev[b.size()], limit + 1);
+}
+
+int EditDistance(std::string_view a, std::string_view b, int limit) {
+    if (std::abs(static_cast<long long>(a.size()) - static_cast<long long>(b.size())) > limit) return limit + 1;
+    if (a.size() < b.size()) std::swap(a, b);
+    if (b.size() <= 64) return EditDistanceMatcher(b).Distance(a, limit);
+    return EditDistanceDP(a, b, limit);
+}
+
+EditDistanceMatcher::EditDistanceMatcher(std::string_view p) : pattern(p) {
+    if (pattern.size() > 64) return;
+    for (std::size_t i = 0; i < pattern.size(); ++i) {
+        peq[static_cast<unsigned char>(pattern[i])] |= std::uint64_t(1) << i;
+    }
+}
+
+int EditDistanceMatcher::Distance(std::string_view text, int limit) const {
+    const long long m = static_cast<long long>(pattern.size());
+    const long long n = static_cast<long long>(text.size());
+    if (std::abs(m - n) > limit) return limit + 1;
+    if (m == 0) return static_cast<int>(n);
+    if (m > 64) return EditDistanceDP(pattern, text, limit);
+
+    // Vertical deltas of the current column as +1 (pv) and -1 (mv) bit vectors
+    const std::uint64_t last = std::uint64_t(1) << (m - 1);
+    std::uint64_t pv = ~std::uint64_t(0);
+    std::uint64_t mv = 0;
+    long long score = m;
+    for (long long j = 0; j < n; ++j) {
+        const std::uint64_t eq = peq[static_cast<unsigned char>(text[j])];
+        const std::uint64_t xv = eq | mv;
+        const std::uint64_t xh = (((eq & pv) + pv) ^ pv) | eq;
+        std::uint64_t ph = mv | ~(xh | pv);
+        std::uint64_t mh = pv & xh;
+        if (ph & last) ++score;
+        else if (mh & last) --score;
+        // Global distance: the top row grows by one per text byte
+        ph = (ph << 1) | 1;
+        mh <<= 1;
+        pv = mh | ~(xv | ph);
+        mv = ph & xv;
+        // Each remaining byte lowers the last row by at most one
+        if (score - (n - j - 1) > limit) return limit + 1;
+    }
+    return score > limit ? limit + 1 : static_cast<int>(score);
+}
+
+} // namespace chessDataLib::utils
@@ -0,0 +1,217 @@
+#include "utils/externalSort.hpp"
+#include "utils/workStealingPool.hpp"
+#include <algorithm>
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <queue>
+#include <random>
+#include <thread>
+
+namespace chessDataLib::utils {
+
+namespace fs = std::filesystem;
+
+namespace {
+
+constexpr std::size_t kMaxFanIn = 64;          // runs merged at once
+constexpr std::size_t kStreamBuffer = 1 << 16; // per run file
+constexpr std::size_t kParallelSortMin = 1 << 14;
+
+// Heap bytes of a buffered record
+std::size_t Footprint(const std::string& s) {
+    return sizeof(std::string) + (s.capacity() > 15 ? s.capacity() + 1 : 0);
+}
+
+// Records in run files: varint length, then the bytes
+void WriteRecord(std::ostream& out, const std::string& s) {
+    char len[10];
+    int n = 0;
+    std::uint64_t v = s.size();
+    do {
+        len[n++] = static_cast<char>((v & 0x7f) | (v > 0x7f ? 0x80 : 0));
+        v >>= 7;
+    } while (v);
+    out.write(len, n);
+    out.write(s.data(), static_cast<std::streamsize>(s.size()));
+}
+
+struct RunReader {
+    std::unique_ptr<char[]> streamBuffer = std::make_unique<char[]>(kStreamBuffer);
+    std::ifstream in;
+    std::string record;
+    bool failed = false;  // the run ended inside a record
+
+    bool Open(const std::string& path) {
+        in.rdbuf()->pubsetbuf(streamBuffer.get(), kStreamBuffer);
+        in.open(path, std::ios::binary);
+        return in.is_open();
+    }
+
+    // Reads the next record; false at the end of the run, with failed set
+    // if the run was cut short or could not be read
+    bool Next() {
+        std::uint64_t size = 0;
+        for (int shift = 0;; shift += 7) {
+            const int c = in.get();
+            if (c == EOF) {
+                failed = shift > 0 || in.bad();
+                return false;
+            }
+            if (shift > 63) return !(failed = true);
+            size |= static_cast<std::uint64_t>(c & 0x7f) << shift;
+            if (!(c & 0x80)) break;
+        }
+        record.resize(static_cast<std::size_t>(size));
+        in.read(record.data(), static_cast<std::streamsize>(size));
+        failed = static_cast<std::uint64_t>(in.gcount()) != size;
+        return !failed;
+    }
+};
+
+} // namespace
+
+ExternalSorter::ExternalSorter(std::size_t memoryBudget, std::string tempDirectory, unsigned threadCount)
+    : budget(std::max<std::size_t>(memoryBudget, 1)), directory(std::move(tempDirectory)), threads(threadCount) {
+    if (directory.empty()) directory = fs::temp_directory_path().string();
+}
+
+ExternalSorter::~ExternalSorter() {
+    std::error_code ec;
+    for (const auto& path : files) fs::remove(path, ec);
+}
+
+bool ExternalSorter::Add(std::string record) {
+    if (failed) return false;
+    bufferBytes += Footprint(record);
+    buffer.push_back(std::move(record));
+    if (bufferBytes >= budget) failed = !Spill();
+    return !failed;
+}
+
+void ExternalSorter::SortBuffer() {
+    const unsigned workers = threads ? threads : std::max(1u, std::thread::hardware_concurrency());
+    const std::size_t chunks = std::min<std::size_t>(workers, buffer.size() / kParallelSortMin);
+    if (chunks <= 1) {
+        std::sort(buffer.begin(), buffer.end());
+        return;
+    }
+    WorkStealingPool pool(workers);
+
+    // Sort equal chunks in parallel, then merge neighbours level by level
+    std::vector<std::size_t> bounds(chunks + 1);
+    for (std::size_t i = 0; i <= chunks; ++i) bounds[i] = buffer.size() * i / chunks;
+    pool.Run(chunks, [&](std::size_t i, unsigned) {
+        std::sort(buffer.begin() + bounds[i], buffer.begin() + bounds[i + 1]);
+    });
+    for (std::size_t width = 1; width < chunks; width *= 2) {
+        const std::size_t pairs = (chunks + 2 * width - 1) / (2 * width);
+        pool.Run(pairs, [&](std::size_t p, unsigned) {
+            const std::size_t first = p * 2 * width;
+            const std::size_t middle = std::min(first + width, chunks);
+            const std::size_t last = std::min(first + 2 * width, chunks);
+            if (middle < last) {
+                std::inplace_merge(buffer.begin() + bounds[first], buffer.begin() + bounds[middle],
+                                   buffer.begin() + bounds[last]);
+            }
+        });
+    }
+}
+
+std::string ExternalSorter::NewRunPath() {
+    static std::atomic<std::uint64_t> counter{0};
+    static const std::uint64_t tag = std::random_device()();
+    const std::string path = (fs::path(directory) / ("chessDataLib_sort_" + std::to_string(tag) + "_" +
+                                                     std::to_string(counter.fetch_add(1)) + ".run"))
+                                 .string();
+    files.push_back(path);
+    return path;
+}
+
+bool ExternalSorter::Spill() {
+    SortBuffer();
+    const std::string path = NewRunPath();
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out.is_open()) {
+        std::cerr << "ExternalSorter: failed to open " << path << "\n";
+        return false;
+    }
+    for (const auto& record : buffer) WriteRecord(out, record);
+    out.close();
+    if (!out) {
+        std::cerr << "ExternalSorter: failed to write " << path << "\n";
+        return false;
+    }
+    runs.push_back(path);
+    spilled++;
+    buffer.clear();
+    buffer.shrink_to_fit();
+    bufferBytes = 0;
+    return true;
+}
+
+bool ExternalSorter::Merge(const std::vector<std::string>& inputs,
+                           const std::function<bool(const std::string&)>& emit) {
+    std::vector<RunReader> readers(inputs.size());
+    const auto greater = [&readers](std::size_t a, std::size_t b) { return readers[a].record > readers[b].record; };
+    std::priority_queue<std::size_t, std::vector<std::size_t>, decltype(greater)> heap(greater);
+    // Queues the run's next record; a truncated run is an error, not an early end
+    const auto advance = [&](std::size_t i) {
+        if (readers[i].Next()) heap.push(i);
+        if (!readers[i].failed) return true;
+        std::cerr << "ExternalSorter: failed to read " << inputs[i] << "\n";
+        return false;
+    };
+    for (std::size_t i = 0; i < inputs.size(); ++i) {
+        if (!readers[i].Open(inputs[i])) {
+            std::cerr << "ExternalSorter: failed to open " << inputs[i] << "\n";
+            return false;
+        }
+        if (!advance(i)) return false;
+    }
+    while (!heap.empty()) {
+        const std::size_t i = heap.top();
+        heap.pop();
+        if (!emit(readers[i].record) || !advance(i)) return false;
+    }
+    return true;
+}
+
+bool ExternalSorter::Finish(const std::function<bool(const std::string&)>& emit) {
+    if (failed) return false;
+    if (runs.empty()) {
+        SortBuffer();
+        for (const auto& record : buffer) {
+            if (!emit(record)) return false;
+        }
+        return true;
+    }
+    if (!buffer.empty() && !Spill()) return false;
+
+    // Intermediate passes until one merge covers every run
+    std::error_code ec;
+    while (runs.size() > kMaxFanIn) {
+        std::vector<std::string> next;
+        for (std::size_t first = 0; first < runs.size(); first += kMaxFanIn) {
+            const std::vector<std::string> group(runs.begin() + first,
+                                                 runs.begin() + std::min(first + kMaxFanIn, runs.size()));
+            const std::string path = NewRunPath();
+            std::ofstream out(path, std::ios::binary | std::ios::trunc);
+            if (!out.is_open() || !Merge(group, [&out](const std::string& r) {
+                    WriteRecord(out, r);
+                    return static_cast<bool>(out);
+                })) {
+                std::cerr << "ExternalSorter: failed to write " << path << "\n";
+                return false;
+            }
+            for (const auto& merged : group) fs::remove(merged, ec);
+            next.push_back(path);
+        }
+        runs.swap(next);
+    }
+    return Merge(runs, emit);
+}
+
+} // namespace chessDataLib::utils
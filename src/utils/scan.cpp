@@ -0,0 +1,122 @@
+#include "utils/scan.hpp"
+#include "utils/bits.hpp"
+#include <cstring>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define CHESSDATALIB_HAVE_AVX2 1
+#endif
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define CHESSDATALIB_HAVE_SSE2 1
+#endif
+
+namespace chessDataLib::utils {
+
+static const char* FindPairScalar(const char* p, const char* end, char a, char b) {
+    while (p + 1 < end) {
+        p = static_cast<const char*>(std::memchr(p, a, static_cast<std::size_t>(end - p - 1)));
+        if (!p) return end;
+        if (p[1] == b) return p;
+        ++p;
+    }
+    return end;
+}
+
+const char* FindPair(const char* begin, const char* end, char a, char b) {
+    const char* p = begin;
+#ifdef CHESSDATALIB_HAVE_SSE2
+    const __m128i va = _mm_set1_epi8(a);
+    const __m128i vb = _mm_set1_epi8(b);
+    // Compare 16 candidate positions at once: byte i matches a, byte i+1 matches b
+    while (end - p >= 17) {
+        __m128i first = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        __m128i second = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 1));
+        int mask = _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(first, va), _mm_cmpeq_epi8(second, vb)));
+        if (mask) return p + CountTrailingZeros(static_cast<std::uint32_t>(mask));
+        p += 16;
+    }
+#endif
+    return FindPairScalar(p, end, a, b);
+}
+
+const char* FindGameStart(const char* begin, const char* p, const char* end) {
+    for (const char* q = p > begin ? p - 1 : p; (q = FindPair(q, end, '\n', '[')) != end; ++q) {
+        if (q + 1 < p) continue;
+        if ((q - begin >= 1 && q[-1] == '\n') || (q - begin >= 2 && q[-1] == '\r' && q[-2] == '\n')) {
+            return q + 1;
+        }
+    }
+    return end;
+}
+
+const char* FindFirstGame(const char* begin, const char* end) {
+    const char* p = begin;
+    if (end - p >= 3 && static_cast<unsigned char>(p[0]) == 0xEF && static_cast<unsigned char>(p[1]) == 0xBB &&
+        static_cast<unsigned char>(p[2]) == 0xBF) {
+        p += 3;
+    }
+    while (p < end && (*p == ' ' || *p == '\t' || *p == '\r' || *p == '\n')) ++p;
+    if (p < end && *p == '[') return p;
+    return FindGameStart(begin, p, end);
+}
+
+std::uint64_t NewlineMask64(const char* p) {
+#if defined(CHESSDATALIB_HAVE_AVX2)
+    const __m256i nl = _mm256_set1_epi8('\n');
+    const __m256i lo = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+    const __m256i hi = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + 32));
+    const std::uint64_t a = static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(lo, nl)));
+    const std::uint64_t b = static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(hi, nl)));
+    return a | (b << 32);
+#elif defined(CHESSDATALIB_HAVE_SSE2)
+    const __m128i nl = _mm_set1_epi8('\n');
+    std::uint64_t mask = 0;
+    for (int i = 0; i < 4; ++i) {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 16 * i));
+        mask |= static_cast<std::uint64_t>(static_cast<std::uint16_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, nl)))) << (16 * i);
+    }
+    return mask;
+#else
+    std::uint64_t mask = 0;
+    for (int i = 0; i < 64; ++i) mask |= static_cast<std::uint64_t>(p[i] == '\n') << i;
+    return mask;
+#endif
+}
+
+// === LineScanner ===
+
+LineScanner::LineScanner(const char* begin, const char* end) {
+    Reset(begin, end);
+}
+
+void LineScanner::Reset(const char* begin, const char* rangeEnd) {
+    block = begin;
+    blockEnd = begin;  // nothing classified yet
+    end = rangeEnd;
+    mask = 0;
+}
+
+const char* LineScanner::Next(const char* p) {
+    while (p < end) {
+        if (p >= block && p < blockEnd) {
+            const std::uint64_t pending = mask & (~0ull << (p - block));
+            if (pending) return block + CountTrailingZeros(pending);
+            p = blockEnd;
+            continue;
+        }
+        block = p;
+        if (end - p >= 64) {
+            blockEnd = p + 64;
+            mask = NewlineMask64(p);
+        } else {
+            // Tail shorter than a block: classify byte by byte
+            blockEnd = end;
+            mask = 0;
+            for (std::ptrdiff_t i = 0; i < end - p; ++i) mask |= static_cast<std::uint64_t>(p[i] == '\n') << i;
+        }
+    }
+    return end;
+}
+
+} // namespace chessDataLib::utils
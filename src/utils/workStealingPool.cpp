@@ -0,0 +1,91 @@
+#include "utils/workStealingPool.hpp"
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace chessDataLib::utils {
+
+namespace {
+
+struct WorkerQueue {
+    std::mutex mutex;
+    std::deque<std::size_t> tasks;
+
+    bool PopBack(std::size_t& task) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (tasks.empty()) return false;
+        task = tasks.back();
+        tasks.pop_back();
+        return true;
+    }
+
+    bool StealFront(std::size_t& task) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (tasks.empty()) return false;
+        task = tasks.front();
+        tasks.pop_front();
+        return true;
+    }
+};
+
+} // namespace
+
+WorkStealingPool::WorkStealingPool(unsigned count) : threadCount(count) {
+    if (threadCount == 0) threadCount = std::max(1u, std::thread::hardware_concurrency());
+}
+
+unsigned WorkStealingPool::GetThreadCount() const {
+    return threadCount;
+}
+
+void WorkStealingPool::Run(std::size_t taskCount, const Task& fn) {
+    if (taskCount == 0) return;
+
+    const unsigned workers = static_cast<unsigned>(std::min<std::size_t>(threadCount, taskCount));
+    if (workers == 1) {
+        for (std::size_t i = 0; i < taskCount; ++i) fn(i, 0);
+        return;
+    }
+
+    // Seed in reverse so each worker pops its lowest (largest) task index first
+    std::vector<std::unique_ptr<WorkerQueue>> queues;
+    for (unsigned w = 0; w < workers; ++w) queues.push_back(std::make_unique<WorkerQueue>());
+    for (std::size_t i = taskCount; i-- > 0;) queues[i % workers]->tasks.push_back(i);
+
+    std::atomic<bool> failed{false};
+    std::exception_ptr error;
+    std::mutex errorMutex;
+
+    auto worker = [&](unsigned self) {
+        std::size_t task;
+        for (;;) {
+            if (failed.load(std::memory_order_relaxed)) return;
+            bool found = queues[self]->PopBack(task);
+            for (unsigned k = 1; !found && k < workers; ++k) {
+                found = queues[(self + k) % workers]->StealFront(task);
+            }
+            if (!found) return; // no task spawns new ones, so empty everywhere means done
+            try {
+                fn(task, self);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(errorMutex);
+                if (!error) error = std::current_exception();
+                failed = true;
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (unsigned w = 1; w < workers; ++w) threads.emplace_back(worker, w);
+    worker(0);
+    for (auto& t : threads) t.join();
+
+    if (error) std::rethrow_exception(error);
+}
+
+} // namespace chessDataLib::utils
@@ -0,0 +1,97 @@
+#include "arrowWriter.hpp"
+#include "utils/flatBuffer.hpp"
+#include <gtest/gtest.h>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+
+using namespace chessDataLib;
+namespace fs = std::filesystem;
+
+namespace {
+
+std::string ReadAll(const fs::path& path) {
+    std::ifstream in(path, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+}
+
+template <typename T>
+T Load(const std::string& buf, std::size_t at) {
+    T v;
+    std::memcpy(&v, buf.data() + at, sizeof v);
+    return v;
+}
+
+// Position of a table field, or 0 when absent (minimal FlatBuffers reader)
+std::size_t FieldAt(const std::string& buf, std::size_t table, int id) {
+    const std::size_t vtable = table - static_cast<std::size_t>(Load<std::int32_t>(buf, table));
+    if (4 + 2 * static_cast<std::size_t>(id) >= Load<std::uint16_t>(buf, vtable)) return 0;
+    const std::uint16_t off = Load<std::uint16_t>(buf, vtable + 4 + 2 * static_cast<std::size_t>(id));
+    return off ? table + off : 0;
+}
+
+std::size_t Deref(const std::string& buf, std::size_t at) {
+    return at + Load<std::uint32_t>(buf, at);
+}
+
+} // namespace
+
+TEST(FlatBufferBuilder, WritesReadableTables) {
+    utils::FlatBufferBuilder b;
+    const auto bytes = b.Finish([](utils::FlatBufferBuilder& fb) {
+        utils::FlatBufferBuilder::Table t;
+        t.I16(0, -3).Offset(1, [](utils::FlatBufferBuilder& sb) { return sb.WriteString("name"); }).I64(3, 1ll << 40);
+        return fb.WriteTable(t);
+    });
+    const std::string buf(bytes.begin(), bytes.end());
+    EXPECT_EQ(buf.size() % 8, 0u);
+
+    const std::size_t root = Deref(buf, 0);
+    EXPECT_EQ(Load<std::int16_t>(buf, FieldAt(buf, root, 0)), -3);
+    const std::size_t name = Deref(buf, FieldAt(buf, root, 1));
+    EXPECT_EQ(buf.substr(name + 4, Load<std::uint32_t>(buf, name)), "name");
+    EXPECT_EQ(FieldAt(buf, root, 2), 0u);
+    EXPECT_EQ(FieldAt(buf, root, 3) % 8, 0u);
+    EXPECT_EQ(Load<std::int64_t>(buf, FieldAt(buf, root, 3)), 1ll << 40);
+}
+
+TEST(ArrowWriter, WritesFileWithFooterPerBatch) {
+    const fs::path path = fs::temp_directory_path() / "chessDataLib_arrow_test.arrow";
+    ArrowWriter writer;
+    writer.SetBatchRows(4);
+    ASSERT_TRUE(writer.Open(path.string(), {{"name", ArrowWriter::Type::DictionaryUtf8},
+                                            {"elo", ArrowWriter::Type::Int32, true},
+                                            {"note", ArrowWriter::Type::Utf8}}));
+    for (int i = 0; i < 10; ++i) {
+        writer.AppendString(0, i % 2 ? "odd" : "even");
+        if (i % 3) writer.AppendInt32(1, 2000 + i);
+        else writer.AppendNull(1);
+        writer.AppendString(2, std::string(static_cast<std::size_t>(i), 'x'));
+        ASSERT_TRUE(writer.EndRow());
+    }
+    ASSERT_TRUE(writer.Close());
+    EXPECT_EQ(writer.GetRowCount(), 10u);
+    EXPECT_EQ(writer.GetBatchCount(), 3u);
+
+    const std::string file = ReadAll(path);
+    ASSERT_GT(file.size(), 16u);
+    EXPECT_EQ(file.compare(0, 8, std::string("ARROW1\0\0", 8)), 0);
+    EXPECT_EQ(file.compare(file.size() - 6, 6, "ARROW1"), 0);
+
+    // Footer: three record batch blocks and one dictionary block (no new values after the first batch)
+    const auto footerSize = static_cast<std::size_t>(Load<std::int32_t>(file, file.size() - 10));
+    const std::string footer = file.substr(file.size() - 10 - footerSize, footerSize);
+    const std::size_t root = Deref(footer, 0);
+    EXPECT_EQ(Load<std::uint32_t>(footer, Deref(footer, FieldAt(footer, root, 2))), 1u);
+    const std::size_t batches = Deref(footer, FieldAt(footer, root, 3));
+    ASSERT_EQ(Load<std::uint32_t>(footer, batches), 3u);
+
+    // Each block points at an 8-aligned message starting with the continuation marker
+    for (std::size_t i = 0; i < 3; ++i) {
+        const auto offset = static_cast<std::size_t>(Load<std::int64_t>(footer, batches + 4 + 24 * i));
+        EXPECT_EQ(offset % 8, 0u);
+        EXPECT_EQ(Load<std::uint32_t>(file, offset), 0xFFFFFFFFu);
+    }
+    fs::remove(path);
+}
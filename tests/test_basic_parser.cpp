@@ -0,0 +1,78 @@
+#include "basicParser.hpp"
+#include "parser.hpp"
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <fstream>
+
+using namespace chessDataLib;
+namespace fs = std::filesystem;
+
+namespace {
+
+class BasicParserTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        dir = fs::temp_directory_path() / ("chessDataLib_basic_" + std::to_string(::testing::UnitTest::GetInstance()->random_seed()));
+        fs::create_directories(dir);
+        path = dir / "games.pgn";
+        std::ofstream out(path, std::ios::binary);
+        out << "\r\n";
+        const char* results[] = {"1-0", "0-1", "1/2-1/2"};
+        for (int i = 0; i < 200; ++i) {
+            out << "[Event \"Open " << i % 5 << "\"]\r\n"
+                << "[White \"Player, " << i % 11 << "\"]\r\n"
+                << "[Black \"Player, " << (i + 4) % 11 << "\"]\r\n"
+                << "[Result \"" << results[i % 3] << "\"]\r\n"
+                << "[WhiteElo \"" << 2000 + i << "\"]\r\n"
+                << "[Annotator \"x\"]\r\n\r\n"
+                << "1. e4 { [%clk 0:03:00] } e5 2. Nf3 (2. Nc3 Nf6) Nc6\r\n3. Bb5 " << results[i % 3] << "\r\n\r\n";
+        }
+    }
+    void TearDown() override { fs::remove_all(dir); }
+
+    fs::path dir, path;
+};
+
+} // namespace
+
+TEST_F(BasicParserTest, ExtractsOnlySelectedFields) {
+    BasicParser<Extract::Players | Extract::Result> light;
+    light.SetChunkSize(1024);
+    light.SetThreadCount(4);
+    ASSERT_TRUE(light.LoadFile(path.string()));
+    static_assert(!BasicParser<Extract::Players | Extract::Result>::kScansMoveText);
+
+    Parser full;
+    ASSERT_TRUE(full.LoadFile(path.string()));
+    const auto& games = light.GetGames();
+    ASSERT_EQ(games.size(), full.GetGames().size());
+    ASSERT_EQ(games.size(), 200u);
+    for (std::size_t i = 0; i < games.size(); ++i) {
+        EXPECT_EQ(games[i].GetWhite(), full.GetGames()[i].GetWhite());
+        EXPECT_EQ(games[i].GetBlack(), full.GetGames()[i].GetBlack());
+        EXPECT_EQ(games[i].GetResult(), full.GetGames()[i].GetResult());
+        EXPECT_TRUE(games[i].GetEvent().empty());
+        EXPECT_TRUE(games[i].GetWhiteElo().empty());
+        EXPECT_EQ(games[i].GetMoveCount(), 0);
+        EXPECT_FALSE(games[i].HasMoveText());
+    }
+}
+
+TEST_F(BasicParserTest, AllFieldsMatchFullPipeline) {
+    BasicParser<Extract::All> parser;
+    parser.SetChunkSize(2048);
+    ASSERT_TRUE(parser.LoadFile(path.string()));
+    Parser full;
+    ASSERT_TRUE(full.LoadFile(path.string()));
+    ASSERT_EQ(parser.GetGames().size(), 200u);
+    for (std::size_t i = 0; i < 200; ++i) {
+        const Game& a = parser.GetGames()[i];
+        const Game& b = full.GetGames()[i];
+        EXPECT_EQ(a.GetEvent(), b.GetEvent());
+        EXPECT_EQ(a.GetWhiteElo(), b.GetWhiteElo());
+        EXPECT_EQ(a.GetMoveCount(), 3);
+        EXPECT_EQ(a.GetMoveCount(), b.GetMoveCount());
+        EXPECT_EQ(a.GetClocks(), b.GetClocks());
+        EXPECT_EQ(parser.GetMoveText(a), full.GetMoveText(b));
+    }
+}
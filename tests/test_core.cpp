@@ -1,18 +1,55 @@
-name: CI
+#include "game.hpp"
+#include "player.hpp"
+#include "tournament.hpp"
+#include "databaseStats.hpp"
+#include <gtest/gtest.h>
 
-on:
-  push:
-  pull_request:
+using namespace chessDataLib;
 
-jobs:
-  build:
-    runs-on: ubuntu-latest
-    steps:
-      - name: Checkout
-        uses: actions/checkout@v4
+TEST(Core, GameResultHelpers) {
+    Game g;
+    g.SetResult("1-0");
+    EXPECT_TRUE(g.IsWhiteWin());
+    g.SetResult("1/2-1/2");
+    EXPECT_TRUE(g.IsDraw());
+    g.SetResult("*");
+    EXPECT_TRUE(g.IsUnknownResult());
+}
 
-      - name: Configure
-        run: mkdir -p build && cd build && cmake ..
+TEST(Core, PlayerMerge) {
+    Player a, b;
+    a.SetName("A");
+    a.IncrementGameCount();
+    a.IncrementWinCount();
+    a.AddOpponent("X");
+    b.IncrementGameCount();
+    b.IncrementDrawCount();
+    b.AddOpponent("X");
+    b.AddOpponent("Y");
+    a.MergeWith(b);
+    EXPECT_EQ(a.GetTotalGames(), 2);
+    EXPECT_EQ(a.GetWinsCount(), 1);
+    EXPECT_EQ(a.GetDrawCount(), 1);
+    EXPECT_EQ(a.GetOpponents().size(), 2u);
+}
 
-      - name: Build
-        run: cmake --build build --parallel
\ No newline at end of file
+TEST(Core, TournamentAddPlayer) {
+    Tournament t("Open");
+    t.AddPlayer("A");
+    t.AddPlayer("B");
+    t.AddPlayer("A");
+    EXPECT_EQ(t.GetUniquePlayers(), 2);
+    EXPECT_EQ(t.GetPlayerGameCount().at("A"), 2);
+}
+
+TEST(Core, ResultCounting) {
+    DatabaseStats stats;
+    stats.IncrementResultCount("1-0");
+    stats.IncrementResultCount(" 0-1 ");
+    stats.IncrementResultCount("1/2");
+    stats.IncrementResultCount("*");
+    EXPECT_EQ(stats.GetWhiteWins(), 1);
+    EXPECT_EQ(stats.GetBlackWins(), 1);
+    EXPECT_EQ(stats.GetDraws(), 1);
+    EXPECT_EQ(stats.GetUnknownResults(), 1);
+}
@@ -0,0 +1,189 @@
+#include "utils/externalSort.hpp"
+#include "parser.hpp"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <random>
+
+using namespace chessDataLib;
+namespace fs = std::filesystem;
+
+namespace {
+
+std::vector<std::string> RandomRecords(std::size_t count) {
+    std::mt19937 rng(7);
+    std::vector<std::string> records;
+    for (std::size_t i = 0; i < count; ++i) {
+        std::string r(1 + rng() % 40, '\0');
+        for (char& c : r) c = static_cast<char>(rng() % 256);
+        records.push_back(std::move(r));
+    }
+    return records;
+}
+
+std::vector<std::string> ReadLines(const fs::path& path) {
+    std::ifstream in(path);
+    std::vector<std::string> lines;
+    for (std::string line; std::getline(in, line);) lines.push_back(line);
+    return lines;
+}
+
+} // namespace
+
+TEST(ExternalSorter, SortsInMemory) {
+    auto records = RandomRecords(50000);
+    utils::ExternalSorter sorter(1u << 30, std::string(), 4);
+    for (const auto& r : records) ASSERT_TRUE(sorter.Add(r));
+    std::vector<std::string> out;
+    ASSERT_TRUE(sorter.Finish([&out](const std::string& r) {
+        out.push_back(r);
+        return true;
+    }));
+    EXPECT_EQ(sorter.GetRunCount(), 0u);
+    std::sort(records.begin(), records.end());
+    EXPECT_EQ(out, records);
+}
+
+TEST(ExternalSorter, SpillsAndMergesInPasses) {
+    const fs::path dir = fs::temp_directory_path() / "chessDataLib_external_sort";
+    fs::create_directories(dir);
+    auto records = RandomRecords(20000);
+    std::vector<std::string> out;
+    {
+        // About 100 records per run: more runs than one merge takes
+        utils::ExternalSorter sorter(100 * 64, dir.string(), 2);
+        for (const auto& r : records) ASSERT_TRUE(sorter.Add(r));
+        EXPECT_GT(sorter.GetRunCount(), 64u);
+        ASSERT_TRUE(sorter.Finish([&out](const std::string& r) {
+            out.push_back(r);
+            return true;
+        }));
+    }
+    std::sort(records.begin(), records.end());
+    EXPECT_EQ(out, records);
+    EXPECT_TRUE(fs::is_empty(dir));
+
+    // emit can stop the merge
+    utils::ExternalSorter sorter(64, dir.string());
+    for (int i = 0; i < 10; ++i) sorter.Add(std::to_string(i));
+    int seen = 0;
+    EXPECT_FALSE(sorter.Finish([&seen](const std::string&) { return ++seen < 3; }));
+    EXPECT_EQ(seen, 3);
+    fs::remove_all(dir);
+
+    utils::ExternalSorter missing(1, (dir / "missing").string());
+    EXPECT_FALSE(missing.Add("x"));
+}
+
+TEST(ExternalSorter, FailsOnTruncatedRun) {
+    const fs::path dir = fs::temp_directory_path() / "chessDataLib_external_sort_truncated";
+    fs::create_directories(dir);
+    {
+        utils::ExternalSorter sorter(256, dir.string());
+        for (const auto& r : RandomRecords(100)) ASSERT_TRUE(sorter.Add(r));
+        ASSERT_GT(sorter.GetRunCount(), 1u);
+        const fs::path run = fs::directory_iterator(dir)->path();
+        fs::resize_file(run, fs::file_size(run) - 1);
+        std::size_t emitted = 0;
+        EXPECT_FALSE(sorter.Finish([&emitted](const std::string&) {
+            ++emitted;
+            return true;
+        }));
+        EXPECT_LT(emitted, 100u);
+    }
+    fs::remove_all(dir);
+}
+
+TEST(ExternalSorter, ExportsSortedPlayers) {
+    const fs::path dir = fs::temp_directory_path() / "chessDataLib_sorted_export";
+    fs::create_directories(dir);
+    const fs::path pgn = dir / "games.pgn";
+    {
+        std::ofstream out(pgn, std::ios::binary);
+        // Player Pi plays i games against Q, winning every third
+        for (int i = 1; i <= 60; ++i) {
+            for (int g = 0; g < i; ++g) {
+                out << "[Event \"E\"]\n[White \"P" << i << "\"]\n[Black \"Q\"]\n[Result \""
+                    << (g % 3 == 0 ? "1-0" : "0-1") << "\"]\n\n1. e4 e5 *\n\n";
+            }
+        }
+    }
+    Parser parser;
+    parser.SetThreadCount(2);
+    ASSERT_TRUE(parser.LoadFile(pgn.string()));
+
+    PlayerExportOptions options;
+    const fs::path inMemory = dir / "memory.csv";
+    ASSERT_TRUE(parser.ExportPlayerStatsCSV(inMemory.string(), options));
+    const auto rows = ReadLines(inMemory);
+    ASSERT_EQ(rows.size(), 62u);
+    EXPECT_EQ(rows[0], "Player,TotalGames,Wins,Losses,Draws,WinPct,LossPct,DrawPct");
+    EXPECT_EQ(rows[1].substr(0, 7), "Q,1830,");
+    EXPECT_EQ(rows[2].substr(0, 6), "P60,60");
+    EXPECT_EQ(rows[61].substr(0, 5), "P1,1,");
+
+    // A tiny budget spills every few rows and must give the same file
+    options.memoryBudget = 256;
+    options.tempDirectory = dir.string();
+    const fs::path spilled = dir / "spilled.csv";
+    ASSERT_TRUE(parser.ExportPlayerStatsCSV(spilled.string(), options));
+    EXPECT_EQ(ReadLines(spilled), rows);
+
+    // Ties on score are broken by name
+    options.key = PlayerExportOptions::Key::Score;
+    ASSERT_TRUE(parser.ExportPlayerStatsCSV(spilled.string(), options));
+    const auto byScore = ReadLines(spilled);
+    EXPECT_EQ(byScore[1].substr(0, 3), "P1,");
+    EXPECT_EQ(byScore[2].substr(0, 2), "Q,");
+    EXPECT_EQ(byScore[3].substr(0, 3), "P2,");
+    EXPECT_EQ(byScore[4].substr(0, 3), "P4,");
+
+    options.key = PlayerExportOptions::Key::Name;
+    ASSERT_TRUE(parser.ExportPlayerStatsCSV(spilled.string(), options));
+    EXPECT_EQ(ReadLines(spilled)[1].substr(0, 2), "Q,");
+    options.descending = false;
+    ASSERT_TRUE(parser.ExportPlayerStatsCSV(spilled.string(), options));
+    const auto byName = ReadLines(spilled);
+    EXPECT_EQ(byName[1].substr(0, 3), "P1,");
+    EXPECT_EQ(byName[2].substr(0, 4), "P10,");
+    EXPECT_TRUE(std::is_sorted(byName.begin() + 1, byName.end()));
+
+    options.key = PlayerExportOptions::Key::Wins;
+    ASSERT_TRUE(parser.ExportPlayerStatsCSV(spilled.string(), options));
+    EXPECT_EQ(ReadLines(spilled)[61].substr(0, 2), "Q,");
+
+    EXPECT_FALSE(parser.ExportPlayerStatsCSV((dir / "missing" / "x.csv").string(), options));
+    fs::remove_all(dir);
+}
+
+TEST(ExternalSorter, ExportOrdersCloseScoresExactly) {
+    // One draw in 46409 and in 46410 games: the scores differ by less than 2^-31
+    const fs::path dir = fs::temp_directory_path() / "chessDataLib_sorted_scores";
+    fs::create_directories(dir);
+    const fs::path pgn = dir / "games.pgn";
+    {
+        std::ofstream out(pgn, std::ios::binary);
+        const auto games = [&out](const char* player, int count) {
+            out << "[White \"" << player << "\"]\n[Black \"Z\"]\n[Result \"1/2-1/2\"]\n\n1/2-1/2\n\n";
+            for (int i = 1; i < count; ++i) {
+                out << "[White \"" << player << "\"]\n[Black \"Z\"]\n[Result \"0-1\"]\n\n0-1\n\n";
+            }
+        };
+        games("X", 46410);
+        games("Y", 46409);
+    }
+    Parser parser;
+    ASSERT_TRUE(parser.LoadFile(pgn.string()));
+
+    PlayerExportOptions options;
+    options.key = PlayerExportOptions::Key::Score;
+    const fs::path csv = dir / "players.csv";
+    ASSERT_TRUE(parser.ExportPlayerStatsCSV(csv.string(), options));
+    const auto rows = ReadLines(csv);
+    ASSERT_EQ(rows.size(), 4u);
+    EXPECT_EQ(rows[1].substr(0, 2), "Z,");
+    EXPECT_EQ(rows[2].substr(0, 2), "Y,");
+    EXPECT_EQ(rows[3].substr(0, 2), "X,");
+    fs::remove_all(dir);
+}
@@ -0,0 +1,95 @@
+#include "utils/flatHashMap.hpp"
+#include <gtest/gtest.h>
+#include <random>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+using namespace chessDataLib::utils;
+
+TEST(FlatHashMap, InsertsFindsAndGrows) {
+    StringMap<int> m;
+    EXPECT_TRUE(m.empty());
+    EXPECT_EQ(m.find("missing"), m.end());
+
+    for (int i = 0; i < 1000; ++i) m["player" + std::to_string(i)] = i;
+    EXPECT_EQ(m.size(), 1000u);
+    EXPECT_GE(m.capacity() * 7, m.size() * 8);
+
+    // Heterogeneous lookup: no std::string is built for the probe
+    const std::string_view key = "player417";
+    ASSERT_NE(m.find(key), m.end());
+    EXPECT_EQ(m.find(key)->second, 417);
+    EXPECT_EQ(m.at("player0"), 0);
+    EXPECT_THROW(m.at("nobody"), std::out_of_range);
+
+    auto [it, inserted] = m.try_emplace("player5", 99);
+    EXPECT_FALSE(inserted);
+    EXPECT_EQ(it->second, 5);
+
+    int sum = 0;
+    std::size_t visited = 0;
+    for (const auto& [name, value] : m) {
+        sum += value;
+        ++visited;
+        EXPECT_EQ(name, "player" + std::to_string(value));
+    }
+    EXPECT_EQ(visited, 1000u);
+    EXPECT_EQ(sum, 999 * 1000 / 2);
+}
+
+TEST(FlatHashMap, MatchesUnorderedMapUnderRandomChurn) {
+    StringMap<int> flat;
+    std::unordered_map<std::string, int> reference;
+    std::mt19937 rng(7);
+    for (int step = 0; step < 50000; ++step) {
+        const std::string key = std::to_string(rng() % 3000);
+        switch (rng() % 3) {
+            case 0:
+                flat[key] += step;
+                reference[key] += step;
+                break;
+            case 1:
+                EXPECT_EQ(flat.erase(key), reference.erase(key));
+                break;
+            default:
+                EXPECT_EQ(flat.count(key), reference.count(key));
+                break;
+        }
+    }
+    ASSERT_EQ(flat.size(), reference.size());
+    for (const auto& kv : reference) EXPECT_EQ(flat.at(kv.first), kv.second);
+
+    // Tombstones are reclaimed rather than growing the table without bound
+    EXPECT_LE(flat.capacity(), 8192u);
+}
+
+TEST(FlatHashMap, CopiesAndMovesOwnEntries) {
+    StringMap<std::string> a;
+    a["long key that does not fit in the small string buffer"] = "value";
+    a["k"] = "v";
+
+    StringMap<std::string> b = a;
+    b["k"] = "changed";
+    EXPECT_EQ(a.at("k"), "v");
+
+    StringMap<std::string> c = std::move(b);
+    EXPECT_EQ(c.size(), 2u);
+    EXPECT_EQ(c.at("k"), "changed");
+
+    a = c;
+    EXPECT_EQ(a.at("k"), "changed");
+    a.clear();
+    EXPECT_TRUE(a.empty());
+    EXPECT_EQ(a.begin(), a.end());
+    EXPECT_EQ(c.size(), 2u);
+}
+
+TEST(Bits, CountTrailingZeros) {
+    EXPECT_EQ(CountTrailingZeros(std::uint32_t(1)), 0);
+    EXPECT_EQ(CountTrailingZeros(std::uint32_t(0x80000000u)), 31);
+    EXPECT_EQ(CountTrailingZeros(std::uint32_t(0x0000A000u)), 13);
+    EXPECT_EQ(CountTrailingZeros(std::uint64_t(1)), 0);
+    EXPECT_EQ(CountTrailingZeros(std::uint64_t(1) << 40), 40);
+    EXPECT_EQ(CountTrailingZeros(std::uint64_t(0x8000000000000000ull)), 63);
+}
@@ -0,0 +1,109 @@
+#include "gameHistograms.hpp"
+#include "parser.hpp"
+#include "statsSnapshot.hpp"
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <fstream>
+
+using namespace chessDataLib;
+namespace fs = std::filesystem;
+
+using Outcome = GameHistograms::Outcome;
+
+TEST(GameHistograms, BinsLengthsAndRatingGaps) {
+    EXPECT_EQ(GameHistograms::PlyBinOf(0), 0);
+    EXPECT_EQ(GameHistograms::PlyBinOf(79), 7);
+    EXPECT_EQ(GameHistograms::PlyBinOf(1000), GameHistograms::kPlyBins - 1);
+    EXPECT_EQ(GameHistograms::GapBinOf(0), 16);
+    EXPECT_EQ(GameHistograms::GapBinOf(-1), 15);
+    EXPECT_EQ(GameHistograms::GapBinOf(-5000), 0);
+    EXPECT_EQ(GameHistograms::GapBinOf(800), GameHistograms::kGapBins - 1);
+    EXPECT_EQ(GameHistograms::GapBinStart(15), -50);
+
+    GameHistograms h;
+    h.AddGame(80, "1-0", 2600, 2400);
+    h.AddGame(120, "1/2-1/2", 2400, 2400);
+    h.AddGame(60, "0-1", 2600, 2400);
+    h.AddGame(10, "*", 2500, 2500);
+    h.AddGame(85, "1-0", 0, 2400);
+    EXPECT_EQ(h.GetGames(), 5u);
+    EXPECT_EQ(h.GetLengthHistogram()[8], 2u);
+    EXPECT_EQ(h.GetLengthHistogram(Outcome::WhiteWin)[8], 2u);
+    EXPECT_EQ(h.GetLengthHistogram(Outcome::Unfinished)[1], 1u);
+    EXPECT_DOUBLE_EQ(h.GetAverageLength(Outcome::WhiteWin), 82.5);
+    EXPECT_DOUBLE_EQ(h.GetAverageLength(), 71.0);
+    EXPECT_DOUBLE_EQ(h.GetAverageLength(Outcome::Draw), 120.0);
+
+    // Unfinished and unrated games have no rating gap
+    const RatingGapBin& favourite = h.GetRatingGaps()[GameHistograms::GapBinOf(200)];
+    EXPECT_EQ(favourite.games, 2u);
+    EXPECT_DOUBLE_EQ(favourite.GetDecisiveRate(), 100.0);
+    EXPECT_DOUBLE_EQ(favourite.GetActualScore(), 0.5);
+    EXPECT_NEAR(favourite.GetExpectedScore(), 0.7597, 1e-4);
+    const RatingGapBin& even = h.GetRatingGaps()[GameHistograms::GapBinOf(0)];
+    EXPECT_EQ(even.games, 1u);
+    EXPECT_DOUBLE_EQ(even.GetDecisiveRate(), 0.0);
+    EXPECT_DOUBLE_EQ(even.GetExpectedScore(), 0.5);
+    EXPECT_DOUBLE_EQ(RatingGapBin().GetActualScore(), 0.0);
+
+    GameHistograms other;
+    other.AddGame(80, "0-1", 2000, 2400);
+    h.MergeWith(other);
+    EXPECT_EQ(h.GetGames(), 6u);
+    EXPECT_EQ(h.GetLengthHistogram()[8], 3u);
+    EXPECT_EQ(h.GetRatingGaps()[GameHistograms::GapBinOf(-400)].blackWins, 1u);
+}
+
+TEST(GameHistograms, CollectedByParserAndSnapshotted) {
+    const fs::path dir = fs::temp_directory_path() / "chessDataLib_histograms";
+    fs::create_directories(dir);
+    const fs::path pgn = dir / "games.pgn";
+    {
+        std::ofstream out(pgn, std::ios::binary);
+        const char* results[] = {"1-0", "1/2-1/2", "0-1"};
+        for (int i = 0; i < 90; ++i) {
+            out << "[Event \"E\"]\n[White \"A\"]\n[Black \"B\"]\n[Result \"" << results[i % 3]
+                << "\"]\n[WhiteElo \"" << 2400 + 100 * (i % 3) << "\"]\n[BlackElo \"2400\"]\n\n";
+            // i % 3 + 1 full moves
+            for (int m = 0; m <= i % 3; ++m) out << m + 1 << ". Nf3 Nf6 ";
+            out << results[i % 3] << "\n\n";
+        }
+    }
+
+    // Per-thread copies merge to the single-threaded result
+    Parser serial;
+    serial.SetThreadCount(1);
+    ASSERT_TRUE(serial.LoadFile(pgn.string()));
+    Parser parallel;
+    parallel.SetThreadCount(3);
+    parallel.SetChunkSize(256);
+    ASSERT_TRUE(parallel.LoadFile(pgn.string()));
+
+    const GameHistograms& h = parallel.GetStats().GetHistograms();
+    EXPECT_EQ(h.GetGames(), 90u);
+    EXPECT_EQ(h.GetLengthHistogram(Outcome::WhiteWin)[0], 30u);
+    EXPECT_EQ(h.GetPlySum(Outcome::Draw), 30u * 4);
+    EXPECT_DOUBLE_EQ(h.GetAverageLength(Outcome::BlackWin), 6.0);
+    EXPECT_EQ(h.GetRatingGaps()[GameHistograms::GapBinOf(200)].blackWins, 30u);
+    EXPECT_EQ(h.GetRatingGaps()[GameHistograms::GapBinOf(100)].draws, 30u);
+    EXPECT_EQ(parallel.GetGames()[1].GetPlyCount(), 4);
+    for (int o = 0; o < GameHistograms::kOutcomes; ++o) {
+        EXPECT_EQ(h.GetLengthHistogram(static_cast<Outcome>(o)),
+                  serial.GetStats().GetHistograms().GetLengthHistogram(static_cast<Outcome>(o)));
+    }
+    for (int b = 0; b < GameHistograms::kGapBins; ++b) {
+        EXPECT_EQ(h.GetRatingGaps()[b].expectedMicros,
+                  serial.GetStats().GetHistograms().GetRatingGaps()[b].expectedMicros);
+    }
+
+    const fs::path snapshot = dir / "games.snapshot";
+    ASSERT_TRUE(StatsSnapshot::Save(snapshot.string(), FileIdentity(), parallel.GetStats()));
+    FileIdentity identity;
+    DatabaseStats loaded;
+    ASSERT_TRUE(StatsSnapshot::Load(snapshot.string(), identity, loaded));
+    EXPECT_EQ(loaded.GetHistograms().GetLengthHistogram(), h.GetLengthHistogram());
+    EXPECT_EQ(loaded.GetHistograms().GetPlySum(Outcome::Draw), 120u);
+    EXPECT_EQ(loaded.GetHistograms().GetRatingGaps()[GameHistograms::GapBinOf(0)].whiteWins, 30u);
+
+    fs::remove_all(dir);
+}
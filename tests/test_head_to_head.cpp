@@ -0,0 +1,54 @@
+#include "headToHead.hpp"
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+using namespace chessDataLib;
+
+TEST(HeadToHead, RecordsAreOrientedPerPlayer) {
+    HeadToHead h2h;
+    h2h.AddGame("A", "B", "1-0");
+    h2h.AddGame("B", "A", "1-0");
+    h2h.AddGame("B", "A", "1/2-1/2");
+    h2h.AddGame("A", "C", "0-1");
+
+    PairRecord r;
+    ASSERT_TRUE(h2h.GetRecord("A", "B", r));
+    EXPECT_EQ(r.games, 3u);
+    EXPECT_EQ(r.wins, 1u);
+    EXPECT_EQ(r.losses, 1u);
+    EXPECT_DOUBLE_EQ(r.GetScore(), 1.5);
+    ASSERT_TRUE(h2h.GetRecord("C", "A", r));
+    EXPECT_EQ(r.wins, 1u);
+    EXPECT_FALSE(h2h.GetRecord("B", "C", r));
+    EXPECT_EQ(h2h.GetPairCount(), 2u);
+}
+
+TEST(HeadToHead, MergeRemapsIdsAndBuildsMatrix) {
+    HeadToHead first, second;
+    first.AddGame("A", "B", "1-0");
+    second.AddGame("C", "B", "1/2-1/2");
+    second.AddGame("B", "A", "0-1");
+    first.MergeWith(second);
+
+    PairRecord r;
+    ASSERT_TRUE(first.GetRecord("A", "B", r));
+    EXPECT_EQ(r.wins, 2u);
+
+    HeadToHead::Matrix m = first.BuildMatrix({"A", "B", "C", "Nobody"}, 2);
+    ASSERT_EQ(m.Size(), 4u);
+    EXPECT_FLOAT_EQ(m.scores[0 * 4 + 1], 2.0f);
+    EXPECT_FLOAT_EQ(m.scores[1 * 4 + 0], 0.0f);
+    EXPECT_EQ(m.games[1 * 4 + 0], 2u);
+    EXPECT_FLOAT_EQ(m.scores[2 * 4 + 1], 0.5f);
+    EXPECT_EQ(m.games[3 * 4 + 0], 0u);
+
+    const std::string path = ::testing::TempDir() + "h2h.csv";
+    ASSERT_TRUE(first.ExportCrosstableCSV(path, {"A", "B", "C"}));
+    std::ifstream in(path);
+    std::stringstream content;
+    content << in.rdbuf();
+    EXPECT_EQ(content.str(), "Player,A,B,C\nA,,2/2,\nB,0/2,,0.5/1\nC,,0.5/1,\n");
+    std::remove(path.c_str());
+}
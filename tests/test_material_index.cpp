@@ -0,0 +1,140 @@
+#include "materialIndex.hpp"
+#include "parser.hpp"
+#include <gtest/gtest.h>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+using namespace chessDataLib;
+namespace fs = std::filesystem;
+
+namespace {
+
+Board FromFen(const char* fen) {
+    Board board;
+    EXPECT_TRUE(board.SetFen(fen, fen + std::strlen(fen)));
+    return board;
+}
+
+// Resolve SAN moves from a position into packed moves
+std::vector<PackedMove> Pack(Board board, std::initializer_list<const char*> sans) {
+    std::vector<PackedMove> packed;
+    for (const char* san : sans) {
+        Move move;
+        EXPECT_EQ(board.ParseSan(san, san + std::strlen(san), move), SanStatus::Ok) << san;
+        packed.push_back(Board::Pack(move));
+        board.MakeMove(move);
+    }
+    return packed;
+}
+
+} // namespace
+
+TEST(MaterialIndex, SignaturesCountPiecesAndBishopColors) {
+    const MaterialKey start = MaterialIndex::KeyOf(Board());
+    EXPECT_EQ(MaterialIndex::ToString(start), "KQRRBBNNPPPPPPPPvKQRRBBNNPPPPPPPP");
+    EXPECT_EQ(MaterialIndex::Count(start, White, Pawn), 8);
+    EXPECT_EQ(MaterialIndex::BishopCount(start, Black, true), 1);
+    EXPECT_EQ(MaterialIndex::Mirror(start), start);
+
+    const MaterialKey ocb = MaterialIndex::KeyOf(FromFen("4k3/8/3b4/8/8/8/4B3/4K3 w - - 0 1"));
+    EXPECT_TRUE(MaterialIndex::IsOppositeColoredBishops(ocb));
+    const MaterialKey same = MaterialIndex::KeyOf(FromFen("4k3/8/4b3/8/8/8/4B3/4K3 w - - 0 1"));
+    EXPECT_FALSE(MaterialIndex::IsOppositeColoredBishops(same));
+
+    MaterialKey parsed;
+    ASSERT_TRUE(MaterialIndex::ParseSignature("KBvKB", parsed));
+    EXPECT_EQ(MaterialIndex::Normalize(ocb), parsed);
+    EXPECT_EQ(MaterialIndex::Normalize(same), parsed);
+    EXPECT_FALSE(MaterialIndex::ParseSignature("KRP", parsed));
+    EXPECT_FALSE(MaterialIndex::ParseSignature("RvK", parsed));
+    EXPECT_FALSE(MaterialIndex::ParseSignature("KXvK", parsed));
+}
+
+TEST(MaterialIndex, PostsPlyRangesPerSignature) {
+    // R+P vs R+P: Black takes on b3 at ply 2, White takes on d4 at ply 3
+    const Board rook = FromFen("4k3/8/8/8/3p4/1P6/1r6/R3K3 w - - 0 1");
+    const auto rookMoves = Pack(rook, {"Ra4", "Rxb3", "Rxd4"});
+
+    MaterialIndex index;
+    index.AddGame(0, rook, {rookMoves.data(), rookMoves.size()});
+    MaterialIndex other;
+    other.AddGame(0, FromFen("4k3/8/3b4/8/8/8/4B3/4K3 w - - 0 1"), {});
+    index.MergeWith(other, 1);
+    index.Finalize();
+    EXPECT_EQ(index.GetPostingCount(), 4u);
+
+    MaterialKey key;
+    ASSERT_TRUE(MaterialIndex::ParseSignature("KRPvKRP", key));
+    const auto before = index.Find(key);
+    ASSERT_EQ(before.size, 1u);
+    EXPECT_EQ(before.data[0].game, 0u);
+    EXPECT_EQ(before.data[0].firstPly, 0);
+    EXPECT_EQ(before.data[0].lastPly, 1);
+
+    const auto rpr = index.FindSignature("KRvKRP");
+    ASSERT_EQ(rpr.size(), 1u);
+    EXPECT_EQ(rpr[0].firstPly, 2);
+    EXPECT_EQ(rpr[0].lastPly, 2);
+    EXPECT_TRUE(index.FindSignature("KRPvKR", false).empty());
+    EXPECT_EQ(index.FindSignature("KRPvKR", true).size(), 1u);
+
+    const auto rr = index.FindSignature("KRvKR");
+    ASSERT_EQ(rr.size(), 1u);
+    EXPECT_EQ(rr[0].firstPly, 3);
+    EXPECT_EQ(rr[0].lastPly, 3);
+
+    const auto bishops = index.FindOppositeColoredBishops(false);
+    ASSERT_EQ(bishops.size(), 1u);
+    EXPECT_EQ(bishops[0].game, 1u);
+}
+
+TEST(MaterialIndex, ParserIndexesLoadedGames) {
+    const fs::path dir = fs::temp_directory_path() / "chessDataLib_material";
+    fs::create_directories(dir);
+    const fs::path path = dir / "games.pgn";
+    {
+        std::ofstream out(path, std::ios::binary);
+        for (int i = 0; i < 50; ++i) {
+            out << "[White \"A\"]\n[Black \"B\"]\n[Result \"1/2-1/2\"]\n\n1. e4 d5 2. exd5 Qxd5 1/2-1/2\n\n";
+            out << "[White \"A\"]\n[Black \"B\"]\n[Result \"1/2-1/2\"]\n"
+                   "[FEN \"4k3/8/3b4/8/8/8/4BP2/4K3 w - - 0 1\"]\n\n1. f4 Bxf4 1/2-1/2\n\n";
+        }
+    }
+
+    Parser parser;
+    parser.SetThreadCount(4);
+    parser.SetChunkSize(512);
+    parser.SetIndexMaterial(true);
+    ASSERT_TRUE(parser.LoadFile(path.string()));
+    const MaterialIndex& index = parser.GetMaterialIndex();
+
+    const auto ocb = index.FindOppositeColoredBishops(false);
+    ASSERT_EQ(ocb.size(), 50u);
+    for (std::size_t i = 0; i < ocb.size(); ++i) {
+        EXPECT_EQ(ocb[i].game, 2 * i + 1);
+        EXPECT_EQ(ocb[i].firstPly, 2);
+        EXPECT_EQ(parser.GetGames()[ocb[i].game].GetMoveCount(), 1);
+    }
+
+    // Both sides lose a pawn in the Scandinavian
+    EXPECT_EQ(index.FindSignature("KQRRBBNNPPPPPPPvKQRRBBNNPPPPPPP").size(), 50u);
+    EXPECT_FALSE(parser.GetGames()[0].HasMoves());
+    fs::remove_all(dir);
+}
+
+TEST(MaterialIndex, IndexesMovesAfterRestOfLineComments) {
+    const fs::path dir = fs::temp_directory_path() / "chessDataLib_material_comments";
+    fs::create_directories(dir);
+    const fs::path path = dir / "games.pgn";
+    std::ofstream(path, std::ios::binary) << "[White \"A\"]\n[Black \"B\"]\n[Result \"1/2-1/2\"]\n\n"
+                                             "1. e4 d5 ; Scandinavian\n2. exd5 Qxd5 1/2-1/2\n\n";
+
+    Parser parser;
+    parser.SetIndexMaterial(true);
+    ASSERT_TRUE(parser.LoadFile(path.string()));
+    const auto postings = parser.GetMaterialIndex().FindSignature("KQRRBBNNPPPPPPPvKQRRBBNNPPPPPPP");
+    ASSERT_EQ(postings.size(), 1u);
+    EXPECT_EQ(postings[0].firstPly, 4);
+    fs::remove_all(dir);
+}
@@ -0,0 +1,37 @@
+#include "memoryReport.hpp"
+#include "parser.hpp"
+#include "player.hpp"
+#include <gtest/gtest.h>
+
+using namespace chessDataLib;
+
+TEST(MemoryReport, StringHeapVersusSSO) {
+    MemoryUsage u;
+    utils::AccountString("short", u);
+    utils::AccountString(std::string(200, 'x'), u);
+    EXPECT_EQ(u.ssoStrings, 1u);
+    EXPECT_EQ(u.heapStrings, 1u);
+    EXPECT_GE(u.stringHeapBytes, 201u);
+}
+
+TEST(MemoryReport, PlayerCountsOpeningsAndOpponents) {
+    Player p;
+    p.SetName("Some Rather Long Player Name, Grandmaster");
+    p.AddOpponent("Opponent");
+    p.IncrementOpening("B90");
+    p.IncrementOpening("C42");
+    MemoryUsage u = p.GetMemoryUsage();
+    EXPECT_EQ(u.hashElements, 2u);
+    EXPECT_GT(u.hashBuckets, 0u);
+    EXPECT_GT(u.containerBytes, 0u);
+    EXPECT_EQ(u.heapStrings, 1u);
+}
+
+TEST(MemoryReport, EmptyParserHasAllComponents) {
+    Parser parser;
+    MemoryReport report = parser.GetMemoryReport();
+    ASSERT_EQ(report.GetComponents().size(), 4u);
+    EXPECT_EQ(report.GetComponents()[0].name, "games");
+    EXPECT_GE(report.GetTotal().TotalBytes(), sizeof(DatabaseStats));
+    EXPECT_NE(report.ToString().find("total"), std::string::npos);
+}
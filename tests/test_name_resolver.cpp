@@ -0,0 +1,218 @@
+#include "playerNameResolver.hpp"
+#include "parser.hpp"
+#include "utils/editDistance.hpp"
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <fstream>
+#include <random>
+
+using namespace chessDataLib;
+namespace fs = std::filesystem;
+
+TEST(EditDistance, BitParallelMatchesDynamicProgramming) {
+    EXPECT_EQ(utils::EditDistance("kitten", "sitting"), 3);
+    EXPECT_EQ(utils::EditDistance("", "abc"), 3);
+    EXPECT_EQ(utils::EditDistance("carlsen, magnus", "carlsen, magnsu"), 2);
+    EXPECT_EQ(utils::EditDistance("kitten", "sitting", 1), 2);
+
+    // Random strings over a small alphabet, against a plain DP; lengths
+    // straddle the 64-byte word of the bit-parallel matcher
+    std::mt19937 rng(7);
+    const auto randomString = [&rng](std::size_t length) {
+        std::string s(length, 'a');
+        for (char& c : s) c = static_cast<char>('a' + rng() % 4);
+        return s;
+    };
+    const auto reference = [](const std::string& a, const std::string& b) {
+        std::vector<std::vector<int>> d(a.size() + 1, std::vector<int>(b.size() + 1));
+        for (std::size_t i = 0; i <= a.size(); ++i) d[i][0] = static_cast<int>(i);
+        for (std::size_t j = 0; j <= b.size(); ++j) d[0][j] = static_cast<int>(j);
+        for (std::size_t i = 1; i <= a.size(); ++i) {
+            for (std::size_t j = 1; j <= b.size(); ++j) {
+                d[i][j] = std::min({d[i - 1][j] + 1, d[i][j - 1] + 1, d[i - 1][j - 1] + (a[i - 1] != b[j - 1])});
+            }
+        }
+        return d[a.size()][b.size()];
+    };
+    for (int round = 0; round < 300; ++round) {
+        const std::string a = randomString(rng() % 80);
+        const std::string b = randomString(rng() % 80);
+        const int expected = reference(a, b);
+        EXPECT_EQ(utils::EditDistanceMatcher(a).Distance(b, 1000), expected) << a << " / " << b;
+        EXPECT_EQ(utils::EditDistance(a, b, 5), std::min(expected, 6)) << a << " / " << b;
+    }
+}
+
+TEST(PlayerNameResolver, NormalizesSpellings) {
+    EXPECT_EQ(PlayerNameResolver::Normalize("Carlsen, Magnus"), "carlsen, magnus");
+    EXPECT_EQ(PlayerNameResolver::Normalize("Magnus Carlsen"), "carlsen, magnus");
+    EXPECT_EQ(PlayerNameResolver::Normalize("  CARLSEN,Magnus. "), "carlsen, magnus");
+    EXPECT_EQ(PlayerNameResolver::Normalize("Carlsen,M"), "carlsen, m");
+    EXPECT_EQ(PlayerNameResolver::Normalize("Carlsen M."), "carlsen, m");
+    EXPECT_EQ(PlayerNameResolver::Normalize("Vachier-Lagrave, Maxime"), "vachier lagrave, maxime");
+    EXPECT_EQ(PlayerNameResolver::Normalize("Jan van der Wiel"), "van der wiel, jan");
+    EXPECT_EQ(PlayerNameResolver::Normalize("Nepomniachtchi"), "nepomniachtchi");
+    EXPECT_EQ(PlayerNameResolver::Normalize("Dubov, Daniil"), "dubov, daniil");
+    EXPECT_EQ(PlayerNameResolver::Normalize("O'Kelly de Galway, Alberic"), "okelly de galway, alberic");
+    // UTF-8 Latin accents fold to ASCII
+    EXPECT_EQ(PlayerNameResolver::Normalize("H\xC3\xBC" "bner, Robert"), "hubner, robert");
+    EXPECT_EQ(PlayerNameResolver::Normalize("Ragger, Markus \xC5\xA0"), "ragger, markus s");
+}
+
+TEST(PlayerNameResolver, ResolvesAliasesInitialsAndTypos) {
+    PlayerNameResolver resolver;
+    resolver.AddCanonical("Carlsen, Magnus");
+    resolver.AddCanonical("Caruana, Fabiano");
+    resolver.AddCanonical("Nakamura, Hikaru");
+    resolver.AddCanonical("Polgar, Judit");
+    resolver.AddCanonical("Polgar, Susan");
+    resolver.AddAlias("DrNykterstein", "Carlsen, Magnus");
+    resolver.Build();
+    EXPECT_EQ(resolver.GetCanonicalCount(), 5u);
+
+    using Kind = PlayerNameResolver::MatchKind;
+    const auto check = [&resolver](const char* name, Kind kind, const char* canonical) {
+        const PlayerNameResolver::Match match = resolver.Resolve(name);
+        EXPECT_EQ(match.kind, kind) << name;
+        EXPECT_EQ(match.canonical, canonical) << name;
+    };
+    check("Carlsen, Magnus", Kind::Exact, "Carlsen, Magnus");
+    check("DrNykterstein", Kind::Alias, "Carlsen, Magnus");
+    check("drnykterstein", Kind::Alias, "Carlsen, Magnus");
+    check("Magnus Carlsen", Kind::Normalized, "Carlsen, Magnus");
+    check("Carlsen Magnus", Kind::Normalized, "Carlsen, Magnus");
+    check("Carlsen,M", Kind::Initials, "Carlsen, Magnus");
+    check("H. Nakamura", Kind::Initials, "Nakamura, Hikaru");
+    check("Caruana, Fabaino", Kind::Fuzzy, "Caruana, Fabiano");
+    check("Nakamura, Hikar", Kind::Fuzzy, "Nakamura, Hikaru");
+
+    // Ambiguous or too far: left unresolved
+    check("Polgar, J", Kind::Initials, "Polgar, Judit");
+    check("Polgar", Kind::None, "");
+    check("Polgar, Judan", Kind::None, "");
+    check("Kasparov, Garry", Kind::None, "");
+    check("Caruna, Fbaino", Kind::None, "");
+
+    const auto suggestions = resolver.Suggest("Polgar, Judan");
+    ASSERT_EQ(suggestions.size(), 2u);
+    EXPECT_EQ(suggestions[0].canonical, "Polgar, Judit");
+    EXPECT_EQ(suggestions[0].distance, 2);
+    EXPECT_EQ(suggestions[1].canonical, "Polgar, Susan");
+
+    const auto all = resolver.ResolveAll({"Magnus Carlsen", "Kasparov, Garry", "Carlsen,M"}, 2);
+    ASSERT_EQ(all.size(), 3u);
+    EXPECT_EQ(all[0].canonical, "Carlsen, Magnus");
+    EXPECT_FALSE(all[1].IsResolved());
+    EXPECT_EQ(all[2].canonical, "Carlsen, Magnus");
+
+    resolver.SetMaxDistance(0);
+    check("Caruana, Fabaino", Kind::None, "");
+}
+
+TEST(PlayerNameResolver, LoadsAliasTableAndMergesParserPlayers) {
+    const fs::path dir = fs::temp_directory_path() / "chessDataLib_names";
+    fs::create_directories(dir);
+    const fs::path aliases = dir / "aliases.tsv";
+    {
+        std::ofstream out(aliases, std::ios::binary);
+        out << "# alias<TAB>canonical\r\n"
+            << "Magnus C.\tCarlsen, Magnus\r\n"
+            << "\r\n"
+            << "no tab on this line\n";
+    }
+    const fs::path pgn = dir / "games.pgn";
+    {
+        std::ofstream out(pgn, std::ios::binary);
+        const char* games[][3] = {{"Carlsen, Magnus", "Caruana, Fabiano", "1-0"},
+                                  {"Magnus Carlsen", "Caruana,F", "1/2-1/2"},
+                                  {"Magnus C.", "Caruana, Fabaino", "0-1"},
+                                  {"Carlsen,M", "Someone, Else", "1-0"}};
+        for (const auto& g : games) {
+            out << "[Event \"Test\"]\n[White \"" << g[0] << "\"]\n[Black \"" << g[1] << "\"]\n[Result \"" << g[2]
+                << "\"]\n\n1. e4 e5 " << g[2] << "\n\n";
+        }
+    }
+
+    PlayerNameResolver resolver;
+    EXPECT_FALSE(resolver.LoadAliases((dir / "missing.tsv").string()));
+    ASSERT_TRUE(resolver.LoadAliases(aliases.string()));
+    resolver.AddCanonical("Caruana, Fabiano");
+    resolver.Build();
+    EXPECT_EQ(resolver.Resolve("Magnus C.").kind, PlayerNameResolver::MatchKind::Alias);
+    EXPECT_GT(resolver.GetMemoryUsage().TotalBytes(), 0u);
+
+    Parser parser;
+    ASSERT_TRUE(parser.LoadFile(pgn.string()));
+    EXPECT_EQ(parser.GetPlayerStats().size(), 8u);
+    EXPECT_EQ(parser.ResolvePlayerNames(resolver), 5u);
+
+    const auto& players = parser.GetPlayerStats();
+    ASSERT_EQ(players.size(), 3u);
+    const Player& carlsen = players.at("Carlsen, Magnus");
+    EXPECT_EQ(carlsen.GetName(), "Carlsen, Magnus");
+    EXPECT_EQ(carlsen.GetTotalGames(), 4);
+    EXPECT_EQ(carlsen.GetWinsCount(), 2);
+    EXPECT_EQ(carlsen.GetDrawCount(), 1);
+    EXPECT_EQ(carlsen.GetLossCount(), 1);
+    EXPECT_EQ(players.at("Caruana, Fabiano").GetTotalGames(), 3);
+    EXPECT_EQ(parser.GetStats().GetUniquePlayers(), 3);
+    EXPECT_EQ(parser.GetStats().GetMostActivePlayer(), "Carlsen, Magnus");
+    EXPECT_EQ(parser.ResolvePlayerNames(resolver), 0u);
+
+    fs::remove_all(dir);
+}
+
+TEST(PlayerNameResolver, ResolvedNamesReachEveryPerPlayerTable) {
+    const fs::path dir = fs::temp_directory_path() / "chessDataLib_names_tables";
+    fs::create_directories(dir);
+    const fs::path pgn = dir / "games.pgn";
+    {
+        std::ofstream out(pgn, std::ios::binary);
+        const char* games[][4] = {{"Carlsen, Magnus", "Caruana, Fabiano", "1-0", "2019"},
+                                  {"Caruana,F", "Carlsen,M", "1/2-1/2", "2020"},
+                                  {"Carlsen,M", "Caruana, Fabiano", "0-1", "2021"}};
+        for (const auto& g : games) {
+            out << "[Event \"Match\"]\n[Date \"" << g[3] << ".01.01\"]\n[White \"" << g[0] << "\"]\n[Black \""
+                << g[1] << "\"]\n[Result \"" << g[2] << "\"]\n\n1. e4 e5 " << g[2] << "\n\n";
+        }
+    }
+
+    PlayerNameResolver resolver;
+    resolver.AddCanonical("Carlsen, Magnus");
+    resolver.AddCanonical("Caruana, Fabiano");
+    resolver.Build();
+
+    Parser parser;
+    parser.SetTimeSeriesRange(2019, 3);
+    ASSERT_TRUE(parser.LoadFile(pgn.string()));
+    EXPECT_EQ(parser.ResolvePlayerNames(resolver), 2u);
+
+    // Head-to-head agrees with the player stats: 1 win, 1 draw, 1 loss
+    PairRecord record;
+    ASSERT_TRUE(parser.GetHeadToHead().GetRecord("Carlsen, Magnus", "Caruana, Fabiano", record));
+    EXPECT_EQ(record.games, 3u);
+    EXPECT_EQ(record.wins, 1u);
+    EXPECT_EQ(record.draws, 1u);
+    EXPECT_EQ(record.losses, 1u);
+    EXPECT_FALSE(parser.GetHeadToHead().GetRecord("Carlsen,M", "Caruana,F", record));
+    EXPECT_EQ(parser.GetHeadToHead().GetPlayerCount(), 2u);
+
+    const std::vector<TimeBucketTotals> series = parser.GetTimeSeriesStats().GetPlayerSeries("Carlsen, Magnus");
+    ASSERT_EQ(series.size(), 3u);
+    std::uint64_t games = 0;
+    for (const TimeBucketTotals& t : series) games += t.games;
+    EXPECT_EQ(games, static_cast<std::uint64_t>(parser.GetPlayerStats().at("Carlsen, Magnus").GetTotalGames()));
+    EXPECT_EQ(series[1].draws, 1u);
+    EXPECT_EQ(parser.GetTimeSeriesStats().GetPlayerCount(), 2u);
+
+    const Tournament& match = parser.GetTournaments().at("Match");
+    EXPECT_EQ(match.GetUniquePlayers(), 2);
+    EXPECT_EQ(match.GetPlayerGameCount().at("Carlsen, Magnus"), 3);
+    const std::vector<TournamentStanding> standings = match.ComputeStandings();
+    ASSERT_EQ(standings.size(), 2u);
+    EXPECT_DOUBLE_EQ(standings[0].score, 1.5);
+    EXPECT_EQ(standings[0].games, 3);
+    EXPECT_EQ(parser.GetStats().GetTournaments().at("Match").GetUniquePlayers(), 2);
+
+    fs::remove_all(dir);
+}
@@ -0,0 +1,89 @@
+#include "openingStats.hpp"
+#include <gtest/gtest.h>
+
+using namespace chessDataLib;
+
+TEST(OpeningStats, EcoSlots) {
+    EXPECT_EQ(OpeningStats::EcoIndex("A00"), 0);
+    EXPECT_EQ(OpeningStats::EcoIndex("B90"), 190);
+    EXPECT_EQ(OpeningStats::EcoIndex("E99"), 499);
+    EXPECT_EQ(OpeningStats::EcoIndex("F00"), -1);
+    EXPECT_EQ(OpeningStats::EcoIndex("?"), -1);
+    EXPECT_EQ(OpeningStats::EcoCode(190), "B90");
+}
+
+TEST(OpeningStats, SlicesByEcoRatingAndYear) {
+    OpeningStats stats(2000, 20);
+    stats.AddGame("B90", "1-0", 2500, 2450, 2010);
+    stats.AddGame("B90", "1/2-1/2", 2600, 2300, 2011);
+    stats.AddGame("B91", "0-1", 0, 2400, 0);
+    stats.AddGame("C42", "1-0", 1800, 1900, 2015);
+    stats.AddGame("", "1-0", 1800, 1900, 2015);
+
+    OpeningQuery sicilian;
+    sicilian.ecoFirst = "B20";
+    sicilian.ecoLast = "B99";
+    OpeningTotals all = stats.Slice(sicilian);
+    EXPECT_EQ(all.games, 3u);
+    EXPECT_EQ(all.ratedGames, 2u);
+
+    sicilian.minElo = 2400;
+    OpeningTotals strong = stats.Slice(sicilian);
+    EXPECT_EQ(strong.games, 1u);
+    EXPECT_DOUBLE_EQ(strong.GetWhiteScorePercentage(), 100.0);
+    EXPECT_DOUBLE_EQ(strong.GetAverageWhiteElo(), 2500.0);
+
+    OpeningQuery year;
+    year.yearFirst = 2011;
+    year.yearLast = 2015;
+    EXPECT_EQ(stats.Slice(year).games, 2u);
+    EXPECT_EQ(stats.Slice(OpeningQuery()).games, 4u);
+    EXPECT_EQ(stats.GetUnclassifiedGames(), 1u);
+    EXPECT_EQ(stats.GetUndatedGames(), 1u);
+
+    OpeningStats other(2000, 20);
+    other.AddGame("C42", "0-1", 1800, 1900, 2015);
+    ASSERT_TRUE(stats.MergeWith(other));
+    auto perEco = stats.SliceByEco(OpeningQuery());
+    EXPECT_EQ(perEco[OpeningStats::EcoIndex("C42")].games, 2u);
+    EXPECT_EQ(perEco[OpeningStats::EcoIndex("C42")].blackWins, 1u);
+    EXPECT_FALSE(stats.MergeWith(OpeningStats()));
+
+    // Without a year dimension a year filter selects nothing, not everything
+    OpeningStats undated;
+    undated.AddGame("B90", "1-0", 2500, 2450, 2010);
+    EXPECT_EQ(undated.Slice(OpeningQuery()).games, 1u);
+    EXPECT_EQ(undated.Slice(year).games, 0u);
+    EXPECT_EQ(undated.SliceByEco(year)[OpeningStats::EcoIndex("B90")].games, 0u);
+}
+
+TEST(OpeningStats, RatingBoundsCountWholeBandsAndOpenYearRange) {
+    OpeningStats stats(2000, 20);
+    stats.AddGame("B90", "1-0", 2420, 2410, 2005);  // band 2400-2599
+    stats.AddGame("B90", "1-0", 2390, 2500, 2010);  // band 2200-2399
+    stats.AddGame("B90", "1-0", 2610, 2650, 2015);  // band 2600-2799
+
+    OpeningQuery q;
+    q.minElo = 2400;
+    q.maxElo = 2599;
+    EXPECT_EQ(stats.Slice(q).games, 1u);
+
+    // Non-multiples never admit games outside the bounds
+    q.minElo = 2450;
+    q.maxElo = 0;
+    EXPECT_EQ(stats.Slice(q).games, 1u);  // only the 2600 band
+    q.minElo = 0;
+    q.maxElo = 2400;
+    EXPECT_EQ(stats.Slice(q).games, 1u);  // up to 2399
+    q.minElo = 2400;
+    q.maxElo = 2400;
+    EXPECT_EQ(stats.Slice(q).games, 0u);
+
+    // yearLast 0 leaves the range open at the top
+    OpeningQuery since;
+    since.yearFirst = 2010;
+    EXPECT_EQ(stats.Slice(since).games, 2u);
+    OpeningQuery until;
+    until.yearLast = 2010;
+    EXPECT_EQ(stats.Slice(until).games, 2u);
+}
@@ -0,0 +1,458 @@
+#include "parser.hpp"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <thread>
+
+using namespace chessDataLib;
+namespace fs = std::filesystem;
+
+namespace {
+
+std::string MakeGame(int i) {
+    const char* results[] = {"1-0", "0-1", "1/2-1/2"};
+    std::string white = "Player" + std::to_string(i % 7);
+    std::string black = "Player" + std::to_string((i + 3) % 7);
+    std::string result = results[i % 3];
+    return "[Event \"Event" + std::to_string(i % 4) + "\"]\n"
+           "[White \"" + white + "\"]\n"
+           "[Black \"" + black + "\"]\n"
+           "[Result \"" + result + "\"]\n"
+           "\n"
+           "1. e4 e5 2. Nf3 Nc6\r\n3. Bb5 a6 " + result + "\n\n";
+}
+
+fs::path WriteFixture(const fs::path& dir, const std::string& name, int first, int count) {
+    fs::path path = dir / name;
+    std::ofstream out(path, std::ios::binary);
+    for (int i = first; i < first + count; ++i) out << MakeGame(i);
+    return path;
+}
+
+class ParserIntegration : public ::testing::Test {
+protected:
+    void SetUp() override {
+        dir = fs::temp_directory_path() / ("chessDataLib_parser_" + std::to_string(::testing::UnitTest::GetInstance()->random_seed()));
+        fs::create_directories(dir);
+        big = WriteFixture(dir, "big.pgn", 0, 300);
+        small = WriteFixture(dir, "small.pgn", 300, 5);
+        std::ofstream(dir / "notes.txt") << "not a pgn\n";
+    }
+    void TearDown() override { fs::remove_all(dir); }
+
+    fs::path dir, big, small;
+};
+
+} // namespace
+
+TEST_F(ParserIntegration, LoadFileParsesGames) {
+    Parser parser;
+    ASSERT_TRUE(parser.LoadFile(small.string()));
+    ASSERT_EQ(parser.GetGames().size(), 5u);
+    EXPECT_EQ(parser.GetGames()[0].GetWhite(), "Player6");
+    EXPECT_EQ(parser.GetGames()[0].GetMoveCount(), 3);
+    EXPECT_EQ(parser.GetStats().GetTotalGames(), 5);
+}
+
+TEST_F(ParserIntegration, ChunkedParallelLoadMatchesSequential) {
+    Parser sequential;
+    sequential.SetThreadCount(1);
+    ASSERT_TRUE(sequential.LoadFiles({big.string(), small.string()}));
+
+    Parser parallel;
+    parallel.SetThreadCount(4);
+    parallel.SetChunkSize(1024);
+    ASSERT_TRUE(parallel.LoadFiles({big.string(), small.string()}));
+
+    ASSERT_EQ(parallel.GetGames().size(), 305u);
+    for (std::size_t i = 0; i < parallel.GetGames().size(); ++i) {
+        EXPECT_EQ(parallel.GetGames()[i].GetWhite(), sequential.GetGames()[i].GetWhite());
+    }
+    const auto& a = sequential.GetStats();
+    const auto& b = parallel.GetStats();
+    EXPECT_EQ(a.GetWhiteWins(), b.GetWhiteWins());
+    EXPECT_EQ(a.GetDraws(), b.GetDraws());
+    EXPECT_EQ(b.GetUniquePlayers(), 7);
+    EXPECT_EQ(b.GetUniqueTournaments(), 4);
+    for (const auto& kv : sequential.GetPlayerStats()) {
+        EXPECT_EQ(parallel.GetPlayerStats().at(kv.first).GetTotalGames(), kv.second.GetTotalGames());
+    }
+    EXPECT_EQ(parallel.GetTournaments().at("Event0").GetTotalGames(), 77);
+}
+
+TEST_F(ParserIntegration, LoadDirectoryUsesPattern) {
+    Parser parser;
+    int lastPercent = -1;
+    ASSERT_TRUE(parser.LoadDirectory(dir.string(), "*.pgn", [&](int percent, const std::string&) {
+        lastPercent = percent;
+    }));
+    EXPECT_EQ(parser.GetGames().size(), 305u);
+    EXPECT_EQ(lastPercent, 100);
+    EXPECT_FALSE(parser.LoadFile((dir / "missing.pgn").string()));
+}
+
+TEST_F(ParserIntegration, SnapshotCacheReturnsStatsForUnchangedFile) {
+    const fs::path cacheDir = dir / "cache";
+    const DatabaseStats fresh = Parser::AnalyzeFile(big.string());
+
+    {
+        StatsSnapshotCache cache(cacheDir.string());
+        Parser::AnalyzeFile(big.string(), cache);
+        EXPECT_EQ(cache.GetMisses(), 1u);
+    }
+
+    // A new cache instance must pick the snapshot up from disk
+    StatsSnapshotCache cache(cacheDir.string());
+    const DatabaseStats cached = Parser::AnalyzeFile(big.string(), cache);
+    EXPECT_EQ(cache.GetHits(), 1u);
+    EXPECT_EQ(cached.GetTotalGames(), fresh.GetTotalGames());
+    EXPECT_EQ(cached.GetDraws(), fresh.GetDraws());
+    EXPECT_EQ(cached.GetMostActivePlayer(), fresh.GetMostActivePlayer());
+    EXPECT_EQ(cached.GetPlayerStats().at("Player1").GetWinsCount(),
+              fresh.GetPlayerStats().at("Player1").GetWinsCount());
+    EXPECT_EQ(cached.GetTournaments().at("Event2").GetUniquePlayers(),
+              fresh.GetTournaments().at("Event2").GetUniquePlayers());
+
+    // Appending a game changes the identity and forces a re-parse
+    std::ofstream(big, std::ios::app | std::ios::binary) << MakeGame(999);
+    const DatabaseStats updated = Parser::AnalyzeFile(big.string(), cache);
+    EXPECT_EQ(updated.GetTotalGames(), fresh.GetTotalGames() + 1);
+    EXPECT_EQ(cache.GetMisses(), 1u);
+}
+
+TEST_F(ParserIntegration, SnapshotCacheSkipsFilesChangedDuringParse) {
+    // Append a game once parsing is done but before the cache stores the stats
+    StatsSnapshotCache cache;
+    bool appended = false;
+    Parser::AnalyzeFile(big.string(), cache, [&](int percent, const std::string&) {
+        if (percent == 100 && !appended) {
+            std::ofstream(big, std::ios::app | std::ios::binary) << MakeGame(999);
+            appended = true;
+        }
+    });
+    ASSERT_TRUE(appended);
+
+    const DatabaseStats after = Parser::AnalyzeFile(big.string(), cache);
+    EXPECT_EQ(cache.GetHits(), 0u);
+    EXPECT_EQ(after.GetTotalGames(), 301);
+}
+
+TEST_F(ParserIntegration, IndexedRandomAccess) {
+    Parser parser;
+    ASSERT_TRUE(parser.OpenIndexed(big.string()));
+    ASSERT_EQ(parser.GetIndexedGameCount(), 300u);
+    EXPECT_TRUE(fs::exists(GameIndex::SidecarPath(big.string())));
+
+    Game game;
+    ASSERT_TRUE(parser.GetGameAt(123, game));
+    EXPECT_EQ(game.GetWhite(), "Player" + std::to_string(123 % 7));
+    EXPECT_EQ(game.GetEvent(), "Event3");
+    EXPECT_FALSE(parser.GetGameAt(300, game));
+
+    auto page = parser.ReadGames(295, 10);
+    ASSERT_EQ(page.size(), 5u);
+    EXPECT_EQ(page.back().GetBlack(), "Player" + std::to_string((299 + 3) % 7));
+
+    // Second open must come from the sidecar and agree with a fresh scan
+    GameIndex fromSidecar;
+    ASSERT_TRUE(fromSidecar.Load(GameIndex::SidecarPath(big.string())));
+    GameIndex scanned;
+    ASSERT_TRUE(scanned.Build(big.string()));
+    ASSERT_EQ(fromSidecar.Size(), scanned.Size());
+    EXPECT_EQ(fromSidecar.At(299).offset, scanned.At(299).offset);
+    EXPECT_EQ(fromSidecar.At(299).length, scanned.At(299).length);
+}
+
+TEST_F(ParserIntegration, LazyMoveTextFromSource) {
+    Parser parser;
+    parser.SetMoveListCacheSize(16);
+    ASSERT_TRUE(parser.LoadFile(small.string()));
+    const Game game = parser.GetGames()[2];
+    ASSERT_TRUE(game.HasMoveText());
+    EXPECT_EQ(sizeof(MoveTextRef), 16u);
+    EXPECT_EQ(parser.GetMoveText(game), "1. e4 e5 2. Nf3 Nc6\r\n3. Bb5 a6 1/2-1/2");
+
+    auto moves = parser.GetMoveList(game);
+    ASSERT_EQ(moves->size(), 6u);
+    EXPECT_EQ((*moves)[4], "Bb5");
+    EXPECT_EQ(parser.GetMoveList(game).get(), moves.get()); // served from the LRU
+
+    ASSERT_TRUE(parser.OpenIndexed(big.string()));
+    Game indexed;
+    ASSERT_TRUE(parser.GetGameAt(7, indexed));
+    EXPECT_EQ(parser.GetMoveList(indexed)->back(), "a6");
+
+    // Handles name their file by id, so they survive later loads
+    ASSERT_TRUE(parser.LoadFile(big.string()));
+    EXPECT_EQ(parser.GetSources().Size(), 3u);
+    EXPECT_EQ(parser.GetMoveText(game), parser.GetMoveText(parser.GetGames()[2]));
+    EXPECT_EQ(parser.GetMoveList(parser.GetGames().back())->back(), "a6");
+    EXPECT_TRUE(parser.GetMoveText(Game()).empty());
+}
+
+TEST_F(ParserIntegration, StoresPackedMoves) {
+    Parser parser;
+    parser.SetThreadCount(4);
+    parser.SetChunkSize(1024);
+    parser.SetStoreMoves(true);
+    ASSERT_TRUE(parser.LoadFile(big.string()));
+    ASSERT_EQ(parser.GetGames().size(), 300u);
+    EXPECT_EQ(parser.GetMovePool().Size(), 300u * 6);
+
+    const Game& game = parser.GetGames()[123];
+    ASSERT_TRUE(game.HasMoves());
+    EXPECT_EQ(sizeof(MovesRef), 16u);
+    const MoveSpan moves = parser.GetMoves(game);
+    ASSERT_EQ(moves.size, 6u);
+    Board board;
+    for (PackedMove m : moves) board.MakeMove(board.Unpack(m));
+    EXPECT_EQ(board.PieceAt(33), Bishop | (White << 3));  // Bb5
+    EXPECT_EQ(board.PieceAt(40), Pawn | (Black << 3));    // a6
+
+    ASSERT_TRUE(parser.OpenIndexed(big.string()));
+    Game indexed;
+    ASSERT_TRUE(parser.GetGameAt(7, indexed));
+    EXPECT_FALSE(indexed.HasMoves());
+    EXPECT_EQ(parser.GetMoveList(indexed)->size(), 6u);
+
+    Parser plain;
+    ASSERT_TRUE(plain.LoadFile(small.string()));
+    EXPECT_FALSE(plain.GetGames()[0].HasMoves());
+}
+
+TEST_F(ParserIntegration, RestOfLineCommentsEndAtLineBreak) {
+    const fs::path path = dir / "comments.pgn";
+    std::ofstream(path, std::ios::binary)
+        << "[White \"A\"]\n[Black \"B\"]\n[Result \"1-0\"]\n\n1. e4 e5 ; main line 2. d4\r\n"
+           "2. Nf3 Nc6 ; 3. d4\n3. Bb5 a6 1-0\n\n";
+
+    Parser parser;
+    parser.SetStoreMoves(true);
+    ASSERT_TRUE(parser.LoadFile(path.string()));
+    ASSERT_EQ(parser.GetGames().size(), 1u);
+    const Game& game = parser.GetGames()[0];
+    EXPECT_EQ(game.GetPlyCount(), 6);
+    EXPECT_EQ(parser.GetMoves(game).size, 6u);
+    EXPECT_EQ(parser.GetMoveList(game)->size(), 6u);
+}
+
+TEST_F(ParserIntegration, PackedMovesStayPutAcrossLoads) {
+    Parser parser;
+    parser.SetChunkSize(1024);
+    parser.SetStoreMoves(true);
+    ASSERT_TRUE(parser.LoadFile(small.string()));
+    const MoveSpan first = parser.GetMoves(parser.GetGames()[2]);
+    ASSERT_EQ(first.size, 6u);
+    const std::vector<PackedMove> copy(first.begin(), first.end());
+
+    // Each load adds a segment; views into earlier ones are not moved
+    ASSERT_TRUE(parser.LoadFile(big.string()));
+    ASSERT_TRUE(parser.LoadFile(big.string()));
+    EXPECT_EQ(parser.GetMovePool().GetSegmentCount(), 3u);
+    EXPECT_EQ(std::vector<PackedMove>(first.begin(), first.end()), copy);
+    const MoveSpan again = parser.GetMoves(parser.GetGames()[2]);
+    EXPECT_EQ(again.data, first.data);
+    const MoveSpan last = parser.GetMoves(parser.GetGames().back());
+    EXPECT_EQ(std::vector<PackedMove>(last.begin(), last.end()), copy);
+    EXPECT_TRUE(parser.GetMoves(Game()).empty());
+}
+
+TEST_F(ParserIntegration, ChargesClocksAndBlundersFromFenSideToMove) {
+    const fs::path path = dir / "fen.pgn";
+    std::ofstream(path, std::ios::binary)
+        << "[White \"W\"]\n[Black \"B\"]\n[Result \"1-0\"]\n[SetUp \"1\"]\n"
+           "[FEN \"4k3/8/8/8/8/8/4P3/4K3 b - - 0 1\"]\n\n"
+           "1... Kd7 { [%eval 0.5] [%clk 0:01:00] } 2. Kd2 { [%eval 0.5] [%clk 0:02:00] } "
+           "2... Kc6 { [%eval 9.0] [%clk 0:00:30] } 3. Kd3 { [%eval 9.0] [%clk 0:01:59] } 1-0\n\n";
+
+    Parser parser;
+    ASSERT_TRUE(parser.LoadFile(path.string()));
+    const Player& white = parser.GetPlayerStats().at("W");
+    const Player& black = parser.GetPlayerStats().at("B");
+    // Black moved first: the 30 s drop and the 8.5-pawn swing are Black's
+    EXPECT_EQ(black.GetTimeSpentCentis(), 3000);
+    EXPECT_EQ(white.GetTimeSpentCentis(), 100);
+    EXPECT_EQ(black.GetBlunderCount(), 1);
+    EXPECT_EQ(white.GetBlunderCount(), 0);
+}
+
+TEST_F(ParserIntegration, ThrottledProgressAndCancellation) {
+    Parser parser;
+    parser.SetThreadCount(4);
+    parser.SetChunkSize(1024);
+    std::vector<ProgressInfo> reports;
+    std::mutex mutex;
+    ProgressOptions options;
+    options.intervalBytes = 1;  // report on every update
+    parser.SetProgressHandler([&](const ProgressInfo& info) {
+        std::lock_guard<std::mutex> lock(mutex);
+        reports.push_back(info);
+    }, options);
+    ASSERT_TRUE(parser.LoadFile(big.string()));
+    ASSERT_GE(reports.size(), 2u);
+    for (std::size_t i = 1; i < reports.size(); ++i) EXPECT_GE(reports[i].bytesDone, reports[i - 1].bytesDone);
+    const ProgressInfo& last = reports.back();
+    EXPECT_TRUE(last.finished);
+    EXPECT_FALSE(last.cancelled);
+    EXPECT_EQ(last.bytesDone, fs::file_size(big));
+    EXPECT_EQ(last.bytesTotal, fs::file_size(big));
+    EXPECT_EQ(last.gamesDone, 300u);
+    EXPECT_EQ(last.GetPercent(), 100);
+
+    // Cancelled from the handler: the load fails and earlier data stays as it was
+    CancellationToken token;
+    parser.SetCancellationToken(token);
+    parser.SetProgressHandler([&token](const ProgressInfo&) { token.Cancel(); }, options);
+    EXPECT_FALSE(parser.LoadFile(big.string()));
+    EXPECT_EQ(parser.GetGames().size(), 300u);
+    EXPECT_EQ(parser.GetStats().GetTotalGames(), 300);
+
+    // A reset token lets the next load run
+    token.Reset();
+    parser.SetProgressHandler(nullptr);
+    EXPECT_TRUE(parser.LoadFile(small.string()));
+    EXPECT_EQ(parser.GetGames().size(), 305u);
+}
+
+TEST_F(ParserIntegration, ExportFilteredCopiesOriginalGames) {
+    const fs::path out = dir / "filtered.pgn";
+    Parser parser;
+    parser.SetThreadCount(4);
+    parser.SetChunkSize(1024);
+    PGNExporter::Summary summary;
+    ASSERT_TRUE(parser.ExportFilteredPGN({big.string(), small.string()}, out.string(),
+                                         [](const Game& g) { return g.GetWhite() == "Player2"; }, &summary));
+    EXPECT_EQ(summary.gamesScanned, 305u);
+
+    // Player2 has White in games i with i % 7 == 2
+    std::string expected;
+    for (int i = 2; i < 305; i += 7) expected += MakeGame(i);
+    EXPECT_EQ(summary.gamesWritten, 44u);
+    EXPECT_EQ(summary.ranges, 44u);
+
+    std::ifstream in(out, std::ios::binary);
+    const std::string actual((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    EXPECT_EQ(actual, expected);
+    EXPECT_EQ(summary.bytesWritten, expected.size());
+
+    // Adjacent selections coalesce into one range per file
+    ASSERT_TRUE(parser.ExportFilteredPGN({big.string(), small.string()}, out.string(),
+                                         [](const Game&) { return true; }, &summary));
+    EXPECT_EQ(summary.ranges, 2u);
+    EXPECT_EQ(summary.bytesWritten, fs::file_size(big) + fs::file_size(small));
+}
+
+TEST_F(ParserIntegration, ExportFilteredRefusesToOverwriteAnInput) {
+    Parser parser;
+    const auto keepAll = [](const Game&) { return true; };
+    const std::uintmax_t size = fs::file_size(small);
+    EXPECT_FALSE(parser.ExportFilteredPGN({big.string(), small.string()}, small.string(), keepAll));
+
+    // A hard link names the same file under another path
+    const fs::path link = dir / "link.pgn";
+    fs::create_hard_link(small, link);
+    EXPECT_FALSE(parser.ExportFilteredPGN({small.string()}, link.string(), keepAll));
+    EXPECT_EQ(fs::file_size(small), size);
+    ASSERT_TRUE(parser.LoadFile(small.string()));
+    EXPECT_EQ(parser.GetGames().size(), 5u);
+}
+
+TEST_F(ParserIntegration, PublishesConsistentStatsSnapshots) {
+    Parser parser;
+    parser.SetThreadCount(2);
+    parser.SetChunkSize(1024);
+    EXPECT_EQ(parser.GetStatsSnapshot()->GetTotalGames(), 0);
+    ASSERT_TRUE(parser.LoadFile(small.string()));
+    EXPECT_EQ(parser.GetStatsVersion(), 0u);
+
+    parser.SetPublishStats(true, 3600.0);  // whole loads only
+    EXPECT_EQ(parser.GetStatsVersion(), 1u);
+    EXPECT_EQ(parser.GetStatsSnapshot()->GetTotalGames(), 5);
+
+    // A reader checks every snapshot it sees while loads run on this thread
+    std::atomic<bool> done{false};
+    std::atomic<int> torn{0};
+    std::atomic<int> seen{0};
+    std::thread reader([&] {
+        std::uint64_t lastVersion = 0;
+        do {
+            if (parser.GetStatsVersion() == lastVersion) {
+                std::this_thread::yield();
+                continue;
+            }
+            lastVersion = parser.GetStatsVersion();
+            const std::shared_ptr<const DatabaseStats> s = parser.GetStatsSnapshot();
+            int playerGames = 0;
+            for (const auto& kv : s->GetPlayerStats()) playerGames += kv.second.GetTotalGames();
+            const int results = s->GetWhiteWins() + s->GetBlackWins() + s->GetDraws() + s->GetUnknownResults();
+            if (results != s->GetTotalGames() || playerGames != 2 * s->GetTotalGames() ||
+                static_cast<int>(s->GetPlayerStats().size()) != s->GetUniquePlayers() ||
+                (s->GetTotalGames() - 5) % 300 != 0) {
+                ++torn;
+            }
+            ++seen;
+        } while (!done.load());
+    });
+    const std::shared_ptr<const DatabaseStats> before = parser.GetStatsSnapshot();
+    // Join before asserting: returning with the reader joinable would terminate
+    bool loaded = true;
+    for (int i = 0; i < 5; ++i) loaded = parser.LoadFile(big.string()) && loaded;
+    done = true;
+    reader.join();
+    ASSERT_TRUE(loaded);
+
+    EXPECT_EQ(torn.load(), 0);
+    EXPECT_GT(seen.load(), 0);
+    EXPECT_EQ(parser.GetStatsVersion(), 6u);
+    EXPECT_EQ(parser.GetStatsSnapshot()->GetTotalGames(), 1505);
+    // Held snapshots stay valid and unchanged
+    EXPECT_EQ(before->GetTotalGames(), 5);
+}
+
+TEST_F(ParserIntegration, PublishesSnapshotsDuringMultiChunkLoad) {
+    Parser parser;
+    parser.SetThreadCount(4);
+    parser.SetChunkSize(1024);
+    parser.SetPublishStats(true, 0.0);  // after every chunk
+    ASSERT_EQ(parser.GetStatsVersion(), 1u);
+
+    // A reader checks every snapshot it sees and notes totals between whole loads
+    std::atomic<bool> done{false};
+    std::atomic<bool> sawPartial{false};
+    std::atomic<int> torn{0};
+    std::thread reader([&] {
+        while (!done.load()) {
+            const std::shared_ptr<const DatabaseStats> s = parser.GetStatsSnapshot();
+            int playerGames = 0;
+            for (const auto& kv : s->GetPlayerStats()) playerGames += kv.second.GetTotalGames();
+            const int results = s->GetWhiteWins() + s->GetBlackWins() + s->GetDraws() + s->GetUnknownResults();
+            if (results != s->GetTotalGames() || playerGames != 2 * s->GetTotalGames() ||
+                static_cast<int>(s->GetPlayerStats().size()) != s->GetUniquePlayers()) {
+                ++torn;
+            }
+            if (s->GetTotalGames() % 300 != 0) sawPartial = true;
+        }
+    });
+    // Join before asserting: returning with the reader joinable would terminate
+    bool loaded = true;
+    int loads = 0;
+    std::uint64_t versionsPerLoad = 0;
+    while (loaded && loads < 50 && (loads == 0 || !sawPartial.load())) {
+        const std::uint64_t version = parser.GetStatsVersion();
+        loaded = parser.LoadFile(big.string());
+        versionsPerLoad = parser.GetStatsVersion() - version;
+        ++loads;
+    }
+    done = true;
+    reader.join();
+    ASSERT_TRUE(loaded);
+
+    EXPECT_EQ(torn.load(), 0);
+    EXPECT_TRUE(sawPartial.load());
+    EXPECT_GT(versionsPerLoad, 2u);  // snapshots within the load, then the whole load
+    const std::shared_ptr<const DatabaseStats> last = parser.GetStatsSnapshot();
+    EXPECT_EQ(last->GetTotalGames(), 300 * loads);
+    EXPECT_EQ(last->GetUniqueTournaments(), parser.GetStats().GetUniqueTournaments());
+}
@@ -0,0 +1,208 @@
+#include "PGNGameBuilder.hpp"
+#include "PGNAnnotationExtractor.hpp"
+#include "PGNStatsUpdater.hpp"
+#include "PGNTokenizer.hpp"
+#include "utils/chunkPlan.hpp"
+#include "utils/scan.hpp"
+#include <gtest/gtest.h>
+#include <memory>
+#include <sstream>
+
+using namespace chessDataLib;
+
+TEST(PGNBuilder, CopiesTagsAndCountsMoves) {
+    std::unordered_map<std::string, std::string> tags{
+        {"Event", "Open"}, {"White", "A"}, {"Black", "B"}, {"Result", "1-0"}, {"ECO", "C20"}};
+    Game g = PGNGameBuilder::Build(tags, "1. e4 e5 2. Qh5 Nc6 3. Bc4 Nf6 4. Qxf7# 1-0");
+    EXPECT_EQ(g.GetEvent(), "Open");
+    EXPECT_EQ(g.GetEco(), "C20");
+    EXPECT_EQ(g.GetMoveCount(), 4);
+    EXPECT_TRUE(g.GetClocks().empty());
+}
+
+TEST(PGNStatsUpdater, FillsMapsAndCountersOnly) {
+    utils::StringMap<Player> players;
+    utils::StringMap<Tournament> tournaments;
+    DatabaseStats stats;
+    std::unordered_map<std::string, std::string> tags{
+        {"Event", "Open"}, {"White", "A"}, {"Black", "B"}, {"Result", "1-0"}};
+    PGNStatsUpdater::Update(PGNGameBuilder::Build(tags, "1. e4 e5 1-0"), players, tournaments, stats);
+    tags["Result"] = "1/2-1/2";
+    PGNStatsUpdater::Update(PGNGameBuilder::Build(tags, "1. d4 d5 1/2-1/2"), players, tournaments, stats);
+
+    EXPECT_EQ(players.size(), 2u);
+    EXPECT_EQ(players.at("A").GetTotalGames(), 2);
+    EXPECT_EQ(tournaments.at("Open").GetTotalGames(), 2);
+    EXPECT_EQ(stats.GetTotalGames(), 2);
+    EXPECT_EQ(stats.GetDraws(), 1);
+    // No per-worker copies of the players and tournaments
+    EXPECT_TRUE(stats.GetPlayerStats().empty());
+    EXPECT_TRUE(stats.GetTournaments().empty());
+    EXPECT_TRUE(stats.GetPlayerNames().empty());
+}
+
+TEST(PGNAnnotations, ParsesClockAndEval) {
+    const std::string clk = "1:02:03.4";
+    EXPECT_EQ(PGNAnnotationExtractor::ParseClock(clk.data(), clk.data() + clk.size()), 372340);
+    const std::string eval = "-0.25";
+    EXPECT_EQ(PGNAnnotationExtractor::ParseEval(eval.data(), eval.data() + eval.size()), -25);
+    const std::string mate = "#-3";
+    EXPECT_EQ(PGNAnnotationExtractor::ParseEval(mate.data(), mate.data() + mate.size()),
+              -(GameAnnotations::kMateScore - 3));
+
+    // Overlong numbers are malformed rather than overflowing
+    const std::string longClock = "0:00:" + std::string(30, '9');
+    EXPECT_EQ(PGNAnnotationExtractor::ParseClock(longClock.data(), longClock.data() + longClock.size()),
+              GameAnnotations::kNoValue);
+    const std::string longEval = "#" + std::string(30, '9');
+    EXPECT_EQ(PGNAnnotationExtractor::ParseEval(longEval.data(), longEval.data() + longEval.size()),
+              GameAnnotations::kNoValue);
+    const std::string longPawns = "-" + std::string(30, '9') + ".5";
+    EXPECT_EQ(PGNAnnotationExtractor::ParseEval(longPawns.data(), longPawns.data() + longPawns.size()),
+              GameAnnotations::kNoValue);
+}
+
+TEST(PGNAnnotations, SkipsRestOfLineComments) {
+    GameAnnotations ann = PGNAnnotationExtractor::Extract(
+        "1. e4 { [%clk 0:03:00] } e5 ; a6 b6 { [%clk 0:00:01] }\n2. Nf3 Nc6 3. Bb5 a6 1-0");
+    EXPECT_EQ(ann.plies, 6);
+    ASSERT_EQ(ann.clocks.size(), 6u);
+    EXPECT_EQ(ann.clocks[0], 18000);
+    EXPECT_EQ(ann.clocks[1], GameAnnotations::kNoValue);
+    EXPECT_EQ(PGNGameBuilder::Build({}, "1. e4 e5 ; 2. d4 d5\n2. Nf3 Nc6 3. Bb5 a6 1-0\n").GetMoveCount(), 3);
+}
+
+TEST(PGNAnnotations, FillsPerPlyColumns) {
+    const std::string moves =
+        "1. e4 { [%eval 0.3] [%clk 0:03:00] } 1... e5 { [%eval 0.25] [%clk 0:02:58] } "
+        "2. Qh5 (2. Nf3 { [%clk 0:00:01] }) { [%eval -0.5] [%clk 0:02:50] } "
+        "2... g6 { [%eval 4.0] [%clk 0:02:40] } 0-1";
+    GameAnnotations ann = PGNAnnotationExtractor::Extract(moves);
+    ASSERT_EQ(ann.plies, 4);
+    ASSERT_EQ(ann.clocks.size(), 4u);
+    EXPECT_EQ(ann.clocks[2], 17000);
+    EXPECT_EQ(ann.evals[3], 400);
+
+    int64_t spent = 0;
+    int timed = 0;
+    PGNAnnotationExtractor::ComputeTimeUsage(ann.clocks, true, spent, timed);
+    EXPECT_EQ(spent, 1000);
+    EXPECT_EQ(timed, 1);
+    EXPECT_EQ(PGNAnnotationExtractor::CountBlunders(ann.evals, true), 0);
+    EXPECT_EQ(PGNAnnotationExtractor::CountBlunders(ann.evals, false), 1);
+
+    // The same columns when Black made the first ply
+    PGNAnnotationExtractor::ComputeTimeUsage(ann.clocks, false, spent, timed, false);
+    EXPECT_EQ(spent, 1000);
+    EXPECT_EQ(timed, 1);
+    const int threshold = PGNAnnotationExtractor::kBlunderThreshold;
+    EXPECT_EQ(PGNAnnotationExtractor::CountBlunders(ann.evals, false, threshold, false), 0);
+    EXPECT_EQ(PGNAnnotationExtractor::CountBlunders(ann.evals, true, threshold, false), 0);
+}
+
+TEST(PGNTokenizer, LineScannerFindsEveryBreak) {
+    std::string text;
+    for (int i = 0; i < 300; ++i) text += std::string(static_cast<std::size_t>(i % 70), 'x') + '\n';
+    text += "tail";
+
+    utils::LineScanner scanner(text.data(), text.data() + text.size());
+    std::size_t expected = text.find('\n');
+    const char* p = text.data();
+    int lines = 0;
+    for (const char* nl; (nl = scanner.Next(p)) != text.data() + text.size(); p = nl + 1, ++lines) {
+        ASSERT_EQ(static_cast<std::size_t>(nl - text.data()), expected);
+        expected = text.find('\n', expected + 1);
+    }
+    EXPECT_EQ(lines, 300);
+    EXPECT_EQ(expected, std::string::npos);
+}
+
+TEST(PGNTokenizer, FindFirstGameSkipsBomAndPreamble) {
+    const auto first = [](const std::string& text) {
+        return utils::FindFirstGame(text.data(), text.data() + text.size()) - text.data();
+    };
+    EXPECT_EQ(first("[Event \"a\"]\n"), 0);
+    EXPECT_EQ(first("\xEF\xBB\xBF\r\n [Event \"a\"]\n"), 6);
+    EXPECT_EQ(first("comment line\n\n[Event \"a\"]\n"), 14);
+    EXPECT_EQ(first("  \n"), 3);
+    EXPECT_EQ(first(""), 0);
+}
+
+TEST(PGNTokenizer, StreamAndMemoryModesAgreeAcrossRefills) {
+    // Larger than one read block, CRLF line breaks, no final newline
+    std::string pgn;
+    for (int i = 0; pgn.size() < (3u << 20); ++i) {
+        pgn += "[Event \"E" + std::to_string(i) + "\"]\r\n[Result \"1-0\"]\r\n\r\n";
+        pgn += "1. e4 e5 2. Nf3 {" + std::string(static_cast<std::size_t>(i % 200), 'c') + "} Nc6\r\n3. Bb5 1-0\r\n\r\n";
+    }
+    pgn += "[Event \"Last\"]\n\n1. d4 *";
+
+    std::istringstream stream(pgn);
+    PGNTokenizer fromStream(stream, 10);
+    PGNTokenizer fromMemory(pgn.data(), pgn.size(), 10);
+    std::size_t games = 0;
+    while (fromMemory.NextGame()) {
+        ASSERT_TRUE(fromStream.NextGame());
+        ASSERT_EQ(fromStream.GetCurrentTagLines(), fromMemory.GetCurrentTagLines());
+        ASSERT_EQ(fromStream.GetCurrentMoveText(), fromMemory.GetCurrentMoveText());
+        ASSERT_EQ(fromStream.GetCurrentGameOffset(), fromMemory.GetCurrentGameOffset());
+        ASSERT_EQ(fromStream.GetCurrentMoveTextOffset(), fromMemory.GetCurrentMoveTextOffset());
+        ASSERT_EQ(fromStream.GetCurrentMoveTextLength(), fromMemory.GetCurrentMoveTextLength());
+        ASSERT_EQ(pgn.compare(fromMemory.GetCurrentGameOffset() - 10, 7, "[Event "), 0);
+        ++games;
+    }
+    EXPECT_FALSE(fromStream.NextGame());
+    EXPECT_GT(games, 1000u);
+    EXPECT_EQ(fromMemory.GetCurrentTagLines().size(), 0u);
+}
+
+TEST(PGNTokenizer, StreamModeGrowsBufferForLongLines) {
+    // Each move-text line is longer than a read block and than the last,
+    // so every refill inside it grows (and moves) the buffer
+    std::string pgn;
+    std::vector<std::string> comments;
+    for (std::size_t size : {std::size_t(1) << 19, std::size_t(3) << 19, std::size_t(5) << 20}) {
+        comments.push_back(std::string(size, 'x'));
+        pgn += "[Event \"E\"]\n[Result \"1-0\"]\n\n1. e4 {" + comments.back() + "} e5 1-0\n\n";
+    }
+
+    std::istringstream stream(pgn);
+    PGNTokenizer tokenizer(stream);
+    for (const auto& comment : comments) {
+        ASSERT_TRUE(tokenizer.NextGame());
+        // Compared with EXPECT_TRUE so a failure does not print megabytes
+        const std::string& moveText = tokenizer.GetCurrentMoveText();
+        EXPECT_EQ(moveText.size(), comment.size() + 16);
+        EXPECT_TRUE(moveText == "1. e4 {" + comment + "} e5 1-0\n");
+    }
+    EXPECT_FALSE(tokenizer.NextGame());
+}
+
+TEST(PGNTokenizer, PlanChunksCutsAtGameStarts) {
+    struct Source {
+        std::string text;
+        const char* Data() const { return text.data(); }
+        std::uint64_t Size() const { return text.size(); }
+    };
+    std::string pgn;
+    for (int i = 0; i < 40; ++i) pgn += "[Event \"e" + std::to_string(i) + "\"]\n\n1. e4 e5 1-0\n\n";
+    std::vector<std::unique_ptr<Source>> sources;
+    sources.push_back(std::make_unique<Source>(Source{pgn}));
+    sources.push_back(nullptr);  // failed to open
+    sources.push_back(std::make_unique<Source>(Source{""}));
+    sources.push_back(std::make_unique<Source>(Source{pgn}));
+
+    const std::vector<utils::ChunkTask> tasks = utils::PlanChunks(sources, 256);
+    ASSERT_GT(tasks.size(), 2u);
+    std::uint64_t covered[4] = {0, 0, 0, 0};
+    for (std::size_t i = 0; i < tasks.size(); ++i) {
+        const utils::ChunkTask& t = tasks[i];
+        ASSERT_TRUE(t.file == 0 || t.file == 3);
+        if (i > 0 && tasks[i - 1].file == t.file) EXPECT_EQ(tasks[i - 1].end, t.begin);
+        EXPECT_LT(t.begin, t.end);
+        EXPECT_EQ(pgn[t.begin], '[');
+        covered[t.file] += t.end - t.begin;
+    }
+    EXPECT_EQ(covered[0], pgn.size());
+    EXPECT_EQ(covered[3], pgn.size());
+}
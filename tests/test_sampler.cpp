@@ -0,0 +1,122 @@
+#include "parser.hpp"
+#include "utils/reservoir.hpp"
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <fstream>
+#include <set>
+
+using namespace chessDataLib;
+namespace fs = std::filesystem;
+
+namespace {
+
+// Game i has Round "i", Elo band (i % 3) * 200 + 2000 and a time control by i % 4
+std::string MakeGame(int i) {
+    const char* controls[] = {"60+0", "180+2", "600+5", "40/7200"};
+    const int elo = 2000 + (i % 3) * 200 + 50;
+    return "[Event \"Sample\"]\n"
+           "[Round \"" + std::to_string(i) + "\"]\n"
+           "[White \"W" + std::to_string(i) + "\"]\n"
+           "[Black \"B" + std::to_string(i) + "\"]\n"
+           "[Result \"1-0\"]\n"
+           "[WhiteElo \"" + std::to_string(elo) + "\"]\n"
+           "[BlackElo \"" + std::to_string(elo) + "\"]\n"
+           "[TimeControl \"" + controls[i % 4] + "\"]\n"
+           "\n1. e4 e5 2. Nf3 1-0\n\n";
+}
+
+class Sampling : public ::testing::Test {
+protected:
+    void SetUp() override {
+        dir = fs::temp_directory_path() / ("chessDataLib_sampler_" + std::to_string(::testing::UnitTest::GetInstance()->random_seed()));
+        fs::create_directories(dir);
+        first = dir / "first.pgn";
+        second = dir / "second.pgn";
+        std::ofstream a(first, std::ios::binary), b(second, std::ios::binary);
+        for (int i = 0; i < 200; ++i) a << MakeGame(i);
+        for (int i = 200; i < 300; ++i) b << MakeGame(i);
+    }
+    void TearDown() override { fs::remove_all(dir); }
+
+    fs::path dir, first, second;
+};
+
+int Round(const Game& g) {
+    return std::stoi(g.GetRound());
+}
+
+} // namespace
+
+TEST(Reservoir, SamplesUniformly) {
+    // 4000 samples of 10 from 1000 items: each block of 100 items is expected 4000 times
+    std::vector<int> blocks(10, 0);
+    for (std::uint64_t seed = 0; seed < 4000; ++seed) {
+        utils::Reservoir<int> reservoir(10, seed);
+        for (int i = 0; i < 1000; ++i) {
+            if (reservoir.Wants()) reservoir.Add(i);
+            else reservoir.Skip();
+        }
+        ASSERT_EQ(reservoir.Items().size(), 10u);
+        std::set<int> distinct(reservoir.Items().begin(), reservoir.Items().end());
+        ASSERT_EQ(distinct.size(), 10u);
+        for (int v : reservoir.Items()) blocks[static_cast<std::size_t>(v / 100)]++;
+    }
+    for (int count : blocks) {
+        EXPECT_GT(count, 3700);
+        EXPECT_LT(count, 4300);
+    }
+
+    utils::Reservoir<int> small(10, 1);
+    for (int i = 0; i < 4; ++i) small.Offer(i);
+    EXPECT_EQ(small.Items(), (std::vector<int>{0, 1, 2, 3}));
+    EXPECT_EQ(small.Seen(), 4u);
+}
+
+TEST_F(Sampling, UniformSampleSpansFilesInOrder) {
+    Parser parser;
+    std::vector<Game> sample;
+    ASSERT_TRUE(parser.SampleGames({first.string(), second.string()}, 25, sample, 7));
+    ASSERT_EQ(sample.size(), 25u);
+    for (std::size_t i = 1; i < sample.size(); ++i) EXPECT_LT(Round(sample[i - 1]), Round(sample[i]));
+    EXPECT_EQ(parser.GetMoveList(sample[0])->size(), 3u);
+
+    std::vector<Game> again;
+    ASSERT_TRUE(parser.SampleGames({first.string(), second.string()}, 25, again, 7));
+    for (std::size_t i = 0; i < sample.size(); ++i) EXPECT_EQ(sample[i].GetRound(), again[i].GetRound());
+
+    std::vector<Game> all;
+    ASSERT_TRUE(parser.SampleGames({first.string(), second.string()}, 1000, all));
+    EXPECT_EQ(all.size(), 300u);
+    EXPECT_EQ(parser.GetGames().size(), 0u);
+}
+
+TEST_F(Sampling, StratifiedSampleFillsEachStratum) {
+    Parser parser;
+    std::map<std::string, std::vector<Game>> samples;
+    ASSERT_TRUE(parser.SampleGamesStratified({first.string(), second.string()}, 5, GameSampler::ByEloBand(), samples));
+    ASSERT_EQ(samples.size(), 3u);
+    for (const auto& [band, games] : samples) {
+        ASSERT_EQ(games.size(), 5u) << band;
+        for (const Game& g : games) {
+            EXPECT_EQ(band, std::to_string(2000 + Round(g) % 3 * 200) + "-" + std::to_string(2199 + Round(g) % 3 * 200));
+        }
+    }
+
+    ASSERT_TRUE(parser.SampleGamesStratified({second.string()}, 1000, GameSampler::ByTimeControl(), samples));
+    ASSERT_EQ(samples.size(), 4u);
+    EXPECT_EQ(samples["bullet"].size(), 25u);
+    EXPECT_EQ(samples["blitz"].size(), 25u);
+    EXPECT_EQ(samples["rapid"].size(), 25u);
+    EXPECT_EQ(samples["classical"].size(), 25u);
+    EXPECT_EQ(Round(samples["rapid"].front()), 202);
+}
+
+TEST_F(Sampling, IndexedSampleReadsOnlyChosenGames) {
+    Parser parser;
+    EXPECT_TRUE(parser.SampleIndexedGames(5).empty());
+    ASSERT_TRUE(parser.OpenIndexed(first.string()));
+    const std::vector<Game> sample = parser.SampleIndexedGames(40, 3);
+    ASSERT_EQ(sample.size(), 40u);
+    for (std::size_t i = 1; i < sample.size(); ++i) EXPECT_LT(Round(sample[i - 1]), Round(sample[i]));
+    EXPECT_EQ(parser.SampleIndexedGames(500).size(), 200u);
+}
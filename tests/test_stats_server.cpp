@@ -0,0 +1,217 @@
+#include "statsServer.hpp"
+#include "parser.hpp"
+#include "statsSnapshot.hpp"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+
+#if defined(__linux__)
+#include <cerrno>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+using namespace chessDataLib;
+namespace fs = std::filesystem;
+
+namespace {
+
+class StatsServerTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        dir = fs::temp_directory_path() / "chessDataLib_server";
+        fs::create_directories(dir);
+        pgn = dir / "games.pgn";
+        std::ofstream out(pgn, std::ios::binary);
+        const char* games[][5] = {{"Carlsen, Magnus", "Caruana, Fabiano", "1-0", "B90", "1"},
+                                  {"Caruana, Fabiano", "Carlsen, Magnus", "1/2-1/2", "C65", "2"},
+                                  {"Carlsen, Magnus", "Ding, Liren", "0-1", "B92", "3"}};
+        for (const auto& g : games) {
+            out << "[Event \"Open\"]\n[Date \"2024.01.0" << g[4] << "\"]\n[Round \"" << g[4] << "\"]\n[White \""
+                << g[0] << "\"]\n[Black \"" << g[1] << "\"]\n[Result \"" << g[2] << "\"]\n[ECO \"" << g[3]
+                << "\"]\n\n1. e4 c5 " << g[2] << "\n\n";
+        }
+    }
+
+    void TearDown() override { fs::remove_all(dir); }
+
+    fs::path dir;
+    fs::path pgn;
+};
+
+#if defined(__linux__)
+// Sends all requests at once and reads until one response line per request
+std::string Exchange(const std::string& socketPath, const std::string& requests) {
+    const int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    socketPath.copy(address.sun_path, socketPath.size());
+    if (::connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+        ::close(fd);
+        return "connect failed";
+    }
+    const auto lines = std::count(requests.begin(), requests.end(), '\n');
+    [[maybe_unused]] const ssize_t sent = ::send(fd, requests.data(), requests.size(), 0);
+    std::string response;
+    char buf[4096];
+    while (std::count(response.begin(), response.end(), '\n') < lines) {
+        const ssize_t n = ::read(fd, buf, sizeof(buf));
+        if (n <= 0) break;
+        response.append(buf, static_cast<std::size_t>(n));
+    }
+    ::close(fd);
+    return response;
+}
+#endif
+
+} // namespace
+
+TEST_F(StatsServerTest, AnswersQueriesFromPGN) {
+    StatsServer server;
+    EXPECT_EQ(server.HandleRequest("STATS"), "OK\t0\t0\t0\t0\t0\t0\t0");
+    ASSERT_EQ(StatsServer::LoadDataset((dir / "missing.pgn").string()), nullptr);
+    server.SetDataset(StatsServer::LoadDataset(pgn.string(), 1));
+
+    EXPECT_EQ(server.HandleRequest("PING"), "OK\tPONG");
+    EXPECT_EQ(server.HandleRequest("STATS"), "OK\t3\t3\t1\t1\t1\t1\t0");
+    EXPECT_EQ(server.HandleRequest("PLAYER Carlsen, Magnus"), "OK\tCarlsen, Magnus\t3\t1\t1\t1");
+    EXPECT_EQ(server.HandleRequest("PLAYER\tDing, Liren\r"), "OK\tDing, Liren\t1\t1\t0\t0");
+    EXPECT_EQ(server.HandleRequest("PLAYER Kasparov, Garry"), "ERR\tunknown player");
+    EXPECT_EQ(server.HandleRequest("TOURNAMENT Open"), "OK\tOpen\t3\t3\tCarlsen, Magnus\t1.5");
+    EXPECT_EQ(server.HandleRequest("OPENING B90"), "OK\t1\t1\t0\t0\t100.0");
+    EXPECT_EQ(server.HandleRequest("OPENING B90 B99"), "OK\t2\t1\t0\t1\t50.0");
+    EXPECT_EQ(server.HandleRequest("OPENING Z00"), "ERR\tinvalid ECO code");
+    EXPECT_EQ(server.HandleRequest("H2H\tCarlsen, Magnus\tCaruana, Fabiano"), "OK\t2\t1\t1\t0");
+    EXPECT_EQ(server.HandleRequest("GAME 2"), "OK\tOpen\t2024.01.03\t3\tCarlsen, Magnus\tDing, Liren\t0-1\tB92");
+    EXPECT_EQ(server.HandleRequest("GAME 3"), "ERR\tinvalid game index");
+    EXPECT_EQ(server.HandleRequest("GAME x"), "ERR\tinvalid game index");
+    EXPECT_EQ(server.HandleRequest("PLAYER"), "ERR\tunknown command");
+    EXPECT_EQ(server.HandleRequest("FLY"), "ERR\tunknown command");
+}
+
+TEST_F(StatsServerTest, AnswersFromSnapshot) {
+    Parser parser;
+    ASSERT_TRUE(parser.LoadFile(pgn.string()));
+    const fs::path snapshot = dir / "games.snapshot";
+    ASSERT_TRUE(StatsSnapshot::Save(snapshot.string(), FileIdentity(), parser.GetStats()));
+
+    // PGN files and short files are rejected by the header check
+    FileIdentity identity;
+    DatabaseStats probe;
+    EXPECT_FALSE(StatsSnapshot::Load(pgn.string(), identity, probe));
+    std::ofstream(dir / "short.snapshot", std::ios::binary) << "CDL";
+    EXPECT_FALSE(StatsSnapshot::Load((dir / "short.snapshot").string(), identity, probe));
+
+    const auto dataset = StatsServer::LoadDataset(snapshot.string());
+    ASSERT_NE(dataset, nullptr);
+    EXPECT_EQ(dataset->parser, nullptr);
+    StatsServer server;
+    server.SetDataset(dataset);
+    EXPECT_EQ(server.HandleRequest("PLAYER Caruana, Fabiano"), "OK\tCaruana, Fabiano\t2\t0\t1\t1");
+    EXPECT_EQ(server.HandleRequest("TOURNAMENT Open"), "OK\tOpen\t3\t3\tCarlsen, Magnus\t1.5");
+    EXPECT_EQ(server.HandleRequest("GAME 0"), "ERR\tnot available from a snapshot");
+}
+
+#if defined(__linux__)
+TEST_F(StatsServerTest, ServesPipelinedRequestsOverSocket) {
+    const std::string socketPath = (dir / "stats.sock").string();
+    StatsServer server;
+    server.SetDataset(StatsServer::LoadDataset(pgn.string(), 1));
+    ASSERT_TRUE(server.Start(socketPath, 2));
+    EXPECT_TRUE(server.IsRunning());
+    EXPECT_FALSE(server.Start(socketPath, 2));
+
+    EXPECT_EQ(Exchange(socketPath, "PING\nPLAYER Ding, Liren\r\nGAME 0\nNOPE\n"),
+              "OK\tPONG\nOK\tDing, Liren\t1\t1\t0\t0\nOK\tOpen\t2024.01.01\t1\tCarlsen, Magnus\t"
+              "Caruana, Fabiano\t1-0\tB90\nERR\tunknown command\n");
+
+    // Many clients at once, each with a large pipelined batch
+    std::string batch;
+    std::string expected;
+    for (int i = 0; i < 2000; ++i) {
+        batch += "PLAYER Carlsen, Magnus\n";
+        expected += "OK\tCarlsen, Magnus\t3\t1\t1\t1\n";
+    }
+    std::vector<std::thread> clients;
+    std::vector<std::string> responses(4);
+    for (int c = 0; c < 4; ++c) {
+        clients.emplace_back([&, c] { responses[c] = Exchange(socketPath, batch); });
+    }
+    for (auto& t : clients) t.join();
+    for (const auto& r : responses) EXPECT_EQ(r, expected);
+
+    // Reloading swaps the data under running connections
+    auto empty = std::make_shared<StatsServer::Dataset>();
+    empty->stats = std::make_shared<DatabaseStats>();
+    server.SetDataset(empty);
+    EXPECT_EQ(Exchange(socketPath, "STATS\n"), "OK\t0\t0\t0\t0\t0\t0\t0\n");
+
+    EXPECT_EQ(server.GetRequestCount(), 8005u);
+    EXPECT_EQ(server.GetConnectionCount(), 6u);
+    server.Stop();
+    EXPECT_FALSE(server.IsRunning());
+    EXPECT_FALSE(fs::exists(socketPath));
+}
+
+TEST_F(StatsServerTest, StopsReadingClientsThatDoNotReadResponses) {
+    const std::string socketPath = (dir / "stats.sock").string();
+    StatsServer server;
+    server.SetDataset(StatsServer::LoadDataset(pgn.string(), 1));
+    ASSERT_TRUE(server.Start(socketPath, 2));
+
+    const int fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0);
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    socketPath.copy(address.sun_path, socketPath.size());
+    ASSERT_EQ(::connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)), 0);
+
+    // Each 7-byte request has a response ten times longer; without
+    // backpressure the server would keep reading and buffer it all
+    const std::string request = "GAME 0\n";
+    const std::string response = "OK\tOpen\t2024.01.01\t1\tCarlsen, Magnus\tCaruana, Fabiano\t1-0\tB90\n";
+    std::string batch;
+    for (int i = 0; i < 4096; ++i) batch += request;
+    const std::size_t total = 128 * batch.size();  // 3.5 MiB of requests
+    std::size_t sent = 0;
+    auto lastProgress = std::chrono::steady_clock::now();
+    while (sent < total && std::chrono::steady_clock::now() - lastProgress < std::chrono::milliseconds(300)) {
+        const std::size_t at = sent % batch.size();
+        const ssize_t n = ::send(fd, batch.data() + at, batch.size() - at, MSG_NOSIGNAL);
+        if (n > 0) {
+            sent += static_cast<std::size_t>(n);
+            lastProgress = std::chrono::steady_clock::now();
+        } else {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+    EXPECT_LT(sent, total / 2);
+
+    // Once the client reads, the held-back requests are all answered in order
+    std::size_t received = 0;
+    bool intact = true;
+    char buf[65536];
+    while (received < total / request.size() * response.size()) {
+        if (sent < total) {
+            const std::size_t at = sent % batch.size();
+            const ssize_t n = ::send(fd, batch.data() + at, batch.size() - at, MSG_NOSIGNAL);
+            if (n > 0) sent += static_cast<std::size_t>(n);
+        }
+        const ssize_t n = ::read(fd, buf, sizeof(buf));
+        if (n == 0) break;
+        if (n < 0) {
+            if (errno != EAGAIN && errno != EWOULDBLOCK) break;
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+            continue;
+        }
+        for (ssize_t i = 0; i < n; ++i, ++received) intact &= buf[i] == response[received % response.size()];
+    }
+    ::close(fd);
+    EXPECT_TRUE(intact);
+    EXPECT_EQ(received, total / request.size() * response.size());
+    server.Stop();
+}
+#endif
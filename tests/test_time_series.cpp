@@ -0,0 +1,138 @@
+#include "timeSeriesStats.hpp"
+#include "parser.hpp"
+#include "utils/date.hpp"
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <fstream>
+
+using namespace chessDataLib;
+namespace fs = std::filesystem;
+
+TEST(PackedDate, ParsesPartialDates) {
+    const std::uint32_t full = utils::PackDate("1990.03.17");
+    EXPECT_EQ(utils::DateYear(full), 1990);
+    EXPECT_EQ(utils::DateMonth(full), 3);
+    EXPECT_EQ(utils::DateDay(full), 17);
+    EXPECT_EQ(utils::FormatDate(full), "1990.03.17");
+
+    EXPECT_EQ(utils::PackDate("1990.??.??"), utils::PackDate(1990, 0, 0));
+    EXPECT_EQ(utils::FormatDate(utils::PackDate("1990.??.??")), "1990.??.??");
+    EXPECT_EQ(utils::FormatDate(utils::PackDate("1990.03.??")), "1990.03.??");
+    EXPECT_EQ(utils::FormatDate(utils::PackDate("2021-11-05")), "2021.11.05");
+    EXPECT_EQ(utils::PackDate("????.??.??"), 0u);
+    EXPECT_EQ(utils::PackDate(""), 0u);
+    EXPECT_EQ(utils::FormatDate(0), "????.??.??");
+
+    // Out-of-range fields are unknown; a day needs a month
+    EXPECT_EQ(utils::FormatDate(utils::PackDate("1990.13.01")), "1990.??.??");
+    EXPECT_EQ(utils::FormatDate(utils::PackDate("1990.02.40")), "1990.02.??");
+    EXPECT_EQ(utils::FormatDate(utils::PackDate("1990.1?.05")), "1990.??.??");
+
+    // Packed dates order like dates; unknown parts sort first
+    EXPECT_LT(utils::PackDate("1990.??.??"), utils::PackDate("1990.01.01"));
+    EXPECT_LT(utils::PackDate("1990.12.31"), utils::PackDate("1991.01.01"));
+
+    Game game;
+    game.SetDate("2001.07.??");
+    EXPECT_EQ(game.GetPackedDate(), utils::PackDate(2001, 7, 0));
+}
+
+TEST(TimeSeriesStats, BucketsByYearAndMonth) {
+    TimeSeriesStats yearly(2000, 3);
+    EXPECT_EQ(yearly.GetBucketCount(), 3);
+    EXPECT_EQ(yearly.BucketOf(utils::PackDate("2001.05.02")), 1);
+    EXPECT_EQ(yearly.BucketOf(utils::PackDate("2003.01.01")), -1);
+    EXPECT_EQ(yearly.BucketOf(0), -1);
+
+    TimeSeriesStats monthly(2000, 2, TimeSeriesStats::Granularity::Month);
+    EXPECT_EQ(monthly.GetBucketCount(), 26);
+    EXPECT_EQ(monthly.BucketOf(utils::PackDate("2000.??.??")), 0);
+    EXPECT_EQ(monthly.BucketOf(utils::PackDate("2001.12.31")), 25);
+    EXPECT_EQ(utils::FormatDate(monthly.BucketDate(14)), "2001.01.??");
+
+    monthly.AddGame(utils::PackDate("2000.03.01"), "B90", "A", "B", "1-0", 2500, 2400);
+    monthly.AddGame(utils::PackDate("2000.??.??"), "C00", "B", "A", "1/2-1/2", 0, 2500);
+    monthly.AddGame(utils::PackDate("2001.06.10"), "B33", "A", "C", "0-1", 2520, 0);
+    monthly.AddGame(0, "B90", "A", "B", "1-0", 0, 0);
+    EXPECT_EQ(monthly.GetUndatedGames(), 1u);
+
+    const auto all = monthly.GetSeries();
+    EXPECT_EQ(all[3].games, 1u);
+    EXPECT_EQ(all[0].draws, 1u);
+    EXPECT_DOUBLE_EQ(all[3].GetAverageElo(), 2450.0);
+    const auto years = monthly.ToYears(all);
+    ASSERT_EQ(years.size(), 2u);
+    EXPECT_EQ(years[0].games, 2u);
+    EXPECT_EQ(years[1].losses, 1u);
+
+    // Player series are from the player's side
+    const auto a = monthly.ToYears(monthly.GetPlayerSeries("A"));
+    EXPECT_EQ(a[0].games, 2u);
+    EXPECT_EQ(a[0].wins, 1u);
+    EXPECT_EQ(a[0].draws, 1u);
+    EXPECT_DOUBLE_EQ(a[0].GetAverageElo(), 2500.0);
+    EXPECT_EQ(a[1].losses, 1u);
+    EXPECT_DOUBLE_EQ(a[0].GetScorePercentage(), 75.0);
+    EXPECT_EQ(monthly.GetPlayerSeries("C")[19].wins, 1u);
+    EXPECT_EQ(monthly.GetPlayerSeries("Nobody")[0].games, 0u);
+    EXPECT_EQ(monthly.GetPlayerCount(), 3u);
+
+    // Sicilian (B20-B99) share per year
+    const auto share = monthly.GetOpeningShare("B20", "B99");
+    EXPECT_DOUBLE_EQ(share[3], 100.0);
+    EXPECT_DOUBLE_EQ(share[0], 0.0);
+    const auto sicilian = monthly.ToYears(monthly.GetOpeningSeries("B20", "B99"));
+    EXPECT_EQ(sicilian[0].games, 1u);
+    EXPECT_EQ(sicilian[1].games, 1u);
+    EXPECT_EQ(monthly.GetOpeningSeries("B20", "Z99")[3].games, 0u);
+}
+
+TEST(TimeSeriesStats, MergesPlayerSpans) {
+    TimeSeriesStats first(2000, 10), second(2000, 10), other(1990, 10);
+    first.AddGame(utils::PackDate("2005.01.01"), "A00", "A", "B", "1-0", 0, 0);
+    second.AddGame(utils::PackDate("2002.01.01"), "A00", "A", "B", "0-1", 0, 0);
+    second.AddGame(utils::PackDate("2008.01.01"), "A00", "B", "A", "0-1", 0, 0);
+    EXPECT_FALSE(first.MergeWith(other));
+    ASSERT_TRUE(first.MergeWith(second));
+
+    const auto a = first.GetPlayerSeries("A");
+    EXPECT_EQ(a[2].losses, 1u);
+    EXPECT_EQ(a[5].wins, 1u);
+    EXPECT_EQ(a[8].wins, 1u);
+    EXPECT_EQ(first.GetSeries()[8].losses, 1u);
+    EXPECT_GT(first.GetMemoryUsage().TotalBytes(), 0u);
+}
+
+TEST(TimeSeriesStats, BuiltByParser) {
+    const fs::path dir = fs::temp_directory_path() / "chessDataLib_time_series";
+    fs::create_directories(dir);
+    const fs::path pgn = dir / "games.pgn";
+    {
+        std::ofstream out(pgn, std::ios::binary);
+        for (int i = 0; i < 40; ++i) {
+            out << "[Event \"E\"]\n[Date \"" << 2010 + i % 4 << ".0" << 1 + i % 9 << ".??\"]\n[White \"P" << i % 5
+                << "\"]\n[Black \"Q\"]\n[Result \"1-0\"]\n[ECO \"" << (i % 2 ? "B90" : "D37")
+                << "\"]\n[WhiteElo \"2400\"]\n\n1. e4 c5 1-0\n\n";
+        }
+    }
+
+    Parser parser;
+    parser.SetThreadCount(2);
+    parser.SetChunkSize(512);
+    parser.SetTimeSeriesRange(2010, 3, TimeSeriesStats::Granularity::Month);
+    ASSERT_TRUE(parser.LoadFile(pgn.string()));
+    const TimeSeriesStats& series = parser.GetTimeSeriesStats();
+    EXPECT_EQ(series.GetUndatedGames(), 10u);
+
+    const auto years = series.ToYears(series.GetSeries());
+    ASSERT_EQ(years.size(), 3u);
+    for (const auto& y : years) EXPECT_EQ(y.games, 10u);
+    EXPECT_EQ(series.ToYears(series.GetPlayerSeries("Q"))[1].losses, 10u);
+    // Odd games are B90 and fall in 2011 and 2013
+    EXPECT_EQ(series.ToYears(series.GetOpeningSeries("B20", "B99"))[1].games, 10u);
+    EXPECT_EQ(series.ToYears(series.GetOpeningSeries("B20", "B99"))[0].games, 0u);
+    EXPECT_DOUBLE_EQ(years[0].GetAverageElo(), 2400.0);
+    EXPECT_EQ(parser.GetOpeningStats().GetYearCount(), 0);
+
+    fs::remove_all(dir);
+}
@@ -0,0 +1,206 @@
+#include "tournament.hpp"
+#include "parser.hpp"
+#include "statsSnapshot.hpp"
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+using namespace chessDataLib;
+namespace fs = std::filesystem;
+
+namespace {
+
+// Four-player round robin: A 2.5, C 2, B 1, D 0.5
+const char* kRoundRobin[][4] = {{"A", "B", "1", "1-0"}, {"C", "D", "1", "1/2-1/2"},
+                                {"A", "C", "2", "1/2-1/2"}, {"B", "D", "2", "1-0"},
+                                {"D", "A", "3", "0-1"}, {"B", "C", "3.1", "0-1"}};
+
+Tournament MakeRoundRobin() {
+    Tournament t("Round Robin");
+    for (const auto& g : kRoundRobin) t.RecordGame(g[0], g[1], g[2], g[3]);
+    return t;
+}
+
+} // namespace
+
+TEST(Tournament, RecordsCompactGames) {
+    Tournament t = MakeRoundRobin();
+    t.RecordGame("A", "E", "?", "*");
+    EXPECT_EQ(t.GetTotalGames(), 7);
+    EXPECT_EQ(t.GetUniquePlayers(), 5);
+    EXPECT_EQ(t.GetPlayerGameCount().at("A"), 4);
+
+    const auto& games = t.GetGames();
+    ASSERT_EQ(games.size(), 7u);
+    EXPECT_EQ(t.GetPlayers()[games[5].white], "B");
+    EXPECT_EQ(games[5].round, 3);
+    EXPECT_EQ(games[5].whitePoints, 0);
+    EXPECT_EQ(games[6].round, 0);
+    EXPECT_EQ(games[6].whitePoints, TournamentGame::kUnfinished);
+
+    const auto round2 = t.GetPairings(2);
+    ASSERT_EQ(round2.size(), 2u);
+    EXPECT_EQ(t.GetPlayers()[round2[1].white], "B");
+    EXPECT_GT(t.GetMemoryUsage().TotalBytes(), 0u);
+}
+
+TEST(Tournament, ComputesScoresAndTieBreaks) {
+    const auto standings = MakeRoundRobin().ComputeStandings();
+    ASSERT_EQ(standings.size(), 4u);
+
+    const char* order[] = {"A", "C", "B", "D"};
+    const double score[] = {2.5, 2.0, 1.0, 0.5};
+    const double buchholz[] = {3.5, 4.0, 5.0, 5.5};
+    const double sonnebornBerger[] = {2.5, 2.5, 0.5, 1.0};
+    const double median[] = {1.0, 1.0, 2.0, 2.0};
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_EQ(standings[i].name, order[i]);
+        EXPECT_EQ(standings[i].rank, i + 1);
+        EXPECT_EQ(standings[i].games, 3);
+        EXPECT_DOUBLE_EQ(standings[i].score, score[i]) << order[i];
+        EXPECT_DOUBLE_EQ(standings[i].buchholz, buchholz[i]) << order[i];
+        EXPECT_DOUBLE_EQ(standings[i].sonnebornBerger, sonnebornBerger[i]) << order[i];
+        EXPECT_DOUBLE_EQ(standings[i].medianBuchholz, median[i]) << order[i];
+    }
+    EXPECT_EQ(standings[0].wins, 2);
+    EXPECT_EQ(standings[0].draws, 1);
+    EXPECT_EQ(standings[3].losses, 2);
+
+    // Full ties share a rank and are listed by name
+    Tournament tie("Tie");
+    tie.RecordGame("Y", "X", "1", "1/2-1/2");
+    tie.RecordGame("Z", "X", "2", "*");
+    const auto tied = tie.ComputeStandings();
+    ASSERT_EQ(tied.size(), 3u);
+    EXPECT_EQ(tied[0].name, "X");
+    EXPECT_EQ(tied[1].name, "Y");
+    EXPECT_EQ(tied[0].rank, 1);
+    EXPECT_EQ(tied[1].rank, 1);
+    EXPECT_EQ(tied[2].rank, 3);
+    EXPECT_EQ(tied[0].games, 1);
+    EXPECT_EQ(tied[2].games, 0);
+}
+
+TEST(Tournament, BuildsCrosstableByRoundOrSequence) {
+    const Crosstable table = MakeRoundRobin().BuildCrosstable();
+    ASSERT_TRUE(table.byRound);
+    ASSERT_EQ(table.columns, (std::vector<int>{1, 2, 3}));
+    ASSERT_EQ(table.rows.size(), 4u);
+
+    // Row 0 is A: beat B (row 2) with white in round 1
+    const Crosstable::Cell& cell = table.At(0, 0);
+    EXPECT_EQ(cell.opponent, 2);
+    EXPECT_TRUE(cell.white);
+    EXPECT_EQ(cell.points, 2);
+    EXPECT_EQ(table.At(2, 0).opponent, 0);
+    EXPECT_EQ(table.At(2, 0).points, 0);
+    EXPECT_FALSE(table.At(2, 0).white);
+    const std::string text = table.ToString();
+    EXPECT_NE(text.find("3w1"), std::string::npos) << text;
+    EXPECT_NE(text.find("R3"), std::string::npos) << text;
+
+    // Missing and repeated rounds fall back to each player's game sequence
+    Tournament match("Match");
+    match.RecordGame("P", "Q", "?", "1-0");
+    match.RecordGame("Q", "P", "?", "1/2-1/2");
+    match.RecordGame("P", "Q", "", "*");
+    const Crosstable seq = match.BuildCrosstable();
+    EXPECT_FALSE(seq.byRound);
+    ASSERT_EQ(seq.columns, (std::vector<int>{1, 2, 3}));
+    EXPECT_EQ(seq.rows[0].name, "P");
+    EXPECT_EQ(seq.At(0, 1).points, 1);
+    EXPECT_FALSE(seq.At(0, 1).white);
+    EXPECT_EQ(seq.At(1, 2).points, TournamentGame::kUnfinished);
+    EXPECT_NE(seq.ToString().find("G3"), std::string::npos);
+}
+
+TEST(Tournament, MergeRemapsPlayerIndices) {
+    Tournament first("Round Robin"), second("Round Robin");
+    for (int i = 0; i < 6; ++i) {
+        const auto& g = kRoundRobin[i];
+        (i % 2 ? second : first).RecordGame(g[0], g[1], g[2], g[3]);
+    }
+    first.MergeWith(second);
+    EXPECT_EQ(first.GetTotalGames(), 6);
+    EXPECT_EQ(first.GetUniquePlayers(), 4);
+
+    const auto merged = first.ComputeStandings();
+    const auto expected = MakeRoundRobin().ComputeStandings();
+    ASSERT_EQ(merged.size(), expected.size());
+    for (std::size_t i = 0; i < merged.size(); ++i) {
+        EXPECT_EQ(merged[i].name, expected[i].name);
+        EXPECT_DOUBLE_EQ(merged[i].sonnebornBerger, expected[i].sonnebornBerger);
+    }
+}
+
+TEST(Tournament, StandingsSurviveParserAndSnapshot) {
+    const fs::path dir = fs::temp_directory_path() / "chessDataLib_tournament";
+    fs::create_directories(dir);
+    const fs::path pgn = dir / "rr.pgn";
+    {
+        std::ofstream out(pgn, std::ios::binary);
+        for (const auto& g : kRoundRobin) {
+            out << "[Event \"Round Robin\"]\n[Round \"" << g[2] << "\"]\n[White \"" << g[0] << "\"]\n[Black \""
+                << g[1] << "\"]\n[Result \"" << g[3] << "\"]\n\n1. e4 e5 " << g[3] << "\n\n";
+        }
+    }
+
+    Parser parser;
+    parser.SetThreadCount(2);
+    ASSERT_TRUE(parser.LoadFile(pgn.string()));
+    const Tournament& t = parser.GetTournaments().at("Round Robin");
+    ASSERT_EQ(t.GetGames().size(), 6u);
+    EXPECT_EQ(t.ComputeStandings()[0].name, "A");
+
+    const fs::path csv = dir / "standings.csv";
+    ASSERT_TRUE(parser.ExportStandingsCSV(csv.string()));
+    std::ifstream in(csv);
+    std::string header, first;
+    std::getline(in, header);
+    std::getline(in, first);
+    EXPECT_EQ(header, "Tournament,Rank,Player,Games,Wins,Draws,Losses,Score,Buchholz,SonnebornBerger,MedianBuchholz");
+    EXPECT_EQ(first, "Round Robin,1,A,3,2,1,0,2.5,3.5,2.5,1");
+    EXPECT_FALSE(parser.ExportStandingsCSV((dir / "missing" / "x.csv").string()));
+
+    // Snapshots keep the game arrays, so standings come back without the PGN
+    FileIdentity identity;
+    DatabaseStats restored;
+    ASSERT_TRUE(StatsSnapshot::Deserialize(StatsSnapshot::Serialize(identity, parser.GetStats()), identity, restored));
+    const auto standings = restored.GetTournaments().at("Round Robin").ComputeStandings();
+    ASSERT_EQ(standings.size(), 4u);
+    EXPECT_EQ(standings[1].name, "C");
+    EXPECT_DOUBLE_EQ(standings[3].buchholz, 5.5);
+
+    fs::remove_all(dir);
+}
+
+TEST(Tournament, ChunkedLoadKeepsFileOrder) {
+    const fs::path dir = fs::temp_directory_path() / "chessDataLib_tournament_order";
+    fs::create_directories(dir);
+    const fs::path pgn = dir / "swiss.pgn";
+    {
+        // Round g / 10 + 1, players numbered by game so the order is visible
+        std::ofstream out(pgn, std::ios::binary);
+        for (int g = 0; g < 400; ++g) {
+            out << "[Event \"Swiss\"]\n[Round \"" << g / 10 + 1 << "\"]\n[White \"W" << g << "\"]\n[Black \"B"
+                << g % 10 << "\"]\n[Result \"1-0\"]\n\n1. e4 e5 1-0\n\n";
+        }
+    }
+
+    Parser parser;
+    parser.SetThreadCount(4);
+    parser.SetChunkSize(1024);
+    ASSERT_TRUE(parser.LoadFile(pgn.string()));
+    const Tournament& t = parser.GetTournaments().at("Swiss");
+    const auto& games = t.GetGames();
+    ASSERT_EQ(games.size(), 400u);
+    for (std::size_t g = 0; g < games.size(); ++g) {
+        EXPECT_EQ(t.GetPlayers()[games[g].white], "W" + std::to_string(g));
+        EXPECT_EQ(games[g].round, g / 10 + 1);
+    }
+    const auto pairings = t.GetPairings(7);
+    ASSERT_EQ(pairings.size(), 10u);
+    EXPECT_EQ(t.GetPlayers()[pairings[0].white], "W60");
+    fs::remove_all(dir);
+}
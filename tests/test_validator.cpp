@@ -0,0 +1,185 @@
+#include "PGNValidator.hpp"
+#include "board.hpp"
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+using namespace chessDataLib;
+
+namespace {
+
+std::uint64_t Perft(const Board& board, int depth) {
+    Move moves[Board::kMaxMoves];
+    const int n = board.GenerateLegal(moves);
+    if (depth == 1) return static_cast<std::uint64_t>(n);
+    std::uint64_t nodes = 0;
+    for (int i = 0; i < n; ++i) {
+        Board next = board;
+        next.MakeMove(moves[i]);
+        nodes += Perft(next, depth - 1);
+    }
+    return nodes;
+}
+
+bool SetFen(Board& board, const char* fen) {
+    return board.SetFen(fen, fen + std::strlen(fen));
+}
+
+SanStatus Play(Board& board, const char* san) {
+    Move move;
+    const SanStatus status = board.ParseSan(san, san + std::strlen(san), move);
+    if (status == SanStatus::Ok) board.MakeMove(move);
+    return status;
+}
+
+std::vector<ValidationIssue> Validate(const std::string& pgn) {
+    std::vector<ValidationIssue> issues;
+    PGNValidator::ValidateGame(pgn.data(), pgn.data() + pgn.size(), 100, issues);
+    return issues;
+}
+
+} // namespace
+
+TEST(Board, PerftMatchesKnownCounts) {
+    Board start;
+    EXPECT_EQ(Perft(start, 3), 8902u);
+
+    // "Kiwipete": castling, en passant and promotions in one position
+    Board kiwipete;
+    ASSERT_TRUE(SetFen(kiwipete, "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1"));
+    EXPECT_EQ(Perft(kiwipete, 2), 2039u);
+    EXPECT_EQ(Perft(kiwipete, 3), 97862u);
+}
+
+TEST(Board, ResolvesSanIncludingSpecialMoves) {
+    Board board;
+    for (const char* san : {"e4", "d5", "exd5", "c5", "dxc6", "Nf6", "cxb7", "Nbd7", "bxa8=Q", "e6", "Nf3", "Be7",
+                            "Bb5", "O-O", "O-O"}) {
+        EXPECT_EQ(Play(board, san), SanStatus::Ok) << san;
+    }
+    EXPECT_EQ(board.PieceAt(6), King | (White << 3));
+    EXPECT_EQ(board.PieceAt(62), King | (Black << 3));
+    EXPECT_EQ(board.PieceAt(56), Queen | (White << 3));
+    EXPECT_EQ(board.CastlingRights(), 0);
+}
+
+TEST(Board, ReportsAmbiguousIllegalAndMalformedSan) {
+    Board board;
+    ASSERT_TRUE(SetFen(board, "4k3/8/8/8/8/8/4K3/R6R w - - 0 1"));
+    EXPECT_EQ(Play(board, "Rd1"), SanStatus::Ambiguous);
+    EXPECT_EQ(Play(board, "O-O"), SanStatus::Illegal);
+    EXPECT_EQ(Play(board, "Rz9"), SanStatus::Malformed);
+    EXPECT_EQ(Play(board, "Rad1"), SanStatus::Ok);
+
+    // A pinned knight does not make the other knight's move ambiguous
+    ASSERT_TRUE(SetFen(board, "7k/8/8/8/8/2N1N3/8/4K3 w - - 0 1"));
+    EXPECT_EQ(Play(board, "Nd5"), SanStatus::Ambiguous);
+    ASSERT_TRUE(SetFen(board, "4r2k/8/8/8/8/2N1N3/8/4K3 w - - 0 1"));
+    EXPECT_EQ(Play(board, "Nd5"), SanStatus::Ok);
+    EXPECT_EQ(board.PieceAt(35), Knight | (White << 3));
+}
+
+TEST(Board, PackedMovesRoundTrip) {
+    Board kiwipete;
+    ASSERT_TRUE(SetFen(kiwipete, "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1"));
+    Board promotion;
+    ASSERT_TRUE(SetFen(promotion, "n3k3/1P6/8/8/8/8/8/4K3 w - - 0 1"));
+    Board enPassant;
+    ASSERT_TRUE(SetFen(enPassant, "4k3/8/8/3pP3/8/8/8/4K3 w - d6 0 1"));
+
+    for (const Board* board : {&kiwipete, &promotion, &enPassant}) {
+        Move moves[Board::kMaxMoves];
+        const int n = board->GenerateLegal(moves);
+        for (int i = 0; i < n; ++i) {
+            const PackedMove packed = Board::Pack(moves[i]);
+            EXPECT_NE(packed, 0);
+            Board expected = *board;
+            expected.MakeMove(moves[i]);
+            Board actual = *board;
+            actual.MakeMove(board->Unpack(packed));
+            for (int sq = 0; sq < 64; ++sq) ASSERT_EQ(actual.PieceAt(sq), expected.PieceAt(sq)) << i;
+            EXPECT_EQ(actual.CastlingRights(), expected.CastlingRights());
+        }
+    }
+}
+
+TEST(PGNValidator, AcceptsCleanGames) {
+    const std::string pgn =
+        "[Event \"Test\"]\r\n[Date \"2001.??.??\"]\r\n[Result \"1-0\"]\r\n[WhiteElo \"2450\"]\r\n[ECO \"C20\"]\r\n\r\n"
+        "1. e4 {comment} e5 2. Qh5 (2. Nf3 Nc6) Nc6 3. Bc4 Nf6?? 4. Qxf7# 1-0\r\n";
+    EXPECT_TRUE(Validate(pgn).empty());
+
+    const std::string stalemate = "[FEN \"7k/8/6K1/8/8/8/8/5Q2 w - - 0 1\"]\n\n1. Qf7 1/2-1/2\n";
+    EXPECT_TRUE(Validate(stalemate).empty());
+
+    // The result tag agrees with the token, but the final position is stalemate
+    const std::string wrongResult =
+        "[Result \"1-0\"]\n[FEN \"7k/8/6K1/8/8/8/8/5Q2 w - - 0 1\"]\n\n1. Qf7 1-0\n";
+    const auto issues = Validate(wrongResult);
+    ASSERT_EQ(issues.size(), 1u);
+    EXPECT_EQ(issues[0].kind, ValidationIssueKind::ResultMismatch);
+    EXPECT_EQ(issues[0].ply, 1u);
+}
+
+TEST(PGNValidator, ReportsMoveAndTagIssuesWithOffsets) {
+    const std::string pgn =
+        "[Result \"1-0\"]\n[WhiteElo \"24x0\"]\n[Date \"2001.13.01\"]\n\n1. e4 e5 2. Ke3 Nc6 0-1\n";
+    const auto issues = Validate(pgn);
+    ASSERT_EQ(issues.size(), 4u);
+    EXPECT_EQ(issues[0].kind, ValidationIssueKind::BadEloTag);
+    EXPECT_EQ(issues[0].offset, 100u + pgn.find("[WhiteElo"));
+    EXPECT_EQ(issues[1].kind, ValidationIssueKind::BadDateTag);
+    EXPECT_EQ(issues[2].kind, ValidationIssueKind::IllegalMove);
+    EXPECT_EQ(issues[2].detail, "Ke3");
+    EXPECT_EQ(issues[2].ply, 3u);
+    EXPECT_EQ(issues[2].offset, 100u + pgn.find("Ke3"));
+    EXPECT_EQ(issues[3].kind, ValidationIssueKind::ResultMismatch);
+    EXPECT_EQ(issues[3].detail, "0-1");
+
+    const auto missing = Validate("[Result \"*\"]\n\n1. e4 e5\n");
+    ASSERT_EQ(missing.size(), 1u);
+    EXPECT_EQ(missing[0].kind, ValidationIssueKind::MissingResult);
+}
+
+TEST(PGNValidator, ValidatesFilesInParallelChunks) {
+    const std::string path = "validator_test.pgn";
+    const std::string good = "[Event \"E\"]\n[Result \"1/2-1/2\"]\n\n1. d4 d5 2. c4 e6 1/2-1/2\n\n";
+    const std::string bad = "[Event \"E\"]\n[Result \"1-0\"]\n\n1. d4 d5 2. Ke3 e6 1-0\n\n";
+    std::ostringstream content;
+    for (int i = 0; i < 200; ++i) content << (i % 50 == 7 ? bad : good);
+    {
+        std::ofstream out(path, std::ios::binary);
+        out << content.str();
+    }
+
+    PGNValidator validator;
+    validator.SetThreadCount(4);
+    validator.SetChunkSize(1024);
+    ValidationReport report;
+    ASSERT_TRUE(validator.ValidateFiles({path}, report));
+    EXPECT_EQ(report.games, 200u);
+    EXPECT_EQ(report.gamesWithIssues, 4u);
+    ASSERT_EQ(report.Count(ValidationIssueKind::IllegalMove), 4u);
+    for (int k = 0; k < 4; ++k) {
+        const ValidationIssue& issue = report.issues[static_cast<std::size_t>(k)];
+        const std::uint64_t game = static_cast<std::uint64_t>(k * 50 + 7);
+        EXPECT_EQ(issue.game, game);
+        EXPECT_EQ(issue.gameOffset, (game - static_cast<std::uint64_t>(k)) * good.size() + k * bad.size());
+        EXPECT_EQ(issue.offset, issue.gameOffset + bad.find("Ke3"));
+    }
+
+    const std::string reportPath = "validator_test.jsonl";
+    ASSERT_TRUE(report.WriteJsonLines(reportPath));
+    std::ifstream in(reportPath);
+    std::string line;
+    std::getline(in, line);
+    EXPECT_NE(line.find("\"games\":200"), std::string::npos);
+    std::getline(in, line);
+    EXPECT_NE(line.find("\"kind\":\"illegal_move\""), std::string::npos);
+    EXPECT_NE(line.find("\"detail\":\"Ke3\""), std::string::npos);
+
+    std::remove(path.c_str());
+    std::remove(reportPath.c_str());
+}
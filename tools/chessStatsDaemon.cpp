@@ -0,0 +1,60 @@
+// Resident stats daemon: loads a PGN file or stats snapshot once and answers
+// StatsServer queries on a Unix domain socket until SIGINT or SIGTERM.
+// SIGHUP reloads the file; queries keep being answered from the old data
+// until the new data is ready.
+//
+//     chessStatsDaemon <database.pgn|snapshot> <socket> [threads]
+//
+// Try it with: printf 'STATS\nPLAYER Carlsen, Magnus\n' | nc -U <socket>
+
+#include "statsServer.hpp"
+#include <csignal>
+#include <cstdlib>
+#include <iostream>
+#include <pthread.h>
+#include <string>
+
+using namespace chessDataLib;
+
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        std::cerr << "usage: " << argv[0] << " <database.pgn|snapshot> <socket> [threads]\n";
+        return 2;
+    }
+    const std::string database = argv[1];
+    const std::string socketPath = argv[2];
+    const unsigned threads = argc > 3 ? static_cast<unsigned>(std::strtoul(argv[3], nullptr, 10)) : 0;
+
+    // Handle signals synchronously on this thread; workers inherit the mask
+    sigset_t signals;
+    sigemptyset(&signals);
+    sigaddset(&signals, SIGINT);
+    sigaddset(&signals, SIGTERM);
+    sigaddset(&signals, SIGHUP);
+    pthread_sigmask(SIG_BLOCK, &signals, nullptr);
+
+    auto dataset = StatsServer::LoadDataset(database, threads);
+    if (!dataset) {
+        std::cerr << "chessStatsDaemon: failed to load " << database << "\n";
+        return 1;
+    }
+    StatsServer server;
+    server.SetDataset(std::move(dataset));
+    if (!server.Start(socketPath, threads)) return 1;
+    std::cerr << "chessStatsDaemon: serving " << database << " on " << socketPath << "\n";
+
+    while (true) {
+        int signal = 0;
+        if (sigwait(&signals, &signal) != 0 || signal != SIGHUP) break;
+        if (auto reloaded = StatsServer::LoadDataset(database, threads)) {
+            server.SetDataset(std::move(reloaded));
+            std::cerr << "chessStatsDaemon: reloaded " << database << "\n";
+        } else {
+            std::cerr << "chessStatsDaemon: reload failed, keeping the previous data\n";
+        }
+    }
+
+    server.Stop();
+    std::cerr << "chessStatsDaemon: answered " << server.GetRequestCount() << " requests\n";
+    return 0;
+}